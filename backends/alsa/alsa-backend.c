@@ -39,6 +39,21 @@
 #define BACKEND_PRIORITY 20
 #define BACKEND_FLAGS MATE_MIXER_BACKEND_NO_FLAGS
 
+/* Maximum number of sound cards probed at the same time */
+#define PROBE_MAX_THREADS 8
+
+#ifdef ALSA_BENCH_PROBE_DELAY
+/* The benchmark build of the backend, see bench/Makefile.am, delays probing
+ * each card by ALSA_BENCH_PROBE_DELAY milliseconds, which stands in for a slow
+ * card, and reads the maximum number of cards probed at the same time from
+ * the environment variable below, 0 probes them one after another in the
+ * calling thread */
+#define ALSA_ENV_PROBE_THREADS "MATE_MIXER_ALSA_PROBE_THREADS"
+#endif
+
+/* List of the sound cards known to the kernel */
+#define PROC_ASOUND_CARDS "/proc/asound/cards"
+
 #define ALSA_DEVICE_GET_ID(d) \
   (g_object_get_data(G_OBJECT(d), "__matemixer_alsa_device_id"))
 
@@ -46,11 +61,31 @@
   (g_object_set_data_full(G_OBJECT(d), "__matemixer_alsa_device_id", \
                           g_strdup(id), g_free))
 
+typedef struct {
+  GMutex mutex;
+  GCond cond;
+  guint pending;
+  gboolean open_mixers;
+  GHashTable *devices_ids;
+} AlsaProbeBatch;
+
+typedef struct {
+  gchar *card;
+  gchar *id;
+  gchar *label;
+  snd_mixer_t *handle;
+  AlsaProbeBatch *batch;
+} AlsaCardProbe;
+
 struct _AlsaBackendPrivate {
   GSource *timeout_source;
+  GThreadPool *probe_pool;
+  gchar *cards;
   GList *streams;
   GList *devices;
   GHashTable *devices_ids;
+  MateMixerLoadingFlags loading_flags;
+  guint transaction_depth;
 
 #ifdef HAVE_UDEV
   struct {
@@ -69,17 +104,33 @@ G_DEFINE_DYNAMIC_TYPE_EXTENDED(AlsaBackend, alsa_backend,
                                MATE_MIXER_TYPE_BACKEND, 0,
                                G_ADD_PRIVATE_DYNAMIC(AlsaBackend))
 
+static void alsa_backend_set_loading_flags(MateMixerBackend *backend,
+                                           MateMixerLoadingFlags flags);
 static gboolean alsa_backend_open(MateMixerBackend *backend);
 static void alsa_backend_close(MateMixerBackend *backend);
 static const GList *alsa_backend_list_devices(MateMixerBackend *backend);
 static const GList *alsa_backend_list_streams(MateMixerBackend *backend);
+static GList *alsa_backend_list_loaded_streams(MateMixerBackend *backend);
+static void alsa_backend_begin_transaction(MateMixerBackend *backend);
+static void alsa_backend_commit_transaction(MateMixerBackend *backend);
 
 static gboolean read_devices(AlsaBackend *alsa);
+static gboolean read_devices_if_changed(AlsaBackend *alsa);
+static void read_devices_filtered(AlsaBackend *alsa, gboolean skip_known);
 
-static gboolean read_device(AlsaBackend *alsa, const gchar *card);
+static gboolean read_cards(AlsaBackend *alsa);
+
+static gboolean read_device(AlsaBackend *alsa, AlsaCardProbe *probe);
+
+static void probe_cards(AlsaBackend *alsa, GPtrArray *probes);
+static void probe_card(AlsaCardProbe *probe, gpointer user_data);
 
 static void add_device(AlsaBackend *alsa, AlsaDevice *device);
 
+static void load_deferred_devices(AlsaBackend *alsa);
+
+static void remove_vanished_devices(AlsaBackend *alsa, GPtrArray *probes);
+
 static void remove_device(AlsaBackend *alsa, AlsaDevice *device);
 static void remove_device_by_name(AlsaBackend *alsa, const gchar *name);
 static void remove_device_by_list_item(AlsaBackend *alsa, GList *item);
@@ -91,6 +142,13 @@ static void select_default_output_stream(AlsaBackend *alsa);
 
 static void free_stream_list(AlsaBackend *alsa);
 
+static AlsaCardProbe *card_probe_new(const gchar *card);
+static void card_probe_free(AlsaCardProbe *probe);
+
+#ifdef ALSA_BENCH_PROBE_DELAY
+static guint read_config_uint(const gchar *variable, guint value);
+#endif
+
 static gint compare_devices(gconstpointer a, gconstpointer b);
 static gint compare_device_name(gconstpointer a, gconstpointer b);
 
@@ -117,10 +175,14 @@ static void alsa_backend_class_init(AlsaBackendClass *klass) {
   object_class->finalize = alsa_backend_finalize;
 
   backend_class = MATE_MIXER_BACKEND_CLASS(klass);
+  backend_class->set_loading_flags = alsa_backend_set_loading_flags;
   backend_class->open = alsa_backend_open;
   backend_class->close = alsa_backend_close;
   backend_class->list_devices = alsa_backend_list_devices;
   backend_class->list_streams = alsa_backend_list_streams;
+  backend_class->list_loaded_streams = alsa_backend_list_loaded_streams;
+  backend_class->begin_transaction = alsa_backend_begin_transaction;
+  backend_class->commit_transaction = alsa_backend_commit_transaction;
 }
 
 /* Called in the code generated by G_DEFINE_DYNAMIC_TYPE() */
@@ -240,8 +302,8 @@ static void timeout_source_setup(AlsaBackend *alsa) {
   /* Poll ALSA for changes every second, this only discovers added or removed
    * sound cards, sound card related events are handled by AlsaDevices */
   alsa->priv->timeout_source = g_timeout_source_new_seconds(1);
-  g_source_set_callback(alsa->priv->timeout_source, (GSourceFunc)read_devices,
-                        alsa, NULL);
+  g_source_set_callback(alsa->priv->timeout_source,
+                        (GSourceFunc)read_devices_if_changed, alsa, NULL);
   g_source_attach(alsa->priv->timeout_source,
                   g_main_context_get_thread_default());
 }
@@ -252,18 +314,47 @@ static void timeout_source_cleanup(AlsaBackend *alsa) {
   g_source_destroy(alsa->priv->timeout_source);
 }
 
+static void alsa_backend_set_loading_flags(MateMixerBackend *backend,
+                                           MateMixerLoadingFlags flags) {
+  g_return_if_fail(ALSA_IS_BACKEND(backend));
+
+  ALSA_BACKEND(backend)->priv->loading_flags = flags;
+}
+
 static gboolean alsa_backend_open(MateMixerBackend *backend) {
   AlsaBackend *alsa;
+  guint threads;
+  GError *error = NULL;
 
   g_return_val_if_fail(ALSA_IS_BACKEND(backend), FALSE);
 
   alsa = ALSA_BACKEND(backend);
 
+  threads = PROBE_MAX_THREADS;
+#ifdef ALSA_BENCH_PROBE_DELAY
+  threads = read_config_uint(ALSA_ENV_PROBE_THREADS, threads);
+#endif
+
+  /* Sound cards are probed in parallel as opening a slow card may take a long
+   * time, without the pool they are just probed one after another */
+  if (threads > 0) {
+    alsa->priv->probe_pool = g_thread_pool_new((GFunc)probe_card, NULL,
+                                               threads, FALSE, &error);
+    if (alsa->priv->probe_pool == NULL) {
+      g_warning("Failed to create thread pool: %s", error->message);
+      g_error_free(error);
+    }
+  }
+
 #ifdef HAVE_UDEV
   if (!udev_monitor_setup(alsa))
 #endif
     timeout_source_setup(alsa);
 
+  /* Remember the current set of cards, so that polling does not probe the
+   * same cards again */
+  read_cards(alsa);
+
   /* Read the initial list of devices so we have some starting point, there
    * isn't really a way to detect errors here, failing to add a device may
    * be a device-related problem so make the backend always open successfully */
@@ -285,6 +376,18 @@ void alsa_backend_close(MateMixerBackend *backend) {
   udev_monitor_cleanup(alsa);
 #endif
 
+  if (alsa->priv->probe_pool != NULL) {
+    g_thread_pool_free(alsa->priv->probe_pool, FALSE, TRUE);
+    alsa->priv->probe_pool = NULL;
+  }
+
+  /* Do not lose the changes of an unfinished transaction */
+  if (alsa->priv->transaction_depth > 0) {
+    alsa->priv->transaction_depth = 0;
+
+    g_list_foreach(alsa->priv->devices, (GFunc)alsa_device_flush_writes, NULL);
+  }
+
   if (alsa->priv->devices != NULL) {
     g_list_free_full(alsa->priv->devices, g_object_unref);
     alsa->priv->devices = NULL;
@@ -294,6 +397,8 @@ void alsa_backend_close(MateMixerBackend *backend) {
 
   g_hash_table_remove_all(alsa->priv->devices_ids);
 
+  g_clear_pointer(&alsa->priv->cards, g_free);
+
   _mate_mixer_backend_set_state(backend, MATE_MIXER_STATE_IDLE);
 }
 
@@ -313,6 +418,10 @@ static const GList *alsa_backend_list_streams(MateMixerBackend *backend) {
   if (alsa->priv->streams == NULL) {
     GList *list;
 
+    /* Loading a device may emit stream-added and invalidate the list, so
+     * make sure all the devices are loaded before creating it */
+    load_deferred_devices(alsa);
+
     /* Walk through the list of devices and create the stream list, each
      * device has at most one input and one output stream */
     list = g_list_last(alsa->priv->devices);
@@ -337,15 +446,92 @@ static const GList *alsa_backend_list_streams(MateMixerBackend *backend) {
   return alsa->priv->streams;
 }
 
+static GList *alsa_backend_list_loaded_streams(MateMixerBackend *backend) {
+  AlsaBackend *alsa;
+  GList *streams = NULL;
+  GList *list;
+
+  g_return_val_if_fail(ALSA_IS_BACKEND(backend), NULL);
+
+  alsa = ALSA_BACKEND(backend);
+
+  /* Same as the stream list, but skip the devices which have not been
+   * loaded instead of loading them */
+  list = g_list_last(alsa->priv->devices);
+  while (list != NULL) {
+    AlsaDevice *device = ALSA_DEVICE(list->data);
+    AlsaStream *stream;
+
+    if (alsa_device_is_load_deferred(device) == FALSE) {
+      stream = alsa_device_get_output_stream(device);
+      if (stream != NULL) streams = g_list_prepend(streams, stream);
+
+      stream = alsa_device_get_input_stream(device);
+      if (stream != NULL) streams = g_list_prepend(streams, stream);
+    }
+    list = list->prev;
+  }
+  return streams;
+}
+
+static void alsa_backend_begin_transaction(MateMixerBackend *backend) {
+  AlsaBackend *alsa;
+
+  g_return_if_fail(ALSA_IS_BACKEND(backend));
+
+  alsa = ALSA_BACKEND(backend);
+
+  /* Contexts sharing the backend may run their transactions at once */
+  if (alsa->priv->transaction_depth++ > 0) return;
+
+  /* Devices added or loaded during the transaction write right away */
+  g_list_foreach(alsa->priv->devices, (GFunc)alsa_device_hold_writes, NULL);
+}
+
+static void alsa_backend_commit_transaction(MateMixerBackend *backend) {
+  AlsaBackend *alsa;
+
+  g_return_if_fail(ALSA_IS_BACKEND(backend));
+
+  alsa = ALSA_BACKEND(backend);
+
+  if (alsa->priv->transaction_depth == 0) return;
+  if (--alsa->priv->transaction_depth > 0) return;
+
+  g_list_foreach(alsa->priv->devices, (GFunc)alsa_device_flush_writes, NULL);
+}
+
 static gboolean read_devices(AlsaBackend *alsa) {
+  read_devices_filtered(alsa, FALSE);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean read_devices_if_changed(AlsaBackend *alsa) {
+  /* Probing opens every card, which is not worth doing each second for the
+   * cards which are already known when the set of cards has not changed,
+   * the loaded devices handle their own events.
+   * The "default" device is always probed as it may be reassigned without
+   * the set of cards changing, and so are the unknown cards, which may have
+   * become readable in the meantime */
+  read_devices_filtered(alsa, !read_cards(alsa));
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void read_devices_filtered(AlsaBackend *alsa, gboolean skip_known) {
+  GPtrArray *probes;
   gint num;
   gint ret;
+  guint i;
   gchar card[16];
   gboolean added = FALSE;
 
+  probes = g_ptr_array_new_with_free_func((GDestroyNotify)card_probe_free);
+
   /* Read the default device first, it will be either one of the hardware cards
    * that will be queried later, or a software mixer */
-  if (read_device(alsa, "default") == TRUE) added = TRUE;
+  g_ptr_array_add(probes, card_probe_new("default"));
 
   for (num = -1;;) {
     /* Read number of the next sound card */
@@ -354,24 +540,55 @@ static gboolean read_devices(AlsaBackend *alsa) {
 
     g_snprintf(card, sizeof(card), "hw:%d", num);
 
-    if (read_device(alsa, card) == TRUE) added = TRUE;
+    if (skip_known == TRUE &&
+        g_list_find_custom(alsa->priv->devices, card, compare_device_name) !=
+            NULL)
+      continue;
+
+    g_ptr_array_add(probes, card_probe_new(card));
   }
 
+  probe_cards(alsa, probes);
+
+  /* The probes may finish in any order, but the devices are always added in
+   * the order of the cards */
+  for (i = 0; i < probes->len; i++) {
+    if (read_device(alsa, g_ptr_array_index(probes, i)) == TRUE) added = TRUE;
+  }
+
+  /* Only a complete list of cards tells which ones have vanished */
+  if (skip_known == FALSE) remove_vanished_devices(alsa, probes);
+
+  g_ptr_array_unref(probes);
+
   /* If any card has been added, make sure we have the most suitable default
    * input and output streams */
   if (added == TRUE) {
     select_default_input_stream(alsa);
     select_default_output_stream(alsa);
   }
-  return G_SOURCE_CONTINUE;
 }
 
-static gboolean read_device(AlsaBackend *alsa, const gchar *card) {
+static gboolean read_cards(AlsaBackend *alsa) {
+  gchar *cards;
+
+  /* Without the proc file there is no cheap way to find out, so assume
+   * a change */
+  if (g_file_get_contents(PROC_ASOUND_CARDS, &cards, NULL, NULL) == FALSE)
+    return TRUE;
+
+  if (g_strcmp0(cards, alsa->priv->cards) == 0) {
+    g_free(cards);
+    return FALSE;
+  }
+
+  g_free(alsa->priv->cards);
+  alsa->priv->cards = cards;
+  return TRUE;
+}
+
+static gboolean read_device(AlsaBackend *alsa, AlsaCardProbe *probe) {
   AlsaDevice *device;
-  snd_ctl_t *ctl;
-  snd_ctl_card_info_t *info;
-  const gchar *id;
-  gint ret;
 
   /*
    * The device may be already known.
@@ -381,46 +598,108 @@ static gboolean read_device(AlsaBackend *alsa, const gchar *card) {
    * reassigned by ALSA when the sound card is removed or the sound mixer
    * quits.
    */
-  ret = snd_ctl_open(&ctl, card, 0);
-  if (ret < 0) {
-    remove_device_by_name(alsa, card);
+  if (probe->id == NULL) {
+    remove_device_by_name(alsa, probe->card);
     return FALSE;
   }
 
-  snd_ctl_card_info_alloca(&info);
+  /* We also keep a list of device identifiers to be sure no card is
+   * added twice, this could commonly happen because some card may
+   * also be assigned to the "default" ALSA device */
+  if (g_hash_table_contains(alsa->priv->devices_ids, probe->id) == TRUE)
+    return FALSE;
 
-  ret = snd_ctl_card_info(ctl, info);
-  if (ret < 0) {
-    g_warning("Failed to read card info: %s", snd_strerror(ret));
+  device = alsa_device_new(probe->card, probe->label);
 
-    remove_device_by_name(alsa, card);
-    snd_ctl_close(ctl);
+  /* With deferred devices the card info is all we need to list the device,
+   * its mixer is loaded when the device streams are first requested */
+  if (alsa->priv->loading_flags & MATE_MIXER_LOADING_DEFER_DEVICES)
+    alsa_device_defer_load(device);
+  else if (probe->handle == NULL) {
+    g_object_unref(device);
     return FALSE;
+  } else {
+    alsa_device_open_with_mixer(device, probe->handle);
+    probe->handle = NULL;
   }
 
-  id = snd_ctl_card_info_get_id(info);
+  ALSA_DEVICE_SET_ID(device, probe->id);
+  add_device(alsa, device);
+  return TRUE;
+}
 
-  /* We also keep a list of device identifiers to be sure no card is
-   * added twice, this could commonly happen because some card may
-   * also be assigned to the "default" ALSA device */
-  if (g_hash_table_contains(alsa->priv->devices_ids, id) == TRUE) {
-    snd_ctl_close(ctl);
-    return FALSE;
+static void probe_cards(AlsaBackend *alsa, GPtrArray *probes) {
+  AlsaProbeBatch batch;
+  guint i;
+
+  if (probes->len == 0) return;
+
+  g_mutex_init(&batch.mutex);
+  g_cond_init(&batch.cond);
+
+  batch.pending = probes->len;
+  batch.open_mixers =
+      !(alsa->priv->loading_flags & MATE_MIXER_LOADING_DEFER_DEVICES);
+  batch.devices_ids = alsa->priv->devices_ids;
+
+  for (i = 0; i < probes->len; i++) {
+    AlsaCardProbe *probe = g_ptr_array_index(probes, i);
+
+    probe->batch = &batch;
+
+    if (alsa->priv->probe_pool == NULL ||
+        g_thread_pool_push(alsa->priv->probe_pool, probe, NULL) == FALSE)
+      probe_card(probe, NULL);
   }
 
-  device = alsa_device_new(card, snd_ctl_card_info_get_name(info));
+  /* Wait for all the probes to finish, the workers read the table of device
+   * identifiers, so it must not change until then */
+  g_mutex_lock(&batch.mutex);
+  while (batch.pending > 0) g_cond_wait(&batch.cond, &batch.mutex);
+  g_mutex_unlock(&batch.mutex);
+
+  g_mutex_clear(&batch.mutex);
+  g_cond_clear(&batch.cond);
+}
+
+static void probe_card(AlsaCardProbe *probe, gpointer user_data) {
+  AlsaProbeBatch *batch = probe->batch;
+  snd_ctl_t *ctl;
+  snd_ctl_card_info_t *info;
+  gint ret;
+
+  /* This function is called in a worker thread, it must not touch the
+   * backend or any device instance */
+#ifdef ALSA_BENCH_PROBE_DELAY
+  g_usleep(ALSA_BENCH_PROBE_DELAY * G_TIME_SPAN_MILLISECOND);
+#endif
+
+  ret = snd_ctl_open(&ctl, probe->card, 0);
+  if (ret == 0) {
+    snd_ctl_card_info_alloca(&info);
+
+    ret = snd_ctl_card_info(ctl, info);
+    if (ret == 0) {
+      probe->id = g_strdup(snd_ctl_card_info_get_id(info));
+      probe->label = g_strdup(snd_ctl_card_info_get_name(info));
+    } else
+      g_warning("Failed to read card info: %s", snd_strerror(ret));
 
-  if (alsa_device_open(device) == FALSE) {
-    g_object_unref(device);
     snd_ctl_close(ctl);
-    return FALSE;
   }
 
-  ALSA_DEVICE_SET_ID(device, id);
-  add_device(alsa, device);
+  /* Only open the mixer of cards which are not known yet, the "default"
+   * device and the card it points to may both be opened here, the duplicate
+   * is dropped when the devices are added */
+  if (probe->id != NULL && batch->open_mixers == TRUE &&
+      g_hash_table_contains(batch->devices_ids, probe->id) == FALSE)
+    probe->handle = alsa_device_open_mixer(probe->card);
 
-  snd_ctl_close(ctl);
-  return TRUE;
+  g_mutex_lock(&batch->mutex);
+
+  if (--batch->pending == 0) g_cond_signal(&batch->cond);
+
+  g_mutex_unlock(&batch->mutex);
 }
 
 static void add_device(AlsaBackend *alsa, AlsaDevice *device) {
@@ -449,7 +728,51 @@ static void add_device(AlsaBackend *alsa, AlsaDevice *device) {
 
   /* Load the device elements after emitting device-added, because the load
    * function will most likely emit stream-added on the device and backend */
-  alsa_device_load(device);
+  if (alsa_device_is_open(device) == TRUE) alsa_device_load(device);
+}
+
+static void load_deferred_devices(AlsaBackend *alsa) {
+  GList *list;
+
+  list = alsa->priv->devices;
+  while (list != NULL) {
+    alsa_device_ensure_loaded(ALSA_DEVICE(list->data));
+
+    list = list->next;
+  }
+}
+
+static void remove_vanished_devices(AlsaBackend *alsa, GPtrArray *probes) {
+  GSList *vanished = NULL;
+  GList *list;
+  guint i;
+
+  /* A loaded device is closed by its poll thread when the card goes away,
+   * a device without an open mixer, either deferred or one which failed to
+   * load, has no poll thread and must be removed once its card is no longer
+   * enumerated */
+  for (list = alsa->priv->devices; list != NULL; list = list->next) {
+    AlsaDevice *device = ALSA_DEVICE(list->data);
+    const gchar *name;
+
+    if (alsa_device_is_open(device) == TRUE) continue;
+
+    name = mate_mixer_device_get_name(MATE_MIXER_DEVICE(device));
+
+    for (i = 0; i < probes->len; i++) {
+      AlsaCardProbe *probe = g_ptr_array_index(probes, i);
+
+      if (strcmp(name, probe->card) == 0) break;
+    }
+    if (i == probes->len) vanished = g_slist_prepend(vanished, device);
+  }
+
+  /* Removing a device emits signals, so do not walk the list meanwhile */
+  while (vanished != NULL) {
+    remove_device(alsa, ALSA_DEVICE(vanished->data));
+
+    vanished = g_slist_delete_link(vanished, vanished);
+  }
 }
 
 static void remove_device(AlsaBackend *alsa, AlsaDevice *device) {
@@ -514,7 +837,12 @@ static void select_default_input_stream(AlsaBackend *alsa) {
   list = alsa->priv->devices;
   while (list != NULL) {
     AlsaDevice *device = ALSA_DEVICE(list->data);
-    AlsaStream *stream = alsa_device_get_input_stream(device);
+    AlsaStream *stream;
+
+    /* Only load as many devices as needed to find the default stream */
+    alsa_device_ensure_loaded(device);
+
+    stream = alsa_device_get_input_stream(device);
 
     if (stream != NULL) {
       _mate_mixer_backend_set_default_input_stream(MATE_MIXER_BACKEND(alsa),
@@ -534,7 +862,12 @@ static void select_default_output_stream(AlsaBackend *alsa) {
   list = alsa->priv->devices;
   while (list != NULL) {
     AlsaDevice *device = ALSA_DEVICE(list->data);
-    AlsaStream *stream = alsa_device_get_output_stream(device);
+    AlsaStream *stream;
+
+    /* Only load as many devices as needed to find the default stream */
+    alsa_device_ensure_loaded(device);
+
+    stream = alsa_device_get_output_stream(device);
 
     if (stream != NULL) {
       _mate_mixer_backend_set_default_output_stream(MATE_MIXER_BACKEND(alsa),
@@ -556,6 +889,25 @@ static void free_stream_list(AlsaBackend *alsa) {
   alsa->priv->streams = NULL;
 }
 
+static AlsaCardProbe *card_probe_new(const gchar *card) {
+  AlsaCardProbe *probe;
+
+  probe = g_slice_new0(AlsaCardProbe);
+  probe->card = g_strdup(card);
+
+  return probe;
+}
+
+static void card_probe_free(AlsaCardProbe *probe) {
+  if (probe->handle != NULL) snd_mixer_close(probe->handle);
+
+  g_free(probe->card);
+  g_free(probe->id);
+  g_free(probe->label);
+
+  g_slice_free(AlsaCardProbe, probe);
+}
+
 static gint compare_devices(gconstpointer a, gconstpointer b) {
   MateMixerDevice *d1 = MATE_MIXER_DEVICE(a);
   MateMixerDevice *d2 = MATE_MIXER_DEVICE(b);
@@ -569,3 +921,21 @@ static gint compare_device_name(gconstpointer a, gconstpointer b) {
 
   return strcmp(mate_mixer_device_get_name(device), name);
 }
+
+#ifdef ALSA_BENCH_PROBE_DELAY
+static guint read_config_uint(const gchar *variable, guint value) {
+  const gchar *str;
+  gchar *end;
+  guint64 v;
+
+  str = g_getenv(variable);
+  if (str == NULL) return value;
+
+  v = g_ascii_strtoull(str, &end, 10);
+  if (end == str || *end != '\0' || v > G_MAXUINT) {
+    g_warning("Invalid value of %s: %s", variable, str);
+    return value;
+  }
+  return (guint)v;
+}
+#endif
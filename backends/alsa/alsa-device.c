@@ -50,6 +50,16 @@
   (ALSA_STREAM_CONTROL_GET_SCORE(                \
       alsa_stream_get_default_control(ALSA_STREAM(s))))
 
+/* Kinds of library objects a single ALSA element is modelled as */
+enum {
+  ELEMENT_INPUT_SWITCH = 1 << 0,
+  ELEMENT_OUTPUT_SWITCH = 1 << 1,
+  ELEMENT_INPUT_TOGGLE = 1 << 2,
+  ELEMENT_OUTPUT_TOGGLE = 1 << 3,
+  ELEMENT_INPUT_CONTROL = 1 << 4,
+  ELEMENT_OUTPUT_CONTROL = 1 << 5
+};
+
 struct _AlsaDevicePrivate {
   snd_mixer_t *handle;
   GMainContext *context;
@@ -59,6 +69,7 @@ struct _AlsaDevicePrivate {
   AlsaStream *output;
   GList *streams;
   gboolean events_pending;
+  gboolean load_deferred;
 };
 
 enum { CLOSED, N_SIGNALS };
@@ -96,6 +107,10 @@ static void load_element(AlsaDevice *device, snd_mixer_elem_t *el);
 
 static void load_elements_by_name(AlsaDevice *device, const gchar *name);
 
+static gboolean reload_elements_by_name(AlsaDevice *device,
+                                        snd_mixer_elem_t *el,
+                                        const gchar *name);
+
 static void remove_elements_by_name(AlsaDevice *device, const gchar *name);
 
 static void handle_poll(AlsaDevice *device);
@@ -123,6 +138,9 @@ static void get_output_control_info(snd_mixer_elem_t *el, gchar **name,
                                     MateMixerStreamControlRole *role,
                                     gint *score);
 
+static guint get_element_layout(snd_mixer_elem_t *el);
+static guint get_stream_element_layout(AlsaDevice *device, const gchar *name);
+
 static MateMixerDirection get_switch_direction(snd_mixer_elem_t *el);
 static void get_switch_info(snd_mixer_elem_t *el, gchar **name, gchar **label,
                             MateMixerStreamSwitchRole *role);
@@ -211,31 +229,25 @@ AlsaDevice *alsa_device_new(const gchar *name, const gchar *label) {
   return device;
 }
 
-gboolean alsa_device_open(AlsaDevice *device) {
+snd_mixer_t *alsa_device_open_mixer(const gchar *name) {
   snd_mixer_t *handle;
-  const gchar *name;
   gint ret;
 
-  g_return_val_if_fail(ALSA_IS_DEVICE(device), FALSE);
-  g_return_val_if_fail(device->priv->handle == NULL, FALSE);
-
-  name = mate_mixer_device_get_name(MATE_MIXER_DEVICE(device));
-
-  g_debug("Opening device %s (%s)", name,
-          mate_mixer_device_get_label(MATE_MIXER_DEVICE(device)));
+  g_return_val_if_fail(name != NULL, NULL);
 
-  /* Open the mixer for the current device */
+  /* This function does not touch any device instance, so it is safe to call
+   * it from a worker thread */
   ret = snd_mixer_open(&handle, 0);
   if (ret < 0) {
     g_warning("Failed to open mixer: %s", snd_strerror(ret));
-    return FALSE;
+    return NULL;
   }
   ret = snd_mixer_attach(handle, name);
   if (ret < 0) {
     g_warning("Failed to attach mixer to %s: %s", name, snd_strerror(ret));
 
     snd_mixer_close(handle);
-    return FALSE;
+    return NULL;
   }
   ret = snd_mixer_selem_register(handle, NULL, NULL);
   if (ret < 0) {
@@ -243,7 +255,7 @@ gboolean alsa_device_open(AlsaDevice *device) {
               snd_strerror(ret));
 
     snd_mixer_close(handle);
-    return FALSE;
+    return NULL;
   }
   ret = snd_mixer_load(handle);
   if (ret < 0) {
@@ -251,9 +263,41 @@ gboolean alsa_device_open(AlsaDevice *device) {
               snd_strerror(ret));
 
     snd_mixer_close(handle);
-    return FALSE;
+    return NULL;
   }
+  return handle;
+}
+
+gboolean alsa_device_open(AlsaDevice *device) {
+  snd_mixer_t *handle;
+  const gchar *name;
+
+  g_return_val_if_fail(ALSA_IS_DEVICE(device), FALSE);
+  g_return_val_if_fail(device->priv->handle == NULL, FALSE);
+
+  name = mate_mixer_device_get_name(MATE_MIXER_DEVICE(device));
+
+  g_debug("Opening device %s (%s)", name,
+          mate_mixer_device_get_label(MATE_MIXER_DEVICE(device)));
+
+  /* Open the mixer for the current device */
+  handle = alsa_device_open_mixer(name);
+  if (handle == NULL) return FALSE;
+
+  device->priv->handle = handle;
+  return TRUE;
+}
+
+gboolean alsa_device_open_with_mixer(AlsaDevice *device, snd_mixer_t *handle) {
+  g_return_val_if_fail(ALSA_IS_DEVICE(device), FALSE);
+  g_return_val_if_fail(handle != NULL, FALSE);
+  g_return_val_if_fail(device->priv->handle == NULL, FALSE);
+
+  g_debug("Opening device %s (%s)",
+          mate_mixer_device_get_name(MATE_MIXER_DEVICE(device)),
+          mate_mixer_device_get_label(MATE_MIXER_DEVICE(device)));
 
+  /* Takes ownership of a mixer opened with alsa_device_open_mixer() */
   device->priv->handle = handle;
   return TRUE;
 }
@@ -332,6 +376,62 @@ void alsa_device_load(AlsaDevice *device) {
     g_thread_unref(thread);
 }
 
+void alsa_device_defer_load(AlsaDevice *device) {
+  g_return_if_fail(ALSA_IS_DEVICE(device));
+  g_return_if_fail(device->priv->handle == NULL);
+
+  /* The mixer will be opened and loaded when the streams of the device are
+   * first needed, see alsa_device_ensure_loaded() */
+  device->priv->load_deferred = TRUE;
+}
+
+void alsa_device_ensure_loaded(AlsaDevice *device) {
+  g_return_if_fail(ALSA_IS_DEVICE(device));
+
+  if (device->priv->load_deferred == FALSE) return;
+
+  device->priv->load_deferred = FALSE;
+
+  /* The owner is likely walking its list of devices right now, so do not
+   * close the device on failure, it just stays without any streams in the
+   * same way as a sound card without usable mixer elements */
+  if (alsa_device_open(device) == TRUE) alsa_device_load(device);
+}
+
+gboolean alsa_device_is_load_deferred(AlsaDevice *device) {
+  g_return_val_if_fail(ALSA_IS_DEVICE(device), FALSE);
+
+  return device->priv->load_deferred;
+}
+
+void alsa_device_hold_writes(AlsaDevice *device) {
+  const GList *list;
+
+  g_return_if_fail(ALSA_IS_DEVICE(device));
+
+  list =
+      mate_mixer_stream_list_controls(MATE_MIXER_STREAM(device->priv->input));
+  g_list_foreach((GList *)list, (GFunc)alsa_stream_control_hold_writes, NULL);
+
+  list =
+      mate_mixer_stream_list_controls(MATE_MIXER_STREAM(device->priv->output));
+  g_list_foreach((GList *)list, (GFunc)alsa_stream_control_hold_writes, NULL);
+}
+
+void alsa_device_flush_writes(AlsaDevice *device) {
+  const GList *list;
+
+  g_return_if_fail(ALSA_IS_DEVICE(device));
+
+  list =
+      mate_mixer_stream_list_controls(MATE_MIXER_STREAM(device->priv->input));
+  g_list_foreach((GList *)list, (GFunc)alsa_stream_control_flush_writes, NULL);
+
+  list =
+      mate_mixer_stream_list_controls(MATE_MIXER_STREAM(device->priv->output));
+  g_list_foreach((GList *)list, (GFunc)alsa_stream_control_flush_writes, NULL);
+}
+
 AlsaStream *alsa_device_get_input_stream(AlsaDevice *device) {
   g_return_val_if_fail(ALSA_IS_DEVICE(device), NULL);
 
@@ -361,6 +461,9 @@ static const GList *alsa_device_list_streams(MateMixerDevice *mmd) {
 
   device = ALSA_DEVICE(mmd);
 
+  /* May emit stream-added, so do it before creating the list */
+  alsa_device_ensure_loaded(device);
+
   if (device->priv->streams == NULL) {
     AlsaStream *stream;
 
@@ -586,53 +689,18 @@ static void add_stream_output_toggle(AlsaDevice *device, snd_mixer_elem_t *el) {
 }
 
 static void load_element(AlsaDevice *device, snd_mixer_elem_t *el) {
-  gboolean cvolume = FALSE;
-  gboolean pvolume = FALSE;
-
-  if (snd_mixer_selem_is_enumerated(el) == 1) {
-    MateMixerDirection direction;
-    gboolean cenum = FALSE;
-    gboolean penum = FALSE;
-
-#if SND_LIB_VERSION >= ALSA_PACK_VERSION(1, 0, 10)
-    /* The enumeration may have a capture or a playback capability.
-     * If it has either both or none, try to guess the more appropriate
-     * direction. */
-    cenum = snd_mixer_selem_is_enum_capture(el);
-    penum = snd_mixer_selem_is_enum_playback(el);
-#endif
-    if (cenum ^ penum) {
-      if (cenum == TRUE)
-        direction = MATE_MIXER_DIRECTION_INPUT;
-      else
-        direction = MATE_MIXER_DIRECTION_OUTPUT;
-    } else
-      direction = get_switch_direction(el);
+  guint layout;
 
-    if (direction == MATE_MIXER_DIRECTION_INPUT)
-      add_stream_input_switch(device, el);
-    else
-      add_stream_output_switch(device, el);
-  }
+  layout = get_element_layout(el);
 
-  if (snd_mixer_selem_has_capture_volume(el) == 1 ||
-      snd_mixer_selem_has_common_volume(el) == 1)
-    cvolume = TRUE;
-  if (snd_mixer_selem_has_playback_volume(el) == 1 ||
-      snd_mixer_selem_has_common_volume(el) == 1)
-    pvolume = TRUE;
+  if (layout & ELEMENT_INPUT_SWITCH) add_stream_input_switch(device, el);
+  if (layout & ELEMENT_OUTPUT_SWITCH) add_stream_output_switch(device, el);
 
-  if (cvolume == FALSE && pvolume == FALSE) {
-    /* Control without volume and with a switch are modelled as toggles */
-    if (snd_mixer_selem_has_capture_switch(el) == 1)
-      add_stream_input_toggle(device, el);
+  if (layout & ELEMENT_INPUT_TOGGLE) add_stream_input_toggle(device, el);
+  if (layout & ELEMENT_OUTPUT_TOGGLE) add_stream_output_toggle(device, el);
 
-    if (snd_mixer_selem_has_playback_switch(el) == 1)
-      add_stream_output_toggle(device, el);
-  } else {
-    if (cvolume == TRUE) add_stream_input_control(device, el);
-    if (pvolume == TRUE) add_stream_output_control(device, el);
-  }
+  if (layout & ELEMENT_INPUT_CONTROL) add_stream_input_control(device, el);
+  if (layout & ELEMENT_OUTPUT_CONTROL) add_stream_output_control(device, el);
 }
 
 static void load_elements_by_name(AlsaDevice *device, const gchar *name) {
@@ -640,6 +708,23 @@ static void load_elements_by_name(AlsaDevice *device, const gchar *name) {
   alsa_stream_load_elements(device->priv->output, name);
 }
 
+static gboolean reload_elements_by_name(AlsaDevice *device,
+                                        snd_mixer_elem_t *el,
+                                        const gchar *name) {
+  /* The existing controls and switches can only be kept if the element is
+   * still modelled as the same kinds of objects in the same streams, the
+   * name, label and role are all derived from the element name */
+  if (get_element_layout(el) != get_stream_element_layout(device, name))
+    return FALSE;
+
+  if (alsa_stream_reload_elements(device->priv->input, name) == FALSE)
+    return FALSE;
+  if (alsa_stream_reload_elements(device->priv->output, name) == FALSE)
+    return FALSE;
+
+  return TRUE;
+}
+
 static void remove_elements_by_name(AlsaDevice *device, const gchar *name) {
   if (alsa_stream_remove_elements(device->priv->input, name) == TRUE) {
     /* Removing last stream element "removes" the stream */
@@ -767,13 +852,21 @@ static int handle_element_callback(snd_mixer_elem_t *el, guint mask) {
     validate_default_controls(device);
   } else {
     if (mask & SND_CTL_EVENT_MASK_INFO) {
-      remove_elements_by_name(device, name);
-      load_element(device, el);
-
-      /* Revalidate default controls assignment */
-      validate_default_controls(device);
-    }
-    if (mask & SND_CTL_EVENT_MASK_VALUE) load_elements_by_name(device, name);
+      /* Update the existing objects in place if possible, so that the
+       * owners only receive notifications about changed properties, and
+       * only fall back to replacing the objects when the element has
+       * changed too much */
+      if (reload_elements_by_name(device, el, name) == FALSE) {
+        g_debug("Replacing elements of %s after info change", name);
+
+        remove_elements_by_name(device, name);
+        load_element(device, el);
+
+        /* Revalidate default controls assignment */
+        validate_default_controls(device);
+      }
+    } else if (mask & SND_CTL_EVENT_MASK_VALUE)
+      load_elements_by_name(device, name);
   }
   g_free(name);
 
@@ -915,6 +1008,86 @@ static void get_output_control_info(snd_mixer_elem_t *el, gchar **name,
     *score = -1;
 }
 
+static guint get_element_layout(snd_mixer_elem_t *el) {
+  gboolean cvolume = FALSE;
+  gboolean pvolume = FALSE;
+  guint layout = 0;
+
+  if (snd_mixer_selem_is_enumerated(el) == 1) {
+    MateMixerDirection direction;
+    gboolean cenum = FALSE;
+    gboolean penum = FALSE;
+
+#if SND_LIB_VERSION >= ALSA_PACK_VERSION(1, 0, 10)
+    /* The enumeration may have a capture or a playback capability.
+     * If it has either both or none, try to guess the more appropriate
+     * direction. */
+    cenum = snd_mixer_selem_is_enum_capture(el);
+    penum = snd_mixer_selem_is_enum_playback(el);
+#endif
+    if (cenum ^ penum) {
+      if (cenum == TRUE)
+        direction = MATE_MIXER_DIRECTION_INPUT;
+      else
+        direction = MATE_MIXER_DIRECTION_OUTPUT;
+    } else
+      direction = get_switch_direction(el);
+
+    if (direction == MATE_MIXER_DIRECTION_INPUT)
+      layout |= ELEMENT_INPUT_SWITCH;
+    else
+      layout |= ELEMENT_OUTPUT_SWITCH;
+  }
+
+  if (snd_mixer_selem_has_capture_volume(el) == 1 ||
+      snd_mixer_selem_has_common_volume(el) == 1)
+    cvolume = TRUE;
+  if (snd_mixer_selem_has_playback_volume(el) == 1 ||
+      snd_mixer_selem_has_common_volume(el) == 1)
+    pvolume = TRUE;
+
+  if (cvolume == FALSE && pvolume == FALSE) {
+    /* Control without volume and with a switch are modelled as toggles */
+    if (snd_mixer_selem_has_capture_switch(el) == 1)
+      layout |= ELEMENT_INPUT_TOGGLE;
+
+    if (snd_mixer_selem_has_playback_switch(el) == 1)
+      layout |= ELEMENT_OUTPUT_TOGGLE;
+  } else {
+    if (cvolume == TRUE) layout |= ELEMENT_INPUT_CONTROL;
+    if (pvolume == TRUE) layout |= ELEMENT_OUTPUT_CONTROL;
+  }
+  return layout;
+}
+
+static guint get_stream_element_layout(AlsaDevice *device, const gchar *name) {
+  AlsaElement *element;
+  guint layout = 0;
+
+  element = alsa_stream_get_switch_element(device->priv->input, name);
+  if (element != NULL) {
+    if (ALSA_IS_TOGGLE(element))
+      layout |= ELEMENT_INPUT_TOGGLE;
+    else
+      layout |= ELEMENT_INPUT_SWITCH;
+  }
+
+  element = alsa_stream_get_switch_element(device->priv->output, name);
+  if (element != NULL) {
+    if (ALSA_IS_TOGGLE(element))
+      layout |= ELEMENT_OUTPUT_TOGGLE;
+    else
+      layout |= ELEMENT_OUTPUT_SWITCH;
+  }
+
+  if (alsa_stream_get_control_element(device->priv->input, name) != NULL)
+    layout |= ELEMENT_INPUT_CONTROL;
+  if (alsa_stream_get_control_element(device->priv->output, name) != NULL)
+    layout |= ELEMENT_OUTPUT_CONTROL;
+
+  return layout;
+}
+
 static MateMixerDirection get_switch_direction(snd_mixer_elem_t *el) {
   MateMixerDirection direction;
   gchar *name;
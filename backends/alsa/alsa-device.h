@@ -18,6 +18,7 @@
 #ifndef ALSA_DEVICE_H
 #define ALSA_DEVICE_H
 
+#include <alsa/asoundlib.h>
 #include <glib-object.h>
 #include <glib.h>
 #include <libmatemixer/matemixer.h>
@@ -57,12 +58,22 @@ GType alsa_device_get_type(void) G_GNUC_CONST;
 
 AlsaDevice *alsa_device_new(const gchar *name, const gchar *label);
 
+snd_mixer_t *alsa_device_open_mixer(const gchar *name);
+
 gboolean alsa_device_open(AlsaDevice *device);
+gboolean alsa_device_open_with_mixer(AlsaDevice *device, snd_mixer_t *handle);
 gboolean alsa_device_is_open(AlsaDevice *device);
 void alsa_device_close(AlsaDevice *device);
 
 void alsa_device_load(AlsaDevice *device);
 
+void alsa_device_defer_load(AlsaDevice *device);
+void alsa_device_ensure_loaded(AlsaDevice *device);
+gboolean alsa_device_is_load_deferred(AlsaDevice *device);
+
+void alsa_device_hold_writes(AlsaDevice *device);
+void alsa_device_flush_writes(AlsaDevice *device);
+
 AlsaStream *alsa_device_get_input_stream(AlsaDevice *device);
 AlsaStream *alsa_device_get_output_stream(AlsaDevice *device);
 
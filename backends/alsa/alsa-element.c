@@ -43,6 +43,19 @@ gboolean alsa_element_load(AlsaElement *element) {
   return ALSA_ELEMENT_GET_INTERFACE(element)->load(element);
 }
 
+gboolean alsa_element_reload(AlsaElement *element) {
+  AlsaElementInterface *iface;
+
+  g_return_val_if_fail(ALSA_IS_ELEMENT(element), FALSE);
+
+  /* Reloading is used when the element info has changed, elements which do
+   * not cache anything derived from the info can simply be loaded again */
+  iface = ALSA_ELEMENT_GET_INTERFACE(element);
+  if (iface->reload != NULL) return iface->reload(element);
+
+  return iface->load(element);
+}
+
 void alsa_element_close(AlsaElement *element) {
   AlsaElementInterface *iface;
 
@@ -43,6 +43,7 @@ struct _AlsaElementInterface {
   void (*set_snd_element)(AlsaElement *element, snd_mixer_elem_t *el);
 
   gboolean (*load)(AlsaElement *element);
+  gboolean (*reload)(AlsaElement *element);
   void (*close)(AlsaElement *element);
 };
 
@@ -52,6 +53,7 @@ snd_mixer_elem_t *alsa_element_get_snd_element(AlsaElement *element);
 void alsa_element_set_snd_element(AlsaElement *element, snd_mixer_elem_t *el);
 
 gboolean alsa_element_load(AlsaElement *element);
+gboolean alsa_element_reload(AlsaElement *element);
 
 void alsa_element_close(AlsaElement *element);
 
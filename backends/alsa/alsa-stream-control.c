@@ -22,6 +22,7 @@
 #include <glib.h>
 #include <libmatemixer/matemixer-private.h>
 #include <libmatemixer/matemixer.h>
+#include <string.h>
 
 #include "alsa-constants.h"
 #include "alsa-element.h"
@@ -30,8 +31,13 @@ struct _AlsaStreamControlPrivate {
   AlsaControlData data;
   guint32 channel_mask;
   snd_mixer_elem_t *element;
+  gboolean hold_writes;
+  guint pending;
 };
 
+/* Values changed while the writes are held */
+enum { PENDING_MUTE = 1 << 0, PENDING_VOLUME = 1 << 1 };
+
 static void alsa_element_interface_init(AlsaElementInterface *iface);
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE(
@@ -76,9 +82,11 @@ static gdouble alsa_stream_control_get_channel_decibel(
 static gboolean alsa_stream_control_set_channel_decibel(
     MateMixerStreamControl *mmsc, guint channel, gdouble decibel);
 
+static gfloat alsa_stream_control_get_balance(MateMixerStreamControl *mmsc);
 static gboolean alsa_stream_control_set_balance(MateMixerStreamControl *mmsc,
                                                 gfloat balance);
 
+static gfloat alsa_stream_control_get_fade(MateMixerStreamControl *mmsc);
 static gboolean alsa_stream_control_set_fade(MateMixerStreamControl *mmsc,
                                              gfloat fade);
 
@@ -96,6 +104,12 @@ static void control_data_get_average_front_back(AlsaControlData *data,
 static gfloat control_data_get_balance(AlsaControlData *data);
 static gfloat control_data_get_fade(AlsaControlData *data);
 
+static gboolean write_mute(AlsaStreamControl *control, gboolean mute);
+static gboolean write_volume(AlsaStreamControl *control, guint volume);
+static gboolean write_channel_volume(AlsaStreamControl *control,
+                                     snd_mixer_selem_channel_id_t channel,
+                                     guint volume);
+
 static void alsa_element_interface_init(AlsaElementInterface *iface) {
   iface->get_snd_element = alsa_stream_control_get_snd_element;
   iface->set_snd_element = alsa_stream_control_set_snd_element;
@@ -121,7 +135,9 @@ static void alsa_stream_control_class_init(AlsaStreamControlClass *klass) {
   control_class->set_channel_volume = alsa_stream_control_set_channel_volume;
   control_class->get_channel_decibel = alsa_stream_control_get_channel_decibel;
   control_class->set_channel_decibel = alsa_stream_control_set_channel_decibel;
+  control_class->get_balance = alsa_stream_control_get_balance;
   control_class->set_balance = alsa_stream_control_set_balance;
+  control_class->get_fade = alsa_stream_control_get_fade;
   control_class->set_fade = alsa_stream_control_set_fade;
   control_class->get_min_volume = alsa_stream_control_get_min_volume;
   control_class->get_max_volume = alsa_stream_control_get_max_volume;
@@ -143,15 +159,28 @@ void alsa_stream_control_set_data(AlsaStreamControl *control,
                                   AlsaControlData *data) {
   MateMixerStreamControlFlags flags = MATE_MIXER_STREAM_CONTROL_NO_FLAGS;
   MateMixerStreamControl *mmsc;
+  AlsaControlData old_data;
   gboolean mute = FALSE;
+  gboolean invalidate = FALSE;
 
   g_return_if_fail(ALSA_IS_STREAM_CONTROL(control));
   g_return_if_fail(data != NULL);
 
   mmsc = MATE_MIXER_STREAM_CONTROL(control);
 
+  old_data = control->priv->data;
   control->priv->data = *data;
 
+  /* Re-reading the element must not revert the values which have not been
+   * written yet */
+  if (control->priv->pending & PENDING_MUTE)
+    memcpy(control->priv->data.m, old_data.m, sizeof(old_data.m));
+  if (control->priv->pending & PENDING_VOLUME) {
+    memcpy(control->priv->data.v, old_data.v, sizeof(old_data.v));
+    control->priv->data.volume = old_data.volume;
+  }
+  data = &control->priv->data;
+
   g_object_freeze_notify(G_OBJECT(control));
 
   if (data->channels > 0) {
@@ -197,23 +226,95 @@ void alsa_stream_control_set_data(AlsaStreamControl *control,
         flags |= MATE_MIXER_STREAM_CONTROL_CAN_FADE;
     }
 
-    g_object_notify(G_OBJECT(control), "volume");
+    /* The data is re-read on each element event, only notify about the
+     * volume when it has really changed */
+    if (data->channels != old_data.channels ||
+        data->volume != old_data.volume || data->min != old_data.min ||
+        data->max != old_data.max ||
+        memcmp(data->v, old_data.v, sizeof(data->v)) != 0) {
+      g_object_notify(G_OBJECT(control), "volume");
+      invalidate = TRUE;
+    }
+
+    /* Balance and fade also depend on the channel map and on whether the
+     * channels can be set separately */
+    if (data->volume_joined != old_data.volume_joined ||
+        memcmp(data->c, old_data.c, sizeof(data->c)) != 0)
+      invalidate = TRUE;
   } else {
     control->priv->channel_mask = 0;
+
+    if (old_data.channels > 0) invalidate = TRUE;
   }
 
+  if ((flags ^ mate_mixer_stream_control_get_flags(mmsc)) &
+      (MATE_MIXER_STREAM_CONTROL_CAN_BALANCE |
+       MATE_MIXER_STREAM_CONTROL_CAN_FADE))
+    invalidate = TRUE;
+
   _mate_mixer_stream_control_set_mute(mmsc, mute);
   _mate_mixer_stream_control_set_flags(mmsc, flags);
 
-  if (flags & MATE_MIXER_STREAM_CONTROL_CAN_BALANCE)
-    _mate_mixer_stream_control_set_balance(mmsc,
-                                           control_data_get_balance(data));
-  if (flags & MATE_MIXER_STREAM_CONTROL_CAN_FADE)
-    _mate_mixer_stream_control_set_fade(mmsc, control_data_get_fade(data));
+  /* Balance and fade are only computed when read or watched, the flags
+   * must be up to date at that point */
+  if (invalidate == TRUE)
+    _mate_mixer_stream_control_invalidate_balance_fade(mmsc);
 
   g_object_thaw_notify(G_OBJECT(control));
 }
 
+void alsa_stream_control_hold_writes(AlsaStreamControl *control) {
+  g_return_if_fail(ALSA_IS_STREAM_CONTROL(control));
+
+  /* The changes are only remembered until alsa_stream_control_flush_writes()
+   * writes each of the changed values to the element once */
+  control->priv->hold_writes = TRUE;
+}
+
+void alsa_stream_control_flush_writes(AlsaStreamControl *control) {
+  AlsaStreamControlClass *klass;
+  AlsaControlData *data;
+  gboolean ret = TRUE;
+  guint pending;
+  guint i;
+
+  g_return_if_fail(ALSA_IS_STREAM_CONTROL(control));
+
+  control->priv->hold_writes = FALSE;
+
+  pending = control->priv->pending;
+  control->priv->pending = 0;
+  if (pending == 0) return;
+
+  klass = ALSA_STREAM_CONTROL_GET_CLASS(control);
+  data = &control->priv->data;
+
+  /* The mute is always written to all channels at once */
+  if (pending & PENDING_MUTE) ret = klass->set_mute(control, data->m[0]);
+
+  if (pending & PENDING_VOLUME) {
+    for (i = 1; i < data->channels; i++)
+      if (data->v[i] != data->v[0]) break;
+
+    /* Only write the channels one by one if their volumes differ */
+    if (data->volume_joined == TRUE || i >= data->channels) {
+      if (klass->set_volume(control, data->v[0]) == FALSE) ret = FALSE;
+    } else {
+      for (i = 0; i < data->channels; i++) {
+        snd_mixer_selem_channel_id_t c = alsa_channel_map_to[data->c[i]];
+
+        if (c == SND_MIXER_SCHN_UNKNOWN) continue;
+
+        if (klass->set_channel_volume(control, c, data->v[i]) == FALSE)
+          ret = FALSE;
+      }
+    }
+  }
+
+  /* Get rid of the values which could not be written */
+  if (ret == FALSE) alsa_element_load(ALSA_ELEMENT(control));
+}
+
 static snd_mixer_elem_t *alsa_stream_control_get_snd_element(
     AlsaElement *element) {
   g_return_val_if_fail(ALSA_IS_STREAM_CONTROL(element), NULL);
@@ -262,10 +363,7 @@ static gboolean alsa_stream_control_set_mute(MateMixerStreamControl *mmsc,
   }
 
   if (change == TRUE) {
-    AlsaStreamControlClass *klass;
-
-    klass = ALSA_STREAM_CONTROL_GET_CLASS(control);
-    if (klass->set_mute(control, mute) == FALSE) return FALSE;
+    if (write_mute(control, mute) == FALSE) return FALSE;
 
     for (i = 0; i < control->priv->data.channels; i++)
       control->priv->data.m[i] = mute;
@@ -311,10 +409,7 @@ static gboolean alsa_stream_control_set_volume(MateMixerStreamControl *mmsc,
   }
 
   if (change == TRUE) {
-    AlsaStreamControlClass *klass;
-
-    klass = ALSA_STREAM_CONTROL_GET_CLASS(control);
-    if (klass->set_volume(control, volume) == FALSE) return FALSE;
+    if (write_volume(control, volume) == FALSE) return FALSE;
 
     for (i = 0; i < control->priv->data.channels; i++)
       control->priv->data.v[i] = volume;
@@ -421,8 +516,6 @@ static gboolean alsa_stream_control_set_channel_volume(
   volume = CLAMP(volume, control->priv->data.min, control->priv->data.max);
 
   if (volume != control->priv->data.v[channel]) {
-    AlsaStreamControlClass *klass;
-
     /* Convert channel index to ALSA channel position and make sure it is valid
      */
     snd_mixer_selem_channel_id_t c =
@@ -432,8 +525,7 @@ static gboolean alsa_stream_control_set_channel_volume(
       return FALSE;
     }
 
-    klass = ALSA_STREAM_CONTROL_GET_CLASS(control);
-    if (klass->set_channel_volume(control, c, volume) == FALSE) return FALSE;
+    if (write_channel_volume(control, c, volume) == FALSE) return FALSE;
 
     control->priv->data.v[channel] = volume;
 
@@ -484,9 +576,14 @@ static gboolean alsa_stream_control_set_channel_decibel(
   return alsa_stream_control_set_channel_volume(mmsc, channel, volume);
 }
 
+static gfloat alsa_stream_control_get_balance(MateMixerStreamControl *mmsc) {
+  g_return_val_if_fail(ALSA_IS_STREAM_CONTROL(mmsc), 0.0f);
+
+  return control_data_get_balance(&ALSA_STREAM_CONTROL(mmsc)->priv->data);
+}
+
 static gboolean alsa_stream_control_set_balance(MateMixerStreamControl *mmsc,
                                                 gfloat balance) {
-  AlsaStreamControlClass *klass;
   AlsaStreamControl *control;
   AlsaControlData *data;
   guint left, right;
@@ -497,7 +594,6 @@ static gboolean alsa_stream_control_set_balance(MateMixerStreamControl *mmsc,
   g_return_val_if_fail(ALSA_IS_STREAM_CONTROL(mmsc), FALSE);
 
   control = ALSA_STREAM_CONTROL(mmsc);
-  klass = ALSA_STREAM_CONTROL_GET_CLASS(control);
 
   data = &control->priv->data;
   control_data_get_average_left_right(data, &left, &right);
@@ -533,17 +629,22 @@ static gboolean alsa_stream_control_set_balance(MateMixerStreamControl *mmsc,
               data->min, data->max);
       }
 
-      if (klass->set_channel_volume(
-              control, alsa_channel_map_to[data->c[channel]], volume) == TRUE)
+      if (write_channel_volume(control, alsa_channel_map_to[data->c[channel]],
+                               volume) == TRUE)
         data->v[channel] = volume;
     }
   }
   return TRUE;
 }
 
+static gfloat alsa_stream_control_get_fade(MateMixerStreamControl *mmsc) {
+  g_return_val_if_fail(ALSA_IS_STREAM_CONTROL(mmsc), 0.0f);
+
+  return control_data_get_fade(&ALSA_STREAM_CONTROL(mmsc)->priv->data);
+}
+
 static gboolean alsa_stream_control_set_fade(MateMixerStreamControl *mmsc,
                                              gfloat fade) {
-  AlsaStreamControlClass *klass;
   AlsaStreamControl *control;
   AlsaControlData *data;
   guint front, back;
@@ -554,7 +655,6 @@ static gboolean alsa_stream_control_set_fade(MateMixerStreamControl *mmsc,
   g_return_val_if_fail(ALSA_IS_STREAM_CONTROL(mmsc), FALSE);
 
   control = ALSA_STREAM_CONTROL(mmsc);
-  klass = ALSA_STREAM_CONTROL_GET_CLASS(control);
 
   data = &control->priv->data;
   control_data_get_average_front_back(data, &front, &back);
@@ -590,8 +690,8 @@ static gboolean alsa_stream_control_set_fade(MateMixerStreamControl *mmsc,
               data->min, data->max);
       }
 
-      if (klass->set_channel_volume(
-              control, alsa_channel_map_to[data->c[channel]], volume) == TRUE)
+      if (write_channel_volume(control, alsa_channel_map_to[data->c[channel]],
+                               volume) == TRUE)
         data->v[channel] = volume;
     }
   }
@@ -686,3 +786,30 @@ static gfloat control_data_get_fade(AlsaControlData *data) {
   else
     return +1.0f - ((gfloat)front / (gfloat)back);
 }
+
+static gboolean write_mute(AlsaStreamControl *control, gboolean mute) {
+  if (control->priv->hold_writes == TRUE) {
+    control->priv->pending |= PENDING_MUTE;
+    return TRUE;
+  }
+  return ALSA_STREAM_CONTROL_GET_CLASS(control)->set_mute(control, mute);
+}
+
+static gboolean write_volume(AlsaStreamControl *control, guint volume) {
+  if (control->priv->hold_writes == TRUE) {
+    control->priv->pending |= PENDING_VOLUME;
+    return TRUE;
+  }
+  return ALSA_STREAM_CONTROL_GET_CLASS(control)->set_volume(control, volume);
+}
+
+static gboolean write_channel_volume(AlsaStreamControl *control,
+                                     snd_mixer_selem_channel_id_t channel,
+                                     guint volume) {
+  if (control->priv->hold_writes == TRUE) {
+    control->priv->pending |= PENDING_VOLUME;
+    return TRUE;
+  }
+  return ALSA_STREAM_CONTROL_GET_CLASS(control)->set_channel_volume(
+      control, channel, volume);
+}
@@ -95,6 +95,9 @@ AlsaControlData *alsa_stream_control_get_data(AlsaStreamControl *control);
 void alsa_stream_control_set_data(AlsaStreamControl *control,
                                   AlsaControlData *data);
 
+void alsa_stream_control_hold_writes(AlsaStreamControl *control);
+void alsa_stream_control_flush_writes(AlsaStreamControl *control);
+
 G_END_DECLS
 
 #endif /* ALSA_STREAM_CONTROL_H */
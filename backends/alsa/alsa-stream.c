@@ -192,6 +192,32 @@ void alsa_stream_set_default_control(AlsaStream *stream,
                                            MATE_MIXER_STREAM_CONTROL(control));
 }
 
+AlsaElement *alsa_stream_get_control_element(AlsaStream *stream,
+                                             const gchar *name) {
+  GList *item;
+
+  g_return_val_if_fail(ALSA_IS_STREAM(stream), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  item = g_list_find_custom(stream->priv->controls, name, compare_control_name);
+  if (item != NULL) return ALSA_ELEMENT(item->data);
+
+  return NULL;
+}
+
+AlsaElement *alsa_stream_get_switch_element(AlsaStream *stream,
+                                            const gchar *name) {
+  GList *item;
+
+  g_return_val_if_fail(ALSA_IS_STREAM(stream), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  item = g_list_find_custom(stream->priv->switches, name, compare_switch_name);
+  if (item != NULL) return ALSA_ELEMENT(item->data);
+
+  return NULL;
+}
+
 void alsa_stream_load_elements(AlsaStream *stream, const gchar *name) {
   GList *item;
 
@@ -205,6 +231,23 @@ void alsa_stream_load_elements(AlsaStream *stream, const gchar *name) {
   if (item != NULL) alsa_element_load(ALSA_ELEMENT(item->data));
 }
 
+gboolean alsa_stream_reload_elements(AlsaStream *stream, const gchar *name) {
+  GList *item;
+
+  g_return_val_if_fail(ALSA_IS_STREAM(stream), FALSE);
+  g_return_val_if_fail(name != NULL, FALSE);
+
+  item = g_list_find_custom(stream->priv->controls, name, compare_control_name);
+  if (item != NULL && alsa_element_reload(ALSA_ELEMENT(item->data)) == FALSE)
+    return FALSE;
+
+  item = g_list_find_custom(stream->priv->switches, name, compare_switch_name);
+  if (item != NULL && alsa_element_reload(ALSA_ELEMENT(item->data)) == FALSE)
+    return FALSE;
+
+  return TRUE;
+}
+
 gboolean alsa_stream_remove_elements(AlsaStream *stream, const gchar *name) {
   GList *item;
   gboolean removed = FALSE;
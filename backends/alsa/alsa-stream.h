@@ -68,8 +68,15 @@ AlsaStreamControl *alsa_stream_get_default_control(AlsaStream *stream);
 void alsa_stream_set_default_control(AlsaStream *stream,
                                      AlsaStreamControl *control);
 
+AlsaElement *alsa_stream_get_control_element(AlsaStream *stream,
+                                             const gchar *name);
+AlsaElement *alsa_stream_get_switch_element(AlsaStream *stream,
+                                            const gchar *name);
+
 void alsa_stream_load_elements(AlsaStream *stream, const gchar *name);
 
+gboolean alsa_stream_reload_elements(AlsaStream *stream, const gchar *name);
+
 gboolean alsa_stream_remove_elements(AlsaStream *stream, const gchar *name);
 
 void alsa_stream_remove_all(AlsaStream *stream);
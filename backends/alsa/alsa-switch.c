@@ -22,6 +22,7 @@
 #include <glib.h>
 #include <libmatemixer/matemixer-private.h>
 #include <libmatemixer/matemixer.h>
+#include <string.h>
 
 #include "alsa-element.h"
 #include "alsa-stream.h"
@@ -51,11 +52,13 @@ static snd_mixer_elem_t *alsa_switch_get_snd_element(AlsaElement *element);
 static void alsa_switch_set_snd_element(AlsaElement *element,
                                         snd_mixer_elem_t *el);
 static gboolean alsa_switch_load(AlsaElement *element);
+static gboolean alsa_switch_reload(AlsaElement *element);
 
 static void alsa_element_interface_init(AlsaElementInterface *iface) {
   iface->get_snd_element = alsa_switch_get_snd_element;
   iface->set_snd_element = alsa_switch_set_snd_element;
   iface->load = alsa_switch_load;
+  iface->reload = alsa_switch_reload;
 }
 
 static void alsa_switch_class_init(AlsaSwitchClass *klass) {
@@ -227,3 +230,44 @@ static gboolean alsa_switch_load(AlsaElement *element) {
 
   return FALSE;
 }
+
+static gboolean alsa_switch_reload(AlsaElement *element) {
+  AlsaSwitch *swtch;
+  GList *list;
+  gchar item[128];
+  gint count;
+
+  g_return_val_if_fail(ALSA_IS_SWITCH(element), FALSE);
+
+  swtch = ALSA_SWITCH(element);
+
+  if (G_UNLIKELY(swtch->priv->element == NULL)) return FALSE;
+
+  /* The list of options is only created once, make sure the element still
+   * provides the same enum items, otherwise the switch must be replaced */
+  count = snd_mixer_selem_get_enum_items(swtch->priv->element);
+  if (count < 0 || (guint)count != g_list_length(swtch->priv->options))
+    return FALSE;
+
+  list = swtch->priv->options;
+  while (list != NULL) {
+    AlsaSwitchOption *option = ALSA_SWITCH_OPTION(list->data);
+    const gchar *name;
+    gint ret;
+
+    ret = snd_mixer_selem_get_enum_item_name(swtch->priv->element,
+                                             alsa_switch_option_get_id(option),
+                                             sizeof(item), item);
+    if (ret < 0) return FALSE;
+
+    name = mate_mixer_switch_option_get_name(MATE_MIXER_SWITCH_OPTION(option));
+    if (strcmp(item, name) != 0) return FALSE;
+
+    list = list->next;
+  }
+
+  /* The set of usable channels might have changed, read it again */
+  swtch->priv->channel_mask = 0;
+
+  return alsa_switch_load(element);
+}
@@ -47,11 +47,13 @@ static snd_mixer_elem_t *alsa_toggle_get_snd_element(AlsaElement *element);
 static void alsa_toggle_set_snd_element(AlsaElement *element,
                                         snd_mixer_elem_t *el);
 static gboolean alsa_toggle_load(AlsaElement *element);
+static gboolean alsa_toggle_reload(AlsaElement *element);
 
 static void alsa_element_interface_init(AlsaElementInterface *iface) {
   iface->get_snd_element = alsa_toggle_get_snd_element;
   iface->set_snd_element = alsa_toggle_set_snd_element;
   iface->load = alsa_toggle_load;
+  iface->reload = alsa_toggle_reload;
 }
 
 static void alsa_toggle_class_init(AlsaToggleClass *klass) {
@@ -201,3 +203,12 @@ static gboolean alsa_toggle_load(AlsaElement *element) {
 
   return FALSE;
 }
+
+static gboolean alsa_toggle_reload(AlsaElement *element) {
+  g_return_val_if_fail(ALSA_IS_TOGGLE(element), FALSE);
+
+  /* The set of usable channels might have changed, read it again */
+  ALSA_TOGGLE(element)->priv->channel_mask = 0;
+
+  return alsa_toggle_load(element);
+}
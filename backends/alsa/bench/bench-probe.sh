@@ -0,0 +1,28 @@
+#!/bin/sh
+# Measure how long opening the ALSA backend takes when the sound cards are
+# slow to probe, once with the cards probed one after another and once in
+# parallel.
+#
+# The benchmark build of the backend delays every card probe by 200
+# milliseconds, which stands in for a slow USB or Bluetooth card. With the cards
+# probed in parallel the open time should be bounded by the slowest card rather
+# than the sum of all of them. At least one sound card is needed, the "default"
+# device is probed as well.
+
+test -z "$MATEMIXER_BENCH" && MATEMIXER_BENCH=./alsa-bench
+
+# Usage: run_bench THREADS
+run_bench() {
+    report=`env MATE_MIXER_ALSA_PROBE_THREADS=$1 \
+        $MATEMIXER_BENCH --backend=alsa --format=csv \
+        --duration=0 --iterations=0` || exit 1
+
+    open=`echo "$report" | grep '^startup,open,' | cut -d, -f3`
+    devices=`echo "$report" | grep '^objects,AlsaDevice.count,' | \
+        cut -d, -f3 | cut -d. -f1`
+
+    echo "threads=$1 devices=${devices:-0} open=$open ms"
+}
+
+run_bench 0
+run_bench 8
@@ -0,0 +1,70 @@
+#!/bin/sh
+# Run the synthetic null backend scenarios through matemixer-bench and compare
+# the deterministic part of the reports with the expected output.
+#
+# Timings and event rates depend on the machine, so only the object counts and
+# the number of lost latency samples are compared.
+
+test -z "$srcdir" && srcdir=`dirname $0`
+test -z "$srcdir" && srcdir=.
+
+test -z "$MATEMIXER_BENCH" && MATEMIXER_BENCH=./null-bench
+
+failed=0
+
+# Usage: run_scenario NAME BENCH-OPTIONS [VARIABLE=VALUE...]
+run_scenario() {
+    name=$1
+    options=$2
+    shift 2
+
+    expected=$srcdir/scenarios/$name.expected
+    output=scenario-$name.out
+
+    env MATE_MIXER_NULL_SEED=1 "$@" \
+        $MATEMIXER_BENCH --backend=null --format=csv $options > $output.tmp || {
+        echo "FAIL: $name: matemixer-bench exited with an error"
+        rm -f $output.tmp
+        failed=1
+        return
+    }
+
+    grep -E '^(objects,[^,]*\.count|latency,lost),' $output.tmp > $output
+    rm -f $output.tmp
+
+    if diff -u $expected $output; then
+        echo "PASS: $name"
+        rm -f $output
+    else
+        echo "FAIL: $name"
+        failed=1
+    fi
+}
+
+run_scenario basic "--duration=0 --iterations=10" \
+    MATE_MIXER_NULL_DEVICES=2 \
+    MATE_MIXER_NULL_STREAMS=2 \
+    MATE_MIXER_NULL_CONTROLS=3
+
+run_scenario latency "--duration=0 --iterations=5" \
+    MATE_MIXER_NULL_DEVICES=1 \
+    MATE_MIXER_NULL_STREAMS=2 \
+    MATE_MIXER_NULL_CONTROLS=2 \
+    MATE_MIXER_NULL_LATENCY=20
+
+run_scenario burst "--duration=1 --iterations=0" \
+    MATE_MIXER_NULL_DEVICES=4 \
+    MATE_MIXER_NULL_STREAMS=4 \
+    MATE_MIXER_NULL_CONTROLS=8 \
+    MATE_MIXER_NULL_RATE=1000 \
+    MATE_MIXER_NULL_PATTERN=burst
+
+run_scenario churn "--duration=1 --iterations=0" \
+    MATE_MIXER_NULL_DEVICES=2 \
+    MATE_MIXER_NULL_STREAMS=2 \
+    MATE_MIXER_NULL_CONTROLS=4 \
+    MATE_MIXER_NULL_RATE=100 \
+    MATE_MIXER_NULL_PATTERN=churn \
+    MATE_MIXER_NULL_LIFETIME=200
+
+exit $failed
@@ -22,13 +22,129 @@
 #include <libmatemixer/matemixer-private.h>
 #include <libmatemixer/matemixer.h>
 
+#include "null-device.h"
+#include "null-stream-control.h"
+#include "null-stream.h"
+
 #define BACKEND_NAME "Null"
 #define BACKEND_PRIORITY 0
 #define BACKEND_FLAGS MATE_MIXER_BACKEND_NO_FLAGS
 
-G_DEFINE_DYNAMIC_TYPE(NullBackend, null_backend, MATE_MIXER_TYPE_BACKEND)
+/* Without any configuration the backend exposes nothing, but it can also act
+ * as a synthetic load generator for benchmarking the library and its users.
+ * The environment variables below are read each time the backend is opened:
+ *
+ * MATE_MIXER_NULL_DEVICES   number of devices
+ * MATE_MIXER_NULL_STREAMS   number of streams per device, alternating
+ *                           between output and input
+ * MATE_MIXER_NULL_CONTROLS  number of controls per stream
+ * MATE_MIXER_NULL_CHANNELS  channels per control (1-8), by default a mix of
+ *                           common channel maps is used
+ * MATE_MIXER_NULL_RATE      number of events generated per second
+ * MATE_MIXER_NULL_PATTERN   "steady" spreads volume changes evenly over the
+ *                           second, "burst" generates all of them at once and
+ *                           "churn" adds short-lived controls instead
+ * MATE_MIXER_NULL_LIFETIME  lifetime of churned controls in milliseconds
+ * MATE_MIXER_NULL_LATENCY   simulated server latency in milliseconds, the
+ *                           backend stays connecting for this long and
+ *                           volume changes made by users are applied after
+ *                           the same delay, as they would be by a server
+ * MATE_MIXER_NULL_SEED      seed of the random generator, so that runs can be
+ *                           reproduced */
+#define NULL_ENV_DEVICES "MATE_MIXER_NULL_DEVICES"
+#define NULL_ENV_STREAMS "MATE_MIXER_NULL_STREAMS"
+#define NULL_ENV_CONTROLS "MATE_MIXER_NULL_CONTROLS"
+#define NULL_ENV_CHANNELS "MATE_MIXER_NULL_CHANNELS"
+#define NULL_ENV_RATE "MATE_MIXER_NULL_RATE"
+#define NULL_ENV_PATTERN "MATE_MIXER_NULL_PATTERN"
+#define NULL_ENV_LIFETIME "MATE_MIXER_NULL_LIFETIME"
+#define NULL_ENV_LATENCY "MATE_MIXER_NULL_LATENCY"
+#define NULL_ENV_SEED "MATE_MIXER_NULL_SEED"
+
+#define NULL_DEFAULT_LIFETIME 500
+#define NULL_DEFAULT_SEED 1
+
+/* Events are never generated more often than once per millisecond, higher
+ * rates are reached by generating several events in each wakeup */
+#define NULL_MAX_WAKEUPS 1000
+
+typedef enum {
+  NULL_PATTERN_STEADY,
+  NULL_PATTERN_BURST,
+  NULL_PATTERN_CHURN
+} NullPattern;
+
+typedef struct {
+  NullStreamControl *control;
+  gint64 expires;
+} NullChurnControl;
+
+struct _NullBackendPrivate {
+  GList *devices;
+  GList *streams;
+  GPtrArray *stream_table;
+  GPtrArray *controls;
+  GQueue churn;
+  GSource *connect_source;
+  GSource *event_source;
+  GRand *rand;
+  guint serial;
+
+  struct {
+    guint devices;
+    guint streams;
+    guint controls;
+    guint channels;
+    guint rate;
+    guint lifetime;
+    guint latency;
+    guint32 seed;
+    NullPattern pattern;
+  } config;
+};
+
+/* Channel counts used in turn when no count is configured, most controls are
+ * stereo with an occasional mono or surround one */
+static const guint null_channels_mix[] = {2, 2, 1, 2, 6, 2, 8};
+
+static void null_backend_class_init(NullBackendClass *klass);
+static void null_backend_class_finalize(NullBackendClass *klass);
+static void null_backend_init(NullBackend *null);
+static void null_backend_dispose(GObject *object);
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-function"
+G_DEFINE_DYNAMIC_TYPE_EXTENDED(NullBackend, null_backend,
+                               MATE_MIXER_TYPE_BACKEND, 0,
+                               G_ADD_PRIVATE_DYNAMIC(NullBackend))
+#pragma clang diagnostic pop
 
 static gboolean null_backend_open(MateMixerBackend *backend);
+static void null_backend_close(MateMixerBackend *backend);
+static const GList *null_backend_list_devices(MateMixerBackend *backend);
+static const GList *null_backend_list_streams(MateMixerBackend *backend);
+
+static gboolean load_objects(NullBackend *null);
+
+static void read_config(NullBackend *null);
+static guint read_config_uint(const gchar *variable, guint value);
+
+static void create_devices(NullBackend *null);
+static NullStreamControl *create_control(NullBackend *null, NullStream *stream,
+                                         const gchar *name,
+                                         MateMixerStreamControlRole role);
+
+static void start_events(NullBackend *null);
+static gboolean generate_events(NullBackend *null);
+
+static void change_volume(NullBackend *null);
+static void churn_control(NullBackend *null, gint64 now);
+static void expire_controls(NullBackend *null, gint64 now);
+
+static void select_default_streams(NullBackend *null);
+
+static void free_stream_list(NullBackend *null);
+static void free_churn_control(NullChurnControl *churn);
 
 static MateMixerBackendInfo info;
 
@@ -45,18 +161,471 @@ void backend_module_init(GTypeModule *module) {
 const MateMixerBackendInfo *backend_module_get_info(void) { return &info; }
 
 static void null_backend_class_init(NullBackendClass *klass) {
+  GObjectClass *object_class;
   MateMixerBackendClass *backend_class;
 
+  object_class = G_OBJECT_CLASS(klass);
+  object_class->dispose = null_backend_dispose;
+
   backend_class = MATE_MIXER_BACKEND_CLASS(klass);
   backend_class->open = null_backend_open;
+  backend_class->close = null_backend_close;
+  backend_class->list_devices = null_backend_list_devices;
+  backend_class->list_streams = null_backend_list_streams;
 }
 
 /* Called in the code generated by G_DEFINE_DYNAMIC_TYPE() */
 static void null_backend_class_finalize(NullBackendClass *klass) {}
 
-static void null_backend_init(NullBackend *null) {}
+static void null_backend_init(NullBackend *null) {
+  null->priv = null_backend_get_instance_private(null);
+
+  g_queue_init(&null->priv->churn);
+}
+
+static void null_backend_dispose(GObject *object) {
+  MateMixerBackend *backend;
+  MateMixerState state;
+
+  backend = MATE_MIXER_BACKEND(object);
+
+  state = mate_mixer_backend_get_state(backend);
+  if (state != MATE_MIXER_STATE_IDLE) null_backend_close(backend);
+
+  G_OBJECT_CLASS(null_backend_parent_class)->dispose(object);
+}
 
 static gboolean null_backend_open(MateMixerBackend *backend) {
-  _mate_mixer_backend_set_state(backend, MATE_MIXER_STATE_READY);
+  NullBackend *null;
+
+  g_return_val_if_fail(NULL_IS_BACKEND(backend), FALSE);
+
+  null = NULL_BACKEND(backend);
+
+  read_config(null);
+
+  null->priv->rand = g_rand_new_with_seed(null->priv->config.seed);
+  null->priv->stream_table = g_ptr_array_new_with_free_func(g_object_unref);
+  null->priv->controls = g_ptr_array_new_with_free_func(g_object_unref);
+
+  if (null->priv->config.latency > 0) {
+    /* Pretend the initial state is being read from a server */
+    null->priv->connect_source =
+        g_timeout_source_new(null->priv->config.latency);
+    g_source_set_callback(null->priv->connect_source,
+                          (GSourceFunc)load_objects, null, NULL);
+    g_source_attach(null->priv->connect_source,
+                    g_main_context_get_thread_default());
+
+    _mate_mixer_backend_set_state(backend, MATE_MIXER_STATE_CONNECTING);
+  } else
+    load_objects(null);
+
   return TRUE;
 }
+
+static void null_backend_close(MateMixerBackend *backend) {
+  NullBackend *null;
+
+  g_return_if_fail(NULL_IS_BACKEND(backend));
+
+  null = NULL_BACKEND(backend);
+
+  if (null->priv->connect_source != NULL) {
+    g_source_destroy(null->priv->connect_source);
+    g_source_unref(null->priv->connect_source);
+    null->priv->connect_source = NULL;
+  }
+  if (null->priv->event_source != NULL) {
+    g_source_destroy(null->priv->event_source);
+    g_source_unref(null->priv->event_source);
+    null->priv->event_source = NULL;
+  }
+
+  g_queue_foreach(&null->priv->churn, (GFunc)free_churn_control, NULL);
+  g_queue_clear(&null->priv->churn);
+
+  while (null->priv->devices != NULL) {
+    NullDevice *device = NULL_DEVICE(null->priv->devices->data);
+
+    /* May emit removed signals */
+    null_device_remove_all(device);
+
+    g_signal_handlers_disconnect_by_data(G_OBJECT(device), null);
+
+    null->priv->devices =
+        g_list_delete_link(null->priv->devices, null->priv->devices);
+
+    g_signal_emit_by_name(
+        G_OBJECT(null), "device-removed",
+        mate_mixer_device_get_name(MATE_MIXER_DEVICE(device)));
+
+    g_object_unref(device);
+  }
+
+  free_stream_list(null);
+
+  if (null->priv->stream_table != NULL) {
+    g_ptr_array_unref(null->priv->stream_table);
+    null->priv->stream_table = NULL;
+  }
+  if (null->priv->controls != NULL) {
+    g_ptr_array_unref(null->priv->controls);
+    null->priv->controls = NULL;
+  }
+  if (null->priv->rand != NULL) {
+    g_rand_free(null->priv->rand);
+    null->priv->rand = NULL;
+  }
+
+  _mate_mixer_backend_set_state(backend, MATE_MIXER_STATE_IDLE);
+}
+
+static const GList *null_backend_list_devices(MateMixerBackend *backend) {
+  g_return_val_if_fail(NULL_IS_BACKEND(backend), NULL);
+
+  return NULL_BACKEND(backend)->priv->devices;
+}
+
+static const GList *null_backend_list_streams(MateMixerBackend *backend) {
+  NullBackend *null;
+
+  g_return_val_if_fail(NULL_IS_BACKEND(backend), NULL);
+
+  null = NULL_BACKEND(backend);
+
+  if (null->priv->streams == NULL) {
+    GList *list;
+
+    list = g_list_last(null->priv->devices);
+    while (list != NULL) {
+      const GList *streams;
+
+      streams = mate_mixer_device_list_streams(MATE_MIXER_DEVICE(list->data));
+      streams = g_list_last((GList *)streams);
+
+      while (streams != NULL) {
+        null->priv->streams =
+            g_list_prepend(null->priv->streams, g_object_ref(streams->data));
+        streams = streams->prev;
+      }
+      list = list->prev;
+    }
+  }
+  return null->priv->streams;
+}
+
+static gboolean load_objects(NullBackend *null) {
+  if (null->priv->connect_source != NULL) {
+    g_source_unref(null->priv->connect_source);
+    null->priv->connect_source = NULL;
+  }
+
+  create_devices(null);
+  select_default_streams(null);
+
+  if (null->priv->config.rate > 0 && null->priv->stream_table->len > 0)
+    start_events(null);
+
+  _mate_mixer_backend_set_state(MATE_MIXER_BACKEND(null),
+                                MATE_MIXER_STATE_READY);
+  return G_SOURCE_REMOVE;
+}
+
+static void read_config(NullBackend *null) {
+  const gchar *pattern;
+
+  null->priv->config.devices = read_config_uint(NULL_ENV_DEVICES, 0);
+  null->priv->config.streams = read_config_uint(NULL_ENV_STREAMS, 0);
+  null->priv->config.controls = read_config_uint(NULL_ENV_CONTROLS, 0);
+  null->priv->config.channels = read_config_uint(NULL_ENV_CHANNELS, 0);
+  null->priv->config.rate = read_config_uint(NULL_ENV_RATE, 0);
+  null->priv->config.lifetime =
+      read_config_uint(NULL_ENV_LIFETIME, NULL_DEFAULT_LIFETIME);
+  null->priv->config.latency = read_config_uint(NULL_ENV_LATENCY, 0);
+  null->priv->config.seed = read_config_uint(NULL_ENV_SEED, NULL_DEFAULT_SEED);
+
+  pattern = g_getenv(NULL_ENV_PATTERN);
+  if (g_strcmp0(pattern, "burst") == 0)
+    null->priv->config.pattern = NULL_PATTERN_BURST;
+  else if (g_strcmp0(pattern, "churn") == 0)
+    null->priv->config.pattern = NULL_PATTERN_CHURN;
+  else {
+    if (pattern != NULL && g_strcmp0(pattern, "steady") != 0)
+      g_warning("Invalid value of %s: %s", NULL_ENV_PATTERN, pattern);
+
+    null->priv->config.pattern = NULL_PATTERN_STEADY;
+  }
+
+  if (null->priv->config.devices > 0)
+    g_debug("Creating %u devices with %u streams and %u controls each",
+            null->priv->config.devices, null->priv->config.streams,
+            null->priv->config.controls);
+}
+
+static guint read_config_uint(const gchar *variable, guint value) {
+  const gchar *str;
+  gchar *end;
+  guint64 v;
+
+  str = g_getenv(variable);
+  if (str == NULL) return value;
+
+  v = g_ascii_strtoull(str, &end, 10);
+  if (end == str || *end != '\0' || v > G_MAXUINT) {
+    g_warning("Invalid value of %s: %s", variable, str);
+    return value;
+  }
+  return (guint)v;
+}
+
+static void create_devices(NullBackend *null) {
+  guint i, j, k;
+
+  for (i = 0; i < null->priv->config.devices; i++) {
+    NullDevice *device;
+    gchar *name;
+    gchar *label;
+
+    name = g_strdup_printf("null-%u", i);
+    label = g_strdup_printf("Synthetic Card %u", i + 1);
+
+    device = null_device_new(name, label);
+    g_free(name);
+    g_free(label);
+
+    /* Takes reference of device */
+    null->priv->devices = g_list_append(null->priv->devices, device);
+
+    g_signal_connect_swapped(G_OBJECT(device), "stream-added",
+                             G_CALLBACK(free_stream_list), null);
+    g_signal_connect_swapped(G_OBJECT(device), "stream-removed",
+                             G_CALLBACK(free_stream_list), null);
+
+    g_signal_emit_by_name(
+        G_OBJECT(null), "device-added",
+        mate_mixer_device_get_name(MATE_MIXER_DEVICE(device)));
+
+    for (j = 0; j < null->priv->config.streams; j++) {
+      NullStream *stream;
+      MateMixerDirection direction;
+
+      if (j % 2 == 0)
+        direction = MATE_MIXER_DIRECTION_OUTPUT;
+      else
+        direction = MATE_MIXER_DIRECTION_INPUT;
+
+      name = g_strdup_printf(
+          "null-%u-%s-%u", i,
+          (direction == MATE_MIXER_DIRECTION_OUTPUT) ? "output" : "input",
+          j / 2);
+      label = g_strdup_printf(
+          "Synthetic Card %u %s %u", i + 1,
+          (direction == MATE_MIXER_DIRECTION_OUTPUT) ? "Output" : "Input",
+          j / 2 + 1);
+
+      stream = null_stream_new(name, label, device, direction);
+      g_free(label);
+
+      /* Controls are added before the stream is announced, so that the
+       * stream is complete once users learn about it */
+      for (k = 0; k < null->priv->config.controls; k++) {
+        NullStreamControl *control;
+        gchar *control_name;
+
+        control_name = g_strdup_printf("%s-control-%u", name, k);
+        control = create_control(
+            null, stream, control_name,
+            (k == 0) ? MATE_MIXER_STREAM_CONTROL_ROLE_MASTER
+                     : MATE_MIXER_STREAM_CONTROL_ROLE_APPLICATION);
+        g_free(control_name);
+
+        /* Takes reference of control */
+        g_ptr_array_add(null->priv->controls, control);
+      }
+      g_free(name);
+
+      null_device_add_stream(device, stream);
+
+      /* Takes reference of stream, the table allows picking a random stream
+       * in constant time */
+      g_ptr_array_add(null->priv->stream_table, stream);
+    }
+  }
+}
+
+static NullStreamControl *create_control(NullBackend *null, NullStream *stream,
+                                         const gchar *name,
+                                         MateMixerStreamControlRole role) {
+  NullStreamControl *control;
+  guint channels;
+
+  channels = null->priv->config.channels;
+  if (channels == 0)
+    channels = null_channels_mix[null->priv->serial %
+                                 G_N_ELEMENTS(null_channels_mix)];
+
+  null->priv->serial++;
+
+  control = null_stream_control_new(name, name, role, stream, channels);
+
+  null_stream_control_set_latency(control, null->priv->config.latency);
+
+  null_stream_add_control(stream, control);
+  return control;
+}
+
+static void start_events(NullBackend *null) {
+  guint interval;
+
+  if (null->priv->config.pattern == NULL_PATTERN_BURST)
+    interval = 1000;
+  else
+    interval = 1000 / MIN(null->priv->config.rate, NULL_MAX_WAKEUPS);
+
+  null->priv->event_source = g_timeout_source_new(interval);
+  g_source_set_callback(null->priv->event_source,
+                        (GSourceFunc)generate_events, null, NULL);
+  g_source_attach(null->priv->event_source,
+                  g_main_context_get_thread_default());
+}
+
+static gboolean generate_events(NullBackend *null) {
+  gint64 now;
+  guint count;
+  guint i;
+
+  now = g_get_monotonic_time();
+
+  if (null->priv->config.pattern == NULL_PATTERN_BURST)
+    count = null->priv->config.rate;
+  else
+    count = MAX(null->priv->config.rate / NULL_MAX_WAKEUPS, 1);
+
+  if (null->priv->config.pattern == NULL_PATTERN_CHURN) {
+    expire_controls(null, now);
+
+    for (i = 0; i < count; i++) churn_control(null, now);
+  } else {
+    for (i = 0; i < count; i++) change_volume(null);
+  }
+  return G_SOURCE_CONTINUE;
+}
+
+static void change_volume(NullBackend *null) {
+  MateMixerStreamControl *control;
+  guint volume;
+  guint channels;
+
+  if (null->priv->controls->len == 0) return;
+
+  control = g_ptr_array_index(
+      null->priv->controls,
+      g_rand_int_range(null->priv->rand, 0, null->priv->controls->len));
+
+  volume = g_rand_int_range(null->priv->rand, 0,
+                            mate_mixer_stream_control_get_max_volume(control));
+
+  /* Mostly change the volume of the whole control, but sometimes a single
+   * channel or the mute state like a user would do, the changes come from
+   * the simulated server so they are not subject to the latency */
+  switch (g_rand_int_range(null->priv->rand, 0, 8)) {
+    case 0:
+      channels = mate_mixer_stream_control_get_num_channels(control);
+      null_stream_control_store_channel_volume(
+          NULL_STREAM_CONTROL(control),
+          g_rand_int_range(null->priv->rand, 0, channels), volume);
+      break;
+    case 1:
+      _mate_mixer_stream_control_set_mute(
+          control, !mate_mixer_stream_control_get_mute(control));
+      break;
+    default:
+      null_stream_control_store_volume(NULL_STREAM_CONTROL(control), volume);
+      break;
+  }
+}
+
+static void churn_control(NullBackend *null, gint64 now) {
+  NullChurnControl *churn;
+  NullStream *stream;
+  gchar *name;
+
+  stream = g_ptr_array_index(
+      null->priv->stream_table,
+      g_rand_int_range(null->priv->rand, 0, null->priv->stream_table->len));
+
+  name = g_strdup_printf("%s-client-%u",
+                         mate_mixer_stream_get_name(MATE_MIXER_STREAM(stream)),
+                         null->priv->serial);
+
+  churn = g_slice_new(NullChurnControl);
+  churn->control = create_control(null, stream, name,
+                                  MATE_MIXER_STREAM_CONTROL_ROLE_APPLICATION);
+  churn->expires =
+      now + (gint64)null->priv->config.lifetime * G_TIME_SPAN_MILLISECOND;
+
+  g_free(name);
+
+  /* Controls are created in the order of their expiry time */
+  g_queue_push_tail(&null->priv->churn, churn);
+}
+
+static void expire_controls(NullBackend *null, gint64 now) {
+  NullChurnControl *churn;
+
+  while ((churn = g_queue_peek_head(&null->priv->churn)) != NULL) {
+    MateMixerStream *stream;
+
+    if (churn->expires > now) break;
+
+    g_queue_pop_head(&null->priv->churn);
+
+    stream = mate_mixer_stream_control_get_stream(
+        MATE_MIXER_STREAM_CONTROL(churn->control));
+
+    null_stream_remove_control(NULL_STREAM(stream), churn->control);
+    free_churn_control(churn);
+  }
+}
+
+static void select_default_streams(NullBackend *null) {
+  MateMixerStream *input = NULL;
+  MateMixerStream *output = NULL;
+  const GList *list;
+
+  list = null_backend_list_streams(MATE_MIXER_BACKEND(null));
+  while (list != NULL && (input == NULL || output == NULL)) {
+    MateMixerStream *stream = MATE_MIXER_STREAM(list->data);
+
+    switch (mate_mixer_stream_get_direction(stream)) {
+      case MATE_MIXER_DIRECTION_INPUT:
+        if (input == NULL) input = stream;
+        break;
+      case MATE_MIXER_DIRECTION_OUTPUT:
+        if (output == NULL) output = stream;
+        break;
+      default:
+        break;
+    }
+    list = list->next;
+  }
+
+  _mate_mixer_backend_set_default_input_stream(MATE_MIXER_BACKEND(null),
+                                               input);
+  _mate_mixer_backend_set_default_output_stream(MATE_MIXER_BACKEND(null),
+                                                output);
+}
+
+static void free_stream_list(NullBackend *null) {
+  if (null->priv->streams == NULL) return;
+
+  g_list_free_full(null->priv->streams, g_object_unref);
+
+  null->priv->streams = NULL;
+}
+
+static void free_churn_control(NullChurnControl *churn) {
+  g_object_unref(churn->control);
+  g_slice_free(NullChurnControl, churn);
+}
@@ -36,9 +36,13 @@
 
 typedef struct _NullBackend NullBackend;
 typedef struct _NullBackendClass NullBackendClass;
+typedef struct _NullBackendPrivate NullBackendPrivate;
 
 struct _NullBackend {
   MateMixerBackend parent;
+
+  /*< private >*/
+  NullBackendPrivate *priv;
 };
 
 struct _NullBackendClass {
@@ -0,0 +1,497 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "null-stream-control.h"
+
+#include <glib-object.h>
+#include <glib.h>
+#include <libmatemixer/matemixer-private.h>
+#include <libmatemixer/matemixer.h>
+#include <string.h>
+
+#include "null-stream.h"
+
+/* Use the same scale as a sound server would, so that consumers see
+ * realistic volume values */
+#define NULL_VOLUME_MIN 0
+#define NULL_VOLUME_NORMAL 65536
+
+/* Channel maps for 1 to NULL_MAX_CHANNELS channels, the order follows the
+ * usual mono, stereo, 2.1, quad, 5.0, 5.1, 6.1 and 7.1 layouts */
+static const MateMixerChannelPosition
+    null_channel_maps[NULL_MAX_CHANNELS][NULL_MAX_CHANNELS] = {
+        {MATE_MIXER_CHANNEL_MONO},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT,
+         MATE_MIXER_CHANNEL_LFE},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT,
+         MATE_MIXER_CHANNEL_BACK_LEFT, MATE_MIXER_CHANNEL_BACK_RIGHT},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT,
+         MATE_MIXER_CHANNEL_FRONT_CENTER, MATE_MIXER_CHANNEL_BACK_LEFT,
+         MATE_MIXER_CHANNEL_BACK_RIGHT},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT,
+         MATE_MIXER_CHANNEL_FRONT_CENTER, MATE_MIXER_CHANNEL_LFE,
+         MATE_MIXER_CHANNEL_BACK_LEFT, MATE_MIXER_CHANNEL_BACK_RIGHT},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT,
+         MATE_MIXER_CHANNEL_FRONT_CENTER, MATE_MIXER_CHANNEL_LFE,
+         MATE_MIXER_CHANNEL_BACK_CENTER, MATE_MIXER_CHANNEL_SIDE_LEFT,
+         MATE_MIXER_CHANNEL_SIDE_RIGHT},
+        {MATE_MIXER_CHANNEL_FRONT_LEFT, MATE_MIXER_CHANNEL_FRONT_RIGHT,
+         MATE_MIXER_CHANNEL_FRONT_CENTER, MATE_MIXER_CHANNEL_LFE,
+         MATE_MIXER_CHANNEL_BACK_LEFT, MATE_MIXER_CHANNEL_BACK_RIGHT,
+         MATE_MIXER_CHANNEL_SIDE_LEFT, MATE_MIXER_CHANNEL_SIDE_RIGHT}};
+
+struct _NullStreamControlPrivate {
+  guint channels;
+  guint volume[NULL_MAX_CHANNELS];
+  guint latency;
+  guint pending[NULL_MAX_CHANNELS];
+  GSource *reply_source;
+  GMainContext *context;
+};
+
+static void null_stream_control_class_init(NullStreamControlClass *klass);
+static void null_stream_control_init(NullStreamControl *control);
+static void null_stream_control_dispose(GObject *object);
+static void null_stream_control_finalize(GObject *object);
+
+G_DEFINE_TYPE_WITH_PRIVATE(NullStreamControl, null_stream_control,
+                           MATE_MIXER_TYPE_STREAM_CONTROL)
+
+static gboolean null_stream_control_set_mute(MateMixerStreamControl *mmsc,
+                                             gboolean mute);
+
+static guint null_stream_control_get_num_channels(MateMixerStreamControl *mmsc);
+
+static guint null_stream_control_get_volume(MateMixerStreamControl *mmsc);
+
+static gboolean null_stream_control_set_volume(MateMixerStreamControl *mmsc,
+                                               guint volume);
+
+static gboolean null_stream_control_has_channel_position(
+    MateMixerStreamControl *mmsc, MateMixerChannelPosition position);
+static MateMixerChannelPosition null_stream_control_get_channel_position(
+    MateMixerStreamControl *mmsc, guint channel);
+
+static guint null_stream_control_get_channel_volume(
+    MateMixerStreamControl *mmsc, guint channel);
+static gboolean null_stream_control_set_channel_volume(
+    MateMixerStreamControl *mmsc, guint channel, guint volume);
+
+static gboolean null_stream_control_set_balance(MateMixerStreamControl *mmsc,
+                                                gfloat balance);
+
+static guint null_stream_control_get_min_volume(MateMixerStreamControl *mmsc);
+static guint null_stream_control_get_max_volume(MateMixerStreamControl *mmsc);
+static guint null_stream_control_get_normal_volume(
+    MateMixerStreamControl *mmsc);
+static guint null_stream_control_get_base_volume(MateMixerStreamControl *mmsc);
+
+static const guint *get_target_volume(NullStreamControl *control);
+
+static void request_volume(NullStreamControl *control, const guint *volume);
+static gboolean reply_volume(NullStreamControl *control);
+
+static void store_volume(NullStreamControl *control, const guint *volume);
+
+static void update_balance(NullStreamControl *control);
+
+static gboolean is_left_channel(MateMixerChannelPosition position);
+static gboolean is_right_channel(MateMixerChannelPosition position);
+
+static void null_stream_control_class_init(NullStreamControlClass *klass) {
+  GObjectClass *object_class;
+  MateMixerStreamControlClass *control_class;
+
+  object_class = G_OBJECT_CLASS(klass);
+  object_class->dispose = null_stream_control_dispose;
+  object_class->finalize = null_stream_control_finalize;
+
+  control_class = MATE_MIXER_STREAM_CONTROL_CLASS(klass);
+  control_class->set_mute = null_stream_control_set_mute;
+  control_class->get_num_channels = null_stream_control_get_num_channels;
+  control_class->get_volume = null_stream_control_get_volume;
+  control_class->set_volume = null_stream_control_set_volume;
+  control_class->get_channel_volume = null_stream_control_get_channel_volume;
+  control_class->set_channel_volume = null_stream_control_set_channel_volume;
+  control_class->has_channel_position =
+      null_stream_control_has_channel_position;
+  control_class->get_channel_position =
+      null_stream_control_get_channel_position;
+  control_class->set_balance = null_stream_control_set_balance;
+  control_class->get_min_volume = null_stream_control_get_min_volume;
+  control_class->get_max_volume = null_stream_control_get_max_volume;
+  control_class->get_normal_volume = null_stream_control_get_normal_volume;
+  control_class->get_base_volume = null_stream_control_get_base_volume;
+}
+
+static void null_stream_control_init(NullStreamControl *control) {
+  control->priv = null_stream_control_get_instance_private(control);
+
+  /* Replies are delivered in the main context of the backend, which is not
+   * necessarily the one of the thread calling the setters */
+  control->priv->context = g_main_context_ref_thread_default();
+}
+
+static void null_stream_control_dispose(GObject *object) {
+  NullStreamControl *control;
+
+  control = NULL_STREAM_CONTROL(object);
+
+  if (control->priv->reply_source != NULL) {
+    g_source_destroy(control->priv->reply_source);
+    g_source_unref(control->priv->reply_source);
+    control->priv->reply_source = NULL;
+  }
+
+  G_OBJECT_CLASS(null_stream_control_parent_class)->dispose(object);
+}
+
+static void null_stream_control_finalize(GObject *object) {
+  NullStreamControl *control;
+
+  control = NULL_STREAM_CONTROL(object);
+
+  g_main_context_unref(control->priv->context);
+
+  G_OBJECT_CLASS(null_stream_control_parent_class)->finalize(object);
+}
+
+NullStreamControl *null_stream_control_new(const gchar *name,
+                                           const gchar *label,
+                                           MateMixerStreamControlRole role,
+                                           NullStream *stream,
+                                           guint channels) {
+  NullStreamControl *control;
+  MateMixerStreamControlFlags flags;
+  guint i;
+
+  g_return_val_if_fail(name != NULL, NULL);
+  g_return_val_if_fail(label != NULL, NULL);
+  g_return_val_if_fail(NULL_IS_STREAM(stream), NULL);
+
+  channels = CLAMP(channels, 1, NULL_MAX_CHANNELS);
+
+  flags = MATE_MIXER_STREAM_CONTROL_MUTE_READABLE |
+          MATE_MIXER_STREAM_CONTROL_MUTE_WRITABLE |
+          MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE |
+          MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE;
+  if (channels > 1) flags |= MATE_MIXER_STREAM_CONTROL_CAN_BALANCE;
+
+  control = g_object_new(NULL_TYPE_STREAM_CONTROL, "name", name, "label", label,
+                         "flags", flags, "role", role, "stream", stream, NULL);
+
+  control->priv->channels = channels;
+  for (i = 0; i < channels; i++) control->priv->volume[i] = NULL_VOLUME_NORMAL;
+
+  return control;
+}
+
+void null_stream_control_set_latency(NullStreamControl *control,
+                                     guint latency) {
+  g_return_if_fail(NULL_IS_STREAM_CONTROL(control));
+
+  control->priv->latency = latency;
+}
+
+void null_stream_control_store_volume(NullStreamControl *control,
+                                      guint volume) {
+  guint v[NULL_MAX_CHANNELS];
+  guint i;
+
+  g_return_if_fail(NULL_IS_STREAM_CONTROL(control));
+
+  volume = CLAMP(volume, NULL_VOLUME_MIN, NULL_VOLUME_NORMAL);
+  for (i = 0; i < control->priv->channels; i++) v[i] = volume;
+
+  store_volume(control, v);
+}
+
+void null_stream_control_store_channel_volume(NullStreamControl *control,
+                                              guint channel, guint volume) {
+  guint v[NULL_MAX_CHANNELS];
+
+  g_return_if_fail(NULL_IS_STREAM_CONTROL(control));
+
+  if (channel >= control->priv->channels) return;
+
+  memcpy(v, control->priv->volume, sizeof(v));
+  v[channel] = CLAMP(volume, NULL_VOLUME_MIN, NULL_VOLUME_NORMAL);
+
+  store_volume(control, v);
+}
+
+static gboolean null_stream_control_set_mute(MateMixerStreamControl *mmsc,
+                                             gboolean mute) {
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), FALSE);
+
+  /* The new state is stored by the caller */
+  return TRUE;
+}
+
+static guint null_stream_control_get_num_channels(
+    MateMixerStreamControl *mmsc) {
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), 0);
+
+  return NULL_STREAM_CONTROL(mmsc)->priv->channels;
+}
+
+static guint null_stream_control_get_volume(MateMixerStreamControl *mmsc) {
+  NullStreamControl *control;
+  guint i;
+  guint volume = 0;
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), 0);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+
+  for (i = 0; i < control->priv->channels; i++)
+    volume = MAX(volume, control->priv->volume[i]);
+
+  return volume;
+}
+
+static gboolean null_stream_control_set_volume(MateMixerStreamControl *mmsc,
+                                               guint volume) {
+  NullStreamControl *control;
+  guint v[NULL_MAX_CHANNELS];
+  guint i;
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), FALSE);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+
+  volume = CLAMP(volume, NULL_VOLUME_MIN, NULL_VOLUME_NORMAL);
+  for (i = 0; i < control->priv->channels; i++) v[i] = volume;
+
+  request_volume(control, v);
+  return TRUE;
+}
+
+static guint null_stream_control_get_channel_volume(
+    MateMixerStreamControl *mmsc, guint channel) {
+  NullStreamControl *control;
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), 0);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+
+  if (channel >= control->priv->channels) return 0;
+
+  return control->priv->volume[channel];
+}
+
+static gboolean null_stream_control_set_channel_volume(
+    MateMixerStreamControl *mmsc, guint channel, guint volume) {
+  NullStreamControl *control;
+  guint v[NULL_MAX_CHANNELS];
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), FALSE);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+
+  if (channel >= control->priv->channels) return FALSE;
+
+  memcpy(v, get_target_volume(control), sizeof(v));
+  v[channel] = CLAMP(volume, NULL_VOLUME_MIN, NULL_VOLUME_NORMAL);
+
+  request_volume(control, v);
+  return TRUE;
+}
+
+static MateMixerChannelPosition null_stream_control_get_channel_position(
+    MateMixerStreamControl *mmsc, guint channel) {
+  NullStreamControl *control;
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc),
+                       MATE_MIXER_CHANNEL_UNKNOWN);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+
+  if (channel >= control->priv->channels) return MATE_MIXER_CHANNEL_UNKNOWN;
+
+  return null_channel_maps[control->priv->channels - 1][channel];
+}
+
+static gboolean null_stream_control_has_channel_position(
+    MateMixerStreamControl *mmsc, MateMixerChannelPosition position) {
+  NullStreamControl *control;
+  guint i;
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), FALSE);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+
+  for (i = 0; i < control->priv->channels; i++)
+    if (null_channel_maps[control->priv->channels - 1][i] == position)
+      return TRUE;
+
+  return FALSE;
+}
+
+static gboolean null_stream_control_set_balance(MateMixerStreamControl *mmsc,
+                                                gfloat balance) {
+  NullStreamControl *control;
+  const MateMixerChannelPosition *map;
+  const guint *target;
+  guint v[NULL_MAX_CHANNELS];
+  guint max = 0;
+  guint i;
+
+  g_return_val_if_fail(NULL_IS_STREAM_CONTROL(mmsc), FALSE);
+
+  control = NULL_STREAM_CONTROL(mmsc);
+  map = null_channel_maps[control->priv->channels - 1];
+  target = get_target_volume(control);
+
+  for (i = 0; i < control->priv->channels; i++) max = MAX(max, target[i]);
+
+  /* Scale down the side opposite to the direction of the balance and keep
+   * the channels in the middle untouched */
+  for (i = 0; i < control->priv->channels; i++) {
+    v[i] = target[i];
+
+    if (is_left_channel(map[i]) == TRUE)
+      v[i] = (balance <= 0) ? max : (1.0f - balance) * max;
+    else if (is_right_channel(map[i]) == TRUE)
+      v[i] = (balance <= 0) ? (balance + 1.0f) * max : max;
+  }
+
+  request_volume(control, v);
+  return TRUE;
+}
+
+static guint null_stream_control_get_min_volume(MateMixerStreamControl *mmsc) {
+  return NULL_VOLUME_MIN;
+}
+
+static guint null_stream_control_get_max_volume(MateMixerStreamControl *mmsc) {
+  return NULL_VOLUME_NORMAL;
+}
+
+static guint null_stream_control_get_normal_volume(
+    MateMixerStreamControl *mmsc) {
+  return NULL_VOLUME_NORMAL;
+}
+
+static guint null_stream_control_get_base_volume(
+    MateMixerStreamControl *mmsc) {
+  return NULL_VOLUME_NORMAL;
+}
+
+/* Volume that the control will have once the pending request is applied */
+static const guint *get_target_volume(NullStreamControl *control) {
+  if (control->priv->reply_source != NULL) return control->priv->pending;
+
+  return control->priv->volume;
+}
+
+/* With a latency configured the request is applied as if it went through a
+ * sound server, requests made while one is pending are merged into it */
+static void request_volume(NullStreamControl *control, const guint *volume) {
+  if (control->priv->latency == 0) {
+    store_volume(control, volume);
+    return;
+  }
+
+  memcpy(control->priv->pending, volume,
+         control->priv->channels * sizeof(guint));
+
+  if (control->priv->reply_source != NULL) return;
+
+  control->priv->reply_source = g_timeout_source_new(control->priv->latency);
+  g_source_set_callback(control->priv->reply_source,
+                        (GSourceFunc)reply_volume, control, NULL);
+  g_source_attach(control->priv->reply_source, control->priv->context);
+}
+
+static gboolean reply_volume(NullStreamControl *control) {
+  g_source_unref(control->priv->reply_source);
+  control->priv->reply_source = NULL;
+
+  store_volume(control, control->priv->pending);
+  return G_SOURCE_REMOVE;
+}
+
+static void store_volume(NullStreamControl *control, const guint *volume) {
+  gsize size;
+
+  size = control->priv->channels * sizeof(guint);
+
+  /* Nothing to do? */
+  if (memcmp(control->priv->volume, volume, size) == 0) return;
+
+  memcpy(control->priv->volume, volume, size);
+
+  g_object_freeze_notify(G_OBJECT(control));
+
+  g_object_notify(G_OBJECT(control), "volume");
+
+  /* Emits signal if balance has changed */
+  if (control->priv->channels > 1) update_balance(control);
+
+  g_object_thaw_notify(G_OBJECT(control));
+}
+
+static void update_balance(NullStreamControl *control) {
+  const MateMixerChannelPosition *map;
+  gfloat balance;
+  guint left = 0;
+  guint right = 0;
+  guint i;
+
+  map = null_channel_maps[control->priv->channels - 1];
+
+  for (i = 0; i < control->priv->channels; i++) {
+    if (is_left_channel(map[i]) == TRUE)
+      left = MAX(left, control->priv->volume[i]);
+    else if (is_right_channel(map[i]) == TRUE)
+      right = MAX(right, control->priv->volume[i]);
+  }
+
+  if (left == right)
+    balance = 0.0f;
+  else if (left > right)
+    balance = -1.0f + ((gfloat)right / (gfloat)left);
+  else
+    balance = +1.0f - ((gfloat)left / (gfloat)right);
+
+  _mate_mixer_stream_control_set_balance(MATE_MIXER_STREAM_CONTROL(control),
+                                         balance);
+}
+
+static gboolean is_left_channel(MateMixerChannelPosition position) {
+  switch (position) {
+    case MATE_MIXER_CHANNEL_FRONT_LEFT:
+    case MATE_MIXER_CHANNEL_BACK_LEFT:
+    case MATE_MIXER_CHANNEL_SIDE_LEFT:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+static gboolean is_right_channel(MateMixerChannelPosition position) {
+  switch (position) {
+    case MATE_MIXER_CHANNEL_FRONT_RIGHT:
+    case MATE_MIXER_CHANNEL_BACK_RIGHT:
+    case MATE_MIXER_CHANNEL_SIDE_RIGHT:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
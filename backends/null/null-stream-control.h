@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NULL_STREAM_CONTROL_H
+#define NULL_STREAM_CONTROL_H
+
+#include <glib-object.h>
+#include <glib.h>
+#include <libmatemixer/matemixer.h>
+
+#include "null-types.h"
+
+G_BEGIN_DECLS
+
+/* Largest channel map the synthetic controls provide (7.1) */
+#define NULL_MAX_CHANNELS 8
+
+#define NULL_TYPE_STREAM_CONTROL (null_stream_control_get_type())
+#define NULL_STREAM_CONTROL(o)                               \
+  (G_TYPE_CHECK_INSTANCE_CAST((o), NULL_TYPE_STREAM_CONTROL, \
+                              NullStreamControl))
+#define NULL_IS_STREAM_CONTROL(o) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((o), NULL_TYPE_STREAM_CONTROL))
+#define NULL_STREAM_CONTROL_CLASS(k)                     \
+  (G_TYPE_CHECK_CLASS_CAST((k), NULL_TYPE_STREAM_CONTROL, \
+                           NullStreamControlClass))
+#define NULL_IS_STREAM_CONTROL_CLASS(k) \
+  (G_TYPE_CHECK_CLASS_TYPE((k), NULL_TYPE_STREAM_CONTROL))
+#define NULL_STREAM_CONTROL_GET_CLASS(o)                    \
+  (G_TYPE_INSTANCE_GET_CLASS((o), NULL_TYPE_STREAM_CONTROL, \
+                             NullStreamControlClass))
+
+typedef struct _NullStreamControlClass NullStreamControlClass;
+typedef struct _NullStreamControlPrivate NullStreamControlPrivate;
+
+struct _NullStreamControl {
+  MateMixerStreamControl parent;
+
+  /*< private >*/
+  NullStreamControlPrivate *priv;
+};
+
+struct _NullStreamControlClass {
+  MateMixerStreamControlClass parent;
+};
+
+GType null_stream_control_get_type(void) G_GNUC_CONST;
+
+NullStreamControl *null_stream_control_new(const gchar *name,
+                                           const gchar *label,
+                                           MateMixerStreamControlRole role,
+                                           NullStream *stream,
+                                           guint channels);
+
+void null_stream_control_set_latency(NullStreamControl *control,
+                                     guint latency);
+
+void null_stream_control_store_volume(NullStreamControl *control,
+                                      guint volume);
+void null_stream_control_store_channel_volume(NullStreamControl *control,
+                                              guint channel, guint volume);
+
+G_END_DECLS
+
+#endif /* NULL_STREAM_CONTROL_H */
@@ -44,12 +44,40 @@
 
 #define OSS_MAX_DEVICES 32
 
+/* Devices which are due to be polled within this time are polled together with
+ * the ones which are already due, so that they share a single wakeup */
+#define OSS_POLL_SLACK (25 * G_TIME_SPAN_MILLISECOND)
+
+typedef struct {
+  dev_t rdev;
+  ino_t ino;
+  gchar *label;
+} OssDeviceLabel;
+
+typedef struct {
+  dev_t rdev;
+  ino_t ino;
+  time_t ctime;
+} OssDeviceNode;
+
 struct _OssBackendPrivate {
   gchar *default_device;
   GSource *timeout_source;
+  GSource *poll_source;
   GList *streams;
   GList *devices;
   GHashTable *devices_paths;
+  GHashTable *labels;
+  GHashTable *absent_nodes;
+
+  struct {
+    GHashTable *labels;
+    gint default_index;
+    dev_t dev;
+    ino_t ino;
+    time_t mtime;
+    gboolean valid;
+  } sndstat;
 };
 
 static void oss_backend_class_init(OssBackendClass *klass);
@@ -74,15 +102,27 @@ static gboolean read_devices(OssBackend *oss);
 static gboolean read_device(OssBackend *oss, const gchar *path,
                             gboolean *added);
 
+static void add_absent_node(OssBackend *oss, const gchar *path, GStatBuf *st);
+
 static gchar *read_device_label(OssBackend *oss, const gchar *path, gint fd);
 
 static gchar *read_device_label_sndstat(OssBackend *oss, const gchar *sndstat,
                                         const gchar *path,
                                         guint index) G_GNUC_UNUSED;
 
+static gboolean read_sndstat(OssBackend *oss, const gchar *sndstat);
+
+static guint get_device_index(const gchar *path);
+
+static void free_device_label(OssDeviceLabel *label);
+static void free_device_node(OssDeviceNode *node);
+
 static void add_device(OssBackend *oss, OssDevice *device);
 static void remove_device(OssBackend *oss, OssDevice *device);
 
+static gboolean poll_devices(OssBackend *oss);
+static void schedule_poll(OssBackend *oss);
+
 static void remove_device_by_path(OssBackend *oss, const gchar *path);
 
 static void remove_device_by_list_item(OssBackend *oss, GList *item);
@@ -134,6 +174,19 @@ static void oss_backend_init(OssBackend *oss) {
 
   oss->priv->devices_paths =
       g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+  /* Labels are kept even when the backend is closed, they are validated
+   * against the device node before being used */
+  oss->priv->labels = g_hash_table_new_full(
+      g_str_hash, g_str_equal, g_free, (GDestroyNotify)free_device_label);
+
+  /* Nodes which exist, but did not provide a usable device */
+  oss->priv->absent_nodes = g_hash_table_new_full(
+      g_str_hash, g_str_equal, g_free, (GDestroyNotify)free_device_node);
+
+  oss->priv->sndstat.labels =
+      g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+  oss->priv->sndstat.default_index = -1;
 }
 
 static void oss_backend_dispose(GObject *object) {
@@ -154,6 +207,9 @@ static void oss_backend_finalize(GObject *object) {
   oss = OSS_BACKEND(object);
 
   g_hash_table_unref(oss->priv->devices_paths);
+  g_hash_table_unref(oss->priv->labels);
+  g_hash_table_unref(oss->priv->absent_nodes);
+  g_hash_table_unref(oss->priv->sndstat.labels);
 
   G_OBJECT_CLASS(oss_backend_parent_class)->finalize(object);
 }
@@ -190,6 +246,12 @@ void oss_backend_close(MateMixerBackend *backend) {
 
   g_source_destroy(oss->priv->timeout_source);
 
+  if (oss->priv->poll_source != NULL) {
+    g_source_destroy(oss->priv->poll_source);
+    g_source_unref(oss->priv->poll_source);
+    oss->priv->poll_source = NULL;
+  }
+
   if (oss->priv->devices != NULL) {
     g_list_free_full(oss->priv->devices, g_object_unref);
     oss->priv->devices = NULL;
@@ -202,6 +264,7 @@ void oss_backend_close(MateMixerBackend *backend) {
   free_stream_list(oss);
 
   g_hash_table_remove_all(oss->priv->devices_paths);
+  g_hash_table_remove_all(oss->priv->absent_nodes);
 
   _mate_mixer_backend_set_state(backend, MATE_MIXER_STATE_IDLE);
 }
@@ -281,29 +344,56 @@ static gboolean read_devices(OssBackend *oss) {
 static gboolean read_device(OssBackend *oss, const gchar *path,
                             gboolean *added) {
   OssDevice *device;
+  OssDeviceNode *node;
+  GStatBuf st;
   gint fd;
   gchar *bname;
   gchar *label;
 
   *added = FALSE;
 
+  /* Most of the probed paths don't exist, this is detected without opening
+   * anything */
+  if (g_stat(path, &st) == -1) {
+    if (errno != ENOENT) g_debug("%s: %s", path, g_strerror(errno));
+
+    g_hash_table_remove(oss->priv->absent_nodes, path);
+    remove_device_by_path(oss, path);
+    return FALSE;
+  }
+
+  if (g_hash_table_contains(oss->priv->devices_paths, path) == TRUE) {
+    OssDeviceLabel *cached;
+
+    /* Don't proceed if the device is already known and its node has not
+     * changed, the device's polling facility handles the device going away
+     * while the node stays */
+    cached = g_hash_table_lookup(oss->priv->labels, path);
+    if (cached != NULL && cached->rdev == st.st_rdev &&
+        cached->ino == st.st_ino)
+      return TRUE;
+
+    /* The node has been replaced, read the device again */
+    remove_device_by_path(oss, path);
+  } else {
+    /* Nodes which failed to open are tried again only once they change, this
+     * includes permission changes, which update the node's ctime */
+    node = g_hash_table_lookup(oss->priv->absent_nodes, path);
+    if (node != NULL && node->rdev == st.st_rdev && node->ino == st.st_ino &&
+        node->ctime == st.st_ctime)
+      return FALSE;
+  }
+
   fd = g_open(path, O_RDWR, 0);
   if (fd == -1) {
     if (errno != ENOENT && errno != ENXIO)
       g_debug("%s: %s", path, g_strerror(errno));
 
-    remove_device_by_path(oss, path);
+    add_absent_node(oss, path, &st);
     return FALSE;
   }
 
-  /* Don't proceed if the device is already known, opening the device was
-   * still tested to be absolutely sure that the device is removed it case
-   * it has disappeared, but normally the device's polling facility should
-   * handle this by itself */
-  if (g_hash_table_contains(oss->priv->devices_paths, path) == TRUE) {
-    close(fd);
-    return TRUE;
-  }
+  g_hash_table_remove(oss->priv->absent_nodes, path);
 
   bname = g_path_get_basename(path);
   label = read_device_label(oss, path, fd);
@@ -321,88 +411,160 @@ static gboolean read_device(OssBackend *oss, const gchar *path,
     else
       g_object_unref(device);
   }
+
+  if (*added == FALSE) add_absent_node(oss, path, &st);
+
   return *added;
 }
 
+static void add_absent_node(OssBackend *oss, const gchar *path, GStatBuf *st) {
+  OssDeviceNode *node;
+
+  node = g_slice_new(OssDeviceNode);
+  node->rdev = st->st_rdev;
+  node->ino = st->st_ino;
+  node->ctime = st->st_ctime;
+
+  g_hash_table_replace(oss->priv->absent_nodes, g_strdup(path), node);
+}
+
 static gchar *read_device_label(OssBackend *oss, const gchar *path, gint fd) {
+  OssDeviceLabel *cached;
+  struct stat st;
+  gchar *label = NULL;
   guint index;
 
+  /* Device labels are not expected to change as long as the device node
+   * stays the same, so only read the label again if the node is new */
+  if (fstat(fd, &st) == 0) {
+    cached = g_hash_table_lookup(oss->priv->labels, path);
+    if (cached != NULL && cached->rdev == st.st_rdev &&
+        cached->ino == st.st_ino) {
+#ifdef OSS_PATH_SNDSTAT
+      /* The table is cached as well, this only updates the default device */
+      g_free(read_device_label_sndstat(oss, OSS_PATH_SNDSTAT, path,
+                                       get_device_index(path)));
+#endif
+      return g_strdup(cached->label);
+    }
+  }
+
+  index = get_device_index(path);
+
 #ifdef SOUND_MIXER_INFO
   do {
     struct mixer_info info;
 
     /* Prefer device name supplied by the system, but this calls fails
      * with EINVAL on FreeBSD */
-    if (ioctl(fd, SOUND_MIXER_INFO, &info) == 0) return g_strdup(info.name);
+    if (ioctl(fd, SOUND_MIXER_INFO, &info) == 0) label = g_strdup(info.name);
   } while (0);
 #endif
 
-  index = (guint)g_ascii_strtoull(path + sizeof("/dev/mixer") - 1, NULL, 10);
 #ifdef OSS_PATH_SNDSTAT
   /* If the ioctl doesn't succeed, assume that the mixer device number
    * matches the pcm number in the sndstat file, this is a bit desperate, but
    * it should be correct on FreeBSD */
-  do {
-    gchar *label;
-
+  if (label == NULL)
     label = read_device_label_sndstat(oss, OSS_PATH_SNDSTAT, path, index);
-    if (label != NULL) return label;
-  } while (0);
 #endif
 
-  return g_strdup_printf(_("OSS Mixer %d"), index);
+  if (label == NULL) label = g_strdup_printf(_("OSS Mixer %d"), index);
+
+  if (fstat(fd, &st) == 0) {
+    cached = g_slice_new(OssDeviceLabel);
+    cached->rdev = st.st_rdev;
+    cached->ino = st.st_ino;
+    cached->label = g_strdup(label);
+
+    g_hash_table_replace(oss->priv->labels, g_strdup(path), cached);
+  }
+  return label;
 }
 
 static gchar *read_device_label_sndstat(OssBackend *oss, const gchar *sndstat,
                                         const gchar *path, guint index) {
+  const gchar *label;
+
+  if (read_sndstat(oss, sndstat) == FALSE) return NULL;
+
+  label =
+      g_hash_table_lookup(oss->priv->sndstat.labels, GUINT_TO_POINTER(index));
+  if (label == NULL) return NULL;
+
+  /* Normally the default OSS device is /dev/dsp, but on FreeBSD /dev/dsp
+   * doesn't physically exist on the filesystem, but is managed by the kernel
+   * according to the user-settable default device, in sndstat the default
+   * card definition ends with the word "default" */
+  if (oss->priv->sndstat.default_index == (gint)index) {
+    g_free(oss->priv->default_device);
+
+    oss->priv->default_device = g_strdup(path);
+  }
+  return g_strdup(label);
+}
+
+static gboolean read_sndstat(OssBackend *oss, const gchar *sndstat) {
   FILE *fp;
-  gchar *label = NULL;
-  gchar *prefix;
+  GStatBuf st;
   gchar line[512];
 
+  if (g_stat(sndstat, &st) == -1) {
+    g_debug("Failed to stat %s: %s", sndstat, g_strerror(errno));
+    return FALSE;
+  }
+
+  /* The parsed table is only refreshed when the file changes */
+  if (oss->priv->sndstat.valid == TRUE && oss->priv->sndstat.dev == st.st_dev &&
+      oss->priv->sndstat.ino == st.st_ino &&
+      oss->priv->sndstat.mtime == st.st_mtime)
+    return TRUE;
+
   fp = g_fopen(sndstat, "r");
   if (fp == NULL) {
     g_debug("Failed to open %s: %s", sndstat, g_strerror(errno));
-    return NULL;
+    return FALSE;
   }
 
+  g_hash_table_remove_all(oss->priv->sndstat.labels);
+
+  oss->priv->sndstat.default_index = -1;
+
   /* Example line:
    * pcm0: <ATI R6xx (HDMI)> (play) default */
-  prefix = g_strdup_printf("pcm%u: ", index);
-
   while (fgets(line, sizeof(line), fp) != NULL) {
     gchar *p;
+    gchar *end;
+    guint index;
+
+    if (g_str_has_prefix(line, "pcm") == FALSE) continue;
 
-    if (g_str_has_prefix(line, prefix) == FALSE) continue;
+    index = (guint)g_ascii_strtoull(line + sizeof("pcm") - 1, &end, 10);
+    if (end == line + sizeof("pcm") - 1 || *end != ':') continue;
 
-    p = strchr(line, '<');
+    p = strchr(end, '<');
     if (p != NULL && *p && *(++p)) {
-      gchar *end = strchr(p, '>');
+      end = strchr(p, '>');
 
       if (end != NULL) {
-        label = g_strndup(p, end - p);
-
-        /* Normally the default OSS device is /dev/dsp, but on FreeBSD
-         * /dev/dsp doesn't physically exist on the filesystem, but is
-         * managed by the kernel according to the user-settable default
-         * device, in sndstat the default card definition ends with the
-         * word "default" */
-        if (g_str_has_suffix(line, "default")) {
-          g_free(oss->priv->default_device);
-
-          oss->priv->default_device = g_strdup(path);
-        }
+        g_hash_table_replace(oss->priv->sndstat.labels, GUINT_TO_POINTER(index),
+                             g_strndup(p, end - p));
+
+        if (g_str_has_suffix(g_strchomp(line), "default"))
+          oss->priv->sndstat.default_index = (gint)index;
       } else {
         g_debug("Failed to read sndstat line: %s", line);
       }
-      break;
     }
   }
 
-  g_free(prefix);
   fclose(fp);
 
-  return label;
+  oss->priv->sndstat.dev = st.st_dev;
+  oss->priv->sndstat.ino = st.st_ino;
+  oss->priv->sndstat.mtime = st.st_mtime;
+  oss->priv->sndstat.valid = TRUE;
+  return TRUE;
 }
 
 static void add_device(OssBackend *oss, OssDevice *device) {
@@ -432,6 +594,86 @@ static void add_device(OssBackend *oss, OssDevice *device) {
   /* Load the device elements after emitting device-added, because the load
    * function will most likely emit stream-added on the device and backend */
   oss_device_load(device);
+
+  /* Otherwise the device will be handled in the next scheduled poll, which
+   * is never further away than the time the new device is due */
+  if (oss->priv->poll_source == NULL) schedule_poll(oss);
+}
+
+static gboolean poll_devices(OssBackend *oss) {
+  GSource *source;
+  GList *devices;
+  GList *list;
+  gint64 now;
+
+  now = g_get_monotonic_time();
+
+  /* Signal handlers may close the backend, which frees the device list,
+   * or remove devices from it, so iterate over a referenced copy */
+  source = oss->priv->poll_source;
+  devices = g_list_copy(oss->priv->devices);
+  g_list_foreach(devices, (GFunc)g_object_ref, NULL);
+
+  g_object_ref(oss);
+
+  for (list = devices; list != NULL; list = list->next) {
+    OssDevice *device = OSS_DEVICE(list->data);
+
+    /* Skip devices which have been removed in the meantime */
+    if (g_list_find(oss->priv->devices, device) == NULL) continue;
+
+    if (oss_device_get_poll_time(device) <= now + OSS_POLL_SLACK)
+      oss_device_poll(device, now);
+
+    /* The backend has been closed or the poll rescheduled by a signal
+     * handler, the source must not be touched anymore */
+    if (oss->priv->poll_source != source) break;
+  }
+
+  g_list_free_full(devices, g_object_unref);
+
+  if (oss->priv->poll_source == source) {
+    /* The next wakeup is scheduled according to the device which is due
+     * first */
+    g_source_unref(oss->priv->poll_source);
+    oss->priv->poll_source = NULL;
+
+    schedule_poll(oss);
+  }
+
+  g_object_unref(oss);
+  return G_SOURCE_REMOVE;
+}
+
+static void schedule_poll(OssBackend *oss) {
+  GList *list;
+  gint64 time = G_MAXINT64;
+  gint64 now;
+  guint interval = 0;
+
+  if (oss->priv->poll_source != NULL) {
+    g_source_destroy(oss->priv->poll_source);
+    g_source_unref(oss->priv->poll_source);
+    oss->priv->poll_source = NULL;
+  }
+
+  list = oss->priv->devices;
+  while (list != NULL) {
+    time = MIN(time, oss_device_get_poll_time(OSS_DEVICE(list->data)));
+
+    list = list->next;
+  }
+
+  /* Nothing to poll, the scheduler is started again when a device is added */
+  if (time == G_MAXINT64) return;
+
+  now = g_get_monotonic_time();
+  if (time > now) interval = (guint)((time - now) / G_TIME_SPAN_MILLISECOND);
+
+  oss->priv->poll_source = g_timeout_source_new(interval);
+  g_source_set_callback(oss->priv->poll_source, (GSourceFunc)poll_devices, oss,
+                        NULL);
+  g_source_attach(oss->priv->poll_source, g_main_context_get_thread_default());
 }
 
 static void remove_device(OssBackend *oss, OssDevice *device) {
@@ -580,6 +822,19 @@ static void free_stream_list(OssBackend *oss) {
   oss->priv->streams = NULL;
 }
 
+static guint get_device_index(const gchar *path) {
+  return (guint)g_ascii_strtoull(path + sizeof("/dev/mixer") - 1, NULL, 10);
+}
+
+static void free_device_label(OssDeviceLabel *label) {
+  g_free(label->label);
+  g_slice_free(OssDeviceLabel, label);
+}
+
+static void free_device_node(OssDeviceNode *node) {
+  g_slice_free(OssDeviceNode, node);
+}
+
 static gint compare_devices(gconstpointer a, gconstpointer b) {
   MateMixerDevice *d1 = MATE_MIXER_DEVICE(a);
   MateMixerDevice *d2 = MATE_MIXER_DEVICE(b);
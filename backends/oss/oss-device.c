@@ -178,8 +178,8 @@ struct _OssDevicePrivate {
   gint devmask;
   gint stereodevs;
   gint recmask;
-  guint poll_tag;
-  guint poll_tag_restore;
+  gint64 poll_time;
+  gint64 poll_rapid_until;
   guint poll_counter;
   gboolean poll_use_counter;
   OssPollMode poll_mode;
@@ -203,14 +203,10 @@ G_DEFINE_TYPE_WITH_PRIVATE(OssDevice, oss_device, MATE_MIXER_TYPE_DEVICE)
 
 static const GList *oss_device_list_streams(MateMixerDevice *mmd);
 
-static gboolean poll_mixer(OssDevice *device);
-static gboolean poll_mixer_restore(OssDevice *device);
-
 static void read_mixer_devices(OssDevice *device);
 static void read_mixer_switch(OssDevice *device);
 
-static guint create_poll_source(OssDevice *device, OssPollMode mode);
-static guint create_poll_restore_source(OssDevice *device);
+static void update_poll_time(OssDevice *device, gint64 now);
 
 static void free_stream_list(OssDevice *device);
 
@@ -357,11 +353,6 @@ void oss_device_close(OssDevice *device) {
     g_clear_object(&device->priv->output);
   }
 
-  if (device->priv->poll_tag != 0) g_source_remove(device->priv->poll_tag);
-
-  if (device->priv->poll_tag_restore != 0)
-    g_source_remove(device->priv->poll_tag_restore);
-
   close(device->priv->fd);
   device->priv->fd = -1;
 
@@ -458,8 +449,81 @@ void oss_device_load(OssDevice *device) {
    * This is not used on systems which don't support the modify_counter
    * field, because there is no way to find out whether anything has
    * changed and therefore when to start the rapid polling.
+   *
+   * The device doesn't poll by itself, the owner is expected to call
+   * oss_device_poll() once the time returned by oss_device_get_poll_time()
+   * is reached, which allows polling all the devices in a single wakeup.
    */
-  device->priv->poll_tag = create_poll_source(device, OSS_POLL_NORMAL);
+  device->priv->poll_mode = OSS_POLL_NORMAL;
+
+  update_poll_time(device, g_get_monotonic_time());
+}
+
+gboolean oss_device_poll(OssDevice *device, gint64 now) {
+  gboolean load = TRUE;
+
+  g_return_val_if_fail(OSS_IS_DEVICE(device), FALSE);
+
+  if (G_UNLIKELY(device->priv->fd == -1)) return FALSE;
+
+#ifdef SOUND_MIXER_INFO
+  if (device->priv->poll_use_counter == TRUE) {
+    gint ret;
+    struct mixer_info info;
+
+    /*
+     * The modify_counter field increases each time a change occurs on
+     * the device.
+     *
+     * If this ioctl() works, we use the field to only poll the controls
+     * if a change actually occured and we can also adjust the poll interval.
+     *
+     * The call is also used to detect unplugged devices early.
+     */
+    ret = ioctl(device->priv->fd, SOUND_MIXER_INFO, &info);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        update_poll_time(device, now);
+        return TRUE;
+      }
+
+      /* The owner may unref the device when it is closed */
+      oss_device_close(device);
+      return FALSE;
+    }
+
+    if (device->priv->poll_counter < info.modify_counter)
+      device->priv->poll_counter = info.modify_counter;
+    else
+      load = FALSE;
+  }
+#endif
+
+  if (load == TRUE) {
+    if (device->priv->input != NULL) oss_stream_load(device->priv->input);
+    if (device->priv->output != NULL) oss_stream_load(device->priv->output);
+
+    /* Poll rapidly until there has been no change for a while */
+    if (device->priv->poll_use_counter == TRUE) {
+      device->priv->poll_mode = OSS_POLL_RAPID;
+      device->priv->poll_rapid_until =
+          now + OSS_POLL_TIMEOUT_RESTORE * G_TIME_SPAN_MILLISECOND;
+    }
+  } else if (device->priv->poll_mode == OSS_POLL_RAPID &&
+             now >= device->priv->poll_rapid_until) {
+    device->priv->poll_mode = OSS_POLL_NORMAL;
+  }
+
+  update_poll_time(device, now);
+  return TRUE;
+}
+
+gint64 oss_device_get_poll_time(OssDevice *device) {
+  g_return_val_if_fail(OSS_IS_DEVICE(device), G_MAXINT64);
+
+  if (device->priv->fd == -1) return G_MAXINT64;
+
+  return device->priv->poll_time;
 }
 
 const gchar *oss_device_get_path(OssDevice *device) {
@@ -587,113 +651,20 @@ static void read_mixer_switch(OssDevice *device) {
                                g_list_reverse(options));
 }
 
-static gboolean poll_mixer(OssDevice *device) {
-  gboolean load = TRUE;
-
-  if (G_UNLIKELY(device->priv->fd == -1)) return G_SOURCE_REMOVE;
-
-#ifdef SOUND_MIXER_INFO
-  if (device->priv->poll_use_counter == TRUE) {
-    gint ret;
-    struct mixer_info info;
-
-    /*
-     * The modify_counter field increases each time a change occurs on
-     * the device.
-     *
-     * If this ioctl() works, we use the field to only poll the controls
-     * if a change actually occured and we can also adjust the poll interval.
-     *
-     * The call is also used to detect unplugged devices early.
-     */
-    ret = ioctl(device->priv->fd, SOUND_MIXER_INFO, &info);
-    if (ret == -1) {
-      if (errno == EINTR) return G_SOURCE_CONTINUE;
-
-      oss_device_close(device);
-      return G_SOURCE_REMOVE;
-    }
-
-    if (device->priv->poll_counter < info.modify_counter)
-      device->priv->poll_counter = info.modify_counter;
-    else
-      load = FALSE;
-  }
-#endif
-
-  if (load == TRUE) {
-    if (device->priv->input != NULL) oss_stream_load(device->priv->input);
-    if (device->priv->output != NULL) oss_stream_load(device->priv->output);
-
-    if (device->priv->poll_use_counter == TRUE &&
-        device->priv->poll_mode == OSS_POLL_NORMAL) {
-      /* Create a new rapid source */
-      device->priv->poll_tag = create_poll_source(device, OSS_POLL_RAPID);
-
-      /* Also create another source to restore the poll interval to the
-       * original state */
-      device->priv->poll_tag_restore = create_poll_restore_source(device);
-
-      device->priv->poll_mode = OSS_POLL_RAPID;
-      return G_SOURCE_REMOVE;
-    }
-  }
-  return G_SOURCE_CONTINUE;
-}
-
-static gboolean poll_mixer_restore(OssDevice *device) {
-  if (G_LIKELY(device->priv->poll_mode == OSS_POLL_RAPID)) {
-    /* Remove the current rapid source */
-    g_source_remove(device->priv->poll_tag);
-
-    device->priv->poll_tag = create_poll_source(device, OSS_POLL_NORMAL);
-    device->priv->poll_mode = OSS_POLL_NORMAL;
-  }
-
-  /* Remove the tag for this function as it is only called once, the tag
-   * is only kept so we can remove it in the case the device is closed */
-  device->priv->poll_tag_restore = 0;
-
-  return G_SOURCE_REMOVE;
-}
-
-static guint create_poll_source(OssDevice *device, OssPollMode mode) {
-  GSource *source;
-  guint timeout;
-  guint tag;
-
-  switch (mode) {
+static void update_poll_time(OssDevice *device, gint64 now) {
+  switch (device->priv->poll_mode) {
     case OSS_POLL_NORMAL:
-      timeout = OSS_POLL_TIMEOUT_NORMAL;
+      device->priv->poll_time =
+          now + OSS_POLL_TIMEOUT_NORMAL * G_TIME_SPAN_MILLISECOND;
       break;
     case OSS_POLL_RAPID:
-      timeout = OSS_POLL_TIMEOUT_RAPID;
+      device->priv->poll_time =
+          now + OSS_POLL_TIMEOUT_RAPID * G_TIME_SPAN_MILLISECOND;
       break;
     default:
       g_warn_if_reached();
-      return 0;
+      break;
   }
-
-  source = g_timeout_source_new(timeout);
-  g_source_set_callback(source, (GSourceFunc)poll_mixer, device, NULL);
-
-  tag = g_source_attach(source, g_main_context_get_thread_default());
-  g_source_unref(source);
-
-  return tag;
-}
-
-static guint create_poll_restore_source(OssDevice *device) {
-  GSource *source;
-  guint tag;
-
-  source = g_timeout_source_new(OSS_POLL_TIMEOUT_RESTORE);
-  g_source_set_callback(source, (GSourceFunc)poll_mixer_restore, device, NULL);
-
-  tag = g_source_attach(source, g_main_context_get_thread_default());
-  g_source_unref(source);
-
-  return tag;
 }
 
 static void free_stream_list(OssDevice *device) {
@@ -64,6 +64,9 @@ void oss_device_close(OssDevice *device);
 
 void oss_device_load(OssDevice *device);
 
+gboolean oss_device_poll(OssDevice *device, gint64 now);
+gint64 oss_device_get_poll_time(OssDevice *device);
+
 const gchar *oss_device_get_path(OssDevice *device);
 
 OssStream *oss_device_get_input_stream(OssDevice *device);
@@ -0,0 +1,43 @@
+#!/bin/sh
+# Count the main loop wakeups of an idle OSS backend with one and with several
+# simulated mixer devices open.
+#
+# All the devices are polled from a single scheduler, so the number of wakeups
+# should stay about the same regardless of the number of mixers. With a timer
+# per device, each mixer would add at least two wakeups per second.
+
+test -z "$MATEMIXER_BENCH" && MATEMIXER_BENCH=./oss-bench
+
+# Usage: run_bench MIXERS
+run_bench() {
+    report=`env MATE_MIXER_OSS_FAKE_MIXERS=$1 \
+        $MATEMIXER_BENCH --backend=oss --format=csv \
+        --duration=3 --iterations=0` || {
+        echo "FAIL: matemixer-bench exited with an error" >&2
+        exit 1
+    }
+
+    devices=`echo "$report" | grep '^objects,OssDevice.count,' | \
+        cut -d, -f3 | cut -d. -f1`
+    if test "${devices:-0}" != "$1"; then
+        echo "FAIL: expected $1 devices, found ${devices:-0}" >&2
+        exit 1
+    fi
+
+    echo "$report" | grep '^wakeups,main-loop,' | cut -d, -f3
+}
+
+single=`run_bench 1` || exit 1
+several=`run_bench 16` || exit 1
+
+echo "mixers=1 wakeups=$single/s"
+echo "mixers=16 wakeups=$several/s"
+
+# Allow for some noise, but far less than the two wakeups per second each of
+# the additional mixers would cost
+if awk "BEGIN { exit !($several <= $single * 1.5 + 1) }"; then
+    echo "PASS: wakeups"
+else
+    echo "FAIL: wakeups grow with the number of mixers"
+    exit 1
+fi
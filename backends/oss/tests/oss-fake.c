@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "oss-fake.h"
+
+/* The simulated devices are backed by the real functions */
+#undef g_open
+#undef g_stat
+#undef fstat
+#undef dup
+#undef close
+#undef ioctl
+
+/* Number of simulated mixer devices, they appear as /dev/mixer0 and up, the
+ * real mixer devices are hidden from the backend */
+#define OSS_FAKE_ENV_MIXERS "MATE_MIXER_OSS_FAKE_MIXERS"
+
+/* Same as the number of devices probed by the backend */
+#define OSS_FAKE_MAX_MIXERS 32
+
+#define OSS_FAKE_PATH "/dev/mixer"
+
+#define OSS_FAKE_DEVMASK                                                   \
+  (SOUND_MASK_VOLUME | SOUND_MASK_PCM | SOUND_MASK_LINE | SOUND_MASK_MIC | \
+   SOUND_MASK_CD)
+#define OSS_FAKE_STEREODEVS \
+  (SOUND_MASK_VOLUME | SOUND_MASK_PCM | SOUND_MASK_LINE | SOUND_MASK_CD)
+#define OSS_FAKE_RECMASK (SOUND_MASK_LINE | SOUND_MASK_MIC | SOUND_MASK_CD)
+
+typedef struct {
+  gint volume[SOUND_MIXER_NRDEVICES];
+  gint recsrc;
+  gint modify_counter;
+} OssFakeMixer;
+
+static OssFakeMixer *mixers = NULL;
+static guint n_mixers = 0;
+
+/* Descriptors opened for the simulated devices and their mixer indices */
+static GHashTable *descriptors = NULL;
+
+static void init_mixers(void);
+
+static gboolean is_mixer_path(const gchar *path);
+
+static OssFakeMixer *get_mixer_by_path(const gchar *path, guint *index);
+static OssFakeMixer *get_mixer_by_fd(gint fd, guint *index);
+
+static void fill_stat(guint index, struct stat *buf);
+
+gint oss_fake_open(const gchar *path, gint flags, gint mode) {
+  guint index;
+  gint fd;
+
+  if (is_mixer_path(path) == FALSE) return open(path, flags, mode);
+
+  if (get_mixer_by_path(path, &index) == NULL) {
+    errno = ENOENT;
+    return -1;
+  }
+
+  /* A real descriptor keeps the numbers unique, the calls made on it are
+   * answered by the simulated mixer */
+  fd = open("/dev/null", O_RDWR);
+  if (fd != -1)
+    g_hash_table_insert(descriptors, GINT_TO_POINTER(fd),
+                        GUINT_TO_POINTER(index));
+  return fd;
+}
+
+gint oss_fake_stat(const gchar *path, GStatBuf *buf) {
+  guint index;
+
+  if (is_mixer_path(path) == FALSE) return stat(path, buf);
+
+  if (get_mixer_by_path(path, &index) == NULL) {
+    errno = ENOENT;
+    return -1;
+  }
+
+  fill_stat(index, buf);
+  return 0;
+}
+
+gint oss_fake_fstat(gint fd, struct stat *buf) {
+  guint index;
+
+  if (get_mixer_by_fd(fd, &index) == NULL) return fstat(fd, buf);
+
+  fill_stat(index, buf);
+  return 0;
+}
+
+gint oss_fake_dup(gint fd) {
+  guint index;
+  gint newfd;
+
+  newfd = dup(fd);
+  if (newfd != -1 && get_mixer_by_fd(fd, &index) != NULL)
+    g_hash_table_insert(descriptors, GINT_TO_POINTER(newfd),
+                        GUINT_TO_POINTER(index));
+  return newfd;
+}
+
+gint oss_fake_close(gint fd) {
+  init_mixers();
+
+  g_hash_table_remove(descriptors, GINT_TO_POINTER(fd));
+  return close(fd);
+}
+
+gint oss_fake_ioctl(gint fd, gulong request, gpointer arg) {
+  OssFakeMixer *mixer;
+  guint index;
+  gint *value = arg;
+  gint i;
+
+  mixer = get_mixer_by_fd(fd, &index);
+  if (mixer == NULL) return ioctl(fd, request, arg);
+
+  if (request == MIXER_READ(SOUND_MIXER_DEVMASK)) {
+    *value = OSS_FAKE_DEVMASK;
+    return 0;
+  }
+  if (request == MIXER_READ(SOUND_MIXER_STEREODEVS)) {
+    *value = OSS_FAKE_STEREODEVS;
+    return 0;
+  }
+  if (request == MIXER_READ(SOUND_MIXER_RECMASK)) {
+    *value = OSS_FAKE_RECMASK;
+    return 0;
+  }
+  if (request == MIXER_READ(SOUND_MIXER_RECSRC)) {
+    *value = mixer->recsrc;
+    return 0;
+  }
+  if (request == MIXER_WRITE(SOUND_MIXER_RECSRC)) {
+    mixer->recsrc = *value & OSS_FAKE_RECMASK;
+    mixer->modify_counter++;
+    return 0;
+  }
+
+#ifdef SOUND_MIXER_INFO
+  if (request == SOUND_MIXER_INFO) {
+    struct mixer_info *info = arg;
+
+    memset(info, 0, sizeof(*info));
+
+    g_strlcpy(info->id, "fake", sizeof(info->id));
+    g_snprintf(info->name, sizeof(info->name), "Simulated Mixer %u", index);
+
+    info->modify_counter = mixer->modify_counter;
+    return 0;
+  }
+#endif
+
+  for (i = 0; i < SOUND_MIXER_NRDEVICES; i++) {
+    gint left, right;
+
+    if ((OSS_FAKE_DEVMASK & (1 << i)) == 0) continue;
+
+    if (request == MIXER_READ(i)) {
+      *value = mixer->volume[i];
+      return 0;
+    }
+    if (request == MIXER_WRITE(i)) {
+      left = MIN(*value & 0xFF, 100);
+      right = MIN((*value >> 8) & 0xFF, 100);
+
+      if ((OSS_FAKE_STEREODEVS & (1 << i)) == 0) right = left;
+
+      /* The device reports back the volume it has set */
+      *value = mixer->volume[i] = left | (right << 8);
+
+      mixer->modify_counter++;
+      return 0;
+    }
+  }
+
+  errno = EINVAL;
+  return -1;
+}
+
+static void init_mixers(void) {
+  const gchar *str;
+  guint i, j;
+
+  if (descriptors != NULL) return;
+
+  str = g_getenv(OSS_FAKE_ENV_MIXERS);
+  if (str != NULL)
+    n_mixers = (guint)MIN(g_ascii_strtoull(str, NULL, 10),
+                          OSS_FAKE_MAX_MIXERS);
+
+  mixers = g_new0(OssFakeMixer, n_mixers);
+
+  for (i = 0; i < n_mixers; i++) {
+    for (j = 0; j < SOUND_MIXER_NRDEVICES; j++)
+      mixers[i].volume[j] = 75 | (75 << 8);
+
+    mixers[i].recsrc = SOUND_MASK_MIC;
+  }
+
+  descriptors = g_hash_table_new(g_direct_hash, g_direct_equal);
+}
+
+static gboolean is_mixer_path(const gchar *path) {
+  return g_str_has_prefix(path, OSS_FAKE_PATH);
+}
+
+static OssFakeMixer *get_mixer_by_path(const gchar *path, guint *index) {
+  const gchar *number;
+  gchar *end;
+  guint64 n = 0;
+
+  init_mixers();
+
+  /* The device without a number is the first device */
+  number = path + strlen(OSS_FAKE_PATH);
+  if (*number != '\0') {
+    n = g_ascii_strtoull(number, &end, 10);
+    if (end == number || *end != '\0') return NULL;
+  }
+
+  if (n >= n_mixers) return NULL;
+
+  *index = (guint)n;
+  return &mixers[n];
+}
+
+static OssFakeMixer *get_mixer_by_fd(gint fd, guint *index) {
+  gpointer value;
+
+  init_mixers();
+
+  if (g_hash_table_lookup_extended(descriptors, GINT_TO_POINTER(fd), NULL,
+                                   &value) == FALSE)
+    return NULL;
+
+  *index = GPOINTER_TO_UINT(value);
+  return &mixers[*index];
+}
+
+static void fill_stat(guint index, struct stat *buf) {
+  memset(buf, 0, sizeof(*buf));
+
+  buf->st_mode = S_IFCHR | 0666;
+  buf->st_rdev = (dev_t)(index + 1);
+  buf->st_ino = (ino_t)(index + 1);
+}
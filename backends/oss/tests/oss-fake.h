@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OSS_FAKE_H
+#define OSS_FAKE_H
+
+/* This header is included in front of every source file of the OSS backend
+ * built for the checks, it redirects the system calls made by the backend to
+ * the simulated mixer devices in oss-fake.c */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "oss-common.h"
+
+G_BEGIN_DECLS
+
+#undef g_open
+#undef g_stat
+#undef ioctl
+
+#define g_open(path, flags, mode) oss_fake_open(path, flags, mode)
+#define g_stat(path, buf) oss_fake_stat(path, buf)
+#define fstat(fd, buf) oss_fake_fstat(fd, buf)
+#define dup(fd) oss_fake_dup(fd)
+#define close(fd) oss_fake_close(fd)
+#define ioctl(fd, request, arg) oss_fake_ioctl(fd, request, arg)
+
+gint oss_fake_open(const gchar *path, gint flags, gint mode);
+gint oss_fake_stat(const gchar *path, GStatBuf *buf);
+gint oss_fake_fstat(gint fd, struct stat *buf);
+gint oss_fake_dup(gint fd);
+gint oss_fake_close(gint fd);
+gint oss_fake_ioctl(gint fd, gulong request, gpointer arg);
+
+G_END_DECLS
+
+#endif /* OSS_FAKE_H */
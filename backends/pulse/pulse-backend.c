@@ -43,14 +43,30 @@
    MATE_MIXER_BACKEND_CAN_SET_DEFAULT_INPUT_STREAM | \
    MATE_MIXER_BACKEND_CAN_SET_DEFAULT_OUTPUT_STREAM)
 
+#define RECONNECT_DELAY_MIN 200
+#define RECONNECT_DELAY_MAX 10000
+#define RECONNECT_GRACE_PERIOD 2000
+
 struct _PulseBackendPrivate {
   guint connect_tag;
+  guint grace_tag;
+  guint reconnect_delay;
+  gboolean reconnecting;
   gboolean connected_once;
   GHashTable *devices;
   GHashTable *sinks;
   GHashTable *sources;
+  GHashTable *stale_devices;
+  GHashTable *stale_sinks;
+  GHashTable *stale_sources;
   GHashTable *sink_input_map;
   GHashTable *source_output_map;
+  GHashTable *young_sink_inputs;
+  GHashTable *young_source_outputs;
+  guint min_control_lifetime;
+  MateMixerLoadingFlags loading_flags;
+  gboolean ext_streams_requested;
+  MateMixerInterestFlags interests;
   GHashTable *ext_streams;
   GList *devices_list;
   GList *streams_list;
@@ -60,6 +76,15 @@ struct _PulseBackendPrivate {
   PulseConnection *connection;
 };
 
+/* A sink input or source output which has not yet existed for the minimum
+ * control lifetime, the source is NULL once it has */
+typedef struct {
+  PulseBackend *pulse;
+  guint32 index;
+  gboolean sink_input;
+  GSource *source;
+} PulseYoungControl;
+
 #define PULSE_CHANGE_STATE(p, s) \
   (_mate_mixer_backend_set_state(MATE_MIXER_BACKEND(p), (s)))
 #define PULSE_GET_DEFAULT_SINK(p) \
@@ -120,10 +145,19 @@ static void pulse_backend_set_app_info(MateMixerBackend *backend,
 static void pulse_backend_set_server_address(MateMixerBackend *backend,
                                              const gchar *address);
 
+static void pulse_backend_set_loading_flags(MateMixerBackend *backend,
+                                            MateMixerLoadingFlags flags);
+static void pulse_backend_set_min_control_lifetime(MateMixerBackend *backend,
+                                                   guint lifetime);
+static void pulse_backend_set_interests(MateMixerBackend *backend,
+                                        MateMixerInterestFlags interests);
+
 static const GList *pulse_backend_list_devices(MateMixerBackend *backend);
 static const GList *pulse_backend_list_streams(MateMixerBackend *backend);
 static const GList *pulse_backend_list_stored_controls(
     MateMixerBackend *backend);
+static GList *pulse_backend_list_loaded_stored_controls(
+    MateMixerBackend *backend);
 
 static gboolean pulse_backend_set_default_input_stream(
     MateMixerBackend *backend, MateMixerStream *stream);
@@ -171,17 +205,36 @@ static void on_connection_ext_stream_loaded(PulseConnection *connection,
 static void on_connection_ext_stream_info(
     PulseConnection *connection, const pa_ext_stream_restore_info *info,
     PulseBackend *pulse);
+static void on_connection_lists_loaded(PulseConnection *connection,
+                                       PulseBackend *pulse);
 
+static void schedule_reconnect(PulseBackend *pulse);
 static gboolean source_try_connect(PulseBackend *pulse);
+static gboolean source_grace_expired(PulseBackend *pulse);
+static void leave_grace_period(PulseBackend *pulse);
+
+static void mark_stale(PulseBackend *pulse);
+static PulseDevice *restore_device(PulseBackend *pulse,
+                                   const pa_card_info *info);
+static PulseStream *restore_stream(PulseBackend *pulse, GHashTable *stale,
+                                   GHashTable *table, const gchar *name,
+                                   guint32 index);
 
 static void check_pending_sink(PulseBackend *pulse, PulseStream *stream);
 static void check_pending_source(PulseBackend *pulse, PulseStream *stream);
 
+static void remove_stream(PulseBackend *pulse, PulseStream *stream);
+
 static void remove_sink_input(PulseBackend *backend, PulseSink *sink,
                               guint index);
 static void remove_source_output(PulseBackend *backend, PulseSource *source,
                                  guint index);
 
+static gboolean hold_young_control(PulseBackend *pulse, GHashTable *table,
+                                   guint32 index, gboolean sink_input);
+static gboolean young_control_timeout(PulseYoungControl *young);
+static void free_young_control(PulseYoungControl *young);
+
 static void free_list_devices(PulseBackend *pulse);
 static void free_list_streams(PulseBackend *pulse);
 static void free_list_ext_streams(PulseBackend *pulse);
@@ -214,11 +267,17 @@ static void pulse_backend_class_init(PulseBackendClass *klass) {
   backend_class = MATE_MIXER_BACKEND_CLASS(klass);
   backend_class->set_app_info = pulse_backend_set_app_info;
   backend_class->set_server_address = pulse_backend_set_server_address;
+  backend_class->set_loading_flags = pulse_backend_set_loading_flags;
+  backend_class->set_min_control_lifetime =
+      pulse_backend_set_min_control_lifetime;
+  backend_class->set_interests = pulse_backend_set_interests;
   backend_class->open = pulse_backend_open;
   backend_class->close = pulse_backend_close;
   backend_class->list_devices = pulse_backend_list_devices;
   backend_class->list_streams = pulse_backend_list_streams;
   backend_class->list_stored_controls = pulse_backend_list_stored_controls;
+  backend_class->list_loaded_stored_controls =
+      pulse_backend_list_loaded_stored_controls;
   backend_class->set_default_input_stream =
       pulse_backend_set_default_input_stream;
   backend_class->set_default_output_stream =
@@ -230,6 +289,7 @@ static void pulse_backend_class_finalize(PulseBackendClass *klass) {}
 
 static void pulse_backend_init(PulseBackend *pulse) {
   pulse->priv = pulse_backend_get_instance_private(pulse);
+  pulse->priv->interests = MATE_MIXER_INTEREST_ALL;
 
   /* These hash tables store PulseDevice and PulseStream instances */
   pulse->priv->devices = g_hash_table_new_full(g_direct_hash, g_direct_equal,
@@ -239,6 +299,15 @@ static void pulse_backend_init(PulseBackend *pulse) {
   pulse->priv->sources = g_hash_table_new_full(g_direct_hash, g_direct_equal,
                                                NULL, g_object_unref);
 
+  /* These hash tables store devices and streams kept from a lost connection
+   * under their names until they are found again */
+  pulse->priv->stale_devices =
+      g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_object_unref);
+  pulse->priv->stale_sinks =
+      g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_object_unref);
+  pulse->priv->stale_sources =
+      g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_object_unref);
+
   pulse->priv->ext_streams =
       g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
 
@@ -246,6 +315,14 @@ static void pulse_backend_init(PulseBackend *pulse) {
       g_direct_hash, g_direct_equal, NULL, g_object_unref);
   pulse->priv->source_output_map = g_hash_table_new_full(
       g_direct_hash, g_direct_equal, NULL, g_object_unref);
+
+  /* These hash tables store PulseYoungControl instances */
+  pulse->priv->young_sink_inputs =
+      g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                            (GDestroyNotify)free_young_control);
+  pulse->priv->young_source_outputs =
+      g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                            (GDestroyNotify)free_young_control);
 }
 
 static void pulse_backend_dispose(GObject *object) {
@@ -266,14 +343,19 @@ static void pulse_backend_finalize(GObject *object) {
   pulse = PULSE_BACKEND(object);
 
   if (pulse->priv->app_info != NULL)
-    _mate_mixer_app_info_free(pulse->priv->app_info);
+    _mate_mixer_app_info_unref(pulse->priv->app_info);
 
   g_hash_table_unref(pulse->priv->devices);
   g_hash_table_unref(pulse->priv->sinks);
   g_hash_table_unref(pulse->priv->sources);
+  g_hash_table_unref(pulse->priv->stale_devices);
+  g_hash_table_unref(pulse->priv->stale_sinks);
+  g_hash_table_unref(pulse->priv->stale_sources);
   g_hash_table_unref(pulse->priv->ext_streams);
   g_hash_table_unref(pulse->priv->sink_input_map);
   g_hash_table_unref(pulse->priv->source_output_map);
+  g_hash_table_unref(pulse->priv->young_sink_inputs);
+  g_hash_table_unref(pulse->priv->young_source_outputs);
 
   G_OBJECT_CLASS(pulse_backend_parent_class)->finalize(object);
 }
@@ -309,6 +391,21 @@ static gboolean pulse_backend_open(MateMixerBackend *backend) {
     return FALSE;
   }
 
+  /* In the progressive mode the backend becomes ready as soon as the server
+   * information is known and the rest is published as it arrives */
+  pulse_connection_set_progressive(
+      connection, (pulse->priv->loading_flags & MATE_MIXER_LOADING_PROGRESSIVE)
+                      ? TRUE
+                      : FALSE);
+  pulse_connection_set_lazy_ext_streams(
+      connection,
+      (pulse->priv->loading_flags & MATE_MIXER_LOADING_LAZY_STORED_CONTROLS)
+          ? TRUE
+          : FALSE);
+
+  /* Subscriptions and initial lists are narrowed to the objects of interest */
+  pulse_connection_set_interests(connection, pulse->priv->interests);
+
   g_signal_connect(G_OBJECT(connection), "notify::state",
                    G_CALLBACK(on_connection_state_notify), pulse);
   g_signal_connect(G_OBJECT(connection), "server-info",
@@ -337,6 +434,8 @@ static gboolean pulse_backend_open(MateMixerBackend *backend) {
                    G_CALLBACK(on_connection_ext_stream_loading), pulse);
   g_signal_connect(G_OBJECT(connection), "ext-stream-loaded",
                    G_CALLBACK(on_connection_ext_stream_loaded), pulse);
+  g_signal_connect(G_OBJECT(connection), "lists-loaded",
+                   G_CALLBACK(on_connection_lists_loaded), pulse);
   g_signal_connect(G_OBJECT(connection), "ext-stream-info",
                    G_CALLBACK(on_connection_ext_stream_info), pulse);
 
@@ -365,6 +464,10 @@ static void pulse_backend_close(MateMixerBackend *backend) {
     g_source_remove(pulse->priv->connect_tag);
     pulse->priv->connect_tag = 0;
   }
+  if (pulse->priv->grace_tag != 0) {
+    g_source_remove(pulse->priv->grace_tag);
+    pulse->priv->grace_tag = 0;
+  }
 
   if (pulse->priv->connection != NULL) {
     g_signal_handlers_disconnect_by_data(G_OBJECT(pulse->priv->connection),
@@ -380,11 +483,19 @@ static void pulse_backend_close(MateMixerBackend *backend) {
   g_hash_table_remove_all(pulse->priv->devices);
   g_hash_table_remove_all(pulse->priv->sinks);
   g_hash_table_remove_all(pulse->priv->sources);
+  g_hash_table_remove_all(pulse->priv->stale_devices);
+  g_hash_table_remove_all(pulse->priv->stale_sinks);
+  g_hash_table_remove_all(pulse->priv->stale_sources);
   g_hash_table_remove_all(pulse->priv->ext_streams);
   g_hash_table_remove_all(pulse->priv->sink_input_map);
   g_hash_table_remove_all(pulse->priv->source_output_map);
+  g_hash_table_remove_all(pulse->priv->young_sink_inputs);
+  g_hash_table_remove_all(pulse->priv->young_source_outputs);
 
   pulse->priv->connected_once = FALSE;
+  pulse->priv->reconnecting = FALSE;
+  pulse->priv->reconnect_delay = 0;
+  pulse->priv->ext_streams_requested = FALSE;
 
   PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_IDLE);
 }
@@ -399,7 +510,7 @@ static void pulse_backend_set_app_info(MateMixerBackend *backend,
   pulse = PULSE_BACKEND(backend);
 
   if (pulse->priv->app_info != NULL)
-    _mate_mixer_app_info_free(pulse->priv->app_info);
+    _mate_mixer_app_info_unref(pulse->priv->app_info);
 
   pulse->priv->app_info = _mate_mixer_app_info_copy(info);
 }
@@ -413,6 +524,36 @@ static void pulse_backend_set_server_address(MateMixerBackend *backend,
   PULSE_BACKEND(backend)->priv->server_address = g_strdup(address);
 }
 
+static void pulse_backend_set_loading_flags(MateMixerBackend *backend,
+                                            MateMixerLoadingFlags flags) {
+  g_return_if_fail(PULSE_IS_BACKEND(backend));
+
+  PULSE_BACKEND(backend)->priv->loading_flags = flags;
+}
+
+static void pulse_backend_set_min_control_lifetime(MateMixerBackend *backend,
+                                                   guint lifetime) {
+  g_return_if_fail(PULSE_IS_BACKEND(backend));
+
+  PULSE_BACKEND(backend)->priv->min_control_lifetime = lifetime;
+}
+
+static void pulse_backend_set_interests(MateMixerBackend *backend,
+                                        MateMixerInterestFlags interests) {
+  PulseBackend *pulse;
+
+  g_return_if_fail(PULSE_IS_BACKEND(backend));
+
+  pulse = PULSE_BACKEND(backend);
+
+  pulse->priv->interests = interests;
+
+  /* The connection only widens the interests while connected and loads the
+   * newly requested objects */
+  if (pulse->priv->connection != NULL)
+    pulse_connection_set_interests(pulse->priv->connection, interests);
+}
+
 static const GList *pulse_backend_list_devices(MateMixerBackend *backend) {
   PulseBackend *pulse;
 
@@ -421,7 +562,11 @@ static const GList *pulse_backend_list_devices(MateMixerBackend *backend) {
   pulse = PULSE_BACKEND(backend);
 
   if (pulse->priv->devices_list == NULL) {
-    pulse->priv->devices_list = g_hash_table_get_values(pulse->priv->devices);
+    /* Devices kept from a lost connection are listed until they are either
+     * found again or removed */
+    pulse->priv->devices_list =
+        g_list_concat(g_hash_table_get_values(pulse->priv->devices),
+                      g_hash_table_get_values(pulse->priv->stale_devices));
     if (pulse->priv->devices_list != NULL)
       g_list_foreach(pulse->priv->devices_list, (GFunc)g_object_ref, NULL);
   }
@@ -439,10 +584,13 @@ static const GList *pulse_backend_list_streams(MateMixerBackend *backend) {
     GList *sinks;
     GList *sources;
 
-    sinks = g_hash_table_get_values(pulse->priv->sinks);
+    sinks = g_list_concat(g_hash_table_get_values(pulse->priv->sinks),
+                          g_hash_table_get_values(pulse->priv->stale_sinks));
     if (sinks != NULL) g_list_foreach(sinks, (GFunc)g_object_ref, NULL);
 
-    sources = g_hash_table_get_values(pulse->priv->sources);
+    sources =
+        g_list_concat(g_hash_table_get_values(pulse->priv->sources),
+                      g_hash_table_get_values(pulse->priv->stale_sources));
     if (sources != NULL) g_list_foreach(sources, (GFunc)g_object_ref, NULL);
 
     pulse->priv->streams_list = g_list_concat(sinks, sources);
@@ -458,6 +606,13 @@ static const GList *pulse_backend_list_stored_controls(
 
   pulse = PULSE_BACKEND(backend);
 
+  /* A lazily loaded stream-restore database is read on the first request,
+   * the stored controls are then announced as they arrive */
+  if ((pulse->priv->loading_flags & MATE_MIXER_LOADING_LAZY_STORED_CONTROLS) &&
+      pulse->priv->ext_streams_requested == FALSE)
+    pulse->priv->ext_streams_requested =
+        pulse_connection_load_ext_stream_info(pulse->priv->connection);
+
   if (pulse->priv->ext_streams_list == NULL) {
     pulse->priv->ext_streams_list =
         g_hash_table_get_values(pulse->priv->ext_streams);
@@ -467,6 +622,14 @@ static const GList *pulse_backend_list_stored_controls(
   return pulse->priv->ext_streams_list;
 }
 
+static GList *pulse_backend_list_loaded_stored_controls(
+    MateMixerBackend *backend) {
+  g_return_val_if_fail(PULSE_IS_BACKEND(backend), NULL);
+
+  /* Unlike listing the stored controls, never requests the database */
+  return g_hash_table_get_values(PULSE_BACKEND(backend)->priv->ext_streams);
+}
+
 static gboolean pulse_backend_set_default_input_stream(
     MateMixerBackend *backend, MateMixerStream *stream) {
   PulseBackend *pulse;
@@ -517,28 +680,45 @@ static void on_connection_state_notify(PulseConnection *connection,
   switch (state) {
     case PULSE_CONNECTION_DISCONNECTED:
       if (pulse->priv->connected_once == TRUE) {
-        /* We managed to connect once before, try to reconnect and if it
-         * fails immediately, use a timeout source.
-         * All current devices and streams are marked as hanging as it is
-         * unknown whether they are still available.
-         * Stream callbacks will unmark available streams and remaining
-         * unavailable streams will be removed when the CONNECTED state
-         * is reached. */
-        PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_CONNECTING);
+        /* We managed to connect once before, so try to reconnect,
+         * immediately for the first time and then with an increasing delay.
+         * The READY state is kept while the first attempt is in progress,
+         * but at most for a short grace period, so that a quick restart of
+         * the sound server is not noticed by the user; afterwards the state
+         * falls back to CONNECTING until the connection is restored.
+         * All current devices and streams are kept as it is unknown whether
+         * they are still available, the info callbacks match them with
+         * the new lists and the remaining ones are removed when the lists
+         * are loaded */
+        mark_stale(pulse);
+
+        /* Controls which have not been reported yet are forgotten, those
+         * still present are reported when the state is loaded again */
+        g_hash_table_remove_all(pulse->priv->young_sink_inputs);
+        g_hash_table_remove_all(pulse->priv->young_source_outputs);
 
         if (G_UNLIKELY(pulse->priv->connect_tag != 0)) break;
 
-        if (pulse_connection_connect(connection, TRUE) == FALSE) {
+        if (pulse->priv->reconnecting == FALSE) {
           GSource *source;
 
-          source = g_timeout_source_new(200);
-          g_source_set_callback(source, (GSourceFunc)source_try_connect, pulse,
-                                NULL);
-          pulse->priv->connect_tag =
-              g_source_attach(source, g_main_context_get_thread_default());
+          pulse->priv->reconnecting = TRUE;
 
+          source = g_timeout_source_new(RECONNECT_GRACE_PERIOD);
+          g_source_set_callback(source, (GSourceFunc)source_grace_expired,
+                                pulse, NULL);
+          pulse->priv->grace_tag =
+              g_source_attach(source, g_main_context_get_thread_default());
           g_source_unref(source);
+
+          if (pulse_connection_connect(connection, TRUE) == TRUE) break;
         }
+
+        /* The first attempt has failed */
+        leave_grace_period(pulse);
+
+        PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_CONNECTING);
+        schedule_reconnect(pulse);
         break;
       }
 
@@ -549,11 +729,16 @@ static void on_connection_state_notify(PulseConnection *connection,
     case PULSE_CONNECTION_CONNECTING:
     case PULSE_CONNECTION_AUTHORIZING:
     case PULSE_CONNECTION_LOADING:
-      PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_CONNECTING);
+      if (pulse->priv->connected_once == FALSE)
+        PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_CONNECTING);
       break;
 
     case PULSE_CONNECTION_CONNECTED:
       pulse->priv->connected_once = TRUE;
+      pulse->priv->reconnecting = FALSE;
+      pulse->priv->reconnect_delay = 0;
+
+      leave_grace_period(pulse);
 
       PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_READY);
       break;
@@ -650,6 +835,8 @@ static void on_connection_card_info(PulseConnection *connection,
 
   device =
       g_hash_table_lookup(pulse->priv->devices, GUINT_TO_POINTER(info->index));
+  if (device == NULL) device = restore_device(pulse, info);
+
   if (device == NULL) {
     device = pulse_device_new(connection, info);
 
@@ -686,6 +873,7 @@ static void on_connection_sink_info(PulseConnection *connection,
                                     PulseBackend *pulse) {
   PulseDevice *device = NULL;
   PulseStream *stream;
+  gboolean restored = FALSE;
 
   if (info->card != PA_INVALID_INDEX)
     device =
@@ -693,9 +881,23 @@ static void on_connection_sink_info(PulseConnection *connection,
 
   stream =
       g_hash_table_lookup(pulse->priv->sinks, GUINT_TO_POINTER(info->index));
+  if (stream == NULL) {
+    stream = restore_stream(pulse, pulse->priv->stale_sinks, pulse->priv->sinks,
+                            info->name, info->index);
+    if (stream != NULL) restored = TRUE;
+  }
+
   if (stream == NULL) {
     stream = PULSE_STREAM(pulse_sink_new(connection, info, device));
 
+    /* Lazy application controls are only created on demand */
+    pulse_sink_set_lazy_controls(
+        PULSE_SINK(stream),
+        (pulse->priv->loading_flags &
+         MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS)
+            ? TRUE
+            : FALSE);
+
     g_hash_table_insert(pulse->priv->sinks, GUINT_TO_POINTER(info->index),
                         stream);
 
@@ -712,14 +914,17 @@ static void on_connection_sink_info(PulseConnection *connection,
     }
     /* We might be waiting for this sink to set it as the default */
     check_pending_sink(pulse, stream);
-  } else
+  } else {
     pulse_sink_update(PULSE_SINK(stream), info);
+
+    /* The monitor source index is known after the update */
+    if (restored == TRUE) pulse_sink_reset_monitor(PULSE_SINK(stream));
+  }
 }
 
 static void on_connection_sink_removed(PulseConnection *connection, guint idx,
                                        PulseBackend *pulse) {
   PulseStream *stream;
-  PulseDevice *device;
 
   stream = g_hash_table_lookup(pulse->priv->sinks, GUINT_TO_POINTER(idx));
   if (G_UNLIKELY(stream == NULL)) return;
@@ -727,28 +932,8 @@ static void on_connection_sink_removed(PulseConnection *connection, guint idx,
   g_object_ref(stream);
 
   g_hash_table_remove(pulse->priv->sinks, GUINT_TO_POINTER(idx));
-  free_list_streams(pulse);
-
-  device = pulse_stream_get_device(stream);
-  if (device != NULL) {
-    pulse_device_remove_stream(device, stream);
-  } else {
-    g_signal_emit_by_name(
-        G_OBJECT(pulse), "stream-removed",
-        mate_mixer_stream_get_name(MATE_MIXER_STREAM(stream)));
-  }
+  remove_stream(pulse, stream);
 
-  /* The removed stream might be one of the default streams, this happens
-   * especially when switching profiles, after which PulseAudio removes the
-   * old streams and creates new ones with different names */
-  if (MATE_MIXER_STREAM(stream) == PULSE_GET_DEFAULT_SINK(pulse)) {
-    PULSE_SET_DEFAULT_SINK(pulse, NULL);
-
-    /* PulseAudio usually sends a server info update by itself when default
-     * stream changes, but there is at least one case when it does not - setting
-     * a card profile to off, so to be sure request an update explicitely */
-    pulse_connection_load_server_info(pulse->priv->connection);
-  }
   g_object_unref(stream);
 }
 
@@ -758,6 +943,12 @@ static void on_connection_sink_input_info(PulseConnection *connection,
   PulseSink *sink = NULL;
   PulseSink *prev;
 
+  if (g_hash_table_contains(pulse->priv->sink_input_map,
+                            GUINT_TO_POINTER(info->index)) == FALSE &&
+      hold_young_control(pulse, pulse->priv->young_sink_inputs, info->index,
+                         TRUE) == TRUE)
+    return;
+
   if (G_LIKELY(info->sink != PA_INVALID_INDEX))
     sink =
         g_hash_table_lookup(pulse->priv->sinks, GUINT_TO_POINTER(info->sink));
@@ -798,6 +989,12 @@ static void on_connection_sink_input_removed(PulseConnection *connection,
                                              guint idx, PulseBackend *pulse) {
   PulseSink *sink;
 
+  /* A sink input removed before reaching the minimum lifetime has never
+   * been reported */
+  if (g_hash_table_remove(pulse->priv->young_sink_inputs,
+                          GUINT_TO_POINTER(idx)) == TRUE)
+    return;
+
   sink =
       g_hash_table_lookup(pulse->priv->sink_input_map, GUINT_TO_POINTER(idx));
   if (G_UNLIKELY(sink == NULL)) return;
@@ -810,6 +1007,7 @@ static void on_connection_source_info(PulseConnection *connection,
                                       PulseBackend *pulse) {
   PulseDevice *device = NULL;
   PulseStream *stream;
+  gboolean restored = FALSE;
 
   if (info->card != PA_INVALID_INDEX)
     device =
@@ -817,9 +1015,23 @@ static void on_connection_source_info(PulseConnection *connection,
 
   stream =
       g_hash_table_lookup(pulse->priv->sources, GUINT_TO_POINTER(info->index));
+  if (stream == NULL) {
+    stream = restore_stream(pulse, pulse->priv->stale_sources,
+                            pulse->priv->sources, info->name, info->index);
+    if (stream != NULL) restored = TRUE;
+  }
+
   if (stream == NULL) {
     stream = PULSE_STREAM(pulse_source_new(connection, info, device));
 
+    /* Lazy application controls are only created on demand */
+    pulse_source_set_lazy_controls(
+        PULSE_SOURCE(stream),
+        (pulse->priv->loading_flags &
+         MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS)
+            ? TRUE
+            : FALSE);
+
     g_hash_table_insert(pulse->priv->sources, GUINT_TO_POINTER(info->index),
                         stream);
 
@@ -836,13 +1048,15 @@ static void on_connection_source_info(PulseConnection *connection,
     }
     /* We might be waiting for this source to set it as the default */
     check_pending_source(pulse, stream);
-  } else
+  } else {
     pulse_source_update(PULSE_SOURCE(stream), info);
+
+    if (restored == TRUE) pulse_source_reset_monitor(PULSE_SOURCE(stream));
+  }
 }
 
 static void on_connection_source_removed(PulseConnection *connection, guint idx,
                                          PulseBackend *pulse) {
-  PulseDevice *device;
   PulseStream *stream;
 
   stream = g_hash_table_lookup(pulse->priv->sources, GUINT_TO_POINTER(idx));
@@ -851,28 +1065,8 @@ static void on_connection_source_removed(PulseConnection *connection, guint idx,
   g_object_ref(stream);
 
   g_hash_table_remove(pulse->priv->sources, GUINT_TO_POINTER(idx));
-  free_list_streams(pulse);
+  remove_stream(pulse, stream);
 
-  device = pulse_stream_get_device(stream);
-  if (device != NULL) {
-    pulse_device_remove_stream(device, stream);
-  } else {
-    g_signal_emit_by_name(
-        G_OBJECT(pulse), "stream-removed",
-        mate_mixer_stream_get_name(MATE_MIXER_STREAM(stream)));
-  }
-
-  /* The removed stream might be one of the default streams, this happens
-   * especially when switching profiles, after which PulseAudio removes the
-   * old streams and creates new ones with different names */
-  if (MATE_MIXER_STREAM(stream) == PULSE_GET_DEFAULT_SOURCE(pulse)) {
-    PULSE_SET_DEFAULT_SOURCE(pulse, NULL);
-
-    /* PulseAudio usually sends a server info update by itself when default
-     * stream changes, but there is at least one case when it does not - setting
-     * a card profile to off, so to be sure request an update explicitely */
-    pulse_connection_load_server_info(pulse->priv->connection);
-  }
   g_object_unref(stream);
 }
 
@@ -882,6 +1076,12 @@ static void on_connection_source_output_info(PulseConnection *connection,
   PulseSource *source = NULL;
   PulseSource *prev;
 
+  if (g_hash_table_contains(pulse->priv->source_output_map,
+                            GUINT_TO_POINTER(info->index)) == FALSE &&
+      hold_young_control(pulse, pulse->priv->young_source_outputs,
+                         info->index, FALSE) == TRUE)
+    return;
+
   if (G_LIKELY(info->source != PA_INVALID_INDEX))
     source = g_hash_table_lookup(pulse->priv->sources,
                                  GUINT_TO_POINTER(info->source));
@@ -924,6 +1124,10 @@ static void on_connection_source_output_removed(PulseConnection *connection,
                                                 PulseBackend *pulse) {
   PulseSource *source;
 
+  if (g_hash_table_remove(pulse->priv->young_source_outputs,
+                          GUINT_TO_POINTER(idx)) == TRUE)
+    return;
+
   source = g_hash_table_lookup(pulse->priv->source_output_map,
                                GUINT_TO_POINTER(idx));
   if (G_UNLIKELY(source == NULL)) return;
@@ -995,15 +1199,165 @@ static void on_connection_ext_stream_loaded(PulseConnection *connection,
   }
 }
 
+static void on_connection_lists_loaded(PulseConnection *connection,
+                                       PulseBackend *pulse) {
+  GList *list;
+  GList *item;
+
+  /* Streams and devices kept from a lost connection which have not been
+   * found in the new lists are gone */
+  list = g_list_concat(g_hash_table_get_values(pulse->priv->stale_sinks),
+                       g_hash_table_get_values(pulse->priv->stale_sources));
+
+  g_hash_table_steal_all(pulse->priv->stale_sinks);
+  g_hash_table_steal_all(pulse->priv->stale_sources);
+
+  for (item = list; item != NULL; item = item->next)
+    remove_stream(pulse, PULSE_STREAM(item->data));
+
+  g_list_free_full(list, g_object_unref);
+
+  list = g_hash_table_get_values(pulse->priv->stale_devices);
+  if (list == NULL) return;
+
+  g_hash_table_steal_all(pulse->priv->stale_devices);
+  free_list_devices(pulse);
+
+  for (item = list; item != NULL; item = item->next)
+    g_signal_emit_by_name(
+        G_OBJECT(pulse), "device-removed",
+        mate_mixer_device_get_name(MATE_MIXER_DEVICE(item->data)));
+
+  g_list_free_full(list, g_object_unref);
+}
+
+static void schedule_reconnect(PulseBackend *pulse) {
+  GSource *source;
+  guint delay;
+
+  if (pulse->priv->reconnect_delay == 0)
+    pulse->priv->reconnect_delay = RECONNECT_DELAY_MIN;
+  else
+    pulse->priv->reconnect_delay =
+        MIN(pulse->priv->reconnect_delay * 2, RECONNECT_DELAY_MAX);
+
+  /* Add a random jitter of up to a quarter of the delay in both directions,
+   * so that clients of a restarted sound server do not all reconnect at
+   * the same moment */
+  delay = pulse->priv->reconnect_delay;
+  delay = delay - delay / 4 + g_random_int_range(0, delay / 2 + 1);
+
+  source = g_timeout_source_new(delay);
+  g_source_set_callback(source, (GSourceFunc)source_try_connect, pulse, NULL);
+  pulse->priv->connect_tag =
+      g_source_attach(source, g_main_context_get_thread_default());
+
+  g_source_unref(source);
+}
+
 static gboolean source_try_connect(PulseBackend *pulse) {
-  /* When the connect call succeeds, return FALSE to remove the source
-   * and wait for the connection state notifications, otherwise this function
-   * will be called again */
-  if (pulse_connection_connect(pulse->priv->connection, TRUE) == TRUE) {
-    pulse->priv->connect_tag = 0;
-    return G_SOURCE_REMOVE;
+  pulse->priv->connect_tag = 0;
+
+  /* When the connect call succeeds, wait for the connection state
+   * notifications, otherwise try again later */
+  if (pulse_connection_connect(pulse->priv->connection, TRUE) == FALSE)
+    schedule_reconnect(pulse);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean source_grace_expired(PulseBackend *pulse) {
+  pulse->priv->grace_tag = 0;
+
+  PULSE_CHANGE_STATE(pulse, MATE_MIXER_STATE_CONNECTING);
+  return G_SOURCE_REMOVE;
+}
+
+static void leave_grace_period(PulseBackend *pulse) {
+  if (pulse->priv->grace_tag == 0) return;
+
+  g_source_remove(pulse->priv->grace_tag);
+  pulse->priv->grace_tag = 0;
+}
+
+static void mark_stale(PulseBackend *pulse) {
+  GHashTableIter iter;
+  gpointer key;
+  gpointer value;
+
+  /* Indices are only valid within a single connection, so keep the devices
+   * and streams under their names until the lists are loaded again */
+  g_hash_table_iter_init(&iter, pulse->priv->devices);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    g_hash_table_insert(
+        pulse->priv->stale_devices,
+        (gpointer)mate_mixer_device_get_name(MATE_MIXER_DEVICE(value)), value);
+    g_hash_table_iter_steal(&iter);
+  }
+
+  g_hash_table_iter_init(&iter, pulse->priv->sinks);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    g_hash_table_insert(
+        pulse->priv->stale_sinks,
+        (gpointer)mate_mixer_stream_get_name(MATE_MIXER_STREAM(value)), value);
+    g_hash_table_iter_steal(&iter);
+  }
+
+  g_hash_table_iter_init(&iter, pulse->priv->sources);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    g_hash_table_insert(
+        pulse->priv->stale_sources,
+        (gpointer)mate_mixer_stream_get_name(MATE_MIXER_STREAM(value)), value);
+    g_hash_table_iter_steal(&iter);
+  }
+
+  /* Application streams do not outlive the connection of their client to
+   * the sound server, which is lost when the sound server restarts */
+  g_hash_table_iter_init(&iter, pulse->priv->sink_input_map);
+  while (g_hash_table_iter_next(&iter, &key, &value) == TRUE) {
+    pulse_sink_remove_input(PULSE_SINK(value), GPOINTER_TO_UINT(key));
+    g_hash_table_iter_remove(&iter);
   }
-  return G_SOURCE_CONTINUE;
+
+  g_hash_table_iter_init(&iter, pulse->priv->source_output_map);
+  while (g_hash_table_iter_next(&iter, &key, &value) == TRUE) {
+    pulse_source_remove_output(PULSE_SOURCE(value), GPOINTER_TO_UINT(key));
+    g_hash_table_iter_remove(&iter);
+  }
+}
+
+static PulseDevice *restore_device(PulseBackend *pulse,
+                                   const pa_card_info *info) {
+  PulseDevice *device;
+
+  device = g_hash_table_lookup(pulse->priv->stale_devices, info->name);
+  if (device == NULL) return NULL;
+
+  /* The device is found again after reconnecting, it is updated in place
+   * and no signals are emitted unless its state has changed */
+  g_hash_table_steal(pulse->priv->stale_devices, info->name);
+
+  pulse_device_set_index(device, info->index);
+
+  g_hash_table_insert(pulse->priv->devices, GUINT_TO_POINTER(info->index),
+                      device);
+  return device;
+}
+
+static PulseStream *restore_stream(PulseBackend *pulse, GHashTable *stale,
+                                   GHashTable *table, const gchar *name,
+                                   guint32 index) {
+  PulseStream *stream;
+
+  stream = g_hash_table_lookup(stale, name);
+  if (stream == NULL) return NULL;
+
+  g_hash_table_steal(stale, name);
+
+  pulse_stream_set_index(stream, index);
+
+  g_hash_table_insert(table, GUINT_TO_POINTER(index), stream);
+  return stream;
 }
 
 static void check_pending_sink(PulseBackend *pulse, PulseStream *stream) {
@@ -1042,6 +1396,36 @@ static void check_pending_source(PulseBackend *pulse, PulseStream *stream) {
   PULSE_SET_DEFAULT_SOURCE(pulse, stream);
 }
 
+static void remove_stream(PulseBackend *pulse, PulseStream *stream) {
+  PulseDevice *device;
+
+  free_list_streams(pulse);
+
+  device = pulse_stream_get_device(stream);
+  if (device != NULL) {
+    pulse_device_remove_stream(device, stream);
+  } else {
+    g_signal_emit_by_name(
+        G_OBJECT(pulse), "stream-removed",
+        mate_mixer_stream_get_name(MATE_MIXER_STREAM(stream)));
+  }
+
+  /* The removed stream might be one of the default streams, this happens
+   * especially when switching profiles, after which PulseAudio removes the
+   * old streams and creates new ones with different names */
+  if (MATE_MIXER_STREAM(stream) == PULSE_GET_DEFAULT_SINK(pulse))
+    PULSE_SET_DEFAULT_SINK(pulse, NULL);
+  else if (MATE_MIXER_STREAM(stream) == PULSE_GET_DEFAULT_SOURCE(pulse))
+    PULSE_SET_DEFAULT_SOURCE(pulse, NULL);
+  else
+    return;
+
+  /* PulseAudio usually sends a server info update by itself when default
+   * stream changes, but there is at least one case when it does not - setting
+   * a card profile to off, so to be sure request an update explicitely */
+  pulse_connection_load_server_info(pulse->priv->connection);
+}
+
 static void remove_sink_input(PulseBackend *pulse, PulseSink *sink,
                               guint index) {
   pulse_sink_remove_input(sink, index);
@@ -1056,6 +1440,74 @@ static void remove_source_output(PulseBackend *pulse, PulseSource *source,
   g_hash_table_remove(pulse->priv->source_output_map, GUINT_TO_POINTER(index));
 }
 
+static gboolean hold_young_control(PulseBackend *pulse, GHashTable *table,
+                                   guint32 index, gboolean sink_input) {
+  PulseYoungControl *young;
+
+  if (pulse->priv->min_control_lifetime == 0) return FALSE;
+
+  young = g_hash_table_lookup(table, GUINT_TO_POINTER(index));
+  if (young != NULL) {
+    /* Still too young, the info is requested again once the control
+     * reaches the minimum lifetime */
+    if (young->source != NULL) return TRUE;
+
+    g_hash_table_remove(table, GUINT_TO_POINTER(index));
+    return FALSE;
+  }
+
+  /* Controls which exist while the initial lists are being loaded are
+   * reported immediately */
+  if (pulse_connection_get_loading(pulse->priv->connection) == TRUE)
+    return FALSE;
+
+  young = g_new0(PulseYoungControl, 1);
+  young->pulse = pulse;
+  young->index = index;
+  young->sink_input = sink_input;
+  young->source = g_timeout_source_new(pulse->priv->min_control_lifetime);
+
+  g_source_set_callback(young->source, (GSourceFunc)young_control_timeout,
+                        young, NULL);
+  g_source_attach(young->source, g_main_context_get_thread_default());
+
+  g_hash_table_insert(table, GUINT_TO_POINTER(index), young);
+  return TRUE;
+}
+
+static gboolean young_control_timeout(PulseYoungControl *young) {
+  PulseBackend *pulse = young->pulse;
+  GHashTable *table;
+  gboolean loading;
+
+  g_clear_pointer(&young->source, g_source_unref);
+
+  /* The control has lived long enough, request its current state, which
+   * is going to be reported as usual */
+  if (young->sink_input == TRUE) {
+    table = pulse->priv->young_sink_inputs;
+    loading = pulse_connection_load_sink_input_info(pulse->priv->connection,
+                                                    young->index);
+  } else {
+    table = pulse->priv->young_source_outputs;
+    loading = pulse_connection_load_source_output_info(
+        pulse->priv->connection, young->index);
+  }
+
+  if (loading == FALSE)
+    g_hash_table_remove(table, GUINT_TO_POINTER(young->index));
+
+  return G_SOURCE_REMOVE;
+}
+
+static void free_young_control(PulseYoungControl *young) {
+  if (young->source != NULL) {
+    g_source_destroy(young->source);
+    g_source_unref(young->source);
+  }
+  g_free(young);
+}
+
 static void free_list_devices(PulseBackend *pulse) {
   if (pulse->priv->devices_list == NULL) return;
 
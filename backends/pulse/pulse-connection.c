@@ -19,6 +19,8 @@
 
 #include <glib-object.h>
 #include <glib.h>
+#include <libmatemixer/matemixer-private.h>
+#include <libmatemixer/matemixer.h>
 #include <pulse/ext-stream-restore.h>
 #include <pulse/glib-mainloop.h>
 #include <pulse/pulseaudio.h>
@@ -37,11 +39,39 @@ struct _PulseConnectionPrivate {
   pa_glib_mainloop *mainloop;
   gboolean ext_streams_loading;
   gboolean ext_streams_dirty;
+  gboolean ext_streams_wanted;
+  gboolean progressive;
+  gboolean lazy_ext_streams;
+  gboolean lists_loading;
+  MateMixerInterestFlags interests;
+  GHashTable *app_infos;
+  GSList *batches;
+  GMainContext *main_context;
+  guint n_updates;
+  guint n_updates_skipped;
   PulseConnectionState state;
 };
 
 enum { PROP_0, PROP_SERVER, PROP_STATE, N_PROPERTIES };
 
+typedef enum {
+  PULSE_BATCH_MOVE_SINK_INPUT,
+  PULSE_BATCH_MOVE_SOURCE_OUTPUT,
+  PULSE_BATCH_KILL_SINK_INPUT,
+  PULSE_BATCH_KILL_SOURCE_OUTPUT
+} PulseBatchType;
+
+/* A set of operations reported by a single completion */
+typedef struct {
+  PulseConnection *connection;
+  guint remaining;
+  gboolean success;
+  PulseBatchFunc func;
+  gpointer user_data;
+  GDestroyNotify destroy;
+  GSource *idle;
+} PulseBatch;
+
 static GParamSpec *properties[N_PROPERTIES] = {
     NULL,
 };
@@ -61,6 +91,7 @@ enum {
   EXT_STREAM_LOADING,
   EXT_STREAM_LOADED,
   EXT_STREAM_INFO,
+  LISTS_LOADED,
   N_SIGNALS
 };
 
@@ -80,6 +111,25 @@ G_DEFINE_TYPE_WITH_PRIVATE(PulseConnection, pulse_connection, G_TYPE_OBJECT);
 
 static gchar *create_app_name(void);
 
+static MateMixerAppInfo *create_app_info(pa_proplist *proplist);
+static gboolean compare_app_info(MateMixerAppInfo *info,
+                                 pa_proplist *proplist);
+
+static pa_subscription_mask_t get_subscription_mask(
+    MateMixerInterestFlags interests);
+
+static gboolean request_lists(PulseConnection *connection,
+                              MateMixerInterestFlags interests, GSList **ops,
+                              guint *count);
+
+static gboolean run_batch(PulseConnection *connection, PulseBatchType type,
+                          const guint32 *indices, guint n_indices,
+                          guint32 target, PulseBatchFunc func,
+                          gpointer user_data, GDestroyNotify destroy);
+static void finish_batch(PulseBatch *batch);
+static gboolean finish_batch_cb(PulseBatch *batch);
+static void cancel_batches(PulseConnection *connection);
+
 static gboolean load_lists(PulseConnection *connection);
 static gboolean load_list_finished(PulseConnection *connection);
 
@@ -90,6 +140,8 @@ static void pulse_subscribe_cb(pa_context *c, pa_subscription_event_type_t t,
 static void pulse_restore_subscribe_cb(pa_context *c, void *userdata);
 static void pulse_server_info_cb(pa_context *c, const pa_server_info *info,
                                  void *userdata);
+static void pulse_lists_loaded_cb(pa_context *c, const pa_server_info *info,
+                                  void *userdata);
 static void pulse_card_info_cb(pa_context *c, const pa_card_info *info, int eol,
                                void *userdata);
 static void pulse_sink_info_cb(pa_context *c, const pa_sink_info *info, int eol,
@@ -105,6 +157,7 @@ static void pulse_source_output_info_cb(pa_context *c,
 static void pulse_ext_stream_restore_cb(pa_context *c,
                                         const pa_ext_stream_restore_info *info,
                                         int eol, void *userdata);
+static void pulse_batch_cb(pa_context *c, int success, void *userdata);
 
 static void change_state(PulseConnection *connection,
                          PulseConnectionState state);
@@ -200,6 +253,11 @@ static void pulse_connection_class_init(PulseConnectionClass *klass) {
       "ext-stream-info", G_TYPE_FROM_CLASS(object_class), G_SIGNAL_RUN_LAST,
       G_STRUCT_OFFSET(PulseConnectionClass, ext_stream_info), NULL, NULL,
       g_cclosure_marshal_VOID__POINTER, G_TYPE_NONE, 1, G_TYPE_POINTER);
+
+  signals[LISTS_LOADED] = g_signal_new(
+      "lists-loaded", G_TYPE_FROM_CLASS(object_class), G_SIGNAL_RUN_LAST,
+      G_STRUCT_OFFSET(PulseConnectionClass, lists_loaded), NULL, NULL,
+      g_cclosure_marshal_VOID__VOID, G_TYPE_NONE, 0, G_TYPE_NONE);
 }
 
 static void pulse_connection_get_property(GObject *object, guint param_id,
@@ -241,6 +299,17 @@ static void pulse_connection_set_property(GObject *object, guint param_id,
 
 static void pulse_connection_init(PulseConnection *connection) {
   connection->priv = pulse_connection_get_instance_private(connection);
+  connection->priv->interests = MATE_MIXER_INTEREST_ALL;
+
+  /* The connection is created by the backend within the main context it
+   * runs in, which may be private to the library */
+  connection->priv->main_context = g_main_context_ref_thread_default();
+
+  /* Application information shared by all controls of a client, keyed by
+   * the client index */
+  connection->priv->app_infos =
+      g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                            (GDestroyNotify)_mate_mixer_app_info_unref);
 }
 
 static void pulse_connection_finalize(GObject *object) {
@@ -249,13 +318,18 @@ static void pulse_connection_finalize(GObject *object) {
   connection = PULSE_CONNECTION(object);
 
   g_free(connection->priv->server);
+  g_hash_table_unref(connection->priv->app_infos);
 
   if (connection->priv->context != NULL)
     pa_context_unref(connection->priv->context);
 
+  cancel_batches(connection);
+
   pa_proplist_free(connection->priv->proplist);
   pa_glib_mainloop_free(connection->priv->mainloop);
 
+  g_main_context_unref(connection->priv->main_context);
+
   G_OBJECT_CLASS(pulse_connection_parent_class)->finalize(object);
 }
 
@@ -345,12 +419,140 @@ void pulse_connection_disconnect(PulseConnection *connection) {
 
   connection->priv->context = NULL;
   connection->priv->outstanding = 0;
+  connection->priv->lists_loading = FALSE;
   connection->priv->ext_streams_loading = FALSE;
   connection->priv->ext_streams_dirty = FALSE;
 
+  /* Client indices are only valid within a single connection */
+  g_hash_table_remove_all(connection->priv->app_infos);
+
+  /* Pending operations have been cancelled together with the context */
+  cancel_batches(connection);
+
+  if (connection->priv->n_updates > 0)
+    g_debug("Skipped %u of %u control updates as unchanged",
+            connection->priv->n_updates_skipped, connection->priv->n_updates);
+
+  connection->priv->n_updates = 0;
+  connection->priv->n_updates_skipped = 0;
+
   change_state(connection, PULSE_CONNECTION_DISCONNECTED);
 }
 
+void pulse_connection_count_update(PulseConnection *connection,
+                                   gboolean skipped) {
+  g_return_if_fail(PULSE_IS_CONNECTION(connection));
+
+  connection->priv->n_updates++;
+  if (skipped == TRUE) connection->priv->n_updates_skipped++;
+}
+
+void pulse_connection_set_progressive(PulseConnection *connection,
+                                      gboolean progressive) {
+  g_return_if_fail(PULSE_IS_CONNECTION(connection));
+
+  connection->priv->progressive = progressive;
+}
+
+void pulse_connection_set_lazy_ext_streams(PulseConnection *connection,
+                                           gboolean lazy) {
+  g_return_if_fail(PULSE_IS_CONNECTION(connection));
+
+  connection->priv->lazy_ext_streams = lazy;
+}
+
+void pulse_connection_set_interests(PulseConnection *connection,
+                                    MateMixerInterestFlags interests) {
+  PulseConnectionState state;
+  MateMixerInterestFlags added;
+  GSList *ops = NULL;
+  guint count = 0;
+  gboolean counted;
+  pa_operation *op;
+
+  g_return_if_fail(PULSE_IS_CONNECTION(connection));
+
+  /* Application stream controls live in streams and streams are attached
+   * to their devices, so the objects are always tracked together */
+  if (interests & MATE_MIXER_INTEREST_APPLICATION_CONTROLS)
+    interests |= MATE_MIXER_INTEREST_STREAMS;
+  if (interests & MATE_MIXER_INTEREST_STREAMS)
+    interests |= MATE_MIXER_INTEREST_DEVICES;
+
+  state = connection->priv->state;
+
+  /* While connected the interests may only be widened */
+  if (state == PULSE_CONNECTION_LOADING || state == PULSE_CONNECTION_CONNECTED)
+    interests |= connection->priv->interests;
+
+  added = interests & ~connection->priv->interests;
+
+  connection->priv->interests = interests;
+
+  if (added == MATE_MIXER_INTEREST_NONE ||
+      (state != PULSE_CONNECTION_LOADING &&
+       state != PULSE_CONNECTION_CONNECTED))
+    return;
+
+  op = pa_context_subscribe(connection->priv->context,
+                            get_subscription_mask(interests), NULL, NULL);
+
+  if (process_pulse_operation(connection, op) == FALSE) return;
+
+  if (added & MATE_MIXER_INTEREST_STORED_CONTROLS) {
+    op = pa_ext_stream_restore_subscribe(connection->priv->context, TRUE, NULL,
+                                         NULL);
+
+    /* Keep going if this operation fails */
+    process_pulse_operation(connection, op);
+  }
+
+  if (request_lists(connection, added, &ops, &count) == FALSE) {
+    g_slist_foreach(ops, (GFunc)pa_operation_cancel, NULL);
+    g_slist_foreach(ops, (GFunc)pa_operation_unref, NULL);
+    g_slist_free(ops);
+    return;
+  }
+
+  /* Outside of the progressive mode the initial lists may still be being
+   * counted, in which case the final request also covers the new ones,
+   * otherwise the lists get a request of their own */
+  counted = connection->priv->progressive == FALSE &&
+            state == PULSE_CONNECTION_LOADING &&
+            connection->priv->outstanding > 0;
+
+  if (counted == TRUE)
+    connection->priv->outstanding += count;
+  else if (count > 0) {
+    op = pa_context_get_server_info(connection->priv->context,
+                                    pulse_lists_loaded_cb, connection);
+    if (op != NULL) {
+      ops = g_slist_prepend(ops, op);
+      connection->priv->lists_loading = TRUE;
+    }
+  }
+
+  g_slist_foreach(ops, (GFunc)pa_operation_unref, NULL);
+  g_slist_free(ops);
+
+  if (!(added & MATE_MIXER_INTEREST_STORED_CONTROLS) ||
+      (connection->priv->lazy_ext_streams == TRUE &&
+       connection->priv->ext_streams_wanted == FALSE))
+    return;
+
+  if (counted == TRUE) {
+    /* This might not always be supported */
+    op = pa_ext_stream_restore_read(connection->priv->context,
+                                    pulse_ext_stream_restore_cb, connection);
+    if (op != NULL) {
+      pa_operation_unref(op);
+      connection->priv->outstanding++;
+      connection->priv->ext_streams_wanted = TRUE;
+    }
+  } else
+    pulse_connection_load_ext_stream_info(connection);
+}
+
 PulseConnectionState pulse_connection_get_state(PulseConnection *connection) {
   g_return_val_if_fail(PULSE_IS_CONNECTION(connection),
                        PULSE_CONNECTION_DISCONNECTED);
@@ -358,6 +560,13 @@ PulseConnectionState pulse_connection_get_state(PulseConnection *connection) {
   return connection->priv->state;
 }
 
+gboolean pulse_connection_get_loading(PulseConnection *connection) {
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), FALSE);
+
+  return connection->priv->state == PULSE_CONNECTION_LOADING ||
+         connection->priv->lists_loading == TRUE;
+}
+
 gboolean pulse_connection_load_server_info(PulseConnection *connection) {
   pa_operation *op;
 
@@ -525,6 +734,29 @@ gboolean pulse_connection_load_source_output_info(PulseConnection *connection,
   return process_pulse_operation(connection, op);
 }
 
+MateMixerAppInfo *pulse_connection_get_app_info(PulseConnection *connection,
+                                                guint32 client,
+                                                pa_proplist *proplist) {
+  MateMixerAppInfo *info;
+
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
+  g_return_val_if_fail(proplist != NULL, NULL);
+
+  if (client == PA_INVALID_INDEX) return create_app_info(proplist);
+
+  /* A stream may override the properties of its client, in which case the
+   * cached record is replaced by one matching the newest stream */
+  info = g_hash_table_lookup(connection->priv->app_infos,
+                             GUINT_TO_POINTER(client));
+  if (info == NULL || compare_app_info(info, proplist) == FALSE) {
+    info = create_app_info(proplist);
+
+    g_hash_table_insert(connection->priv->app_infos, GUINT_TO_POINTER(client),
+                        info);
+  }
+  return _mate_mixer_app_info_ref(info);
+}
+
 gboolean pulse_connection_load_ext_stream_info(PulseConnection *connection) {
   pa_operation *op;
 
@@ -534,6 +766,13 @@ gboolean pulse_connection_load_ext_stream_info(PulseConnection *connection) {
       connection->priv->state != PULSE_CONNECTION_CONNECTED)
     return FALSE;
 
+  if (!(connection->priv->interests & MATE_MIXER_INTEREST_STORED_CONTROLS))
+    return FALSE;
+
+  /* From now on follow the changes of the database even when it is loaded
+   * lazily */
+  connection->priv->ext_streams_wanted = TRUE;
+
   /* When we receive a request to load the list of ext-streams, see if
    * loading is already in progress and if it is, wait until the current
    * loading finishes.
@@ -854,6 +1093,52 @@ gboolean pulse_connection_kill_source_output(PulseConnection *connection,
   return process_pulse_operation(connection, op);
 }
 
+gboolean pulse_connection_move_sink_inputs(PulseConnection *connection,
+                                           const guint32 *indices,
+                                           guint n_indices, guint32 sink_index,
+                                           PulseBatchFunc func,
+                                           gpointer user_data,
+                                           GDestroyNotify destroy) {
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), FALSE);
+  g_return_val_if_fail(indices != NULL || n_indices == 0, FALSE);
+
+  return run_batch(connection, PULSE_BATCH_MOVE_SINK_INPUT, indices, n_indices,
+                   sink_index, func, user_data, destroy);
+}
+
+gboolean pulse_connection_move_source_outputs(
+    PulseConnection *connection, const guint32 *indices, guint n_indices,
+    guint32 source_index, PulseBatchFunc func, gpointer user_data,
+    GDestroyNotify destroy) {
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), FALSE);
+  g_return_val_if_fail(indices != NULL || n_indices == 0, FALSE);
+
+  return run_batch(connection, PULSE_BATCH_MOVE_SOURCE_OUTPUT, indices,
+                   n_indices, source_index, func, user_data, destroy);
+}
+
+gboolean pulse_connection_kill_sink_inputs(PulseConnection *connection,
+                                           const guint32 *indices,
+                                           guint n_indices, PulseBatchFunc func,
+                                           gpointer user_data,
+                                           GDestroyNotify destroy) {
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), FALSE);
+  g_return_val_if_fail(indices != NULL || n_indices == 0, FALSE);
+
+  return run_batch(connection, PULSE_BATCH_KILL_SINK_INPUT, indices, n_indices,
+                   PA_INVALID_INDEX, func, user_data, destroy);
+}
+
+gboolean pulse_connection_kill_source_outputs(
+    PulseConnection *connection, const guint32 *indices, guint n_indices,
+    PulseBatchFunc func, gpointer user_data, GDestroyNotify destroy) {
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), FALSE);
+  g_return_val_if_fail(indices != NULL || n_indices == 0, FALSE);
+
+  return run_batch(connection, PULSE_BATCH_KILL_SOURCE_OUTPUT, indices,
+                   n_indices, PA_INVALID_INDEX, func, user_data, destroy);
+}
+
 gboolean pulse_connection_write_ext_stream(
     PulseConnection *connection, const pa_ext_stream_restore_info *info) {
   pa_operation *op;
@@ -905,55 +1190,272 @@ static gchar *create_app_name(void) {
   return g_strdup_printf("libmatemixer-%lu", (gulong)getpid());
 }
 
-static gboolean load_lists(PulseConnection *connection) {
-  GSList *ops = NULL;
-  pa_operation *op;
+static MateMixerAppInfo *create_app_info(pa_proplist *proplist) {
+  MateMixerAppInfo *info;
 
-  if (G_UNLIKELY(connection->priv->outstanding > 0)) {
-    g_warn_if_reached();
+  info = _mate_mixer_app_info_new();
+
+  _mate_mixer_app_info_set_name(
+      info, pa_proplist_gets(proplist, PA_PROP_APPLICATION_NAME));
+  _mate_mixer_app_info_set_id(
+      info, pa_proplist_gets(proplist, PA_PROP_APPLICATION_ID));
+  _mate_mixer_app_info_set_version(
+      info, pa_proplist_gets(proplist, PA_PROP_APPLICATION_VERSION));
+  _mate_mixer_app_info_set_icon(
+      info, pa_proplist_gets(proplist, PA_PROP_APPLICATION_ICON_NAME));
+  return info;
+}
+
+static gboolean compare_app_info(MateMixerAppInfo *info,
+                                 pa_proplist *proplist) {
+  const gchar *prop;
+
+  prop = pa_proplist_gets(proplist, PA_PROP_APPLICATION_NAME);
+  if (g_strcmp0(info->name, prop) != 0) return FALSE;
+
+  prop = pa_proplist_gets(proplist, PA_PROP_APPLICATION_ID);
+  if (g_strcmp0(info->id, prop) != 0) return FALSE;
+
+  prop = pa_proplist_gets(proplist, PA_PROP_APPLICATION_VERSION);
+  if (g_strcmp0(info->version, prop) != 0) return FALSE;
+
+  prop = pa_proplist_gets(proplist, PA_PROP_APPLICATION_ICON_NAME);
+  if (g_strcmp0(info->icon, prop) != 0) return FALSE;
+
+  return TRUE;
+}
+
+static gboolean run_batch(PulseConnection *connection, PulseBatchType type,
+                          const guint32 *indices, guint n_indices,
+                          guint32 target, PulseBatchFunc func,
+                          gpointer user_data, GDestroyNotify destroy) {
+  PulseBatch *batch;
+  guint i;
+
+  if (connection->priv->state != PULSE_CONNECTION_CONNECTED) {
+    if (destroy != NULL) destroy(user_data);
     return FALSE;
   }
 
-  op = pa_context_get_card_info_list(connection->priv->context,
-                                     pulse_card_info_cb, connection);
-  if (G_UNLIKELY(op == NULL)) goto error;
+  batch = g_new0(PulseBatch, 1);
+  batch->connection = connection;
+  batch->success = TRUE;
+  batch->func = func;
+  batch->user_data = user_data;
+  batch->destroy = destroy;
+
+  /* All the requests are written at once and the server processes them in
+   * order, so the whole batch costs a single round trip and the reply to
+   * the last request completes it */
+  for (i = 0; i < n_indices; i++) {
+    pa_context *c = connection->priv->context;
+    pa_operation *op = NULL;
+
+    switch (type) {
+      case PULSE_BATCH_MOVE_SINK_INPUT:
+        op = pa_context_move_sink_input_by_index(c, indices[i], target,
+                                                 pulse_batch_cb, batch);
+        break;
+      case PULSE_BATCH_MOVE_SOURCE_OUTPUT:
+        op = pa_context_move_source_output_by_index(c, indices[i], target,
+                                                    pulse_batch_cb, batch);
+        break;
+      case PULSE_BATCH_KILL_SINK_INPUT:
+        op = pa_context_kill_sink_input(c, indices[i], pulse_batch_cb, batch);
+        break;
+      case PULSE_BATCH_KILL_SOURCE_OUTPUT:
+        op = pa_context_kill_source_output(c, indices[i], pulse_batch_cb,
+                                           batch);
+        break;
+    }
 
-  ops = g_slist_prepend(ops, op);
+    if (process_pulse_operation(connection, op) == FALSE) {
+      batch->success = FALSE;
+      break;
+    }
+    batch->remaining++;
+  }
 
-  op = pa_context_get_sink_info_list(connection->priv->context,
-                                     pulse_sink_info_cb, connection);
-  if (G_UNLIKELY(op == NULL)) goto error;
+  if (batch->remaining == 0) {
+    if (batch->success == FALSE) {
+      /* Nothing has been sent, the caller is told by the return value */
+      if (destroy != NULL) destroy(user_data);
 
-  ops = g_slist_prepend(ops, op);
+      g_free(batch);
+      return FALSE;
+    }
 
-  op = pa_context_get_sink_input_info_list(
-      connection->priv->context, pulse_sink_input_info_cb, connection);
-  if (G_UNLIKELY(op == NULL)) goto error;
+    /* Nothing to wait for, the completion is reported after returning
+     * to the caller */
+    batch->idle = g_idle_source_new();
+    g_source_set_callback(batch->idle, (GSourceFunc)finish_batch_cb, batch,
+                          NULL);
+    g_source_attach(batch->idle, connection->priv->main_context);
+  }
 
-  ops = g_slist_prepend(ops, op);
+  connection->priv->batches = g_slist_prepend(connection->priv->batches, batch);
+  return TRUE;
+}
 
-  op = pa_context_get_source_info_list(connection->priv->context,
-                                       pulse_source_info_cb, connection);
-  if (G_UNLIKELY(op == NULL)) goto error;
+static void finish_batch(PulseBatch *batch) {
+  PulseConnection *connection = batch->connection;
 
-  ops = g_slist_prepend(ops, op);
+  connection->priv->batches = g_slist_remove(connection->priv->batches, batch);
 
-  op = pa_context_get_source_output_info_list(
-      connection->priv->context, pulse_source_output_info_cb, connection);
-  if (G_UNLIKELY(op == NULL)) goto error;
+  if (batch->idle != NULL) {
+    g_source_destroy(batch->idle);
+    g_source_unref(batch->idle);
+  }
 
-  ops = g_slist_prepend(ops, op);
+  if (batch->func != NULL) batch->func(batch->success, batch->user_data);
+  if (batch->destroy != NULL) batch->destroy(batch->user_data);
 
-  connection->priv->outstanding = 5;
+  g_free(batch);
+}
+
+static gboolean finish_batch_cb(PulseBatch *batch) {
+  g_source_unref(batch->idle);
+  batch->idle = NULL;
+
+  finish_batch(batch);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void cancel_batches(PulseConnection *connection) {
+  while (connection->priv->batches != NULL) {
+    PulseBatch *batch = connection->priv->batches->data;
+
+    batch->success = FALSE;
+    finish_batch(batch);
+  }
+}
+
+static pa_subscription_mask_t get_subscription_mask(
+    MateMixerInterestFlags interests) {
+  pa_subscription_mask_t mask = PA_SUBSCRIPTION_MASK_SERVER;
+
+  if (interests & MATE_MIXER_INTEREST_DEVICES)
+    mask |= PA_SUBSCRIPTION_MASK_CARD;
+  if (interests & MATE_MIXER_INTEREST_STREAMS)
+    mask |= PA_SUBSCRIPTION_MASK_SINK | PA_SUBSCRIPTION_MASK_SOURCE;
+  if (interests & MATE_MIXER_INTEREST_APPLICATION_CONTROLS)
+    mask |= PA_SUBSCRIPTION_MASK_SINK_INPUT |
+            PA_SUBSCRIPTION_MASK_SOURCE_OUTPUT | PA_SUBSCRIPTION_MASK_CLIENT;
+
+  return mask;
+}
+
+static gboolean request_lists(PulseConnection *connection,
+                              MateMixerInterestFlags interests, GSList **ops,
+                              guint *count) {
+  pa_operation *op;
+
+  if (interests & MATE_MIXER_INTEREST_DEVICES) {
+    op = pa_context_get_card_info_list(connection->priv->context,
+                                       pulse_card_info_cb, connection);
+    if (G_UNLIKELY(op == NULL)) return FALSE;
+
+    *ops = g_slist_prepend(*ops, op);
+    (*count)++;
+  }
+
+  if (interests & MATE_MIXER_INTEREST_STREAMS) {
+    op = pa_context_get_sink_info_list(connection->priv->context,
+                                       pulse_sink_info_cb, connection);
+    if (G_UNLIKELY(op == NULL)) return FALSE;
+
+    *ops = g_slist_prepend(*ops, op);
+    (*count)++;
+  }
+
+  if (interests & MATE_MIXER_INTEREST_APPLICATION_CONTROLS) {
+    op = pa_context_get_sink_input_info_list(
+        connection->priv->context, pulse_sink_input_info_cb, connection);
+    if (G_UNLIKELY(op == NULL)) return FALSE;
+
+    *ops = g_slist_prepend(*ops, op);
+    (*count)++;
+  }
+
+  if (interests & MATE_MIXER_INTEREST_STREAMS) {
+    op = pa_context_get_source_info_list(connection->priv->context,
+                                         pulse_source_info_cb, connection);
+    if (G_UNLIKELY(op == NULL)) return FALSE;
+
+    *ops = g_slist_prepend(*ops, op);
+    (*count)++;
+  }
+
+  if (interests & MATE_MIXER_INTEREST_APPLICATION_CONTROLS) {
+    op = pa_context_get_source_output_info_list(
+        connection->priv->context, pulse_source_output_info_cb, connection);
+    if (G_UNLIKELY(op == NULL)) return FALSE;
+
+    *ops = g_slist_prepend(*ops, op);
+    (*count)++;
+  }
+
+  return TRUE;
+}
+
+static gboolean load_lists(PulseConnection *connection) {
+  GSList *ops = NULL;
+  guint count = 0;
+  pa_operation *op;
+
+  if (G_UNLIKELY(connection->priv->outstanding > 0)) {
+    g_warn_if_reached();
+    return FALSE;
+  }
+
+  /* In the progressive mode the server information, which finalizes the
+   * connection process, is requested before the lists and the objects are
+   * published as the lists arrive */
+  if (connection->priv->progressive == TRUE) {
+    op = pa_context_get_server_info(connection->priv->context,
+                                    pulse_server_info_cb, connection);
+    if (G_UNLIKELY(op == NULL)) goto error;
+
+    ops = g_slist_prepend(ops, op);
+  }
+
+  /* Only load the objects the application is interested in */
+  if (request_lists(connection, connection->priv->interests, &ops, &count) ==
+      FALSE)
+    goto error;
+
+  connection->priv->outstanding = count;
+
+  /* A lazily loaded stream-restore database is only read when it is first
+   * requested */
+  if ((connection->priv->interests & MATE_MIXER_INTEREST_STORED_CONTROLS) &&
+      (connection->priv->lazy_ext_streams == FALSE ||
+       connection->priv->ext_streams_wanted == TRUE)) {
+    /* This might not always be supported */
+    op = pa_ext_stream_restore_read(connection->priv->context,
+                                    pulse_ext_stream_restore_cb, connection);
+    if (op != NULL) {
+      ops = g_slist_prepend(ops, op);
+      connection->priv->outstanding++;
+      connection->priv->ext_streams_wanted = TRUE;
+    }
+  }
+
+  /* Replies arrive in the order of requests, so once the server information
+   * is received again, all the lists have been published; this is also the
+   * case when no list has been requested at all */
+  if (connection->priv->progressive == TRUE ||
+      connection->priv->outstanding == 0) {
+    op = pa_context_get_server_info(connection->priv->context,
+                                    pulse_lists_loaded_cb, connection);
+    if (G_UNLIKELY(op == NULL)) goto error;
 
-  /* This might not always be supported */
-  op = pa_ext_stream_restore_read(connection->priv->context,
-                                  pulse_ext_stream_restore_cb, connection);
-  if (op != NULL) {
     ops = g_slist_prepend(ops, op);
-    connection->priv->outstanding++;
   }
 
+  connection->priv->lists_loading = TRUE;
+
   g_slist_foreach(ops, (GFunc)pa_operation_unref, NULL);
   g_slist_free(ops);
 
@@ -977,10 +1479,15 @@ static gboolean load_list_finished(PulseConnection *connection) {
     connection->priv->outstanding = 0;
   }
 
-  if (connection->priv->outstanding == 0) {
-    gboolean ret = pulse_connection_load_server_info(connection);
+  /* In the progressive mode server information has already been requested */
+  if (connection->priv->outstanding == 0 &&
+      connection->priv->progressive == FALSE) {
+    pa_operation *op;
+
+    op = pa_context_get_server_info(connection->priv->context,
+                                    pulse_lists_loaded_cb, connection);
 
-    if (G_UNLIKELY(ret == FALSE)) {
+    if (G_UNLIKELY(process_pulse_operation(connection, op) == FALSE)) {
       pulse_connection_disconnect(connection);
       return FALSE;
     }
@@ -1013,19 +1520,17 @@ static void pulse_state_cb(pa_context *c, void *userdata) {
     pa_ext_stream_restore_set_subscribe_cb(
         connection->priv->context, pulse_restore_subscribe_cb, connection);
 
-    op = pa_ext_stream_restore_subscribe(connection->priv->context, TRUE, NULL,
-                                         NULL);
+    if (connection->priv->interests & MATE_MIXER_INTEREST_STORED_CONTROLS) {
+      op = pa_ext_stream_restore_subscribe(connection->priv->context, TRUE,
+                                           NULL, NULL);
 
-    /* Keep going if this operation fails */
-    process_pulse_operation(connection, op);
+      /* Keep going if this operation fails */
+      process_pulse_operation(connection, op);
+    }
 
     op = pa_context_subscribe(
         connection->priv->context,
-        PA_SUBSCRIPTION_MASK_SERVER | PA_SUBSCRIPTION_MASK_CARD |
-            PA_SUBSCRIPTION_MASK_SINK | PA_SUBSCRIPTION_MASK_SOURCE |
-            PA_SUBSCRIPTION_MASK_SINK_INPUT |
-            PA_SUBSCRIPTION_MASK_SOURCE_OUTPUT,
-        NULL, NULL);
+        get_subscription_mask(connection->priv->interests), NULL, NULL);
 
     if (process_pulse_operation(connection, op) == TRUE) {
       change_state(connection, PULSE_CONNECTION_LOADING);
@@ -1094,6 +1599,13 @@ static void pulse_subscribe_cb(pa_context *c, pa_subscription_event_type_t t,
       else
         pulse_connection_load_source_output_info(connection, idx);
       break;
+
+    case PA_SUBSCRIPTION_EVENT_CLIENT:
+      /* Controls keep their references, the next stream of the client
+       * creates a new record */
+      if ((t & PA_SUBSCRIPTION_EVENT_TYPE_MASK) != PA_SUBSCRIPTION_EVENT_NEW)
+        g_hash_table_remove(connection->priv->app_infos, GUINT_TO_POINTER(idx));
+      break;
   }
 }
 
@@ -1102,6 +1614,9 @@ static void pulse_restore_subscribe_cb(pa_context *c, void *userdata) {
 
   connection = PULSE_CONNECTION(userdata);
 
+  /* Nobody is interested in the database yet */
+  if (connection->priv->ext_streams_wanted == FALSE) return;
+
   pulse_connection_load_ext_stream_info(connection);
 }
 
@@ -1119,6 +1634,19 @@ static void pulse_server_info_cb(pa_context *c, const pa_server_info *info,
     change_state(connection, PULSE_CONNECTION_CONNECTED);
 }
 
+static void pulse_lists_loaded_cb(pa_context *c, const pa_server_info *info,
+                                  void *userdata) {
+  PulseConnection *connection;
+
+  connection = PULSE_CONNECTION(userdata);
+
+  connection->priv->lists_loading = FALSE;
+
+  pulse_server_info_cb(c, info, userdata);
+
+  g_signal_emit(G_OBJECT(connection), signals[LISTS_LOADED], 0);
+}
+
 static void pulse_card_info_cb(pa_context *c, const pa_card_info *info, int eol,
                                void *userdata) {
   PulseConnection *connection;
@@ -1220,6 +1748,18 @@ static void pulse_ext_stream_restore_cb(pa_context *c,
   g_signal_emit(G_OBJECT(connection), signals[EXT_STREAM_INFO], 0, info);
 }
 
+static void pulse_batch_cb(pa_context *c, int success, void *userdata) {
+  PulseBatch *batch;
+
+  batch = userdata;
+
+  if (success == 0) batch->success = FALSE;
+
+  if (--batch->remaining > 0) return;
+
+  finish_batch(batch);
+}
+
 static void change_state(PulseConnection *connection,
                          PulseConnectionState state) {
   if (connection->priv->state == state) return;
@@ -20,6 +20,7 @@
 
 #include <glib-object.h>
 #include <glib.h>
+#include <libmatemixer/matemixer.h>
 #include <pulse/ext-stream-restore.h>
 #include <pulse/pulseaudio.h>
 
@@ -43,6 +44,8 @@ G_BEGIN_DECLS
 typedef struct _PulseConnectionClass PulseConnectionClass;
 typedef struct _PulseConnectionPrivate PulseConnectionPrivate;
 
+typedef void (*PulseBatchFunc)(gboolean success, gpointer user_data);
+
 struct _PulseConnection {
   GObject parent;
 
@@ -77,6 +80,8 @@ struct _PulseConnectionClass {
   void (*ext_stream_loaded)(PulseConnection *connection);
   void (*ext_stream_info)(PulseConnection *connection,
                           const pa_ext_stream_restore_info *info);
+
+  void (*lists_loaded)(PulseConnection *connection);
 };
 
 GType pulse_connection_get_type(void) G_GNUC_CONST;
@@ -91,7 +96,18 @@ gboolean pulse_connection_connect(PulseConnection *connection,
                                   gboolean wait_for_daemon);
 void pulse_connection_disconnect(PulseConnection *connection);
 
+void pulse_connection_count_update(PulseConnection *connection,
+                                   gboolean skipped);
+
+void pulse_connection_set_progressive(PulseConnection *connection,
+                                      gboolean progressive);
+void pulse_connection_set_lazy_ext_streams(PulseConnection *connection,
+                                           gboolean lazy);
+void pulse_connection_set_interests(PulseConnection *connection,
+                                    MateMixerInterestFlags interests);
+
 PulseConnectionState pulse_connection_get_state(PulseConnection *connection);
+gboolean pulse_connection_get_loading(PulseConnection *connection);
 
 gboolean pulse_connection_load_server_info(PulseConnection *connection);
 
@@ -118,6 +134,10 @@ gboolean pulse_connection_load_source_output_info(PulseConnection *connection,
 
 gboolean pulse_connection_load_ext_stream_info(PulseConnection *connection);
 
+MateMixerAppInfo *pulse_connection_get_app_info(PulseConnection *connection,
+                                                guint32 client,
+                                                pa_proplist *proplist);
+
 PulseMonitor *pulse_connection_create_monitor(PulseConnection *connection,
                                               guint32 index_source,
                                               guint32 index_sink_input);
@@ -175,6 +195,26 @@ gboolean pulse_connection_kill_sink_input(PulseConnection *connection,
 gboolean pulse_connection_kill_source_output(PulseConnection *connection,
                                              guint32 index);
 
+gboolean pulse_connection_move_sink_inputs(PulseConnection *connection,
+                                           const guint32 *indices,
+                                           guint n_indices, guint32 sink_index,
+                                           PulseBatchFunc func,
+                                           gpointer user_data,
+                                           GDestroyNotify destroy);
+gboolean pulse_connection_move_source_outputs(
+    PulseConnection *connection, const guint32 *indices, guint n_indices,
+    guint32 source_index, PulseBatchFunc func, gpointer user_data,
+    GDestroyNotify destroy);
+
+gboolean pulse_connection_kill_sink_inputs(PulseConnection *connection,
+                                           const guint32 *indices,
+                                           guint n_indices, PulseBatchFunc func,
+                                           gpointer user_data,
+                                           GDestroyNotify destroy);
+gboolean pulse_connection_kill_source_outputs(
+    PulseConnection *connection, const guint32 *indices, guint n_indices,
+    PulseBatchFunc func, gpointer user_data, GDestroyNotify destroy);
+
 gboolean pulse_connection_write_ext_stream(
     PulseConnection *connection, const pa_ext_stream_restore_info *info);
 gboolean pulse_connection_delete_ext_stream(PulseConnection *connection,
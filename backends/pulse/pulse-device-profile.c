@@ -66,3 +66,13 @@ guint pulse_device_profile_get_priority(PulseDeviceProfile *profile) {
 
   return profile->priv->priority;
 }
+
+gboolean pulse_device_profile_set_priority(PulseDeviceProfile *profile,
+                                           guint priority) {
+  g_return_val_if_fail(PULSE_IS_DEVICE_PROFILE(profile), FALSE);
+
+  if (profile->priv->priority == priority) return FALSE;
+
+  profile->priv->priority = priority;
+  return TRUE;
+}
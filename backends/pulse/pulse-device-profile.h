@@ -64,6 +64,9 @@ PulseDeviceProfile *pulse_device_profile_new(const gchar *name,
 const gchar *pulse_device_profile_get_name(PulseDeviceProfile *profile);
 guint pulse_device_profile_get_priority(PulseDeviceProfile *profile);
 
+gboolean pulse_device_profile_set_priority(PulseDeviceProfile *profile,
+                                           guint priority);
+
 G_END_DECLS
 
 #endif /* PULSE_DEVICE_PROFILE_H */
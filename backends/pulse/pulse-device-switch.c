@@ -29,9 +29,11 @@
 
 struct _PulseDeviceSwitchPrivate {
   GList *profiles;
+  GHashTable *index;
 };
 
 static void pulse_device_switch_dispose(GObject *object);
+static void pulse_device_switch_finalize(GObject *object);
 
 G_DEFINE_TYPE_WITH_PRIVATE(PulseDeviceSwitch, pulse_device_switch,
                            MATE_MIXER_TYPE_DEVICE_SWITCH)
@@ -42,7 +44,6 @@ static gboolean pulse_device_switch_set_active_option(
 static const GList *pulse_device_switch_list_options(MateMixerSwitch *mms);
 
 static gint compare_profiles(gconstpointer a, gconstpointer b);
-static gint compare_profile_name(gconstpointer a, gconstpointer b);
 
 static void pulse_device_switch_class_init(PulseDeviceSwitchClass *klass) {
   GObjectClass *object_class;
@@ -50,6 +51,7 @@ static void pulse_device_switch_class_init(PulseDeviceSwitchClass *klass) {
 
   object_class = G_OBJECT_CLASS(klass);
   object_class->dispose = pulse_device_switch_dispose;
+  object_class->finalize = pulse_device_switch_finalize;
 
   switch_class = MATE_MIXER_SWITCH_CLASS(klass);
   switch_class->set_active_option = pulse_device_switch_set_active_option;
@@ -58,6 +60,9 @@ static void pulse_device_switch_class_init(PulseDeviceSwitchClass *klass) {
 
 static void pulse_device_switch_init(PulseDeviceSwitch *swtch) {
   swtch->priv = pulse_device_switch_get_instance_private(swtch);
+
+  /* Name lookup table, the keys and values are owned by the profile list */
+  swtch->priv->index = g_hash_table_new(g_str_hash, g_str_equal);
 }
 
 static void pulse_device_switch_dispose(GObject *object) {
@@ -65,6 +70,8 @@ static void pulse_device_switch_dispose(GObject *object) {
 
   swtch = PULSE_DEVICE_SWITCH(object);
 
+  g_hash_table_remove_all(swtch->priv->index);
+
   if (swtch->priv->profiles != NULL) {
     g_list_free_full(swtch->priv->profiles, g_object_unref);
     swtch->priv->profiles = NULL;
@@ -72,6 +79,16 @@ static void pulse_device_switch_dispose(GObject *object) {
   G_OBJECT_CLASS(pulse_device_switch_parent_class)->dispose(object);
 }
 
+static void pulse_device_switch_finalize(GObject *object) {
+  PulseDeviceSwitch *swtch;
+
+  swtch = PULSE_DEVICE_SWITCH(object);
+
+  g_hash_table_unref(swtch->priv->index);
+
+  G_OBJECT_CLASS(pulse_device_switch_parent_class)->finalize(object);
+}
+
 PulseDeviceSwitch *pulse_device_switch_new(const gchar *name,
                                            const gchar *label,
                                            PulseDevice *device) {
@@ -91,6 +108,43 @@ void pulse_device_switch_add_profile(PulseDeviceSwitch *swtch,
 
   swtch->priv->profiles = g_list_insert_sorted(
       swtch->priv->profiles, g_object_ref(profile), compare_profiles);
+
+  g_hash_table_insert(swtch->priv->index,
+                      (gpointer)pulse_device_profile_get_name(profile),
+                      profile);
+}
+
+void pulse_device_switch_remove_profile(PulseDeviceSwitch *swtch,
+                                        PulseDeviceProfile *profile) {
+  GList *item;
+
+  g_return_if_fail(PULSE_IS_DEVICE_SWITCH(swtch));
+  g_return_if_fail(PULSE_IS_DEVICE_PROFILE(profile));
+
+  item = g_list_find(swtch->priv->profiles, profile);
+  if (G_UNLIKELY(item == NULL)) return;
+
+  g_hash_table_remove(swtch->priv->index,
+                      pulse_device_profile_get_name(profile));
+
+  swtch->priv->profiles = g_list_delete_link(swtch->priv->profiles, item);
+  g_object_unref(profile);
+}
+
+PulseDeviceProfile *pulse_device_switch_get_profile(PulseDeviceSwitch *swtch,
+                                                    const gchar *name) {
+  g_return_val_if_fail(PULSE_IS_DEVICE_SWITCH(swtch), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  return g_hash_table_lookup(swtch->priv->index, name);
+}
+
+void pulse_device_switch_sort_profiles(PulseDeviceSwitch *swtch) {
+  g_return_if_fail(PULSE_IS_DEVICE_SWITCH(swtch));
+
+  /* Called after profile priorities have changed, the list is kept in
+   * the order of priorities */
+  swtch->priv->profiles = g_list_sort(swtch->priv->profiles, compare_profiles);
 }
 
 void pulse_device_switch_set_active_profile(PulseDeviceSwitch *swtch,
@@ -104,18 +158,17 @@ void pulse_device_switch_set_active_profile(PulseDeviceSwitch *swtch,
 
 void pulse_device_switch_set_active_profile_by_name(PulseDeviceSwitch *swtch,
                                                     const gchar *name) {
-  GList *item;
+  PulseDeviceProfile *profile;
 
   g_return_if_fail(PULSE_IS_DEVICE_SWITCH(swtch));
   g_return_if_fail(name != NULL);
 
-  item = g_list_find_custom(swtch->priv->profiles, name, compare_profile_name);
-  if (G_UNLIKELY(item == NULL)) {
+  profile = g_hash_table_lookup(swtch->priv->index, name);
+  if (G_UNLIKELY(profile == NULL)) {
     g_debug("Invalid device switch profile name %s", name);
     return;
   }
-  pulse_device_switch_set_active_profile(swtch,
-                                         PULSE_DEVICE_PROFILE(item->data));
+  pulse_device_switch_set_active_profile(swtch, profile);
 }
 
 static gboolean pulse_device_switch_set_active_option(
@@ -148,10 +201,3 @@ static gint compare_profiles(gconstpointer a, gconstpointer b) {
   return pulse_device_profile_get_priority(PULSE_DEVICE_PROFILE(b)) -
          pulse_device_profile_get_priority(PULSE_DEVICE_PROFILE(a));
 }
-
-static gint compare_profile_name(gconstpointer a, gconstpointer b) {
-  PulseDeviceProfile *profile = PULSE_DEVICE_PROFILE(a);
-  const gchar *name = (const gchar *)b;
-
-  return strcmp(pulse_device_profile_get_name(profile), name);
-}
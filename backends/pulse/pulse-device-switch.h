@@ -63,6 +63,14 @@ PulseDeviceSwitch *pulse_device_switch_new(const gchar *name,
 void pulse_device_switch_add_profile(PulseDeviceSwitch *swtch,
                                      PulseDeviceProfile *profile);
 
+void pulse_device_switch_remove_profile(PulseDeviceSwitch *swtch,
+                                        PulseDeviceProfile *profile);
+
+PulseDeviceProfile *pulse_device_switch_get_profile(PulseDeviceSwitch *swtch,
+                                                    const gchar *name);
+
+void pulse_device_switch_sort_profiles(PulseDeviceSwitch *swtch);
+
 void pulse_device_switch_set_active_profile(PulseDeviceSwitch *swtch,
                                             PulseDeviceProfile *profile);
 
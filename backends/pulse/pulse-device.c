@@ -65,6 +65,9 @@ static const GList *pulse_device_list_switches(MateMixerDevice *mmd);
 
 static void pulse_device_load(PulseDevice *device, const pa_card_info *info);
 
+static void update_ports(PulseDevice *device, const pa_card_info *info);
+static void update_profiles(PulseDevice *device, const pa_card_info *info);
+
 static void free_list_streams(PulseDevice *device);
 
 static void pulse_device_class_init(PulseDeviceClass *klass) {
@@ -203,6 +206,15 @@ void pulse_device_update(PulseDevice *device, const pa_card_info *info) {
   g_return_if_fail(PULSE_IS_DEVICE(device));
   g_return_if_fail(info != NULL);
 
+  /* Cards are updated often, especially those with many profiles, existing
+   * ports and profiles are only updated in place and the switch only
+   * notifies about a changed active profile */
+  update_ports(device, info);
+
+  if (device->priv->pswitch == NULL) return;
+
+  update_profiles(device, info);
+
   if (G_LIKELY(info->active_profile2 != NULL))
     pulse_device_switch_set_active_profile_by_name(device->priv->pswitch,
                                                    info->active_profile2->name);
@@ -244,6 +256,14 @@ guint32 pulse_device_get_index(PulseDevice *device) {
   return device->priv->index;
 }
 
+void pulse_device_set_index(PulseDevice *device, guint32 index) {
+  g_return_if_fail(PULSE_IS_DEVICE(device));
+
+  /* The card is known under a new index after reconnecting to a restarted
+   * sound server */
+  device->priv->index = index;
+}
+
 PulseConnection *pulse_device_get_connection(PulseDevice *device) {
   g_return_val_if_fail(PULSE_IS_DEVICE(device), NULL);
 
@@ -303,31 +323,63 @@ static void pulse_device_load(PulseDevice *device, const pa_card_info *info) {
     g_hash_table_insert(device->priv->ports, g_strdup(name), port);
   }
 
-  /* Create the device profile switch */
+  /* Create the device profile switch, the profiles are filled in by
+   * pulse_device_update() */
   if (info->n_profiles > 0) {
     device->priv->pswitch =
         pulse_device_switch_new("profile", _("Profile"), device);
 
     device->priv->pswitch_list = g_list_prepend(NULL, device->priv->pswitch);
   }
+}
+
+static void update_ports(PulseDevice *device, const pa_card_info *info) {
+  guint i;
+
+  for (i = 0; i < info->n_ports; i++) {
+    PulsePort *port;
+
+    port = g_hash_table_lookup(device->priv->ports, info->ports[i]->name);
+    if (port != NULL) pulse_port_set_priority(port, info->ports[i]->priority);
+  }
+}
+
+static void update_profiles(PulseDevice *device, const pa_card_info *info) {
+  PulseDeviceSwitch *pswitch = device->priv->pswitch;
+  gboolean resort = FALSE;
+  guint i;
 
   for (i = 0; i < info->n_profiles; i++) {
     PulseDeviceProfile *profile;
 
     pa_card_profile_info2 *p_info = info->profiles2[i];
 
+    profile = pulse_device_switch_get_profile(pswitch, p_info->name);
+
     /* PulseAudio 5.0 includes a new pa_card_profile_info2 which only
      * differs in the new available flag, we use it not to include profiles
      * which are unavailable */
-    if (p_info->available == 0) continue;
-
-    profile = pulse_device_profile_new(p_info->name, p_info->description,
-                                       p_info->priority);
-
-    pulse_device_switch_add_profile(device->priv->pswitch, profile);
-
-    g_object_unref(profile);
+    if (p_info->available == 0) {
+      /* Never drop the profile which is about to become active */
+      if (profile != NULL && p_info != info->active_profile2)
+        pulse_device_switch_remove_profile(pswitch, profile);
+      continue;
+    }
+
+    if (profile == NULL) {
+      profile = pulse_device_profile_new(p_info->name, p_info->description,
+                                         p_info->priority);
+
+      pulse_device_switch_add_profile(pswitch, profile);
+      g_object_unref(profile);
+      continue;
+    }
+
+    if (pulse_device_profile_set_priority(profile, p_info->priority))
+      resort = TRUE;
   }
+
+  if (resort == TRUE) pulse_device_switch_sort_profiles(pswitch);
 }
 
 static void free_list_streams(PulseDevice *device) {
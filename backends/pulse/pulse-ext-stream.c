@@ -81,9 +81,11 @@ static MateMixerChannelPosition pulse_ext_stream_get_channel_position(
 static gboolean pulse_ext_stream_has_channel_position(
     MateMixerStreamControl *mmsc, MateMixerChannelPosition position);
 
+static gfloat pulse_ext_stream_get_balance(MateMixerStreamControl *mmsc);
 static gboolean pulse_ext_stream_set_balance(MateMixerStreamControl *mmsc,
                                              gfloat balance);
 
+static gfloat pulse_ext_stream_get_fade(MateMixerStreamControl *mmsc);
 static gboolean pulse_ext_stream_set_fade(MateMixerStreamControl *mmsc,
                                           gfloat fade);
 
@@ -119,7 +121,9 @@ static void pulse_ext_stream_class_init(PulseExtStreamClass *klass) {
   control_class->set_channel_volume = pulse_ext_stream_set_channel_volume;
   control_class->get_channel_position = pulse_ext_stream_get_channel_position;
   control_class->has_channel_position = pulse_ext_stream_has_channel_position;
+  control_class->get_balance = pulse_ext_stream_get_balance;
   control_class->set_balance = pulse_ext_stream_set_balance;
+  control_class->get_fade = pulse_ext_stream_get_fade;
   control_class->set_fade = pulse_ext_stream_set_fade;
   control_class->get_min_volume = pulse_ext_stream_get_min_volume;
   control_class->get_max_volume = pulse_ext_stream_get_max_volume;
@@ -200,7 +204,7 @@ static void pulse_ext_stream_finalize(GObject *object) {
   ext = PULSE_EXT_STREAM(object);
 
   if (ext->priv->app_info != NULL)
-    _mate_mixer_app_info_free(ext->priv->app_info);
+    _mate_mixer_app_info_unref(ext->priv->app_info);
 
   G_OBJECT_CLASS(pulse_ext_stream_parent_class)->finalize(object);
 }
@@ -272,7 +276,7 @@ PulseExtStream *pulse_ext_stream_new(PulseConnection *connection,
                      direction, "stream", parent, "connection", connection,
                      "app-info", app_info, NULL);
 
-  if (app_info != NULL) _mate_mixer_app_info_free(app_info);
+  if (app_info != NULL) _mate_mixer_app_info_unref(app_info);
 
   /* Store values which are expected to be changed */
   pulse_ext_stream_update(ext, info, parent);
@@ -482,6 +486,18 @@ static gboolean pulse_ext_stream_has_channel_position(
     return FALSE;
 }
 
+static gfloat pulse_ext_stream_get_balance(MateMixerStreamControl *mmsc) {
+  PulseExtStream *ext;
+
+  g_return_val_if_fail(PULSE_IS_EXT_STREAM(mmsc), 0.0f);
+
+  ext = PULSE_EXT_STREAM(mmsc);
+
+  /* PulseAudio returns the default 0.0f value on error, so skip checking
+   * validity of the channel map and cvolume */
+  return pa_cvolume_get_balance(&ext->priv->cvolume, &ext->priv->channel_map);
+}
+
 static gboolean pulse_ext_stream_set_balance(MateMixerStreamControl *mmsc,
                                              gfloat balance) {
   PulseExtStream *ext;
@@ -500,6 +516,16 @@ static gboolean pulse_ext_stream_set_balance(MateMixerStreamControl *mmsc,
   return write_cvolume(ext, &cvolume);
 }
 
+static gfloat pulse_ext_stream_get_fade(MateMixerStreamControl *mmsc) {
+  PulseExtStream *ext;
+
+  g_return_val_if_fail(PULSE_IS_EXT_STREAM(mmsc), 0.0f);
+
+  ext = PULSE_EXT_STREAM(mmsc);
+
+  return pa_cvolume_get_fade(&ext->priv->cvolume, &ext->priv->channel_map);
+}
+
 static gboolean pulse_ext_stream_set_fade(MateMixerStreamControl *mmsc,
                                           gfloat fade) {
   PulseExtStream *ext;
@@ -577,8 +603,6 @@ static gboolean write_cvolume(PulseExtStream *ext, const pa_cvolume *cvolume) {
 }
 
 static void store_cvolume(PulseExtStream *ext, const pa_cvolume *cvolume) {
-  gfloat value;
-
   /* Avoid validating whether the volume has changed, it should be done by
    * the caller */
   ext->priv->cvolume = *cvolume;
@@ -586,13 +610,6 @@ static void store_cvolume(PulseExtStream *ext, const pa_cvolume *cvolume) {
 
   g_object_notify(G_OBJECT(ext), "volume");
 
-  /* PulseAudio returns the default 0.0f value on error, so skip checking
-   * validity of the channel map and cvolume */
-  value = pa_cvolume_get_balance(&ext->priv->cvolume, &ext->priv->channel_map);
-
-  _mate_mixer_stream_control_set_balance(MATE_MIXER_STREAM_CONTROL(ext), value);
-
-  value = pa_cvolume_get_fade(&ext->priv->cvolume, &ext->priv->channel_map);
-
-  _mate_mixer_stream_control_set_fade(MATE_MIXER_STREAM_CONTROL(ext), value);
+  _mate_mixer_stream_control_invalidate_balance_fade(
+      MATE_MIXER_STREAM_CONTROL(ext));
 }
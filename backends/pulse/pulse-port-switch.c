@@ -29,9 +29,11 @@
 
 struct _PulsePortSwitchPrivate {
   GList *ports;
+  GHashTable *index;
 };
 
 static void pulse_port_switch_dispose(GObject *object);
+static void pulse_port_switch_finalize(GObject *object);
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE(PulsePortSwitch, pulse_port_switch,
                                     MATE_MIXER_TYPE_STREAM_SWITCH)
@@ -42,7 +44,6 @@ static gboolean pulse_port_switch_set_active_option(
 static const GList *pulse_port_switch_list_options(MateMixerSwitch *mms);
 
 static gint compare_ports(gconstpointer a, gconstpointer b);
-static gint compare_port_name(gconstpointer a, gconstpointer b);
 
 static void pulse_port_switch_class_init(PulsePortSwitchClass *klass) {
   GObjectClass *object_class;
@@ -50,6 +51,7 @@ static void pulse_port_switch_class_init(PulsePortSwitchClass *klass) {
 
   object_class = G_OBJECT_CLASS(klass);
   object_class->dispose = pulse_port_switch_dispose;
+  object_class->finalize = pulse_port_switch_finalize;
 
   switch_class = MATE_MIXER_SWITCH_CLASS(klass);
   switch_class->set_active_option = pulse_port_switch_set_active_option;
@@ -58,6 +60,9 @@ static void pulse_port_switch_class_init(PulsePortSwitchClass *klass) {
 
 static void pulse_port_switch_init(PulsePortSwitch *swtch) {
   swtch->priv = pulse_port_switch_get_instance_private(swtch);
+
+  /* Name lookup table, the keys and values are owned by the port list */
+  swtch->priv->index = g_hash_table_new(g_str_hash, g_str_equal);
 }
 
 static void pulse_port_switch_dispose(GObject *object) {
@@ -65,6 +70,8 @@ static void pulse_port_switch_dispose(GObject *object) {
 
   swtch = PULSE_PORT_SWITCH(object);
 
+  g_hash_table_remove_all(swtch->priv->index);
+
   if (swtch->priv->ports != NULL) {
     g_list_free_full(swtch->priv->ports, g_object_unref);
     swtch->priv->ports = NULL;
@@ -72,6 +79,16 @@ static void pulse_port_switch_dispose(GObject *object) {
   G_OBJECT_CLASS(pulse_port_switch_parent_class)->dispose(object);
 }
 
+static void pulse_port_switch_finalize(GObject *object) {
+  PulsePortSwitch *swtch;
+
+  swtch = PULSE_PORT_SWITCH(object);
+
+  g_hash_table_unref(swtch->priv->index);
+
+  G_OBJECT_CLASS(pulse_port_switch_parent_class)->finalize(object);
+}
+
 PulseStream *pulse_port_switch_get_stream(PulsePortSwitch *swtch) {
   g_return_val_if_fail(PULSE_IS_PORT_SWITCH(swtch), NULL);
 
@@ -85,6 +102,25 @@ void pulse_port_switch_add_port(PulsePortSwitch *swtch, PulsePort *port) {
 
   swtch->priv->ports =
       g_list_insert_sorted(swtch->priv->ports, port, compare_ports);
+
+  g_hash_table_insert(swtch->priv->index, (gpointer)pulse_port_get_name(port),
+                      port);
+}
+
+PulsePort *pulse_port_switch_get_port(PulsePortSwitch *swtch,
+                                      const gchar *name) {
+  g_return_val_if_fail(PULSE_IS_PORT_SWITCH(swtch), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  return g_hash_table_lookup(swtch->priv->index, name);
+}
+
+void pulse_port_switch_sort_ports(PulsePortSwitch *swtch) {
+  g_return_if_fail(PULSE_IS_PORT_SWITCH(swtch));
+
+  /* Called after port priorities have changed, the list is kept in
+   * the order of priorities */
+  swtch->priv->ports = g_list_sort(swtch->priv->ports, compare_ports);
 }
 
 void pulse_port_switch_set_active_port(PulsePortSwitch *swtch,
@@ -98,17 +134,17 @@ void pulse_port_switch_set_active_port(PulsePortSwitch *swtch,
 
 void pulse_port_switch_set_active_port_by_name(PulsePortSwitch *swtch,
                                                const gchar *name) {
-  GList *item;
+  PulsePort *port;
 
   g_return_if_fail(PULSE_IS_PORT_SWITCH(swtch));
   g_return_if_fail(name != NULL);
 
-  item = g_list_find_custom(swtch->priv->ports, name, compare_port_name);
-  if (G_UNLIKELY(item == NULL)) {
+  port = g_hash_table_lookup(swtch->priv->index, name);
+  if (G_UNLIKELY(port == NULL)) {
     g_debug("Invalid switch port name %s", name);
     return;
   }
-  pulse_port_switch_set_active_port(swtch, PULSE_PORT(item->data));
+  pulse_port_switch_set_active_port(swtch, port);
 }
 
 static gboolean pulse_port_switch_set_active_option(
@@ -133,10 +169,3 @@ static gint compare_ports(gconstpointer a, gconstpointer b) {
   return pulse_port_get_priority(PULSE_PORT(b)) -
          pulse_port_get_priority(PULSE_PORT(a));
 }
-
-static gint compare_port_name(gconstpointer a, gconstpointer b) {
-  PulsePort *port = PULSE_PORT(a);
-  const gchar *name = (const gchar *)b;
-
-  return strcmp(pulse_port_get_name(port), name);
-}
@@ -61,6 +61,11 @@ PulseStream *pulse_port_switch_get_stream(PulsePortSwitch *swtch);
 
 void pulse_port_switch_add_port(PulsePortSwitch *swtch, PulsePort *port);
 
+PulsePort *pulse_port_switch_get_port(PulsePortSwitch *swtch,
+                                      const gchar *name);
+
+void pulse_port_switch_sort_ports(PulsePortSwitch *swtch);
+
 void pulse_port_switch_set_active_port(PulsePortSwitch *swtch, PulsePort *port);
 
 void pulse_port_switch_set_active_port_by_name(PulsePortSwitch *swtch,
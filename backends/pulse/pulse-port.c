@@ -63,3 +63,12 @@ guint pulse_port_get_priority(PulsePort *port) {
 
   return port->priv->priority;
 }
+
+gboolean pulse_port_set_priority(PulsePort *port, guint priority) {
+  g_return_val_if_fail(PULSE_IS_PORT(port), FALSE);
+
+  if (port->priv->priority == priority) return FALSE;
+
+  port->priv->priority = priority;
+  return TRUE;
+}
@@ -58,6 +58,8 @@ PulsePort *pulse_port_new(const gchar *name, const gchar *label,
 const gchar *pulse_port_get_name(PulsePort *port);
 guint pulse_port_get_priority(PulsePort *port);
 
+gboolean pulse_port_set_priority(PulsePort *port, guint priority);
+
 G_END_DECLS
 
 #endif /* PULSE_PORT_H */
@@ -59,61 +59,88 @@ PulseSinkInput *pulse_sink_input_new(PulseConnection *connection,
                                      const pa_sink_input_info *info,
                                      PulseSink *parent) {
   PulseSinkInput *input;
-  gchar *name;
-  const gchar *prop;
-  const gchar *label = NULL;
-  MateMixerAppInfo *app_info = NULL;
+  PulseControlRecord *record;
 
-  MateMixerStreamControlFlags flags = MATE_MIXER_STREAM_CONTROL_MUTE_READABLE |
-                                      MATE_MIXER_STREAM_CONTROL_MUTE_WRITABLE |
-                                      MATE_MIXER_STREAM_CONTROL_HAS_MONITOR;
-  MateMixerStreamControlRole role = MATE_MIXER_STREAM_CONTROL_ROLE_UNKNOWN;
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
+  g_return_val_if_fail(info != NULL, NULL);
+  g_return_val_if_fail(PULSE_IS_SINK(parent), NULL);
+
+  record = pulse_sink_input_create_record(connection, info);
+  input = pulse_sink_input_new_from_record(connection, record, parent);
+
+  pulse_control_record_free(record);
+  return input;
+}
 
-  MateMixerStreamControlMediaRole media_role =
-      MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_UNKNOWN;
+PulseSinkInput *pulse_sink_input_new_from_record(PulseConnection *connection,
+                                                 PulseControlRecord *record,
+                                                 PulseSink *parent) {
+  PulseSinkInput *input;
 
   g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
-  g_return_val_if_fail(info != NULL, NULL);
+  g_return_val_if_fail(record != NULL, NULL);
   g_return_val_if_fail(PULSE_IS_SINK(parent), NULL);
 
+  input = g_object_new(PULSE_TYPE_SINK_INPUT, "name", record->name, "label",
+                       record->label, "flags", record->flags, "role",
+                       record->role, "media-role", record->media_role, "stream",
+                       parent, "connection", connection, "index",
+                       record->index, NULL);
+
+  if (record->app_info != NULL)
+    pulse_stream_control_set_app_info(PULSE_STREAM_CONTROL(input),
+                                      record->app_info, FALSE);
+
+  pulse_stream_control_apply_record(PULSE_STREAM_CONTROL(input), record);
+  return input;
+}
+
+PulseControlRecord *pulse_sink_input_create_record(
+    PulseConnection *connection, const pa_sink_input_info *info) {
+  PulseControlRecord *record;
+  const gchar *prop;
+  const gchar *label = NULL;
+
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
+  g_return_val_if_fail(info != NULL, NULL);
+
+  record = g_new0(PulseControlRecord, 1);
+  record->index = info->index;
+  record->flags = MATE_MIXER_STREAM_CONTROL_MUTE_READABLE |
+                  MATE_MIXER_STREAM_CONTROL_MUTE_WRITABLE |
+                  MATE_MIXER_STREAM_CONTROL_HAS_MONITOR;
+  record->role = MATE_MIXER_STREAM_CONTROL_ROLE_UNKNOWN;
+  record->media_role = MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_UNKNOWN;
+
   /* Many mixer applications query the Pulse client list and use the client
    * name here, but we use the name only as an identifier, so let's avoid
    * this unnecessary overhead and use a custom name.
    * Also make sure to make the name unique by including the PulseAudio index.
    */
-  name = g_strdup_printf("pulse-output-control-%lu", (gulong)info->index);
+  record->name =
+      g_strdup_printf("pulse-output-control-%lu", (gulong)info->index);
 
   if (info->has_volume) {
-    flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE |
-             MATE_MIXER_STREAM_CONTROL_HAS_DECIBEL;
+    record->flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE |
+                     MATE_MIXER_STREAM_CONTROL_HAS_DECIBEL;
 
     if (info->volume_writable)
-      flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE;
+      record->flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE;
   }
 
   if (info->client != PA_INVALID_INDEX) {
-    app_info = _mate_mixer_app_info_new();
-
-    role = MATE_MIXER_STREAM_CONTROL_ROLE_APPLICATION;
-
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_NAME);
-    if (prop != NULL) _mate_mixer_app_info_set_name(app_info, prop);
-
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_ID);
-    if (prop != NULL) _mate_mixer_app_info_set_id(app_info, prop);
-
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_VERSION);
-    if (prop != NULL) _mate_mixer_app_info_set_version(app_info, prop);
+    /* Shared with the other controls of the same client */
+    record->app_info = pulse_connection_get_app_info(connection, info->client,
+                                                     info->proplist);
 
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_ICON_NAME);
-    if (prop != NULL) _mate_mixer_app_info_set_icon(app_info, prop);
+    record->role = MATE_MIXER_STREAM_CONTROL_ROLE_APPLICATION;
   }
 
   prop = pa_proplist_gets(info->proplist, PA_PROP_MEDIA_ROLE);
   if (prop != NULL) {
-    media_role = pulse_convert_media_role_name(prop);
+    record->media_role = pulse_convert_media_role_name(prop);
 
-    if (media_role == MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_EVENT) {
+    if (record->media_role == MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_EVENT) {
       /* The event description seems to provide much better readable
        * description for event streams */
       prop = pa_proplist_gets(info->proplist, PA_PROP_EVENT_DESCRIPTION);
@@ -123,20 +150,20 @@ PulseSinkInput *pulse_sink_input_new(PulseConnection *connection,
 
   if (label == NULL) label = info->name;
 
-  input = g_object_new(PULSE_TYPE_SINK_INPUT, "name", name, "label", label,
-                       "flags", flags, "role", role, "media-role", media_role,
-                       "stream", parent, "connection", connection, "index",
-                       info->index, NULL);
-  g_free(name);
+  record->label = g_strdup(label);
 
-  if (app_info != NULL) {
-    /* Takes ownership of app_info */
-    pulse_stream_control_set_app_info(PULSE_STREAM_CONTROL(input), app_info,
-                                      TRUE);
-  }
+  pulse_sink_input_update_record(record, info);
+  return record;
+}
 
-  pulse_sink_input_update(input, info);
-  return input;
+void pulse_sink_input_update_record(PulseControlRecord *record,
+                                    const pa_sink_input_info *info) {
+  g_return_if_fail(record != NULL);
+  g_return_if_fail(info != NULL);
+
+  pulse_control_record_update(record, info->mute ? TRUE : FALSE,
+                              &info->channel_map,
+                              info->has_volume ? &info->volume : NULL);
 }
 
 void pulse_sink_input_update(PulseSinkInput *input,
@@ -144,21 +171,9 @@ void pulse_sink_input_update(PulseSinkInput *input,
   g_return_if_fail(PULSE_IS_SINK_INPUT(input));
   g_return_if_fail(info != NULL);
 
-  /* Let all the information update before emitting notify signals */
-  g_object_freeze_notify(G_OBJECT(input));
-
-  _mate_mixer_stream_control_set_mute(MATE_MIXER_STREAM_CONTROL(input),
-                                      info->mute ? TRUE : FALSE);
-
-  pulse_stream_control_set_channel_map(PULSE_STREAM_CONTROL(input),
-                                       &info->channel_map);
-  if (info->has_volume)
-    pulse_stream_control_set_cvolume(PULSE_STREAM_CONTROL(input), &info->volume,
-                                     0);
-  else
-    pulse_stream_control_set_cvolume(PULSE_STREAM_CONTROL(input), NULL, 0);
-
-  g_object_thaw_notify(G_OBJECT(input));
+  pulse_stream_control_update(PULSE_STREAM_CONTROL(input),
+                              info->mute ? TRUE : FALSE, &info->channel_map,
+                              info->has_volume ? &info->volume : NULL, 0);
 }
 
 static guint pulse_sink_input_get_max_volume(MateMixerStreamControl *mmsc) {
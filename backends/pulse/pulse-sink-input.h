@@ -55,9 +55,19 @@ PulseSinkInput *pulse_sink_input_new(PulseConnection *connection,
                                      const pa_sink_input_info *info,
                                      PulseSink *sink);
 
+PulseSinkInput *pulse_sink_input_new_from_record(PulseConnection *connection,
+                                                 PulseControlRecord *record,
+                                                 PulseSink *sink);
+
 void pulse_sink_input_update(PulseSinkInput *input,
                              const pa_sink_input_info *info);
 
+PulseControlRecord *pulse_sink_input_create_record(
+    PulseConnection *connection, const pa_sink_input_info *info);
+
+void pulse_sink_input_update_record(PulseControlRecord *record,
+                                    const pa_sink_input_info *info);
+
 G_END_DECLS
 
 #endif /* PULSE_SINK_INPUT_H */
@@ -23,6 +23,7 @@
 #include <libmatemixer/matemixer-private.h>
 #include <libmatemixer/matemixer.h>
 #include <pulse/pulseaudio.h>
+#include <string.h>
 
 #include "pulse-connection.h"
 #include "pulse-device.h"
@@ -37,7 +38,9 @@
 struct _PulseSinkPrivate {
   guint32 monitor;
   GHashTable *inputs;
+  GHashTable *records;
   GList *inputs_list;
+  gboolean lazy;
   PulsePortSwitch *pswitch;
   GList *pswitch_list;
   PulseSinkControl *control;
@@ -48,11 +51,29 @@ static void pulse_sink_finalize(GObject *object);
 
 G_DEFINE_TYPE_WITH_PRIVATE(PulseSink, pulse_sink, PULSE_TYPE_STREAM);
 
+static MateMixerStreamControl *pulse_sink_get_control(MateMixerStream *mms,
+                                                     const gchar *name);
+static MateMixerStreamControl *pulse_sink_peek_control(MateMixerStream *mms,
+                                                       const gchar *name);
+static GList *pulse_sink_list_loaded_controls(MateMixerStream *mms);
 static const GList *pulse_sink_list_controls(MateMixerStream *mms);
 static const GList *pulse_sink_list_switches(MateMixerStream *mms);
 
+static gboolean pulse_sink_move_controls(MateMixerStream *mms,
+                                         const GList *controls,
+                                         MateMixerStream *target, guint batch);
+static gboolean pulse_sink_kill_controls(MateMixerStream *mms,
+                                         const GList *controls, guint batch);
+
+static PulseSinkInput *create_input(PulseSink *sink,
+                                    PulseControlRecord *record);
+
+static GArray *collect_indices(PulseSink *sink, const GList *controls);
+
 static void free_list_controls(PulseSink *sink);
 
+static void update_ports(PulseSink *sink, const pa_sink_info *info);
+
 static void pulse_sink_class_init(PulseSinkClass *klass) {
   GObjectClass *object_class;
   MateMixerStreamClass *stream_class;
@@ -62,8 +83,13 @@ static void pulse_sink_class_init(PulseSinkClass *klass) {
   object_class->finalize = pulse_sink_finalize;
 
   stream_class = MATE_MIXER_STREAM_CLASS(klass);
+  stream_class->get_control = pulse_sink_get_control;
+  stream_class->peek_control = pulse_sink_peek_control;
+  stream_class->list_loaded_controls = pulse_sink_list_loaded_controls;
   stream_class->list_controls = pulse_sink_list_controls;
   stream_class->list_switches = pulse_sink_list_switches;
+  stream_class->move_controls = pulse_sink_move_controls;
+  stream_class->kill_controls = pulse_sink_kill_controls;
 }
 
 static void pulse_sink_init(PulseSink *sink) {
@@ -72,6 +98,12 @@ static void pulse_sink_init(PulseSink *sink) {
   sink->priv->inputs = g_hash_table_new_full(g_direct_hash, g_direct_equal,
                                              NULL, g_object_unref);
 
+  /* Compact records of the inputs which have only been announced, see
+   * pulse_sink_set_lazy_controls() */
+  sink->priv->records =
+      g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                            (GDestroyNotify)pulse_control_record_free);
+
   sink->priv->monitor = PA_INVALID_INDEX;
 }
 
@@ -81,6 +113,7 @@ static void pulse_sink_dispose(GObject *object) {
   sink = PULSE_SINK(object);
 
   g_hash_table_remove_all(sink->priv->inputs);
+  g_hash_table_remove_all(sink->priv->records);
 
   g_clear_object(&sink->priv->control);
   g_clear_object(&sink->priv->pswitch);
@@ -100,6 +133,7 @@ static void pulse_sink_finalize(GObject *object) {
   sink = PULSE_SINK(object);
 
   g_hash_table_unref(sink->priv->inputs);
+  g_hash_table_unref(sink->priv->records);
 
   G_OBJECT_CLASS(pulse_sink_parent_class)->finalize(object);
 }
@@ -159,8 +193,17 @@ PulseSink *pulse_sink_new(PulseConnection *connection, const pa_sink_info *info,
   return sink;
 }
 
+void pulse_sink_set_lazy_controls(PulseSink *sink, gboolean lazy) {
+  g_return_if_fail(PULSE_IS_SINK(sink));
+
+  sink->priv->lazy = lazy;
+}
+
 gboolean pulse_sink_add_input(PulseSink *sink, const pa_sink_input_info *info) {
   PulseSinkInput *input;
+  PulseControlRecord *record;
+  PulseConnection *connection;
+  const gchar *name;
 
   g_return_val_if_fail(PULSE_IS_SINK(sink), FALSE);
   g_return_val_if_fail(info != NULL, FALSE);
@@ -168,40 +211,62 @@ gboolean pulse_sink_add_input(PulseSink *sink, const pa_sink_input_info *info) {
   /* This function is used for both creating and refreshing sink inputs */
   input =
       g_hash_table_lookup(sink->priv->inputs, GUINT_TO_POINTER(info->index));
-  if (input == NULL) {
-    const gchar *name;
-    PulseConnection *connection;
+  if (input != NULL) {
+    pulse_sink_input_update(input, info);
+    return FALSE;
+  }
 
-    connection = pulse_stream_get_connection(PULSE_STREAM(sink));
-    input = pulse_sink_input_new(connection, info, sink);
+  record =
+      g_hash_table_lookup(sink->priv->records, GUINT_TO_POINTER(info->index));
+  if (record != NULL) {
+    pulse_sink_input_update_record(record, info);
+    return FALSE;
+  }
+
+  connection = pulse_stream_get_connection(PULSE_STREAM(sink));
+
+  if (sink->priv->lazy == TRUE) {
+    /* Only keep the record until the control is listed or looked up */
+    record = pulse_sink_input_create_record(connection, info);
+    g_hash_table_insert(sink->priv->records, GUINT_TO_POINTER(info->index),
+                        record);
 
+    name = record->name;
+  } else {
+    input = pulse_sink_input_new(connection, info, sink);
     g_hash_table_insert(sink->priv->inputs, GUINT_TO_POINTER(info->index),
                         input);
 
-    free_list_controls(sink);
-
     name = mate_mixer_stream_control_get_name(MATE_MIXER_STREAM_CONTROL(input));
-    g_signal_emit_by_name(G_OBJECT(sink), "control-added", name);
-    return TRUE;
   }
 
-  pulse_sink_input_update(input, info);
-  return FALSE;
+  free_list_controls(sink);
+
+  g_signal_emit_by_name(G_OBJECT(sink), "control-added", name);
+  return TRUE;
 }
 
 void pulse_sink_remove_input(PulseSink *sink, guint32 index) {
   PulseSinkInput *input;
+  PulseControlRecord *record;
   gchar *name;
 
   g_return_if_fail(PULSE_IS_SINK(sink));
 
-  input = g_hash_table_lookup(sink->priv->inputs, GUINT_TO_POINTER(index));
-  if (G_UNLIKELY(input == NULL)) return;
+  record = g_hash_table_lookup(sink->priv->records, GUINT_TO_POINTER(index));
+  if (record != NULL) {
+    name = g_strdup(record->name);
 
-  name = g_strdup(
-      mate_mixer_stream_control_get_name(MATE_MIXER_STREAM_CONTROL(input)));
+    g_hash_table_remove(sink->priv->records, GUINT_TO_POINTER(index));
+  } else {
+    input = g_hash_table_lookup(sink->priv->inputs, GUINT_TO_POINTER(index));
+    if (G_UNLIKELY(input == NULL)) return;
 
-  g_hash_table_remove(sink->priv->inputs, GUINT_TO_POINTER(index));
+    name = g_strdup(
+        mate_mixer_stream_control_get_name(MATE_MIXER_STREAM_CONTROL(input)));
+
+    g_hash_table_remove(sink->priv->inputs, GUINT_TO_POINTER(index));
+  }
 
   free_list_controls(sink);
   g_signal_emit_by_name(G_OBJECT(sink), "control-removed", name);
@@ -212,6 +277,8 @@ void pulse_sink_update(PulseSink *sink, const pa_sink_info *info) {
   g_return_if_fail(PULSE_IS_SINK(sink));
   g_return_if_fail(info != NULL);
 
+  update_ports(sink, info);
+
   /* The switch doesn't allow being unset, PulseAudio should always include
    * the active port name if the are any ports available */
   if (info->active_port != NULL)
@@ -229,6 +296,83 @@ guint32 pulse_sink_get_index_monitor(PulseSink *sink) {
   return sink->priv->monitor;
 }
 
+void pulse_sink_reset_monitor(PulseSink *sink) {
+  g_return_if_fail(PULSE_IS_SINK(sink));
+
+  pulse_stream_control_reset_monitor(
+      PULSE_STREAM_CONTROL(sink->priv->control));
+}
+
+static MateMixerStreamControl *pulse_sink_get_control(MateMixerStream *mms,
+                                                     const gchar *name) {
+  PulseSink *sink;
+  PulseSinkInput *input;
+  MateMixerStreamControl *control;
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_val_if_fail(PULSE_IS_SINK(mms), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  control = pulse_sink_peek_control(mms, name);
+  if (control != NULL) return control;
+
+  sink = PULSE_SINK(mms);
+
+  /* Only create the control which has been looked up */
+  g_hash_table_iter_init(&iter, sink->priv->records);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    PulseControlRecord *record = value;
+
+    if (strcmp(name, record->name) == 0) {
+      input = create_input(sink, record);
+
+      g_hash_table_iter_remove(&iter);
+
+      _mate_mixer_stream_control_loaded(mms, MATE_MIXER_STREAM_CONTROL(input));
+      return MATE_MIXER_STREAM_CONTROL(input);
+    }
+  }
+  return NULL;
+}
+
+static MateMixerStreamControl *pulse_sink_peek_control(MateMixerStream *mms,
+                                                       const gchar *name) {
+  PulseSink *sink;
+  MateMixerStreamControl *control;
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_val_if_fail(PULSE_IS_SINK(mms), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  sink = PULSE_SINK(mms);
+
+  control = MATE_MIXER_STREAM_CONTROL(sink->priv->control);
+  if (strcmp(name, mate_mixer_stream_control_get_name(control)) == 0)
+    return control;
+
+  g_hash_table_iter_init(&iter, sink->priv->inputs);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    control = MATE_MIXER_STREAM_CONTROL(value);
+
+    if (strcmp(name, mate_mixer_stream_control_get_name(control)) == 0)
+      return control;
+  }
+  return NULL;
+}
+
+static GList *pulse_sink_list_loaded_controls(MateMixerStream *mms) {
+  PulseSink *sink;
+
+  g_return_val_if_fail(PULSE_IS_SINK(mms), NULL);
+
+  sink = PULSE_SINK(mms);
+
+  return g_list_prepend(g_hash_table_get_values(sink->priv->inputs),
+                        sink->priv->control);
+}
+
 static const GList *pulse_sink_list_controls(MateMixerStream *mms) {
   PulseSink *sink;
 
@@ -237,12 +381,32 @@ static const GList *pulse_sink_list_controls(MateMixerStream *mms) {
   sink = PULSE_SINK(mms);
 
   if (sink->priv->inputs_list == NULL) {
+    GHashTableIter iter;
+    gpointer value;
+    GSList *loaded = NULL;
+
+    /* Create the controls which have only been announced so far */
+    g_hash_table_iter_init(&iter, sink->priv->records);
+    while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+      loaded = g_slist_prepend(loaded, create_input(sink, value));
+
+      g_hash_table_iter_remove(&iter);
+    }
+
     sink->priv->inputs_list = g_hash_table_get_values(sink->priv->inputs);
     if (sink->priv->inputs_list != NULL)
       g_list_foreach(sink->priv->inputs_list, (GFunc)g_object_ref, NULL);
 
     sink->priv->inputs_list = g_list_prepend(sink->priv->inputs_list,
                                              g_object_ref(sink->priv->control));
+
+    /* Announce them once the list is complete */
+    while (loaded != NULL) {
+      _mate_mixer_stream_control_loaded(
+          mms, MATE_MIXER_STREAM_CONTROL(loaded->data));
+
+      loaded = g_slist_delete_link(loaded, loaded);
+    }
   }
   return sink->priv->inputs_list;
 }
@@ -253,6 +417,115 @@ static const GList *pulse_sink_list_switches(MateMixerStream *mms) {
   return PULSE_SINK(mms)->priv->pswitch_list;
 }
 
+static gboolean pulse_sink_move_controls(MateMixerStream *mms,
+                                         const GList *controls,
+                                         MateMixerStream *target, guint batch) {
+  PulseSink *sink;
+  GArray *indices;
+  gboolean ret;
+
+  g_return_val_if_fail(PULSE_IS_SINK(mms), FALSE);
+
+  if (PULSE_IS_SINK(target) == FALSE) return FALSE;
+
+  sink = PULSE_SINK(mms);
+
+  indices = collect_indices(sink, controls);
+  if (indices == NULL) return FALSE;
+
+  ret = pulse_connection_move_sink_inputs(
+      pulse_stream_get_connection(PULSE_STREAM(sink)),
+      (const guint32 *)indices->data, indices->len,
+      pulse_stream_get_index(PULSE_STREAM(target)),
+      (PulseBatchFunc)pulse_stream_batch_finished,
+      pulse_stream_batch_new(PULSE_STREAM(sink), batch),
+      (GDestroyNotify)pulse_stream_batch_free);
+
+  g_array_free(indices, TRUE);
+  return ret;
+}
+
+static gboolean pulse_sink_kill_controls(MateMixerStream *mms,
+                                         const GList *controls, guint batch) {
+  PulseSink *sink;
+  GArray *indices;
+  gboolean ret;
+
+  g_return_val_if_fail(PULSE_IS_SINK(mms), FALSE);
+
+  sink = PULSE_SINK(mms);
+
+  indices = collect_indices(sink, controls);
+  if (indices == NULL) return FALSE;
+
+  ret = pulse_connection_kill_sink_inputs(
+      pulse_stream_get_connection(PULSE_STREAM(sink)),
+      (const guint32 *)indices->data, indices->len,
+      (PulseBatchFunc)pulse_stream_batch_finished,
+      pulse_stream_batch_new(PULSE_STREAM(sink), batch),
+      (GDestroyNotify)pulse_stream_batch_free);
+
+  g_array_free(indices, TRUE);
+  return ret;
+}
+
+static PulseSinkInput *create_input(PulseSink *sink,
+                                    PulseControlRecord *record) {
+  PulseSinkInput *input;
+
+  input = pulse_sink_input_new_from_record(
+      pulse_stream_get_connection(PULSE_STREAM(sink)), record, sink);
+
+  g_hash_table_insert(sink->priv->inputs, GUINT_TO_POINTER(record->index),
+                      input);
+  return input;
+}
+
+static GArray *collect_indices(PulseSink *sink, const GList *controls) {
+  GArray *indices;
+  guint32 index;
+
+  indices = g_array_new(FALSE, FALSE, sizeof(guint32));
+
+  if (controls == NULL) {
+    GHashTableIter iter;
+    gpointer key;
+
+    /* All the application controls, including the ones which have not
+     * been created yet */
+    g_hash_table_iter_init(&iter, sink->priv->inputs);
+    while (g_hash_table_iter_next(&iter, &key, NULL) == TRUE) {
+      index = GPOINTER_TO_UINT(key);
+      g_array_append_val(indices, index);
+    }
+
+    g_hash_table_iter_init(&iter, sink->priv->records);
+    while (g_hash_table_iter_next(&iter, &key, NULL) == TRUE) {
+      index = GPOINTER_TO_UINT(key);
+      g_array_append_val(indices, index);
+    }
+    return indices;
+  }
+
+  while (controls != NULL) {
+    MateMixerStreamControl *control = MATE_MIXER_STREAM_CONTROL(controls->data);
+
+    /* Only the application controls of this sink are accepted */
+    if (PULSE_IS_SINK_INPUT(control) == FALSE ||
+        mate_mixer_stream_control_get_stream(control) !=
+            MATE_MIXER_STREAM(sink)) {
+      g_array_free(indices, TRUE);
+      return NULL;
+    }
+
+    index = pulse_stream_control_get_index(PULSE_STREAM_CONTROL(control));
+    g_array_append_val(indices, index);
+
+    controls = controls->next;
+  }
+  return indices;
+}
+
 static void free_list_controls(PulseSink *sink) {
   if (sink->priv->inputs_list == NULL) return;
 
@@ -260,3 +533,23 @@ static void free_list_controls(PulseSink *sink) {
 
   sink->priv->inputs_list = NULL;
 }
+
+static void update_ports(PulseSink *sink, const pa_sink_info *info) {
+  gboolean resort = FALSE;
+  guint i;
+
+  if (sink->priv->pswitch == NULL) return;
+
+  /* Only the priorities of the existing ports may change, the list is
+   * re-sorted when any of them did */
+  for (i = 0; i < info->n_ports; i++) {
+    PulsePort *port;
+
+    port = pulse_port_switch_get_port(sink->priv->pswitch,
+                                      info->ports[i]->name);
+    if (port != NULL && pulse_port_set_priority(port, info->ports[i]->priority))
+      resort = TRUE;
+  }
+
+  if (resort == TRUE) pulse_port_switch_sort_ports(sink->priv->pswitch);
+}
@@ -56,6 +56,8 @@ GType pulse_sink_get_type(void) G_GNUC_CONST;
 PulseSink *pulse_sink_new(PulseConnection *connection, const pa_sink_info *info,
                           PulseDevice *device);
 
+void pulse_sink_set_lazy_controls(PulseSink *sink, gboolean lazy);
+
 gboolean pulse_sink_add_input(PulseSink *sink, const pa_sink_input_info *info);
 
 void pulse_sink_remove_input(PulseSink *sink, guint32 index);
@@ -64,6 +66,8 @@ void pulse_sink_update(PulseSink *sink, const pa_sink_info *info);
 
 guint32 pulse_sink_get_index_monitor(PulseSink *sink);
 
+void pulse_sink_reset_monitor(PulseSink *sink);
+
 G_END_DECLS
 
 #endif /* PULSE_SINK_H */
@@ -87,19 +87,9 @@ void pulse_source_control_update(PulseSourceControl *control,
   g_return_if_fail(PULSE_IS_SOURCE_CONTROL(control));
   g_return_if_fail(info != NULL);
 
-  /* Let all the information update before emitting notify signals */
-  g_object_freeze_notify(G_OBJECT(control));
-
-  _mate_mixer_stream_control_set_mute(MATE_MIXER_STREAM_CONTROL(control),
-                                      info->mute ? TRUE : FALSE);
-
-  pulse_stream_control_set_channel_map(PULSE_STREAM_CONTROL(control),
-                                       &info->channel_map);
-
-  pulse_stream_control_set_cvolume(PULSE_STREAM_CONTROL(control), &info->volume,
-                                   info->base_volume);
-
-  g_object_thaw_notify(G_OBJECT(control));
+  pulse_stream_control_update(PULSE_STREAM_CONTROL(control),
+                              info->mute ? TRUE : FALSE, &info->channel_map,
+                              &info->volume, info->base_volume);
 }
 
 static gboolean pulse_source_control_set_mute(PulseStreamControl *psc,
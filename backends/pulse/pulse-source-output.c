@@ -61,72 +61,99 @@ PulseSourceOutput *pulse_source_output_new(PulseConnection *connection,
                                            const pa_source_output_info *info,
                                            PulseSource *parent) {
   PulseSourceOutput *output;
-  gchar *name;
-  const gchar *prop;
-  MateMixerAppInfo *app_info = NULL;
+  PulseControlRecord *record;
+
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
+  g_return_val_if_fail(info != NULL, NULL);
+  g_return_val_if_fail(PULSE_IS_SOURCE(parent), NULL);
 
-  MateMixerStreamControlFlags flags = MATE_MIXER_STREAM_CONTROL_MUTE_READABLE |
-                                      MATE_MIXER_STREAM_CONTROL_MUTE_WRITABLE |
-                                      MATE_MIXER_STREAM_CONTROL_HAS_MONITOR;
-  MateMixerStreamControlRole role = MATE_MIXER_STREAM_CONTROL_ROLE_UNKNOWN;
+  record = pulse_source_output_create_record(connection, info);
+  output = pulse_source_output_new_from_record(connection, record, parent);
 
-  MateMixerStreamControlMediaRole media_role =
-      MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_UNKNOWN;
+  pulse_control_record_free(record);
+  return output;
+}
+
+PulseSourceOutput *pulse_source_output_new_from_record(
+    PulseConnection *connection, PulseControlRecord *record,
+    PulseSource *parent) {
+  PulseSourceOutput *output;
 
   g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
-  g_return_val_if_fail(info != NULL, NULL);
+  g_return_val_if_fail(record != NULL, NULL);
   g_return_val_if_fail(PULSE_IS_SOURCE(parent), NULL);
 
+  output = g_object_new(PULSE_TYPE_SOURCE_OUTPUT, "name", record->name,
+                        "label", record->label, "flags", record->flags, "role",
+                        record->role, "media-role", record->media_role,
+                        "stream", parent, "connection", connection, "index",
+                        record->index, NULL);
+
+  if (record->app_info != NULL)
+    pulse_stream_control_set_app_info(PULSE_STREAM_CONTROL(output),
+                                      record->app_info, FALSE);
+
+  pulse_stream_control_apply_record(PULSE_STREAM_CONTROL(output), record);
+  return output;
+}
+
+PulseControlRecord *pulse_source_output_create_record(
+    PulseConnection *connection, const pa_source_output_info *info) {
+  PulseControlRecord *record;
+  const gchar *prop;
+
+  g_return_val_if_fail(PULSE_IS_CONNECTION(connection), NULL);
+  g_return_val_if_fail(info != NULL, NULL);
+
+  record = g_new0(PulseControlRecord, 1);
+  record->index = info->index;
+  record->flags = MATE_MIXER_STREAM_CONTROL_MUTE_READABLE |
+                  MATE_MIXER_STREAM_CONTROL_MUTE_WRITABLE |
+                  MATE_MIXER_STREAM_CONTROL_HAS_MONITOR;
+  record->role = MATE_MIXER_STREAM_CONTROL_ROLE_UNKNOWN;
+  record->media_role = MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_UNKNOWN;
+
   /* Many mixer applications query the Pulse client list and use the client
    * name here, but we use the name only as an identifier, so let's avoid
    * this unnecessary overhead and use a custom name.
    * Also make sure to make the name unique by including the PulseAudio index.
    */
-  name = g_strdup_printf("pulse-input-control-%lu", (gulong)info->index);
+  record->name =
+      g_strdup_printf("pulse-input-control-%lu", (gulong)info->index);
 
   if (info->has_volume) {
-    flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE |
-             MATE_MIXER_STREAM_CONTROL_HAS_DECIBEL;
+    record->flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE |
+                     MATE_MIXER_STREAM_CONTROL_HAS_DECIBEL;
 
     if (info->volume_writable)
-      flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE;
+      record->flags |= MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE;
   }
 
   if (info->client != PA_INVALID_INDEX) {
-    app_info = _mate_mixer_app_info_new();
+    /* Shared with the other controls of the same client */
+    record->app_info = pulse_connection_get_app_info(connection, info->client,
+                                                     info->proplist);
 
-    role = MATE_MIXER_STREAM_CONTROL_ROLE_APPLICATION;
-
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_NAME);
-    if (prop != NULL) _mate_mixer_app_info_set_name(app_info, prop);
+    record->role = MATE_MIXER_STREAM_CONTROL_ROLE_APPLICATION;
+  }
 
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_ID);
-    if (prop != NULL) _mate_mixer_app_info_set_id(app_info, prop);
+  prop = pa_proplist_gets(info->proplist, PA_PROP_MEDIA_ROLE);
+  if (prop != NULL) record->media_role = pulse_convert_media_role_name(prop);
 
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_VERSION);
-    if (prop != NULL) _mate_mixer_app_info_set_version(app_info, prop);
+  record->label = g_strdup(info->name);
 
-    prop = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_ICON_NAME);
-    if (prop != NULL) _mate_mixer_app_info_set_icon(app_info, prop);
-  }
+  pulse_source_output_update_record(record, info);
+  return record;
+}
 
-  prop = pa_proplist_gets(info->proplist, PA_PROP_MEDIA_ROLE);
-  if (prop != NULL) media_role = pulse_convert_media_role_name(prop);
-
-  output = g_object_new(PULSE_TYPE_SOURCE_OUTPUT, "name", name, "label",
-                        info->name, "flags", flags, "role", role, "media-role",
-                        media_role, "stream", parent, "connection", connection,
-                        "index", info->index, NULL);
-  g_free(name);
-
-  if (app_info != NULL) {
-    /* Takes ownership of app_info */
-    pulse_stream_control_set_app_info(PULSE_STREAM_CONTROL(output), app_info,
-                                      TRUE);
-  }
+void pulse_source_output_update_record(PulseControlRecord *record,
+                                       const pa_source_output_info *info) {
+  g_return_if_fail(record != NULL);
+  g_return_if_fail(info != NULL);
 
-  pulse_source_output_update(output, info);
-  return output;
+  pulse_control_record_update(record, info->mute ? TRUE : FALSE,
+                              &info->channel_map,
+                              info->has_volume ? &info->volume : NULL);
 }
 
 void pulse_source_output_update(PulseSourceOutput *output,
@@ -134,21 +161,9 @@ void pulse_source_output_update(PulseSourceOutput *output,
   g_return_if_fail(PULSE_IS_SOURCE_OUTPUT(output));
   g_return_if_fail(info != NULL);
 
-  /* Let all the information update before emitting notify signals */
-  g_object_freeze_notify(G_OBJECT(output));
-
-  _mate_mixer_stream_control_set_mute(MATE_MIXER_STREAM_CONTROL(output),
-                                      info->mute ? TRUE : FALSE);
-
-  pulse_stream_control_set_channel_map(PULSE_STREAM_CONTROL(output),
-                                       &info->channel_map);
-  if (info->has_volume)
-    pulse_stream_control_set_cvolume(PULSE_STREAM_CONTROL(output),
-                                     &info->volume, 0);
-  else
-    pulse_stream_control_set_cvolume(PULSE_STREAM_CONTROL(output), NULL, 0);
-
-  g_object_thaw_notify(G_OBJECT(output));
+  pulse_stream_control_update(PULSE_STREAM_CONTROL(output),
+                              info->mute ? TRUE : FALSE, &info->channel_map,
+                              info->has_volume ? &info->volume : NULL, 0);
 }
 
 static guint pulse_source_output_get_max_volume(MateMixerStreamControl *mmsc) {
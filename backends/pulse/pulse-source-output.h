@@ -57,9 +57,19 @@ PulseSourceOutput *pulse_source_output_new(PulseConnection *connection,
                                            const pa_source_output_info *info,
                                            PulseSource *source);
 
+PulseSourceOutput *pulse_source_output_new_from_record(
+    PulseConnection *connection, PulseControlRecord *record,
+    PulseSource *source);
+
 void pulse_source_output_update(PulseSourceOutput *output,
                                 const pa_source_output_info *info);
 
+PulseControlRecord *pulse_source_output_create_record(
+    PulseConnection *connection, const pa_source_output_info *info);
+
+void pulse_source_output_update_record(PulseControlRecord *record,
+                                       const pa_source_output_info *info);
+
 G_END_DECLS
 
 #endif /* PULSE_SOURCE_OUTPUT_H */
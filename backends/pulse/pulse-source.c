@@ -23,6 +23,7 @@
 #include <libmatemixer/matemixer-private.h>
 #include <libmatemixer/matemixer.h>
 #include <pulse/pulseaudio.h>
+#include <string.h>
 
 #include "pulse-connection.h"
 #include "pulse-device.h"
@@ -36,7 +37,9 @@
 
 struct _PulseSourcePrivate {
   GHashTable *outputs;
+  GHashTable *records;
   GList *outputs_list;
+  gboolean lazy;
   PulsePortSwitch *pswitch;
   GList *pswitch_list;
   PulseSourceControl *control;
@@ -47,11 +50,30 @@ static void pulse_source_finalize(GObject *object);
 
 G_DEFINE_TYPE_WITH_PRIVATE(PulseSource, pulse_source, PULSE_TYPE_STREAM);
 
+static MateMixerStreamControl *pulse_source_get_control(MateMixerStream *mms,
+                                                       const gchar *name);
+static MateMixerStreamControl *pulse_source_peek_control(MateMixerStream *mms,
+                                                         const gchar *name);
+static GList *pulse_source_list_loaded_controls(MateMixerStream *mms);
 static const GList *pulse_source_list_controls(MateMixerStream *mms);
 static const GList *pulse_source_list_switches(MateMixerStream *mms);
 
+static gboolean pulse_source_move_controls(MateMixerStream *mms,
+                                           const GList *controls,
+                                           MateMixerStream *target,
+                                           guint batch);
+static gboolean pulse_source_kill_controls(MateMixerStream *mms,
+                                           const GList *controls, guint batch);
+
+static PulseSourceOutput *create_output(PulseSource *source,
+                                        PulseControlRecord *record);
+
+static GArray *collect_indices(PulseSource *source, const GList *controls);
+
 static void free_list_controls(PulseSource *source);
 
+static void update_ports(PulseSource *source, const pa_source_info *info);
+
 static void pulse_source_class_init(PulseSourceClass *klass) {
   GObjectClass *object_class;
   MateMixerStreamClass *stream_class;
@@ -61,8 +83,13 @@ static void pulse_source_class_init(PulseSourceClass *klass) {
   object_class->finalize = pulse_source_finalize;
 
   stream_class = MATE_MIXER_STREAM_CLASS(klass);
+  stream_class->get_control = pulse_source_get_control;
+  stream_class->peek_control = pulse_source_peek_control;
+  stream_class->list_loaded_controls = pulse_source_list_loaded_controls;
   stream_class->list_controls = pulse_source_list_controls;
   stream_class->list_switches = pulse_source_list_switches;
+  stream_class->move_controls = pulse_source_move_controls;
+  stream_class->kill_controls = pulse_source_kill_controls;
 }
 
 static void pulse_source_init(PulseSource *source) {
@@ -70,6 +97,12 @@ static void pulse_source_init(PulseSource *source) {
 
   source->priv->outputs = g_hash_table_new_full(g_direct_hash, g_direct_equal,
                                                 NULL, g_object_unref);
+
+  /* Compact records of the outputs which have only been announced, see
+   * pulse_source_set_lazy_controls() */
+  source->priv->records =
+      g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                            (GDestroyNotify)pulse_control_record_free);
 }
 
 static void pulse_source_dispose(GObject *object) {
@@ -78,6 +111,7 @@ static void pulse_source_dispose(GObject *object) {
   source = PULSE_SOURCE(object);
 
   g_hash_table_remove_all(source->priv->outputs);
+  g_hash_table_remove_all(source->priv->records);
 
   g_clear_object(&source->priv->control);
   g_clear_object(&source->priv->pswitch);
@@ -97,6 +131,7 @@ static void pulse_source_finalize(GObject *object) {
   source = PULSE_SOURCE(object);
 
   g_hash_table_unref(source->priv->outputs);
+  g_hash_table_unref(source->priv->records);
 
   G_OBJECT_CLASS(pulse_source_parent_class)->finalize(object);
 }
@@ -158,9 +193,18 @@ PulseSource *pulse_source_new(PulseConnection *connection,
   return source;
 }
 
+void pulse_source_set_lazy_controls(PulseSource *source, gboolean lazy) {
+  g_return_if_fail(PULSE_IS_SOURCE(source));
+
+  source->priv->lazy = lazy;
+}
+
 gboolean pulse_source_add_output(PulseSource *source,
                                  const pa_source_output_info *info) {
   PulseSourceOutput *output;
+  PulseControlRecord *record;
+  PulseConnection *connection;
+  const gchar *name;
 
   g_return_val_if_fail(PULSE_IS_SOURCE(source), FALSE);
   g_return_val_if_fail(info != NULL, FALSE);
@@ -168,40 +212,64 @@ gboolean pulse_source_add_output(PulseSource *source,
   /* This function is used for both creating and refreshing source outputs */
   output =
       g_hash_table_lookup(source->priv->outputs, GUINT_TO_POINTER(info->index));
-  if (output == NULL) {
-    const gchar *name;
-    PulseConnection *connection;
+  if (output != NULL) {
+    pulse_source_output_update(output, info);
+    return FALSE;
+  }
+
+  record =
+      g_hash_table_lookup(source->priv->records, GUINT_TO_POINTER(info->index));
+  if (record != NULL) {
+    pulse_source_output_update_record(record, info);
+    return FALSE;
+  }
+
+  connection = pulse_stream_get_connection(PULSE_STREAM(source));
+
+  if (source->priv->lazy == TRUE) {
+    /* Only keep the record until the control is listed or looked up */
+    record = pulse_source_output_create_record(connection, info);
+    g_hash_table_insert(source->priv->records, GUINT_TO_POINTER(info->index),
+                        record);
 
-    connection = pulse_stream_get_connection(PULSE_STREAM(source));
+    name = record->name;
+  } else {
     output = pulse_source_output_new(connection, info, source);
     g_hash_table_insert(source->priv->outputs, GUINT_TO_POINTER(info->index),
                         output);
 
-    free_list_controls(source);
-
     name =
         mate_mixer_stream_control_get_name(MATE_MIXER_STREAM_CONTROL(output));
-    g_signal_emit_by_name(G_OBJECT(source), "control-added", name);
-    return TRUE;
   }
 
-  pulse_source_output_update(output, info);
-  return FALSE;
+  free_list_controls(source);
+
+  g_signal_emit_by_name(G_OBJECT(source), "control-added", name);
+  return TRUE;
 }
 
 void pulse_source_remove_output(PulseSource *source, guint32 index) {
   PulseSourceOutput *output;
+  PulseControlRecord *record;
   gchar *name;
 
   g_return_if_fail(PULSE_IS_SOURCE(source));
 
-  output = g_hash_table_lookup(source->priv->outputs, GUINT_TO_POINTER(index));
-  if (G_UNLIKELY(output == NULL)) return;
+  record = g_hash_table_lookup(source->priv->records, GUINT_TO_POINTER(index));
+  if (record != NULL) {
+    name = g_strdup(record->name);
 
-  name = g_strdup(
-      mate_mixer_stream_control_get_name(MATE_MIXER_STREAM_CONTROL(output)));
+    g_hash_table_remove(source->priv->records, GUINT_TO_POINTER(index));
+  } else {
+    output =
+        g_hash_table_lookup(source->priv->outputs, GUINT_TO_POINTER(index));
+    if (G_UNLIKELY(output == NULL)) return;
 
-  g_hash_table_remove(source->priv->outputs, GUINT_TO_POINTER(index));
+    name = g_strdup(
+        mate_mixer_stream_control_get_name(MATE_MIXER_STREAM_CONTROL(output)));
+
+    g_hash_table_remove(source->priv->outputs, GUINT_TO_POINTER(index));
+  }
 
   free_list_controls(source);
   g_signal_emit_by_name(G_OBJECT(source), "control-removed", name);
@@ -212,6 +280,8 @@ void pulse_source_update(PulseSource *source, const pa_source_info *info) {
   g_return_if_fail(PULSE_IS_SOURCE(source));
   g_return_if_fail(info != NULL);
 
+  update_ports(source, info);
+
   /* The switch doesn't allow being unset, PulseAudio should always include
    * the active port name if the are any ports available */
   if (info->active_port != NULL)
@@ -221,6 +291,83 @@ void pulse_source_update(PulseSource *source, const pa_source_info *info) {
   pulse_source_control_update(source->priv->control, info);
 }
 
+void pulse_source_reset_monitor(PulseSource *source) {
+  g_return_if_fail(PULSE_IS_SOURCE(source));
+
+  pulse_stream_control_reset_monitor(
+      PULSE_STREAM_CONTROL(source->priv->control));
+}
+
+static MateMixerStreamControl *pulse_source_get_control(MateMixerStream *mms,
+                                                       const gchar *name) {
+  PulseSource *source;
+  PulseSourceOutput *output;
+  MateMixerStreamControl *control;
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_val_if_fail(PULSE_IS_SOURCE(mms), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  control = pulse_source_peek_control(mms, name);
+  if (control != NULL) return control;
+
+  source = PULSE_SOURCE(mms);
+
+  /* Only create the control which has been looked up */
+  g_hash_table_iter_init(&iter, source->priv->records);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    PulseControlRecord *record = value;
+
+    if (strcmp(name, record->name) == 0) {
+      output = create_output(source, record);
+
+      g_hash_table_iter_remove(&iter);
+
+      _mate_mixer_stream_control_loaded(mms, MATE_MIXER_STREAM_CONTROL(output));
+      return MATE_MIXER_STREAM_CONTROL(output);
+    }
+  }
+  return NULL;
+}
+
+static MateMixerStreamControl *pulse_source_peek_control(MateMixerStream *mms,
+                                                         const gchar *name) {
+  PulseSource *source;
+  MateMixerStreamControl *control;
+  GHashTableIter iter;
+  gpointer value;
+
+  g_return_val_if_fail(PULSE_IS_SOURCE(mms), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  source = PULSE_SOURCE(mms);
+
+  control = MATE_MIXER_STREAM_CONTROL(source->priv->control);
+  if (strcmp(name, mate_mixer_stream_control_get_name(control)) == 0)
+    return control;
+
+  g_hash_table_iter_init(&iter, source->priv->outputs);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+    control = MATE_MIXER_STREAM_CONTROL(value);
+
+    if (strcmp(name, mate_mixer_stream_control_get_name(control)) == 0)
+      return control;
+  }
+  return NULL;
+}
+
+static GList *pulse_source_list_loaded_controls(MateMixerStream *mms) {
+  PulseSource *source;
+
+  g_return_val_if_fail(PULSE_IS_SOURCE(mms), NULL);
+
+  source = PULSE_SOURCE(mms);
+
+  return g_list_prepend(g_hash_table_get_values(source->priv->outputs),
+                        source->priv->control);
+}
+
 static const GList *pulse_source_list_controls(MateMixerStream *mms) {
   PulseSource *source;
 
@@ -229,12 +376,32 @@ static const GList *pulse_source_list_controls(MateMixerStream *mms) {
   source = PULSE_SOURCE(mms);
 
   if (source->priv->outputs_list == NULL) {
+    GHashTableIter iter;
+    gpointer value;
+    GSList *loaded = NULL;
+
+    /* Create the controls which have only been announced so far */
+    g_hash_table_iter_init(&iter, source->priv->records);
+    while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE) {
+      loaded = g_slist_prepend(loaded, create_output(source, value));
+
+      g_hash_table_iter_remove(&iter);
+    }
+
     source->priv->outputs_list = g_hash_table_get_values(source->priv->outputs);
     if (source->priv->outputs_list != NULL)
       g_list_foreach(source->priv->outputs_list, (GFunc)g_object_ref, NULL);
 
     source->priv->outputs_list = g_list_prepend(
         source->priv->outputs_list, g_object_ref(source->priv->control));
+
+    /* Announce them once the list is complete */
+    while (loaded != NULL) {
+      _mate_mixer_stream_control_loaded(
+          mms, MATE_MIXER_STREAM_CONTROL(loaded->data));
+
+      loaded = g_slist_delete_link(loaded, loaded);
+    }
   }
   return source->priv->outputs_list;
 }
@@ -245,6 +412,116 @@ static const GList *pulse_source_list_switches(MateMixerStream *mms) {
   return PULSE_SOURCE(mms)->priv->pswitch_list;
 }
 
+static gboolean pulse_source_move_controls(MateMixerStream *mms,
+                                           const GList *controls,
+                                           MateMixerStream *target,
+                                           guint batch) {
+  PulseSource *source;
+  GArray *indices;
+  gboolean ret;
+
+  g_return_val_if_fail(PULSE_IS_SOURCE(mms), FALSE);
+
+  if (PULSE_IS_SOURCE(target) == FALSE) return FALSE;
+
+  source = PULSE_SOURCE(mms);
+
+  indices = collect_indices(source, controls);
+  if (indices == NULL) return FALSE;
+
+  ret = pulse_connection_move_source_outputs(
+      pulse_stream_get_connection(PULSE_STREAM(source)),
+      (const guint32 *)indices->data, indices->len,
+      pulse_stream_get_index(PULSE_STREAM(target)),
+      (PulseBatchFunc)pulse_stream_batch_finished,
+      pulse_stream_batch_new(PULSE_STREAM(source), batch),
+      (GDestroyNotify)pulse_stream_batch_free);
+
+  g_array_free(indices, TRUE);
+  return ret;
+}
+
+static gboolean pulse_source_kill_controls(MateMixerStream *mms,
+                                           const GList *controls, guint batch) {
+  PulseSource *source;
+  GArray *indices;
+  gboolean ret;
+
+  g_return_val_if_fail(PULSE_IS_SOURCE(mms), FALSE);
+
+  source = PULSE_SOURCE(mms);
+
+  indices = collect_indices(source, controls);
+  if (indices == NULL) return FALSE;
+
+  ret = pulse_connection_kill_source_outputs(
+      pulse_stream_get_connection(PULSE_STREAM(source)),
+      (const guint32 *)indices->data, indices->len,
+      (PulseBatchFunc)pulse_stream_batch_finished,
+      pulse_stream_batch_new(PULSE_STREAM(source), batch),
+      (GDestroyNotify)pulse_stream_batch_free);
+
+  g_array_free(indices, TRUE);
+  return ret;
+}
+
+static PulseSourceOutput *create_output(PulseSource *source,
+                                        PulseControlRecord *record) {
+  PulseSourceOutput *output;
+
+  output = pulse_source_output_new_from_record(
+      pulse_stream_get_connection(PULSE_STREAM(source)), record, source);
+
+  g_hash_table_insert(source->priv->outputs, GUINT_TO_POINTER(record->index),
+                      output);
+  return output;
+}
+
+static GArray *collect_indices(PulseSource *source, const GList *controls) {
+  GArray *indices;
+  guint32 index;
+
+  indices = g_array_new(FALSE, FALSE, sizeof(guint32));
+
+  if (controls == NULL) {
+    GHashTableIter iter;
+    gpointer key;
+
+    /* All the application controls, including the ones which have not
+     * been created yet */
+    g_hash_table_iter_init(&iter, source->priv->outputs);
+    while (g_hash_table_iter_next(&iter, &key, NULL) == TRUE) {
+      index = GPOINTER_TO_UINT(key);
+      g_array_append_val(indices, index);
+    }
+
+    g_hash_table_iter_init(&iter, source->priv->records);
+    while (g_hash_table_iter_next(&iter, &key, NULL) == TRUE) {
+      index = GPOINTER_TO_UINT(key);
+      g_array_append_val(indices, index);
+    }
+    return indices;
+  }
+
+  while (controls != NULL) {
+    MateMixerStreamControl *control = MATE_MIXER_STREAM_CONTROL(controls->data);
+
+    /* Only the application controls of this source are accepted */
+    if (PULSE_IS_SOURCE_OUTPUT(control) == FALSE ||
+        mate_mixer_stream_control_get_stream(control) !=
+            MATE_MIXER_STREAM(source)) {
+      g_array_free(indices, TRUE);
+      return NULL;
+    }
+
+    index = pulse_stream_control_get_index(PULSE_STREAM_CONTROL(control));
+    g_array_append_val(indices, index);
+
+    controls = controls->next;
+  }
+  return indices;
+}
+
 static void free_list_controls(PulseSource *source) {
   if (source->priv->outputs_list == NULL) return;
 
@@ -252,3 +529,23 @@ static void free_list_controls(PulseSource *source) {
 
   source->priv->outputs_list = NULL;
 }
+
+static void update_ports(PulseSource *source, const pa_source_info *info) {
+  gboolean resort = FALSE;
+  guint i;
+
+  if (source->priv->pswitch == NULL) return;
+
+  /* Only the priorities of the existing ports may change, the list is
+   * re-sorted when any of them did */
+  for (i = 0; i < info->n_ports; i++) {
+    PulsePort *port;
+
+    port = pulse_port_switch_get_port(source->priv->pswitch,
+                                      info->ports[i]->name);
+    if (port != NULL && pulse_port_set_priority(port, info->ports[i]->priority))
+      resort = TRUE;
+  }
+
+  if (resort == TRUE) pulse_port_switch_sort_ports(source->priv->pswitch);
+}
@@ -57,6 +57,8 @@ GType pulse_source_get_type(void) G_GNUC_CONST;
 PulseSource *pulse_source_new(PulseConnection *connection,
                               const pa_source_info *info, PulseDevice *device);
 
+void pulse_source_set_lazy_controls(PulseSource *source, gboolean lazy);
+
 gboolean pulse_source_add_output(PulseSource *source,
                                  const pa_source_output_info *info);
 
@@ -64,6 +66,8 @@ void pulse_source_remove_output(PulseSource *source, guint32 index);
 
 void pulse_source_update(PulseSource *source, const pa_source_info *info);
 
+void pulse_source_reset_monitor(PulseSource *source);
+
 G_END_DECLS
 
 #endif /* PULSE_SOURCE_H */
@@ -78,6 +78,8 @@ static guint pulse_stream_control_get_channel_volume(
     MateMixerStreamControl *mmsc, guint channel);
 static gboolean pulse_stream_control_set_channel_volume(
     MateMixerStreamControl *mmsc, guint channel, guint volume);
+static gboolean pulse_stream_control_set_channel_volumes(
+    MateMixerStreamControl *mmsc, const guint *volumes, guint channels);
 
 static gdouble pulse_stream_control_get_channel_decibel(
     MateMixerStreamControl *mmsc, guint channel);
@@ -89,9 +91,11 @@ static MateMixerChannelPosition pulse_stream_control_get_channel_position(
 static gboolean pulse_stream_control_has_channel_position(
     MateMixerStreamControl *mmsc, MateMixerChannelPosition position);
 
+static gfloat pulse_stream_control_get_balance(MateMixerStreamControl *mmsc);
 static gboolean pulse_stream_control_set_balance(MateMixerStreamControl *mmsc,
                                                  gfloat balance);
 
+static gfloat pulse_stream_control_get_fade(MateMixerStreamControl *mmsc);
 static gboolean pulse_stream_control_set_fade(MateMixerStreamControl *mmsc,
                                               gfloat fade);
 
@@ -109,7 +113,10 @@ static guint pulse_stream_control_get_base_volume(MateMixerStreamControl *mmsc);
 static void on_monitor_value(PulseMonitor *monitor, gdouble value,
                              PulseStreamControl *control);
 
-static void set_balance_fade(PulseStreamControl *control);
+static gboolean is_unchanged(PulseStreamControl *control, gboolean mute,
+                             const pa_channel_map *map,
+                             const pa_cvolume *cvolume,
+                             pa_volume_t base_volume);
 
 static gboolean set_cvolume(PulseStreamControl *control, pa_cvolume *cvolume);
 
@@ -139,7 +146,9 @@ static void pulse_stream_control_class_init(PulseStreamControlClass *klass) {
       pulse_stream_control_get_channel_position;
   control_class->has_channel_position =
       pulse_stream_control_has_channel_position;
+  control_class->get_balance = pulse_stream_control_get_balance;
   control_class->set_balance = pulse_stream_control_set_balance;
+  control_class->get_fade = pulse_stream_control_get_fade;
   control_class->set_fade = pulse_stream_control_set_fade;
   control_class->get_monitor_enabled = pulse_stream_control_get_monitor_enabled;
   control_class->set_monitor_enabled = pulse_stream_control_set_monitor_enabled;
@@ -147,6 +156,7 @@ static void pulse_stream_control_class_init(PulseStreamControlClass *klass) {
   control_class->get_max_volume = pulse_stream_control_get_max_volume;
   control_class->get_normal_volume = pulse_stream_control_get_normal_volume;
   control_class->get_base_volume = pulse_stream_control_get_base_volume;
+  control_class->set_channel_volumes = pulse_stream_control_set_channel_volumes;
 
   properties[PROP_INDEX] = g_param_spec_uint(
       "index", "Index", "Index of the stream control", 0, G_MAXUINT, 0,
@@ -227,7 +237,7 @@ static void pulse_stream_control_finalize(GObject *object) {
   control = PULSE_STREAM_CONTROL(object);
 
   if (control->priv->app_info != NULL)
-    _mate_mixer_app_info_free(control->priv->app_info);
+    _mate_mixer_app_info_unref(control->priv->app_info);
 
   G_OBJECT_CLASS(pulse_stream_control_parent_class)->finalize(object);
 }
@@ -263,6 +273,26 @@ PulseMonitor *pulse_stream_control_get_monitor(PulseStreamControl *control) {
   return control->priv->monitor;
 }
 
+void pulse_stream_control_reset_monitor(PulseStreamControl *control) {
+  gboolean enabled;
+
+  g_return_if_fail(PULSE_IS_STREAM_CONTROL(control));
+
+  if (control->priv->monitor == NULL) return;
+
+  /* The monitor records through the connection it was created with, after
+   * reconnecting it is replaced by a new one if it was enabled */
+  enabled = pulse_monitor_get_enabled(control->priv->monitor);
+
+  g_signal_handlers_disconnect_by_func(G_OBJECT(control->priv->monitor),
+                                       G_CALLBACK(on_monitor_value), control);
+  g_clear_object(&control->priv->monitor);
+
+  if (enabled == TRUE)
+    pulse_stream_control_set_monitor_enabled(
+        MATE_MIXER_STREAM_CONTROL(control), TRUE);
+}
+
 const pa_cvolume *pulse_stream_control_get_cvolume(
     PulseStreamControl *control) {
   g_return_val_if_fail(PULSE_IS_STREAM_CONTROL(control), NULL);
@@ -282,12 +312,12 @@ void pulse_stream_control_set_app_info(PulseStreamControl *control,
   g_return_if_fail(PULSE_IS_STREAM_CONTROL(control));
 
   if (G_UNLIKELY(control->priv->app_info != NULL))
-    _mate_mixer_app_info_free(control->priv->app_info);
+    _mate_mixer_app_info_unref(control->priv->app_info);
 
   if (take == TRUE)
     control->priv->app_info = info;
   else
-    control->priv->app_info = _mate_mixer_app_info_copy(info);
+    control->priv->app_info = _mate_mixer_app_info_ref(info);
 }
 
 void pulse_stream_control_set_channel_map(PulseStreamControl *control,
@@ -370,9 +400,87 @@ void pulse_stream_control_set_cvolume(PulseStreamControl *control,
                                        flags);
 
   /* Changing volume may change the balance and fade values as well */
-  set_balance_fade(control);
+  _mate_mixer_stream_control_invalidate_balance_fade(
+      MATE_MIXER_STREAM_CONTROL(control));
+
+  g_object_thaw_notify(G_OBJECT(control));
+}
+
+gboolean pulse_stream_control_update(PulseStreamControl *control,
+                                     gboolean mute, const pa_channel_map *map,
+                                     const pa_cvolume *cvolume,
+                                     pa_volume_t base_volume) {
+  g_return_val_if_fail(PULSE_IS_STREAM_CONTROL(control), FALSE);
+  g_return_val_if_fail(map != NULL, FALSE);
+
+  /* Most change events only concern values which are not exposed, such as
+   * the latency or the property list, drop these before running any of the
+   * setters */
+  if (is_unchanged(control, mute, map, cvolume, base_volume) == TRUE) {
+    pulse_connection_count_update(control->priv->connection, TRUE);
+    return FALSE;
+  }
+  pulse_connection_count_update(control->priv->connection, FALSE);
+
+  /* Let all the information update before emitting notify signals */
+  g_object_freeze_notify(G_OBJECT(control));
+
+  _mate_mixer_stream_control_set_mute(MATE_MIXER_STREAM_CONTROL(control),
+                                      mute);
+
+  pulse_stream_control_set_channel_map(control, map);
+  pulse_stream_control_set_cvolume(control, cvolume, base_volume);
 
   g_object_thaw_notify(G_OBJECT(control));
+  return TRUE;
+}
+
+void pulse_stream_control_apply_record(PulseStreamControl *control,
+                                       PulseControlRecord *record) {
+  g_return_if_fail(PULSE_IS_STREAM_CONTROL(control));
+  g_return_if_fail(record != NULL);
+
+  /* Let all the information update before emitting notify signals */
+  g_object_freeze_notify(G_OBJECT(control));
+
+  _mate_mixer_stream_control_set_mute(MATE_MIXER_STREAM_CONTROL(control),
+                                      record->mute);
+
+  pulse_stream_control_set_channel_map(control, &record->channel_map);
+  if (record->has_volume)
+    pulse_stream_control_set_cvolume(control, &record->cvolume, 0);
+  else
+    pulse_stream_control_set_cvolume(control, NULL, 0);
+
+  g_object_thaw_notify(G_OBJECT(control));
+}
+
+void pulse_control_record_update(PulseControlRecord *record, gboolean mute,
+                                 const pa_channel_map *map,
+                                 const pa_cvolume *cvolume) {
+  g_return_if_fail(record != NULL);
+  g_return_if_fail(map != NULL);
+
+  record->mute = mute;
+  record->channel_map = *map;
+
+  if (cvolume != NULL) {
+    record->has_volume = TRUE;
+    record->cvolume = *cvolume;
+  } else {
+    record->has_volume = FALSE;
+    pa_cvolume_init(&record->cvolume);
+  }
+}
+
+void pulse_control_record_free(PulseControlRecord *record) {
+  if (record == NULL) return;
+
+  if (record->app_info != NULL) _mate_mixer_app_info_unref(record->app_info);
+
+  g_free(record->name);
+  g_free(record->label);
+  g_free(record);
 }
 
 static MateMixerAppInfo *pulse_stream_control_get_app_info(
@@ -467,6 +575,25 @@ static gboolean pulse_stream_control_set_channel_volume(
   return set_cvolume(control, &cvolume);
 }
 
+static gboolean pulse_stream_control_set_channel_volumes(
+    MateMixerStreamControl *mmsc, const guint *volumes, guint channels) {
+  PulseStreamControl *control;
+  pa_cvolume cvolume;
+  guint i;
+
+  g_return_val_if_fail(PULSE_IS_STREAM_CONTROL(mmsc), FALSE);
+
+  control = PULSE_STREAM_CONTROL(mmsc);
+
+  if (channels != control->priv->cvolume.channels) return FALSE;
+
+  /* The whole volume is sent to the server in a single request */
+  cvolume = control->priv->cvolume;
+  for (i = 0; i < channels; i++) cvolume.values[i] = (pa_volume_t)volumes[i];
+
+  return set_cvolume(control, &cvolume);
+}
+
 static gdouble pulse_stream_control_get_channel_decibel(
     MateMixerStreamControl *mmsc, guint channel) {
   PulseStreamControl *control;
@@ -529,6 +656,19 @@ static gboolean pulse_stream_control_has_channel_position(
     return FALSE;
 }
 
+static gfloat pulse_stream_control_get_balance(MateMixerStreamControl *mmsc) {
+  PulseStreamControl *control;
+
+  g_return_val_if_fail(PULSE_IS_STREAM_CONTROL(mmsc), 0.0f);
+
+  control = PULSE_STREAM_CONTROL(mmsc);
+
+  /* PulseAudio returns the default 0.0f value on error, so skip checking
+   * validity of the channel map and cvolume */
+  return pa_cvolume_get_balance(&control->priv->cvolume,
+                                &control->priv->channel_map);
+}
+
 static gboolean pulse_stream_control_set_balance(MateMixerStreamControl *mmsc,
                                                  gfloat balance) {
   PulseStreamControl *control;
@@ -546,6 +686,17 @@ static gboolean pulse_stream_control_set_balance(MateMixerStreamControl *mmsc,
   return set_cvolume(control, &cvolume);
 }
 
+static gfloat pulse_stream_control_get_fade(MateMixerStreamControl *mmsc) {
+  PulseStreamControl *control;
+
+  g_return_val_if_fail(PULSE_IS_STREAM_CONTROL(mmsc), 0.0f);
+
+  control = PULSE_STREAM_CONTROL(mmsc);
+
+  return pa_cvolume_get_fade(&control->priv->cvolume,
+                             &control->priv->channel_map);
+}
+
 static gboolean pulse_stream_control_set_fade(MateMixerStreamControl *mmsc,
                                               gfloat fade) {
   PulseStreamControl *control;
@@ -651,24 +802,6 @@ static void on_monitor_value(PulseMonitor *monitor, gdouble value,
   g_signal_emit_by_name(G_OBJECT(control), "monitor-value", value);
 }
 
-static void set_balance_fade(PulseStreamControl *control) {
-  gfloat value;
-
-  /* PulseAudio returns the default 0.0f value on error, so skip checking
-   * validity of the channel map and cvolume */
-  value = pa_cvolume_get_balance(&control->priv->cvolume,
-                                 &control->priv->channel_map);
-
-  _mate_mixer_stream_control_set_balance(MATE_MIXER_STREAM_CONTROL(control),
-                                         value);
-
-  value =
-      pa_cvolume_get_fade(&control->priv->cvolume, &control->priv->channel_map);
-
-  _mate_mixer_stream_control_set_fade(MATE_MIXER_STREAM_CONTROL(control),
-                                      value);
-}
-
 static gboolean set_cvolume(PulseStreamControl *control, pa_cvolume *cvolume) {
   PulseStreamControlClass *klass;
 
@@ -685,6 +818,32 @@ static gboolean set_cvolume(PulseStreamControl *control, pa_cvolume *cvolume) {
   g_object_notify(G_OBJECT(control), "volume");
 
   /* Changing volume may change the balance and fade values as well */
-  set_balance_fade(control);
+  _mate_mixer_stream_control_invalidate_balance_fade(
+      MATE_MIXER_STREAM_CONTROL(control));
   return TRUE;
 }
+
+static gboolean is_unchanged(PulseStreamControl *control, gboolean mute,
+                             const pa_channel_map *map,
+                             const pa_cvolume *cvolume,
+                             pa_volume_t base_volume) {
+  /* The stored state serves as the fingerprint of the exposed values, an
+   * invalid channel map never matches, which also makes the initial update
+   * of a new control go through the setters */
+  if (mate_mixer_stream_control_get_mute(MATE_MIXER_STREAM_CONTROL(control)) !=
+      mute)
+    return FALSE;
+
+  if (control->priv->base_volume != base_volume) return FALSE;
+
+  if (pa_channel_map_valid(map) == 0 ||
+      pa_channel_map_valid(&control->priv->channel_map) == 0 ||
+      pa_channel_map_equal(&control->priv->channel_map, map) == 0)
+    return FALSE;
+
+  if (cvolume != NULL)
+    return pa_cvolume_valid(cvolume) != 0 &&
+           pa_cvolume_equal(&control->priv->cvolume, cvolume) != 0;
+
+  return pa_cvolume_valid(&control->priv->cvolume) == 0;
+}
@@ -62,6 +62,22 @@ struct _PulseStreamControlClass {
   PulseMonitor *(*create_monitor)(PulseStreamControl *control);
 };
 
+/* Compact form of an application stream control which has not been
+ * created yet, it holds everything needed to create the control */
+struct _PulseControlRecord {
+  guint32 index;
+  gchar *name;
+  gchar *label;
+  MateMixerStreamControlFlags flags;
+  MateMixerStreamControlRole role;
+  MateMixerStreamControlMediaRole media_role;
+  MateMixerAppInfo *app_info;
+  gboolean mute;
+  gboolean has_volume;
+  pa_cvolume cvolume;
+  pa_channel_map channel_map;
+};
+
 GType pulse_stream_control_get_type(void) G_GNUC_CONST;
 
 guint32 pulse_stream_control_get_index(PulseStreamControl *control);
@@ -70,6 +86,7 @@ guint32 pulse_stream_control_get_stream_index(PulseStreamControl *control);
 PulseConnection *pulse_stream_control_get_connection(
     PulseStreamControl *control);
 PulseMonitor *pulse_stream_control_get_monitor(PulseStreamControl *control);
+void pulse_stream_control_reset_monitor(PulseStreamControl *control);
 
 const pa_cvolume *pulse_stream_control_get_cvolume(PulseStreamControl *control);
 const pa_channel_map *pulse_stream_control_get_channel_map(
@@ -84,6 +101,19 @@ void pulse_stream_control_set_cvolume(PulseStreamControl *control,
                                       const pa_cvolume *cvolume,
                                       pa_volume_t base_volume);
 
+gboolean pulse_stream_control_update(PulseStreamControl *control,
+                                     gboolean mute, const pa_channel_map *map,
+                                     const pa_cvolume *cvolume,
+                                     pa_volume_t base_volume);
+
+void pulse_stream_control_apply_record(PulseStreamControl *control,
+                                       PulseControlRecord *record);
+
+void pulse_control_record_update(PulseControlRecord *record, gboolean mute,
+                                 const pa_channel_map *map,
+                                 const pa_cvolume *cvolume);
+void pulse_control_record_free(PulseControlRecord *record);
+
 G_END_DECLS
 
 #endif /* PULSE_STREAM_CONTROL_H */
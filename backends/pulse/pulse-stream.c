@@ -34,6 +34,12 @@ struct _PulseStreamPrivate {
   PulseConnection *connection;
 };
 
+/* Completion data of a batch of operations requested by the stream */
+struct _PulseStreamBatch {
+  PulseStream *stream;
+  guint batch;
+};
+
 enum { PROP_0, PROP_INDEX, PROP_CONNECTION, N_PROPERTIES };
 
 static GParamSpec *properties[N_PROPERTIES] = {
@@ -128,6 +134,14 @@ guint32 pulse_stream_get_index(PulseStream *stream) {
   return stream->priv->index;
 }
 
+void pulse_stream_set_index(PulseStream *stream, guint32 index) {
+  g_return_if_fail(PULSE_IS_STREAM(stream));
+
+  /* The stream is known under a new index after reconnecting to a restarted
+   * sound server */
+  stream->priv->index = index;
+}
+
 PulseConnection *pulse_stream_get_connection(PulseStream *stream) {
   g_return_val_if_fail(PULSE_IS_STREAM(stream), NULL);
 
@@ -144,3 +158,28 @@ PulseDevice *pulse_stream_get_device(PulseStream *stream) {
 
   return NULL;
 }
+
+PulseStreamBatch *pulse_stream_batch_new(PulseStream *stream, guint batch) {
+  PulseStreamBatch *data;
+
+  g_return_val_if_fail(PULSE_IS_STREAM(stream), NULL);
+
+  data = g_new0(PulseStreamBatch, 1);
+  data->stream = g_object_ref(stream);
+  data->batch = batch;
+  return data;
+}
+
+void pulse_stream_batch_finished(gboolean success, PulseStreamBatch *data) {
+  g_return_if_fail(data != NULL);
+
+  _mate_mixer_stream_finish_batch(MATE_MIXER_STREAM(data->stream), data->batch,
+                                  success);
+}
+
+void pulse_stream_batch_free(PulseStreamBatch *data) {
+  if (data == NULL) return;
+
+  g_object_unref(data->stream);
+  g_free(data);
+}
@@ -22,6 +22,7 @@ G_BEGIN_DECLS
 
 typedef struct _PulseBackend PulseBackend;
 typedef struct _PulseConnection PulseConnection;
+typedef struct _PulseControlRecord PulseControlRecord;
 typedef struct _PulseDevice PulseDevice;
 typedef struct _PulseDeviceProfile PulseDeviceProfile;
 typedef struct _PulseDeviceSwitch PulseDeviceSwitch;
@@ -38,6 +39,7 @@ typedef struct _PulseSourceControl PulseSourceControl;
 typedef struct _PulseSourceOutput PulseSourceOutput;
 typedef struct _PulseSourceSwitch PulseSourceSwitch;
 typedef struct _PulseStream PulseStream;
+typedef struct _PulseStreamBatch PulseStreamBatch;
 typedef struct _PulseStreamControl PulseStreamControl;
 
 G_END_DECLS
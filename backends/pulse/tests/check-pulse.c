@@ -0,0 +1,561 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libmatemixer/matemixer.h>
+#include <libmatemixer/matemixer-private.h>
+#include <libmatemixer/matemixer-stream-private.h>
+
+#include "pulse-fake.h"
+
+/* How long to wait for the backend to settle before the check fails */
+#define CHECK_TIMEOUT 5000
+
+/* Delay of every reply of the simulated server, so that the replies are
+ * interleaved with the main loop like with a real server */
+#define CHECK_LATENCY 5
+
+#define CARD_NAME "alsa_card.pci-0000_00_1b.0"
+#define SINK_NAME "alsa_output.pci-0000_00_1b.0.analog-stereo"
+#define HDMI_SINK_NAME "alsa_output.pci-0000_00_1b.0.hdmi-stereo"
+#define SOURCE_NAME "alsa_input.pci-0000_00_1b.0.analog-stereo"
+#define EVENT_NAME "sink-input-by-media-role:event"
+#define PLAYER_NAME "sink-input-by-application-name:Player"
+
+typedef struct {
+  const gchar *name;
+  void (*run)(void);
+} Scenario;
+
+typedef struct {
+  guint devices_added;
+  guint devices_removed;
+  guint streams_added;
+  guint streams_removed;
+  guint stored_added;
+  guint stored_removed;
+  guint states;
+  guint ready_streams;
+  guint ready_devices;
+} Counters;
+
+static MateMixerContext *context;
+static Counters counters;
+static const gchar *failure;
+
+static guint32 sink_index;
+static guint32 inputs[3];
+
+static guint controls_added;
+static guint controls_loaded;
+
+static guint volume_changes;
+static MateMixerStreamControl *volume_control;
+
+static guint batches_finished;
+static guint finished_batch;
+static gboolean finished_success;
+static gboolean batch_returned;
+static gboolean batch_early;
+
+/* Record the first failed expectation of the scenario */
+static gboolean expect(gboolean condition, const gchar *reason) {
+  if (condition == FALSE && failure == NULL) failure = reason;
+
+  return condition;
+}
+
+/* Run the main loop until the simulated server has delivered everything and
+ * no other source of the main context is ready to be dispatched */
+static gboolean settle(void) {
+  gint64 end;
+
+  end = g_get_monotonic_time() + CHECK_TIMEOUT * G_TIME_SPAN_MILLISECOND;
+
+  while (g_get_monotonic_time() < end) {
+    if (g_main_context_iteration(NULL, FALSE) == TRUE) continue;
+
+    if (pulse_fake_is_idle() == TRUE) return TRUE;
+
+    g_usleep(G_TIME_SPAN_MILLISECOND);
+  }
+  return FALSE;
+}
+
+static void on_count(gpointer instance, const gchar *name, guint *count) {
+  (*count)++;
+}
+
+static void on_context_state_notify(MateMixerContext *context,
+                                    GParamSpec *pspec) {
+  counters.states++;
+
+  if (mate_mixer_context_get_state(context) != MATE_MIXER_STATE_READY) return;
+
+  /* What the application sees at the moment it is told the context is ready */
+  counters.ready_streams =
+      g_list_length((GList *)mate_mixer_context_list_streams(context));
+  counters.ready_devices =
+      g_list_length((GList *)mate_mixer_context_list_devices(context));
+}
+
+static void on_control_loaded(MateMixerStream *stream,
+                              MateMixerStreamControl *control) {
+  controls_loaded++;
+}
+
+static void on_volume_notify(MateMixerStreamControl *control,
+                             GParamSpec *pspec) {
+  volume_changes++;
+  volume_control = control;
+}
+
+static void on_batch_finished(MateMixerStream *stream, guint batch,
+                              gboolean success) {
+  /* The signal must not be emitted from inside the function which starts
+   * the batch */
+  if (batch_returned == FALSE) batch_early = TRUE;
+
+  batches_finished++;
+  finished_batch = batch;
+  finished_success = success;
+}
+
+static void populate(guint n_inputs) {
+  guint32 card;
+  guint i;
+
+  card = pulse_fake_add(PULSE_FAKE_CARD, CARD_NAME, PA_INVALID_INDEX);
+
+  sink_index = pulse_fake_add(PULSE_FAKE_SINK, SINK_NAME, card);
+
+  pulse_fake_add(PULSE_FAKE_SINK, HDMI_SINK_NAME, card);
+  pulse_fake_add(PULSE_FAKE_SOURCE, SOURCE_NAME, card);
+
+  for (i = 0; i < n_inputs && i < G_N_ELEMENTS(inputs); i++) {
+    gchar *name = g_strdup_printf("Player %u", i);
+
+    inputs[i] = pulse_fake_add(PULSE_FAKE_SINK_INPUT, name, sink_index);
+    g_free(name);
+  }
+
+  pulse_fake_add_ext_stream(EVENT_NAME, NULL);
+  pulse_fake_add_ext_stream(PLAYER_NAME, NULL);
+}
+
+static gboolean open_context(MateMixerLoadingFlags flags,
+                             MateMixerInterestFlags interests) {
+  memset(&counters, 0, sizeof(counters));
+
+  context = mate_mixer_context_new();
+
+  mate_mixer_context_set_backend_type(context, MATE_MIXER_BACKEND_PULSEAUDIO);
+  mate_mixer_context_set_loading_flags(context, flags);
+  mate_mixer_context_set_interests(context, interests);
+
+  g_signal_connect(G_OBJECT(context), "device-added", G_CALLBACK(on_count),
+                   &counters.devices_added);
+  g_signal_connect(G_OBJECT(context), "device-removed", G_CALLBACK(on_count),
+                   &counters.devices_removed);
+  g_signal_connect(G_OBJECT(context), "stream-added", G_CALLBACK(on_count),
+                   &counters.streams_added);
+  g_signal_connect(G_OBJECT(context), "stream-removed", G_CALLBACK(on_count),
+                   &counters.streams_removed);
+  g_signal_connect(G_OBJECT(context), "stored-control-added",
+                   G_CALLBACK(on_count), &counters.stored_added);
+  g_signal_connect(G_OBJECT(context), "stored-control-removed",
+                   G_CALLBACK(on_count), &counters.stored_removed);
+  g_signal_connect(G_OBJECT(context), "notify::state",
+                   G_CALLBACK(on_context_state_notify), NULL);
+
+  if (expect(mate_mixer_context_open(context) == TRUE,
+             "the context could not be opened") == FALSE)
+    return FALSE;
+
+  if (expect(settle() == TRUE, "the backend did not settle") == FALSE)
+    return FALSE;
+
+  return expect(mate_mixer_context_get_state(context) == MATE_MIXER_STATE_READY,
+                "the context is not ready");
+}
+
+static void close_context(void) {
+  mate_mixer_context_close(context);
+
+  g_object_unref(context);
+  context = NULL;
+}
+
+static guint count_controls(MateMixerStream *stream) {
+  return g_list_length((GList *)mate_mixer_stream_list_controls(stream));
+}
+
+/* Without progressive loading the context only becomes ready with all the
+ * lists in place */
+static void check_complete(void) {
+  populate(2);
+
+  if (open_context(MATE_MIXER_LOADING_NONE, MATE_MIXER_INTEREST_ALL) == TRUE) {
+    expect(counters.ready_streams == 3, "streams missing when ready");
+    expect(counters.ready_devices == 1, "devices missing when ready");
+    expect(counters.stored_added == 2, "stored controls missing");
+  }
+  close_context();
+}
+
+/* Progressive loading reports the context ready as soon as the server
+ * information is known and the lists are announced afterwards */
+static void check_progressive(void) {
+  populate(2);
+
+  if (open_context(MATE_MIXER_LOADING_PROGRESSIVE, MATE_MIXER_INTEREST_ALL) ==
+      TRUE) {
+    expect(counters.ready_streams == 0, "streams loaded before ready");
+    expect(counters.ready_devices == 0, "devices loaded before ready");
+    expect(counters.streams_added == 3, "streams not added after ready");
+    expect(counters.devices_added == 1, "devices not added after ready");
+  }
+  close_context();
+}
+
+/* The stream-restore database is only read when the stored controls are
+ * listed for the first time */
+static void check_lazy_stored(void) {
+  populate(0);
+
+  if (open_context(MATE_MIXER_LOADING_LAZY_STORED_CONTROLS,
+                   MATE_MIXER_INTEREST_ALL) == TRUE) {
+    expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_EXT_STREAM_READ) == 0,
+           "database read before it was needed");
+
+    mate_mixer_context_list_stored_controls(context);
+    mate_mixer_context_list_stored_controls(context);
+    settle();
+
+    expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_EXT_STREAM_READ) == 1,
+           "database not read exactly once");
+    expect(counters.stored_added == 2, "stored controls not added");
+  }
+  close_context();
+}
+
+/* Objects which survive a restart of the server are kept without any
+ * signals, only the differences are announced */
+static void check_reconnect(void) {
+  MateMixerDevice *device;
+  MateMixerStream *stream;
+  MateMixerStoredControl *stored;
+
+  populate(2);
+
+  if (open_context(MATE_MIXER_LOADING_NONE, MATE_MIXER_INTEREST_ALL) ==
+      FALSE) {
+    close_context();
+    return;
+  }
+
+  device = mate_mixer_context_get_device(context, CARD_NAME);
+  stream = mate_mixer_context_get_stream(context, SINK_NAME);
+  stored = mate_mixer_context_get_stored_control(context, EVENT_NAME);
+
+  memset(&counters, 0, sizeof(counters));
+
+  pulse_fake_restart();
+
+  if (expect(settle() == TRUE, "no reconnection after restart") == TRUE) {
+    expect(counters.devices_added == 0 && counters.devices_removed == 0,
+           "devices announced again");
+    expect(counters.streams_added == 0 && counters.streams_removed == 0,
+           "streams announced again");
+    expect(counters.stored_added == 0 && counters.stored_removed == 0,
+           "stored controls announced again");
+    expect(counters.states == 0, "state changed during reconnection");
+
+    expect(mate_mixer_context_get_device(context, CARD_NAME) == device,
+           "device replaced");
+    expect(mate_mixer_context_get_stream(context, SINK_NAME) == stream,
+           "stream replaced");
+    expect(mate_mixer_context_get_stored_control(context, EVENT_NAME) ==
+               stored,
+           "stored control replaced");
+  }
+
+  /* A sink which disappears together with the server */
+  pulse_fake_stop();
+  pulse_fake_remove(PULSE_FAKE_SINK,
+                    pulse_fake_find(PULSE_FAKE_SINK, HDMI_SINK_NAME));
+  pulse_fake_start();
+
+  if (expect(settle() == TRUE, "no reconnection after stop") == TRUE) {
+    expect(counters.streams_removed == 1, "vanished stream not removed");
+    expect(counters.streams_added == 0, "streams announced again");
+    expect(mate_mixer_context_get_stream(context, HDMI_SINK_NAME) == NULL,
+           "vanished stream kept");
+    expect(mate_mixer_context_get_stream(context, SINK_NAME) == stream,
+           "stream replaced");
+  }
+  close_context();
+}
+
+/* Nothing is requested or subscribed beyond the interests, widening them
+ * loads the rest */
+static void check_interests(void) {
+  MateMixerStream *stream;
+
+  populate(2);
+
+  if (open_context(MATE_MIXER_LOADING_NONE, MATE_MIXER_INTEREST_DEVICES |
+                                                MATE_MIXER_INTEREST_STREAMS) ==
+      FALSE) {
+    close_context();
+    return;
+  }
+
+  expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_SINK_INPUT_INFO) == 0,
+         "sink inputs requested");
+  expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_EXT_STREAM_READ) == 0,
+         "database requested");
+  expect((pulse_fake_get_subscription_mask() &
+          PA_SUBSCRIPTION_MASK_SINK_INPUT) == 0,
+         "subscribed to sink inputs");
+
+  mate_mixer_context_set_interests(context, MATE_MIXER_INTEREST_ALL);
+
+  if (expect(settle() == TRUE, "widened interests did not settle") == TRUE) {
+    stream = mate_mixer_context_get_stream(context, SINK_NAME);
+
+    expect((pulse_fake_get_subscription_mask() &
+            PA_SUBSCRIPTION_MASK_SINK_INPUT) != 0,
+           "not subscribed to sink inputs");
+    expect(stream != NULL && count_controls(stream) == 3,
+           "application controls not loaded");
+    expect(counters.stored_added == 2, "stored controls not loaded");
+  }
+  close_context();
+}
+
+/* Application controls are announced by name and only created when they
+ * are asked for */
+static void check_lazy_controls(void) {
+  MateMixerStream *stream;
+  GList *loaded;
+  guint i;
+
+  populate(0);
+
+  if (open_context(MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS,
+                   MATE_MIXER_INTEREST_ALL) == FALSE) {
+    close_context();
+    return;
+  }
+
+  stream = mate_mixer_context_get_stream(context, SINK_NAME);
+  if (expect(stream != NULL, "sink missing") == FALSE) {
+    close_context();
+    return;
+  }
+
+  controls_added = 0;
+  controls_loaded = 0;
+
+  g_signal_connect(G_OBJECT(stream), "control-added", G_CALLBACK(on_count),
+                   &controls_added);
+  g_signal_connect(G_OBJECT(stream), "control-loaded",
+                   G_CALLBACK(on_control_loaded), NULL);
+
+  for (i = 0; i < G_N_ELEMENTS(inputs); i++)
+    pulse_fake_add(PULSE_FAKE_SINK_INPUT, "Player", sink_index);
+
+  if (expect(settle() == TRUE, "new inputs did not settle") == TRUE) {
+    expect(controls_added == 3, "controls not announced");
+    expect(controls_loaded == 0, "controls created before needed");
+
+    loaded = _mate_mixer_stream_list_loaded_controls(stream);
+    expect(g_list_length(loaded) == 1, "application controls created");
+    g_list_free(loaded);
+
+    expect(count_controls(stream) == 4, "controls not listed");
+    expect(controls_loaded == 3, "controls not created when listed");
+  }
+  close_context();
+}
+
+/* Moving or killing all the application controls is one batch with a single
+ * notification */
+static void check_batches(void) {
+  MateMixerStream *stream;
+  MateMixerStream *target;
+  guint batch;
+
+  populate(3);
+
+  if (open_context(MATE_MIXER_LOADING_NONE, MATE_MIXER_INTEREST_ALL) ==
+      FALSE) {
+    close_context();
+    return;
+  }
+
+  stream = mate_mixer_context_get_stream(context, SINK_NAME);
+  target = mate_mixer_context_get_stream(context, HDMI_SINK_NAME);
+  if (expect(stream != NULL && target != NULL, "sinks missing") == FALSE) {
+    close_context();
+    return;
+  }
+
+  g_signal_connect(G_OBJECT(stream), "batch-finished",
+                   G_CALLBACK(on_batch_finished), NULL);
+  g_signal_connect(G_OBJECT(target), "batch-finished",
+                   G_CALLBACK(on_batch_finished), NULL);
+
+  batches_finished = 0;
+  batch_returned = FALSE;
+  batch_early = FALSE;
+
+  batch = mate_mixer_stream_move_controls(stream, NULL, target);
+  batch_returned = TRUE;
+
+  expect(batch != 0, "move not started");
+
+  if (expect(settle() == TRUE, "move did not settle") == TRUE) {
+    expect(batch_early == FALSE, "batch finished before returning");
+    expect(batches_finished == 1, "move not finished exactly once");
+    expect(finished_batch == batch && finished_success == TRUE,
+           "move failed");
+    expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_MOVE) == 3,
+           "not one request per control");
+    expect(count_controls(stream) == 1, "controls left behind");
+    expect(count_controls(target) == 4, "controls not moved");
+  }
+
+  batches_finished = 0;
+  batch_returned = FALSE;
+
+  batch = mate_mixer_stream_kill_controls(target, NULL);
+  batch_returned = TRUE;
+
+  expect(batch != 0, "kill not started");
+
+  if (expect(settle() == TRUE, "kill did not settle") == TRUE) {
+    expect(batch_early == FALSE, "batch finished before returning");
+    expect(batches_finished == 1, "kill not finished exactly once");
+    expect(finished_batch == batch && finished_success == TRUE,
+           "kill failed");
+    expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_KILL) == 3,
+           "not one request per control");
+    expect(count_controls(target) == 1, "controls not killed");
+  }
+  close_context();
+}
+
+/* Change events which do not change anything visible are absorbed, a real
+ * change is reported once on the control it belongs to */
+static void check_fingerprint(void) {
+  MateMixerStream *stream;
+  const GList *list;
+  guint requests;
+  gchar *name;
+
+  populate(2);
+
+  if (open_context(MATE_MIXER_LOADING_NONE, MATE_MIXER_INTEREST_ALL) ==
+      FALSE) {
+    close_context();
+    return;
+  }
+
+  stream = mate_mixer_context_get_stream(context, SINK_NAME);
+  if (expect(stream != NULL, "sink missing") == FALSE) {
+    close_context();
+    return;
+  }
+
+  list = mate_mixer_stream_list_controls(stream);
+  while (list != NULL) {
+    g_signal_connect(G_OBJECT(list->data), "notify::volume",
+                     G_CALLBACK(on_volume_notify), NULL);
+    list = list->next;
+  }
+
+  volume_changes = 0;
+  volume_control = NULL;
+
+  requests = pulse_fake_get_requests(PULSE_FAKE_REQUEST_SINK_INFO) +
+             pulse_fake_get_requests(PULSE_FAKE_REQUEST_SINK_INPUT_INFO);
+
+  pulse_fake_storm(PULSE_FAKE_SINK, 20);
+  pulse_fake_storm(PULSE_FAKE_SINK_INPUT, 20);
+
+  if (expect(settle() == TRUE, "storm did not settle") == TRUE) {
+    expect(pulse_fake_get_requests(PULSE_FAKE_REQUEST_SINK_INFO) +
+                   pulse_fake_get_requests(PULSE_FAKE_REQUEST_SINK_INPUT_INFO) >
+               requests,
+           "storm not received");
+    expect(volume_changes == 0, "unchanged volume notified");
+  }
+
+  pulse_fake_set_volume(PULSE_FAKE_SINK_INPUT, inputs[0], PA_VOLUME_NORM / 2);
+
+  if (expect(settle() == TRUE, "volume change did not settle") == TRUE) {
+    name = g_strdup_printf("pulse-output-control-%lu", (gulong)inputs[0]);
+
+    expect(volume_changes == 1, "volume change not notified once");
+    expect(volume_control != NULL &&
+               volume_control == mate_mixer_stream_get_control(stream, name),
+           "volume change notified on another control");
+    g_free(name);
+  }
+  close_context();
+}
+
+static const Scenario scenarios[] = {
+    {"complete", check_complete},       {"progressive", check_progressive},
+    {"lazy-stored", check_lazy_stored}, {"reconnect", check_reconnect},
+    {"interests", check_interests},     {"lazy-controls", check_lazy_controls},
+    {"batches", check_batches},         {"fingerprint", check_fingerprint}};
+
+int main(int argc, char *argv[]) {
+  guint failed = 0;
+  guint i;
+
+  _mate_mixer_set_modules_dir(PULSE_FAKE_MODULES_DIR);
+
+  if (mate_mixer_init() == FALSE) {
+    printf("FAIL: init\n");
+    return 1;
+  }
+
+  for (i = 0; i < G_N_ELEMENTS(scenarios); i++) {
+    failure = NULL;
+
+    pulse_fake_reset();
+    pulse_fake_set_latency(CHECK_LATENCY);
+
+    scenarios[i].run();
+
+    if (failure != NULL) {
+      printf("FAIL: %s: %s\n", scenarios[i].name, failure);
+      failed++;
+    } else
+      printf("PASS: %s\n", scenarios[i].name);
+  }
+  return (failed > 0) ? 1 : 0;
+}
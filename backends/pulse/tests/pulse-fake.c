@@ -0,0 +1,1671 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "pulse-fake.h"
+
+/* A single simulated sound server shared by all the contexts of the process.
+ *
+ * Every context keeps a queue of replies, events and state changes, which
+ * are delivered in order from the main context of the context's main loop
+ * once the configured latency has passed. Requests are processed when their
+ * reply is delivered, so the events they cause follow the reply, and a
+ * context which fails or is released does not receive anything more. */
+
+struct pa_glib_mainloop {
+  pa_mainloop_api api;
+  GMainContext *context;
+};
+
+struct pa_context {
+  gint ref;
+  GMainContext *main_context;
+  pa_context_state_t state;
+  gint error;
+  gboolean nofail;
+  gboolean waiting;
+  pa_subscription_mask_t mask;
+  gboolean restore_subscribed;
+  pa_context_notify_cb_t state_cb;
+  void *state_userdata;
+  pa_context_subscribe_cb_t subscribe_cb;
+  void *subscribe_userdata;
+  pa_ext_stream_restore_subscribe_cb_t restore_cb;
+  void *restore_userdata;
+  GQueue *replies;
+  GSource *source;
+};
+
+typedef enum {
+  PULSE_FAKE_CALL_SERVER_INFO,
+  PULSE_FAKE_CALL_LIST,
+  PULSE_FAKE_CALL_BY_INDEX,
+  PULSE_FAKE_CALL_BY_NAME,
+  PULSE_FAKE_CALL_SET_VOLUME,
+  PULSE_FAKE_CALL_SET_MUTE,
+  PULSE_FAKE_CALL_SET_DEFAULT,
+  PULSE_FAKE_CALL_MOVE,
+  PULSE_FAKE_CALL_KILL,
+  PULSE_FAKE_CALL_SUBSCRIBE,
+  PULSE_FAKE_CALL_EXT_READ,
+  PULSE_FAKE_CALL_EXT_WRITE,
+  PULSE_FAKE_CALL_EXT_DELETE,
+  PULSE_FAKE_CALL_EXT_SUBSCRIBE,
+  PULSE_FAKE_CALL_NOOP
+} PulseFakeCall;
+
+struct pa_operation {
+  gint ref;
+  pa_operation_state_t state;
+  PulseFakeCall call;
+  PulseFakeKind kind;
+  guint32 index;
+  guint32 target;
+  gchar *name;
+  gchar **names;
+  GPtrArray *entries;
+  pa_update_mode_t mode;
+  pa_cvolume volume;
+  gint value;
+  gpointer cb;
+  gpointer userdata;
+};
+
+typedef enum {
+  PULSE_FAKE_REPLY_STATE,
+  PULSE_FAKE_REPLY_EVENT,
+  PULSE_FAKE_REPLY_RESTORE_EVENT,
+  PULSE_FAKE_REPLY_OPERATION
+} PulseFakeReplyType;
+
+typedef struct {
+  PulseFakeReplyType type;
+  gint64 due;
+  pa_context_state_t state;
+  pa_subscription_event_type_t event;
+  guint32 index;
+  pa_operation *op;
+} PulseFakeReply;
+
+typedef struct {
+  guint32 index;
+  gchar *name;
+  guint32 parent;
+  pa_cvolume volume;
+  gboolean mute;
+} PulseFakeObject;
+
+typedef struct {
+  gchar *name;
+  gchar *device;
+  pa_cvolume volume;
+  gboolean mute;
+} PulseFakeExtStream;
+
+static GPtrArray *objects[PULSE_FAKE_N_KINDS];
+static GPtrArray *ext_streams = NULL;
+static gchar *default_sink = NULL;
+static gchar *default_source = NULL;
+
+static GList *contexts = NULL;
+static gboolean running = TRUE;
+static guint latency = 0;
+static guint32 next_index = 0;
+
+static guint requests[PULSE_FAKE_N_REQUESTS];
+static pa_subscription_mask_t subscription_mask = PA_SUBSCRIPTION_MASK_NULL;
+
+static void init_server(void);
+
+static PulseFakeObject *find_object(PulseFakeKind kind, guint32 index);
+static PulseFakeObject *find_object_by_name(PulseFakeKind kind,
+                                            const gchar *name);
+static void free_object(PulseFakeObject *object);
+
+static PulseFakeExtStream *find_ext_stream(const gchar *name);
+static void free_ext_stream(PulseFakeExtStream *ext);
+
+static void update_default(PulseFakeKind kind);
+
+static pa_operation *new_operation(pa_context *c, PulseFakeCall call,
+                                   PulseFakeKind kind, gpointer cb,
+                                   gpointer userdata);
+
+static void queue_reply(pa_context *c, PulseFakeReply *reply);
+static void queue_state(pa_context *c, pa_context_state_t state);
+static void clear_replies(pa_context *c);
+static void schedule_replies(pa_context *c);
+static gboolean dispatch_replies(pa_context *c);
+static void deliver_reply(pa_context *c, PulseFakeReply *reply);
+static void free_reply(PulseFakeReply *reply);
+
+static void post_event(pa_subscription_event_type_t facility,
+                       pa_subscription_event_type_t type, guint32 index);
+static void post_object_event(PulseFakeKind kind,
+                              pa_subscription_event_type_t type,
+                              guint32 index);
+static void post_restore_event(void);
+
+static void process_operation(pa_context *c, pa_operation *o);
+static void reply_server_info(pa_context *c, pa_operation *o);
+static void reply_info(pa_context *c, pa_operation *o,
+                       PulseFakeObject *object);
+static void reply_eol(pa_context *c, pa_operation *o, gint eol);
+static void reply_ext_streams(pa_context *c, pa_operation *o);
+static gboolean write_ext_streams(pa_operation *o);
+static gboolean delete_ext_streams(pa_operation *o);
+
+static void init_spec(pa_sample_spec *spec, pa_channel_map *map);
+
+pa_glib_mainloop *pulse_fake_glib_mainloop_new(GMainContext *c) {
+  pa_glib_mainloop *g;
+
+  g = g_new0(pa_glib_mainloop, 1);
+  g->api.userdata = g;
+
+  /* Same as the real main loop, no context stands for the default one */
+  if (c == NULL) c = g_main_context_default();
+
+  g->context = g_main_context_ref(c);
+  return g;
+}
+
+void pulse_fake_glib_mainloop_free(pa_glib_mainloop *g) {
+  g_main_context_unref(g->context);
+  g_free(g);
+}
+
+pa_mainloop_api *pulse_fake_glib_mainloop_get_api(pa_glib_mainloop *g) {
+  return &g->api;
+}
+
+pa_context *pulse_fake_context_new_with_proplist(pa_mainloop_api *mainloop,
+                                                 const char *name,
+                                                 const pa_proplist *proplist) {
+  pa_glib_mainloop *g = mainloop->userdata;
+  pa_context *c;
+
+  init_server();
+
+  c = g_new0(pa_context, 1);
+  c->ref = 1;
+  c->main_context = g_main_context_ref(g->context);
+  c->state = PA_CONTEXT_UNCONNECTED;
+  c->replies = g_queue_new();
+
+  contexts = g_list_prepend(contexts, c);
+  return c;
+}
+
+pa_context *pulse_fake_context_ref(pa_context *c) {
+  c->ref++;
+  return c;
+}
+
+void pulse_fake_context_unref(pa_context *c) {
+  if (--c->ref > 0) return;
+
+  /* Releasing the context cancels all the pending operations */
+  clear_replies(c);
+
+  if (c->source != NULL) {
+    g_source_destroy(c->source);
+    g_source_unref(c->source);
+  }
+
+  contexts = g_list_remove(contexts, c);
+
+  g_queue_free(c->replies);
+  g_main_context_unref(c->main_context);
+  g_free(c);
+}
+
+int pulse_fake_context_connect(pa_context *c, const char *server,
+                               pa_context_flags_t flags,
+                               const pa_spawn_api *api) {
+  if (c->state != PA_CONTEXT_UNCONNECTED) {
+    c->error = PA_ERR_BADSTATE;
+    return -1;
+  }
+
+  c->state = PA_CONTEXT_CONNECTING;
+  c->nofail = (flags & PA_CONTEXT_NOFAIL) ? TRUE : FALSE;
+
+  if (running == TRUE) {
+    queue_state(c, PA_CONTEXT_AUTHORIZING);
+    queue_state(c, PA_CONTEXT_READY);
+  } else if (c->nofail == TRUE) {
+    /* Keep connecting until the server is started again */
+    c->waiting = TRUE;
+  } else {
+    c->error = PA_ERR_CONNECTIONREFUSED;
+    queue_state(c, PA_CONTEXT_FAILED);
+  }
+  return 0;
+}
+
+pa_context_state_t pulse_fake_context_get_state(pa_context *c) {
+  return c->state;
+}
+
+int pulse_fake_context_errno(pa_context *c) { return c->error; }
+
+void pulse_fake_context_set_state_callback(pa_context *c,
+                                           pa_context_notify_cb_t cb,
+                                           void *userdata) {
+  c->state_cb = cb;
+  c->state_userdata = userdata;
+}
+
+void pulse_fake_context_set_subscribe_callback(pa_context *c,
+                                               pa_context_subscribe_cb_t cb,
+                                               void *userdata) {
+  c->subscribe_cb = cb;
+  c->subscribe_userdata = userdata;
+}
+
+pa_operation *pulse_fake_context_subscribe(pa_context *c,
+                                           pa_subscription_mask_t m,
+                                           pa_context_success_cb_t cb,
+                                           void *userdata) {
+  pa_operation *o;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SUBSCRIBE, PULSE_FAKE_CARD, cb,
+                    userdata);
+  if (o != NULL) o->value = (gint)m;
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_server_info(pa_context *c,
+                                                 pa_server_info_cb_t cb,
+                                                 void *userdata) {
+  requests[PULSE_FAKE_REQUEST_SERVER_INFO]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_SERVER_INFO, PULSE_FAKE_CARD, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_context_get_card_info_by_index(pa_context *c,
+                                                        uint32_t idx,
+                                                        pa_card_info_cb_t cb,
+                                                        void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_CARD_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_INDEX, PULSE_FAKE_CARD, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_card_info_by_name(pa_context *c,
+                                                       const char *name,
+                                                       pa_card_info_cb_t cb,
+                                                       void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_CARD_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_NAME, PULSE_FAKE_CARD, cb, userdata);
+  if (o != NULL) o->name = g_strdup(name);
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_card_info_list(pa_context *c,
+                                                    pa_card_info_cb_t cb,
+                                                    void *userdata) {
+  requests[PULSE_FAKE_REQUEST_CARD_INFO]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_LIST, PULSE_FAKE_CARD, cb, userdata);
+}
+
+pa_operation *pulse_fake_context_get_sink_info_by_index(pa_context *c,
+                                                        uint32_t idx,
+                                                        pa_sink_info_cb_t cb,
+                                                        void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_SINK_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_INDEX, PULSE_FAKE_SINK, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_sink_info_by_name(pa_context *c,
+                                                       const char *name,
+                                                       pa_sink_info_cb_t cb,
+                                                       void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_SINK_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_NAME, PULSE_FAKE_SINK, cb, userdata);
+  if (o != NULL) o->name = g_strdup(name);
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_sink_info_list(pa_context *c,
+                                                    pa_sink_info_cb_t cb,
+                                                    void *userdata) {
+  requests[PULSE_FAKE_REQUEST_SINK_INFO]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_LIST, PULSE_FAKE_SINK, cb, userdata);
+}
+
+pa_operation *pulse_fake_context_get_source_info_by_index(
+    pa_context *c, uint32_t idx, pa_source_info_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_SOURCE_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_INDEX, PULSE_FAKE_SOURCE, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_source_info_by_name(pa_context *c,
+                                                         const char *name,
+                                                         pa_source_info_cb_t cb,
+                                                         void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_SOURCE_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_NAME, PULSE_FAKE_SOURCE, cb,
+                    userdata);
+  if (o != NULL) o->name = g_strdup(name);
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_source_info_list(pa_context *c,
+                                                      pa_source_info_cb_t cb,
+                                                      void *userdata) {
+  requests[PULSE_FAKE_REQUEST_SOURCE_INFO]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_LIST, PULSE_FAKE_SOURCE, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_context_get_sink_input_info(
+    pa_context *c, uint32_t idx, pa_sink_input_info_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_SINK_INPUT_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_INDEX, PULSE_FAKE_SINK_INPUT, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_sink_input_info_list(
+    pa_context *c, pa_sink_input_info_cb_t cb, void *userdata) {
+  requests[PULSE_FAKE_REQUEST_SINK_INPUT_INFO]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_LIST, PULSE_FAKE_SINK_INPUT, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_context_get_source_output_info(
+    pa_context *c, uint32_t idx, pa_source_output_info_cb_t cb,
+    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_SOURCE_OUTPUT_INFO]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_BY_INDEX, PULSE_FAKE_SOURCE_OUTPUT, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_context_get_source_output_info_list(
+    pa_context *c, pa_source_output_info_cb_t cb, void *userdata) {
+  requests[PULSE_FAKE_REQUEST_SOURCE_OUTPUT_INFO]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_LIST, PULSE_FAKE_SOURCE_OUTPUT, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_context_set_default_sink(pa_context *c,
+                                                  const char *name,
+                                                  pa_context_success_cb_t cb,
+                                                  void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_DEFAULT, PULSE_FAKE_SINK, cb,
+                    userdata);
+  if (o != NULL) o->name = g_strdup(name);
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_default_source(pa_context *c,
+                                                    const char *name,
+                                                    pa_context_success_cb_t cb,
+                                                    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_DEFAULT, PULSE_FAKE_SOURCE, cb,
+                    userdata);
+  if (o != NULL) o->name = g_strdup(name);
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_card_profile_by_name(
+    pa_context *c, const char *name, const char *profile,
+    pa_context_success_cb_t cb, void *userdata) {
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  /* Every card has a single profile */
+  return new_operation(c, PULSE_FAKE_CALL_NOOP, PULSE_FAKE_CARD, cb, userdata);
+}
+
+pa_operation *pulse_fake_context_set_sink_mute_by_index(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_MUTE, PULSE_FAKE_SINK, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->value = mute;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_sink_volume_by_index(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_VOLUME, PULSE_FAKE_SINK, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->volume = *volume;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_sink_port_by_index(
+    pa_context *c, uint32_t idx, const char *port, pa_context_success_cb_t cb,
+    void *userdata) {
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  /* Ports are not simulated */
+  return new_operation(c, PULSE_FAKE_CALL_NOOP, PULSE_FAKE_SINK, cb, userdata);
+}
+
+pa_operation *pulse_fake_context_set_source_mute_by_index(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_MUTE, PULSE_FAKE_SOURCE, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->value = mute;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_source_volume_by_index(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_VOLUME, PULSE_FAKE_SOURCE, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->volume = *volume;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_source_port_by_index(
+    pa_context *c, uint32_t idx, const char *port, pa_context_success_cb_t cb,
+    void *userdata) {
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_NOOP, PULSE_FAKE_SOURCE, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_context_set_sink_input_mute(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_MUTE, PULSE_FAKE_SINK_INPUT, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->value = mute;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_sink_input_volume(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_VOLUME, PULSE_FAKE_SINK_INPUT, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->volume = *volume;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_source_output_mute(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_MUTE, PULSE_FAKE_SOURCE_OUTPUT, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->value = mute;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_set_source_output_volume(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_SET_VOLUME, PULSE_FAKE_SOURCE_OUTPUT,
+                    cb, userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->volume = *volume;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_suspend_sink_by_index(
+    pa_context *c, uint32_t idx, int suspend, pa_context_success_cb_t cb,
+    void *userdata) {
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_NOOP, PULSE_FAKE_SINK, cb, userdata);
+}
+
+pa_operation *pulse_fake_context_suspend_source_by_index(
+    pa_context *c, uint32_t idx, int suspend, pa_context_success_cb_t cb,
+    void *userdata) {
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_NOOP, PULSE_FAKE_SOURCE, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_context_move_sink_input_by_index(
+    pa_context *c, uint32_t idx, uint32_t sink_idx, pa_context_success_cb_t cb,
+    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_MOVE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_MOVE, PULSE_FAKE_SINK_INPUT, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->target = sink_idx;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_move_source_output_by_index(
+    pa_context *c, uint32_t idx, uint32_t source_idx,
+    pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_MOVE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_MOVE, PULSE_FAKE_SOURCE_OUTPUT, cb,
+                    userdata);
+  if (o != NULL) {
+    o->index = idx;
+    o->target = source_idx;
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_context_kill_sink_input(pa_context *c, uint32_t idx,
+                                                 pa_context_success_cb_t cb,
+                                                 void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_KILL]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_KILL, PULSE_FAKE_SINK_INPUT, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_context_kill_source_output(pa_context *c,
+                                                    uint32_t idx,
+                                                    pa_context_success_cb_t cb,
+                                                    void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_KILL]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_KILL, PULSE_FAKE_SOURCE_OUTPUT, cb,
+                    userdata);
+  if (o != NULL) o->index = idx;
+  return o;
+}
+
+pa_operation *pulse_fake_ext_stream_restore_read(
+    pa_context *c, pa_ext_stream_restore_read_cb_t cb, void *userdata) {
+  requests[PULSE_FAKE_REQUEST_EXT_STREAM_READ]++;
+
+  return new_operation(c, PULSE_FAKE_CALL_EXT_READ, PULSE_FAKE_CARD, cb,
+                       userdata);
+}
+
+pa_operation *pulse_fake_ext_stream_restore_write(
+    pa_context *c, pa_update_mode_t mode,
+    const pa_ext_stream_restore_info data[], unsigned n, int apply_immediately,
+    pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+  unsigned i;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_EXT_WRITE, PULSE_FAKE_CARD, cb,
+                    userdata);
+  if (o == NULL) return NULL;
+
+  o->mode = mode;
+  o->entries = g_ptr_array_new_with_free_func((GDestroyNotify)free_ext_stream);
+
+  for (i = 0; i < n; i++) {
+    PulseFakeExtStream *ext = g_new0(PulseFakeExtStream, 1);
+
+    ext->name = g_strdup(data[i].name);
+    ext->device = g_strdup(data[i].device);
+    ext->volume = data[i].volume;
+    ext->mute = data[i].mute ? TRUE : FALSE;
+
+    g_ptr_array_add(o->entries, ext);
+  }
+  return o;
+}
+
+pa_operation *pulse_fake_ext_stream_restore_delete(pa_context *c,
+                                                   const char *const s[],
+                                                   pa_context_success_cb_t cb,
+                                                   void *userdata) {
+  pa_operation *o;
+
+  requests[PULSE_FAKE_REQUEST_WRITE]++;
+
+  o = new_operation(c, PULSE_FAKE_CALL_EXT_DELETE, PULSE_FAKE_CARD, cb,
+                    userdata);
+  if (o != NULL) o->names = g_strdupv((gchar **)s);
+  return o;
+}
+
+pa_operation *pulse_fake_ext_stream_restore_subscribe(
+    pa_context *c, int enable, pa_context_success_cb_t cb, void *userdata) {
+  pa_operation *o;
+
+  o = new_operation(c, PULSE_FAKE_CALL_EXT_SUBSCRIBE, PULSE_FAKE_CARD, cb,
+                    userdata);
+  if (o != NULL) o->value = enable;
+  return o;
+}
+
+void pulse_fake_ext_stream_restore_set_subscribe_cb(
+    pa_context *c, pa_ext_stream_restore_subscribe_cb_t cb, void *userdata) {
+  c->restore_cb = cb;
+  c->restore_userdata = userdata;
+}
+
+void pulse_fake_operation_unref(pa_operation *o) {
+  if (--o->ref > 0) return;
+
+  if (o->entries != NULL) g_ptr_array_unref(o->entries);
+
+  g_strfreev(o->names);
+  g_free(o->name);
+  g_free(o);
+}
+
+void pulse_fake_operation_cancel(pa_operation *o) {
+  /* The reply stays queued, but it is not delivered */
+  if (o->state == PA_OPERATION_RUNNING) o->state = PA_OPERATION_CANCELLED;
+}
+
+pa_stream *pulse_fake_stream_new_with_proplist(pa_context *c, const char *name,
+                                               const pa_sample_spec *ss,
+                                               const pa_channel_map *map,
+                                               pa_proplist *p) {
+  c->error = PA_ERR_NOTSUPPORTED;
+  return NULL;
+}
+
+void pulse_fake_reset(void) {
+  guint i;
+
+  init_server();
+
+  for (i = 0; i < PULSE_FAKE_N_KINDS; i++)
+    g_ptr_array_set_size(objects[i], 0);
+
+  g_ptr_array_set_size(ext_streams, 0);
+
+  g_clear_pointer(&default_sink, g_free);
+  g_clear_pointer(&default_source, g_free);
+
+  memset(requests, 0, sizeof(requests));
+
+  subscription_mask = PA_SUBSCRIPTION_MASK_NULL;
+  running = TRUE;
+  latency = 0;
+}
+
+void pulse_fake_set_latency(guint value) { latency = value; }
+
+void pulse_fake_stop(void) {
+  GList *list;
+
+  running = FALSE;
+
+  for (list = contexts; list != NULL; list = list->next) {
+    pa_context *c = list->data;
+
+    if (c->state == PA_CONTEXT_UNCONNECTED ||
+        c->state == PA_CONTEXT_FAILED || c->state == PA_CONTEXT_TERMINATED)
+      continue;
+
+    /* Whatever has not been delivered yet is lost with the server */
+    clear_replies(c);
+
+    if (c->state != PA_CONTEXT_READY && c->nofail == TRUE) {
+      c->waiting = TRUE;
+      continue;
+    }
+
+    c->error = PA_ERR_CONNECTIONTERMINATED;
+    queue_state(c, PA_CONTEXT_FAILED);
+  }
+}
+
+void pulse_fake_start(void) {
+  GList *list;
+
+  running = TRUE;
+
+  for (list = contexts; list != NULL; list = list->next) {
+    pa_context *c = list->data;
+
+    if (c->waiting == FALSE) continue;
+
+    c->waiting = FALSE;
+
+    queue_state(c, PA_CONTEXT_AUTHORIZING);
+    queue_state(c, PA_CONTEXT_READY);
+  }
+}
+
+void pulse_fake_restart(void) {
+  GHashTable *indices;
+  guint i, j;
+
+  init_server();
+
+  pulse_fake_stop();
+
+  /* The restarted server renumbers its objects and the applications have
+   * lost their connections, the devices keep their names */
+  g_ptr_array_set_size(objects[PULSE_FAKE_SINK_INPUT], 0);
+  g_ptr_array_set_size(objects[PULSE_FAKE_SOURCE_OUTPUT], 0);
+
+  indices = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+  for (i = 0; i < PULSE_FAKE_N_KINDS; i++) {
+    for (j = 0; j < objects[i]->len; j++) {
+      PulseFakeObject *object = g_ptr_array_index(objects[i], j);
+      guint32 index = next_index++;
+
+      g_hash_table_insert(indices, GUINT_TO_POINTER(object->index),
+                          GUINT_TO_POINTER(index));
+      object->index = index;
+    }
+  }
+
+  for (i = 0; i < PULSE_FAKE_N_KINDS; i++) {
+    for (j = 0; j < objects[i]->len; j++) {
+      PulseFakeObject *object = g_ptr_array_index(objects[i], j);
+      gpointer parent;
+
+      if (g_hash_table_lookup_extended(indices,
+                                       GUINT_TO_POINTER(object->parent), NULL,
+                                       &parent) == TRUE)
+        object->parent = GPOINTER_TO_UINT(parent);
+    }
+  }
+
+  g_hash_table_unref(indices);
+
+  pulse_fake_start();
+}
+
+guint32 pulse_fake_add(PulseFakeKind kind, const gchar *name, guint32 parent) {
+  PulseFakeObject *object;
+
+  init_server();
+
+  object = g_new0(PulseFakeObject, 1);
+  object->index = next_index++;
+  object->name = g_strdup(name);
+  object->parent = parent;
+
+  pa_cvolume_set(&object->volume, 2, PA_VOLUME_NORM);
+
+  g_ptr_array_add(objects[kind], object);
+
+  post_object_event(kind, PA_SUBSCRIPTION_EVENT_NEW, object->index);
+  update_default(kind);
+  return object->index;
+}
+
+void pulse_fake_remove(PulseFakeKind kind, guint32 index) {
+  PulseFakeObject *object;
+
+  object = find_object(kind, index);
+  if (object == NULL) return;
+
+  g_ptr_array_remove(objects[kind], object);
+
+  post_object_event(kind, PA_SUBSCRIPTION_EVENT_REMOVE, index);
+  update_default(kind);
+}
+
+void pulse_fake_set_volume(PulseFakeKind kind, guint32 index,
+                           pa_volume_t volume) {
+  PulseFakeObject *object;
+
+  object = find_object(kind, index);
+  if (object == NULL) return;
+
+  pa_cvolume_set(&object->volume, object->volume.channels, volume);
+
+  post_object_event(kind, PA_SUBSCRIPTION_EVENT_CHANGE, index);
+}
+
+void pulse_fake_storm(PulseFakeKind kind, guint n_events) {
+  guint i, j;
+
+  init_server();
+
+  /* Change events of values which are not simulated, such as the latency,
+   * the objects look the same as before */
+  for (i = 0; i < n_events; i++)
+    for (j = 0; j < objects[kind]->len; j++) {
+      PulseFakeObject *object = g_ptr_array_index(objects[kind], j);
+
+      post_object_event(kind, PA_SUBSCRIPTION_EVENT_CHANGE, object->index);
+    }
+}
+
+void pulse_fake_add_ext_stream(const gchar *name, const gchar *device) {
+  PulseFakeExtStream *ext;
+
+  init_server();
+
+  ext = g_new0(PulseFakeExtStream, 1);
+  ext->name = g_strdup(name);
+  ext->device = g_strdup(device);
+
+  pa_cvolume_set(&ext->volume, 2, PA_VOLUME_NORM);
+
+  g_ptr_array_add(ext_streams, ext);
+
+  post_restore_event();
+}
+
+guint32 pulse_fake_find(PulseFakeKind kind, const gchar *name) {
+  PulseFakeObject *object;
+
+  object = find_object_by_name(kind, name);
+  if (object == NULL) return PA_INVALID_INDEX;
+
+  return object->index;
+}
+
+guint pulse_fake_get_requests(PulseFakeRequest request) {
+  return requests[request];
+}
+
+pa_subscription_mask_t pulse_fake_get_subscription_mask(void) {
+  return subscription_mask;
+}
+
+gboolean pulse_fake_is_idle(void) {
+  GList *list;
+
+  /* All the contexts are connected and have nothing left to deliver */
+  for (list = contexts; list != NULL; list = list->next) {
+    pa_context *c = list->data;
+
+    if (c->state != PA_CONTEXT_READY || g_queue_is_empty(c->replies) == FALSE)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+static void init_server(void) {
+  guint i;
+
+  if (ext_streams != NULL) return;
+
+  for (i = 0; i < PULSE_FAKE_N_KINDS; i++)
+    objects[i] = g_ptr_array_new_with_free_func((GDestroyNotify)free_object);
+
+  ext_streams = g_ptr_array_new_with_free_func((GDestroyNotify)free_ext_stream);
+}
+
+static PulseFakeObject *find_object(PulseFakeKind kind, guint32 index) {
+  guint i;
+
+  init_server();
+
+  for (i = 0; i < objects[kind]->len; i++) {
+    PulseFakeObject *object = g_ptr_array_index(objects[kind], i);
+
+    if (object->index == index) return object;
+  }
+  return NULL;
+}
+
+static PulseFakeObject *find_object_by_name(PulseFakeKind kind,
+                                            const gchar *name) {
+  guint i;
+
+  init_server();
+
+  for (i = 0; i < objects[kind]->len; i++) {
+    PulseFakeObject *object = g_ptr_array_index(objects[kind], i);
+
+    if (g_strcmp0(object->name, name) == 0) return object;
+  }
+  return NULL;
+}
+
+static void free_object(PulseFakeObject *object) {
+  g_free(object->name);
+  g_free(object);
+}
+
+static PulseFakeExtStream *find_ext_stream(const gchar *name) {
+  guint i;
+
+  for (i = 0; i < ext_streams->len; i++) {
+    PulseFakeExtStream *ext = g_ptr_array_index(ext_streams, i);
+
+    if (g_strcmp0(ext->name, name) == 0) return ext;
+  }
+  return NULL;
+}
+
+static void free_ext_stream(PulseFakeExtStream *ext) {
+  g_free(ext->name);
+  g_free(ext->device);
+  g_free(ext);
+}
+
+static void update_default(PulseFakeKind kind) {
+  PulseFakeObject *object = NULL;
+  gchar **name;
+
+  if (kind == PULSE_FAKE_SINK)
+    name = &default_sink;
+  else if (kind == PULSE_FAKE_SOURCE)
+    name = &default_source;
+  else
+    return;
+
+  /* The first device stream becomes the default one, like the default of
+   * a server without any configuration */
+  if (*name != NULL && find_object_by_name(kind, *name) != NULL) return;
+
+  if (objects[kind]->len > 0) object = g_ptr_array_index(objects[kind], 0);
+
+  if (*name == NULL && object == NULL) return;
+
+  g_free(*name);
+  *name = (object != NULL) ? g_strdup(object->name) : NULL;
+
+  post_event(PA_SUBSCRIPTION_EVENT_SERVER, PA_SUBSCRIPTION_EVENT_CHANGE,
+             PA_INVALID_INDEX);
+}
+
+static pa_operation *new_operation(pa_context *c, PulseFakeCall call,
+                                   PulseFakeKind kind, gpointer cb,
+                                   gpointer userdata) {
+  PulseFakeReply *reply;
+  pa_operation *o;
+
+  if (c->state != PA_CONTEXT_READY) {
+    c->error = PA_ERR_BADSTATE;
+    return NULL;
+  }
+
+  /* One reference is returned to the caller, the other one is kept by the
+   * queued reply */
+  o = g_new0(pa_operation, 1);
+  o->ref = 2;
+  o->state = PA_OPERATION_RUNNING;
+  o->call = call;
+  o->kind = kind;
+  o->index = PA_INVALID_INDEX;
+  o->target = PA_INVALID_INDEX;
+  o->cb = cb;
+  o->userdata = userdata;
+
+  reply = g_new0(PulseFakeReply, 1);
+  reply->type = PULSE_FAKE_REPLY_OPERATION;
+  reply->op = o;
+
+  queue_reply(c, reply);
+  return o;
+}
+
+static void queue_reply(pa_context *c, PulseFakeReply *reply) {
+  reply->due = g_get_monotonic_time() + latency * G_TIME_SPAN_MILLISECOND;
+
+  g_queue_push_tail(c->replies, reply);
+
+  schedule_replies(c);
+}
+
+static void queue_state(pa_context *c, pa_context_state_t state) {
+  PulseFakeReply *reply;
+
+  reply = g_new0(PulseFakeReply, 1);
+  reply->type = PULSE_FAKE_REPLY_STATE;
+  reply->state = state;
+
+  queue_reply(c, reply);
+}
+
+static void clear_replies(pa_context *c) {
+  PulseFakeReply *reply;
+
+  while ((reply = g_queue_pop_head(c->replies)) != NULL) {
+    if (reply->op != NULL) pulse_fake_operation_cancel(reply->op);
+
+    free_reply(reply);
+  }
+}
+
+static void schedule_replies(pa_context *c) {
+  PulseFakeReply *reply;
+  gint64 delay;
+
+  if (c->source != NULL) return;
+
+  reply = g_queue_peek_head(c->replies);
+  if (reply == NULL) return;
+
+  delay = reply->due - g_get_monotonic_time();
+  if (delay < 0) delay = 0;
+
+  c->source = g_timeout_source_new(
+      (guint)((delay + G_TIME_SPAN_MILLISECOND - 1) / G_TIME_SPAN_MILLISECOND));
+
+  g_source_set_callback(c->source, (GSourceFunc)dispatch_replies, c, NULL);
+  g_source_attach(c->source, c->main_context);
+}
+
+static gboolean dispatch_replies(pa_context *c) {
+  PulseFakeReply *reply;
+  gint64 now;
+
+  g_source_unref(c->source);
+  c->source = NULL;
+
+  /* The owner may release the context in any of the callbacks, in which case
+   * the remaining replies are dropped together with the context */
+  pulse_fake_context_ref(c);
+
+  /* Only deliver what was due when the dispatch started, so that a storm of
+   * new events does not block the main loop */
+  now = g_get_monotonic_time();
+
+  while (c->ref > 1) {
+    reply = g_queue_peek_head(c->replies);
+    if (reply == NULL || reply->due > now) break;
+
+    g_queue_pop_head(c->replies);
+
+    deliver_reply(c, reply);
+    free_reply(reply);
+  }
+
+  if (c->ref > 1) schedule_replies(c);
+
+  pulse_fake_context_unref(c);
+  return G_SOURCE_REMOVE;
+}
+
+static void deliver_reply(pa_context *c, PulseFakeReply *reply) {
+  switch (reply->type) {
+    case PULSE_FAKE_REPLY_STATE:
+      c->state = reply->state;
+
+      if (c->state == PA_CONTEXT_FAILED || c->state == PA_CONTEXT_TERMINATED)
+        clear_replies(c);
+
+      if (c->state_cb != NULL) c->state_cb(c, c->state_userdata);
+      break;
+
+    case PULSE_FAKE_REPLY_EVENT:
+      if (c->subscribe_cb != NULL)
+        c->subscribe_cb(c, reply->event, reply->index, c->subscribe_userdata);
+      break;
+
+    case PULSE_FAKE_REPLY_RESTORE_EVENT:
+      if (c->restore_cb != NULL) c->restore_cb(c, c->restore_userdata);
+      break;
+
+    case PULSE_FAKE_REPLY_OPERATION:
+      if (reply->op->state != PA_OPERATION_RUNNING) break;
+
+      process_operation(c, reply->op);
+
+      if (reply->op->state == PA_OPERATION_RUNNING)
+        reply->op->state = PA_OPERATION_DONE;
+      break;
+  }
+}
+
+static void free_reply(PulseFakeReply *reply) {
+  if (reply->op != NULL) pulse_fake_operation_unref(reply->op);
+
+  g_free(reply);
+}
+
+static void post_event(pa_subscription_event_type_t facility,
+                       pa_subscription_event_type_t type, guint32 index) {
+  GList *list;
+
+  for (list = contexts; list != NULL; list = list->next) {
+    pa_context *c = list->data;
+    PulseFakeReply *reply;
+
+    if (c->state != PA_CONTEXT_READY || !(c->mask & (1 << facility)))
+      continue;
+
+    reply = g_new0(PulseFakeReply, 1);
+    reply->type = PULSE_FAKE_REPLY_EVENT;
+    reply->event = facility | type;
+    reply->index = index;
+
+    queue_reply(c, reply);
+  }
+}
+
+static void post_object_event(PulseFakeKind kind,
+                              pa_subscription_event_type_t type,
+                              guint32 index) {
+  static const pa_subscription_event_type_t facilities[PULSE_FAKE_N_KINDS] = {
+      PA_SUBSCRIPTION_EVENT_CARD, PA_SUBSCRIPTION_EVENT_SINK,
+      PA_SUBSCRIPTION_EVENT_SOURCE, PA_SUBSCRIPTION_EVENT_SINK_INPUT,
+      PA_SUBSCRIPTION_EVENT_SOURCE_OUTPUT};
+
+  post_event(facilities[kind], type, index);
+}
+
+static void post_restore_event(void) {
+  GList *list;
+
+  for (list = contexts; list != NULL; list = list->next) {
+    pa_context *c = list->data;
+    PulseFakeReply *reply;
+
+    if (c->state != PA_CONTEXT_READY || c->restore_subscribed == FALSE)
+      continue;
+
+    reply = g_new0(PulseFakeReply, 1);
+    reply->type = PULSE_FAKE_REPLY_RESTORE_EVENT;
+
+    queue_reply(c, reply);
+  }
+}
+
+static void process_operation(pa_context *c, pa_operation *o) {
+  PulseFakeObject *object;
+  PulseFakeObject *target;
+  gboolean success = TRUE;
+
+  switch (o->call) {
+    case PULSE_FAKE_CALL_SERVER_INFO:
+      reply_server_info(c, o);
+      return;
+
+    case PULSE_FAKE_CALL_LIST: {
+      guint i;
+
+      for (i = 0; i < objects[o->kind]->len; i++)
+        reply_info(c, o, g_ptr_array_index(objects[o->kind], i));
+
+      reply_eol(c, o, 1);
+      return;
+    }
+
+    case PULSE_FAKE_CALL_BY_INDEX:
+    case PULSE_FAKE_CALL_BY_NAME:
+      if (o->call == PULSE_FAKE_CALL_BY_INDEX)
+        object = find_object(o->kind, o->index);
+      else
+        object = find_object_by_name(o->kind, o->name);
+
+      if (object == NULL) {
+        c->error = PA_ERR_NOENTITY;
+        reply_eol(c, o, -1);
+        return;
+      }
+      reply_info(c, o, object);
+      reply_eol(c, o, 1);
+      return;
+
+    case PULSE_FAKE_CALL_EXT_READ:
+      reply_ext_streams(c, o);
+      return;
+
+    case PULSE_FAKE_CALL_SET_VOLUME:
+    case PULSE_FAKE_CALL_SET_MUTE:
+      object = find_object(o->kind, o->index);
+      if (object == NULL) {
+        success = FALSE;
+        break;
+      }
+
+      if (o->call == PULSE_FAKE_CALL_SET_VOLUME)
+        object->volume = o->volume;
+      else
+        object->mute = o->value ? TRUE : FALSE;
+
+      post_object_event(o->kind, PA_SUBSCRIPTION_EVENT_CHANGE, o->index);
+      break;
+
+    case PULSE_FAKE_CALL_SET_DEFAULT:
+      object = find_object_by_name(o->kind, o->name);
+      if (object == NULL) {
+        success = FALSE;
+        break;
+      }
+
+      if (o->kind == PULSE_FAKE_SINK) {
+        g_free(default_sink);
+        default_sink = g_strdup(o->name);
+      } else {
+        g_free(default_source);
+        default_source = g_strdup(o->name);
+      }
+
+      post_event(PA_SUBSCRIPTION_EVENT_SERVER, PA_SUBSCRIPTION_EVENT_CHANGE,
+                 PA_INVALID_INDEX);
+      break;
+
+    case PULSE_FAKE_CALL_MOVE:
+      object = find_object(o->kind, o->index);
+      target = find_object((o->kind == PULSE_FAKE_SINK_INPUT)
+                               ? PULSE_FAKE_SINK
+                               : PULSE_FAKE_SOURCE,
+                           o->target);
+
+      if (object == NULL || target == NULL) {
+        success = FALSE;
+        break;
+      }
+      object->parent = o->target;
+
+      post_object_event(o->kind, PA_SUBSCRIPTION_EVENT_CHANGE, o->index);
+      break;
+
+    case PULSE_FAKE_CALL_KILL:
+      object = find_object(o->kind, o->index);
+      if (object == NULL) {
+        success = FALSE;
+        break;
+      }
+      pulse_fake_remove(o->kind, o->index);
+      break;
+
+    case PULSE_FAKE_CALL_SUBSCRIBE:
+      c->mask = (pa_subscription_mask_t)o->value;
+
+      subscription_mask = c->mask;
+      break;
+
+    case PULSE_FAKE_CALL_EXT_WRITE:
+      success = write_ext_streams(o);
+      break;
+
+    case PULSE_FAKE_CALL_EXT_DELETE:
+      success = delete_ext_streams(o);
+      break;
+
+    case PULSE_FAKE_CALL_EXT_SUBSCRIBE:
+      c->restore_subscribed = o->value ? TRUE : FALSE;
+      break;
+
+    case PULSE_FAKE_CALL_NOOP:
+      break;
+  }
+
+  if (success == FALSE) c->error = PA_ERR_NOENTITY;
+
+  if (o->cb != NULL)
+    ((pa_context_success_cb_t)o->cb)(c, success ? 1 : 0, o->userdata);
+}
+
+static void reply_server_info(pa_context *c, pa_operation *o) {
+  pa_server_info info;
+
+  memset(&info, 0, sizeof(info));
+
+  info.user_name = "fake";
+  info.host_name = "localhost";
+  info.server_version = "0.0";
+  info.server_name = "pulseaudio (simulated)";
+  info.default_sink_name = default_sink;
+  info.default_source_name = default_source;
+
+  init_spec(&info.sample_spec, &info.channel_map);
+
+  if (o->cb != NULL) ((pa_server_info_cb_t)o->cb)(c, &info, o->userdata);
+}
+
+static void reply_info(pa_context *c, pa_operation *o,
+                       PulseFakeObject *object) {
+  pa_proplist *proplist;
+
+  if (o->cb == NULL) return;
+
+  proplist = pa_proplist_new();
+
+  switch (o->kind) {
+    case PULSE_FAKE_CARD: {
+      pa_card_info info;
+      pa_card_profile_info2 profile;
+      pa_card_profile_info2 *profiles[1] = {&profile};
+
+      memset(&profile, 0, sizeof(profile));
+      profile.name = "output:analog-stereo";
+      profile.description = "Analog Stereo Output";
+      profile.n_sinks = 1;
+      profile.priority = 6000;
+      profile.available = 1;
+
+      memset(&info, 0, sizeof(info));
+      info.index = object->index;
+      info.name = object->name;
+      info.owner_module = PA_INVALID_INDEX;
+      info.driver = "fake";
+      info.n_profiles = 1;
+      info.profiles2 = profiles;
+      info.active_profile2 = &profile;
+      info.proplist = proplist;
+
+      pa_proplist_sets(proplist, PA_PROP_DEVICE_DESCRIPTION, object->name);
+
+      ((pa_card_info_cb_t)o->cb)(c, &info, 0, o->userdata);
+      break;
+    }
+
+    case PULSE_FAKE_SINK: {
+      pa_sink_info info;
+
+      memset(&info, 0, sizeof(info));
+      info.index = object->index;
+      info.name = object->name;
+      info.description = object->name;
+      info.owner_module = PA_INVALID_INDEX;
+      info.volume = object->volume;
+      info.mute = object->mute;
+      info.monitor_source = PA_INVALID_INDEX;
+      info.driver = "fake";
+      info.flags = PA_SINK_HW_VOLUME_CTRL | PA_SINK_DECIBEL_VOLUME;
+      info.proplist = proplist;
+      info.base_volume = PA_VOLUME_NORM;
+      info.state = PA_SINK_IDLE;
+      info.n_volume_steps = PA_VOLUME_NORM + 1;
+      info.card = object->parent;
+
+      init_spec(&info.sample_spec, &info.channel_map);
+
+      ((pa_sink_info_cb_t)o->cb)(c, &info, 0, o->userdata);
+      break;
+    }
+
+    case PULSE_FAKE_SOURCE: {
+      pa_source_info info;
+
+      memset(&info, 0, sizeof(info));
+      info.index = object->index;
+      info.name = object->name;
+      info.description = object->name;
+      info.owner_module = PA_INVALID_INDEX;
+      info.volume = object->volume;
+      info.mute = object->mute;
+      info.monitor_of_sink = PA_INVALID_INDEX;
+      info.driver = "fake";
+      info.flags = PA_SOURCE_HW_VOLUME_CTRL | PA_SOURCE_DECIBEL_VOLUME;
+      info.proplist = proplist;
+      info.base_volume = PA_VOLUME_NORM;
+      info.state = PA_SOURCE_IDLE;
+      info.n_volume_steps = PA_VOLUME_NORM + 1;
+      info.card = object->parent;
+
+      init_spec(&info.sample_spec, &info.channel_map);
+
+      ((pa_source_info_cb_t)o->cb)(c, &info, 0, o->userdata);
+      break;
+    }
+
+    case PULSE_FAKE_SINK_INPUT: {
+      pa_sink_input_info info;
+
+      memset(&info, 0, sizeof(info));
+      info.index = object->index;
+      info.name = object->name;
+      info.owner_module = PA_INVALID_INDEX;
+      info.client = object->index;
+      info.sink = object->parent;
+      info.volume = object->volume;
+      info.mute = object->mute;
+      info.driver = "fake";
+      info.proplist = proplist;
+      info.has_volume = 1;
+      info.volume_writable = 1;
+
+      init_spec(&info.sample_spec, &info.channel_map);
+
+      /* Every stream is played by an application of its own */
+      pa_proplist_sets(proplist, PA_PROP_APPLICATION_NAME, object->name);
+
+      ((pa_sink_input_info_cb_t)o->cb)(c, &info, 0, o->userdata);
+      break;
+    }
+
+    case PULSE_FAKE_SOURCE_OUTPUT: {
+      pa_source_output_info info;
+
+      memset(&info, 0, sizeof(info));
+      info.index = object->index;
+      info.name = object->name;
+      info.owner_module = PA_INVALID_INDEX;
+      info.client = object->index;
+      info.source = object->parent;
+      info.volume = object->volume;
+      info.mute = object->mute;
+      info.driver = "fake";
+      info.proplist = proplist;
+      info.has_volume = 1;
+      info.volume_writable = 1;
+
+      init_spec(&info.sample_spec, &info.channel_map);
+
+      pa_proplist_sets(proplist, PA_PROP_APPLICATION_NAME, object->name);
+
+      ((pa_source_output_info_cb_t)o->cb)(c, &info, 0, o->userdata);
+      break;
+    }
+
+    case PULSE_FAKE_N_KINDS:
+      break;
+  }
+
+  pa_proplist_free(proplist);
+}
+
+static void reply_eol(pa_context *c, pa_operation *o, gint eol) {
+  if (o->cb == NULL) return;
+
+  switch (o->kind) {
+    case PULSE_FAKE_CARD:
+      ((pa_card_info_cb_t)o->cb)(c, NULL, eol, o->userdata);
+      break;
+    case PULSE_FAKE_SINK:
+      ((pa_sink_info_cb_t)o->cb)(c, NULL, eol, o->userdata);
+      break;
+    case PULSE_FAKE_SOURCE:
+      ((pa_source_info_cb_t)o->cb)(c, NULL, eol, o->userdata);
+      break;
+    case PULSE_FAKE_SINK_INPUT:
+      ((pa_sink_input_info_cb_t)o->cb)(c, NULL, eol, o->userdata);
+      break;
+    case PULSE_FAKE_SOURCE_OUTPUT:
+      ((pa_source_output_info_cb_t)o->cb)(c, NULL, eol, o->userdata);
+      break;
+    case PULSE_FAKE_N_KINDS:
+      break;
+  }
+}
+
+static void reply_ext_streams(pa_context *c, pa_operation *o) {
+  pa_ext_stream_restore_read_cb_t cb = (pa_ext_stream_restore_read_cb_t)o->cb;
+  guint i;
+
+  if (cb == NULL) return;
+
+  for (i = 0; i < ext_streams->len; i++) {
+    PulseFakeExtStream *ext = g_ptr_array_index(ext_streams, i);
+    pa_ext_stream_restore_info info;
+
+    memset(&info, 0, sizeof(info));
+    info.name = ext->name;
+    info.device = ext->device;
+    info.volume = ext->volume;
+    info.mute = ext->mute;
+
+    pa_channel_map_init_stereo(&info.channel_map);
+
+    cb(c, &info, 0, o->userdata);
+  }
+  cb(c, NULL, 1, o->userdata);
+}
+
+static gboolean write_ext_streams(pa_operation *o) {
+  guint i;
+
+  if (o->mode == PA_UPDATE_SET) g_ptr_array_set_size(ext_streams, 0);
+
+  for (i = 0; i < o->entries->len; i++) {
+    PulseFakeExtStream *entry = g_ptr_array_index(o->entries, i);
+    PulseFakeExtStream *ext;
+
+    ext = find_ext_stream(entry->name);
+    if (ext == NULL) {
+      ext = g_new0(PulseFakeExtStream, 1);
+      ext->name = g_strdup(entry->name);
+
+      g_ptr_array_add(ext_streams, ext);
+    }
+
+    g_free(ext->device);
+
+    ext->device = g_strdup(entry->device);
+    ext->volume = entry->volume;
+    ext->mute = entry->mute;
+  }
+
+  post_restore_event();
+  return TRUE;
+}
+
+static gboolean delete_ext_streams(pa_operation *o) {
+  guint i;
+
+  for (i = 0; o->names != NULL && o->names[i] != NULL; i++) {
+    PulseFakeExtStream *ext = find_ext_stream(o->names[i]);
+
+    if (ext != NULL) g_ptr_array_remove(ext_streams, ext);
+  }
+
+  post_restore_event();
+  return TRUE;
+}
+
+static void init_spec(pa_sample_spec *spec, pa_channel_map *map) {
+  spec->format = PA_SAMPLE_S16LE;
+  spec->rate = 44100;
+  spec->channels = 2;
+
+  pa_channel_map_init_stereo(map);
+}
@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PULSE_FAKE_H
+#define PULSE_FAKE_H
+
+/* This header is included in front of every source file of the PulseAudio
+ * backend built for the checks, it redirects the calls which talk to the
+ * sound server to the simulated server in pulse-fake.c.
+ *
+ * The simulated server is a part of the check program, the backend module
+ * resolves these functions from the program when it is loaded. The helpers
+ * which do not need a server, such as the volume and property list
+ * functions, are still provided by libpulse. */
+
+#include <glib.h>
+#include <pulse/ext-stream-restore.h>
+#include <pulse/glib-mainloop.h>
+#include <pulse/pulseaudio.h>
+
+G_BEGIN_DECLS
+
+/* The functions are also referenced by pointers, so the names are replaced
+ * rather than the calls */
+#define pa_glib_mainloop_new pulse_fake_glib_mainloop_new
+#define pa_glib_mainloop_free pulse_fake_glib_mainloop_free
+#define pa_glib_mainloop_get_api pulse_fake_glib_mainloop_get_api
+
+#define pa_context_new_with_proplist pulse_fake_context_new_with_proplist
+#define pa_context_ref pulse_fake_context_ref
+#define pa_context_unref pulse_fake_context_unref
+#define pa_context_connect pulse_fake_context_connect
+#define pa_context_get_state pulse_fake_context_get_state
+#define pa_context_errno pulse_fake_context_errno
+#define pa_context_set_state_callback pulse_fake_context_set_state_callback
+#define pa_context_set_subscribe_callback \
+  pulse_fake_context_set_subscribe_callback
+#define pa_context_subscribe pulse_fake_context_subscribe
+
+#define pa_context_get_server_info pulse_fake_context_get_server_info
+#define pa_context_get_card_info_by_index \
+  pulse_fake_context_get_card_info_by_index
+#define pa_context_get_card_info_by_name \
+  pulse_fake_context_get_card_info_by_name
+#define pa_context_get_card_info_list pulse_fake_context_get_card_info_list
+#define pa_context_get_sink_info_by_index \
+  pulse_fake_context_get_sink_info_by_index
+#define pa_context_get_sink_info_by_name \
+  pulse_fake_context_get_sink_info_by_name
+#define pa_context_get_sink_info_list pulse_fake_context_get_sink_info_list
+#define pa_context_get_source_info_by_index \
+  pulse_fake_context_get_source_info_by_index
+#define pa_context_get_source_info_by_name \
+  pulse_fake_context_get_source_info_by_name
+#define pa_context_get_source_info_list pulse_fake_context_get_source_info_list
+#define pa_context_get_sink_input_info pulse_fake_context_get_sink_input_info
+#define pa_context_get_sink_input_info_list \
+  pulse_fake_context_get_sink_input_info_list
+#define pa_context_get_source_output_info \
+  pulse_fake_context_get_source_output_info
+#define pa_context_get_source_output_info_list \
+  pulse_fake_context_get_source_output_info_list
+
+#define pa_context_set_default_sink pulse_fake_context_set_default_sink
+#define pa_context_set_default_source pulse_fake_context_set_default_source
+#define pa_context_set_card_profile_by_name \
+  pulse_fake_context_set_card_profile_by_name
+#define pa_context_set_sink_mute_by_index \
+  pulse_fake_context_set_sink_mute_by_index
+#define pa_context_set_sink_volume_by_index \
+  pulse_fake_context_set_sink_volume_by_index
+#define pa_context_set_sink_port_by_index \
+  pulse_fake_context_set_sink_port_by_index
+#define pa_context_set_source_mute_by_index \
+  pulse_fake_context_set_source_mute_by_index
+#define pa_context_set_source_volume_by_index \
+  pulse_fake_context_set_source_volume_by_index
+#define pa_context_set_source_port_by_index \
+  pulse_fake_context_set_source_port_by_index
+#define pa_context_set_sink_input_mute pulse_fake_context_set_sink_input_mute
+#define pa_context_set_sink_input_volume \
+  pulse_fake_context_set_sink_input_volume
+#define pa_context_set_source_output_mute \
+  pulse_fake_context_set_source_output_mute
+#define pa_context_set_source_output_volume \
+  pulse_fake_context_set_source_output_volume
+#define pa_context_suspend_sink_by_index \
+  pulse_fake_context_suspend_sink_by_index
+#define pa_context_suspend_source_by_index \
+  pulse_fake_context_suspend_source_by_index
+#define pa_context_move_sink_input_by_index \
+  pulse_fake_context_move_sink_input_by_index
+#define pa_context_move_source_output_by_index \
+  pulse_fake_context_move_source_output_by_index
+#define pa_context_kill_sink_input pulse_fake_context_kill_sink_input
+#define pa_context_kill_source_output pulse_fake_context_kill_source_output
+
+#define pa_ext_stream_restore_read pulse_fake_ext_stream_restore_read
+#define pa_ext_stream_restore_write pulse_fake_ext_stream_restore_write
+#define pa_ext_stream_restore_delete pulse_fake_ext_stream_restore_delete
+#define pa_ext_stream_restore_subscribe pulse_fake_ext_stream_restore_subscribe
+#define pa_ext_stream_restore_set_subscribe_cb \
+  pulse_fake_ext_stream_restore_set_subscribe_cb
+
+#define pa_operation_unref pulse_fake_operation_unref
+#define pa_operation_cancel pulse_fake_operation_cancel
+
+/* Peak monitors are not simulated, creating one always fails */
+#define pa_stream_new_with_proplist pulse_fake_stream_new_with_proplist
+
+pa_glib_mainloop *pulse_fake_glib_mainloop_new(GMainContext *c);
+void pulse_fake_glib_mainloop_free(pa_glib_mainloop *g);
+pa_mainloop_api *pulse_fake_glib_mainloop_get_api(pa_glib_mainloop *g);
+
+pa_context *pulse_fake_context_new_with_proplist(pa_mainloop_api *mainloop,
+                                                 const char *name,
+                                                 const pa_proplist *proplist);
+pa_context *pulse_fake_context_ref(pa_context *c);
+void pulse_fake_context_unref(pa_context *c);
+int pulse_fake_context_connect(pa_context *c, const char *server,
+                               pa_context_flags_t flags,
+                               const pa_spawn_api *api);
+pa_context_state_t pulse_fake_context_get_state(pa_context *c);
+int pulse_fake_context_errno(pa_context *c);
+void pulse_fake_context_set_state_callback(pa_context *c,
+                                           pa_context_notify_cb_t cb,
+                                           void *userdata);
+void pulse_fake_context_set_subscribe_callback(pa_context *c,
+                                               pa_context_subscribe_cb_t cb,
+                                               void *userdata);
+pa_operation *pulse_fake_context_subscribe(pa_context *c,
+                                           pa_subscription_mask_t m,
+                                           pa_context_success_cb_t cb,
+                                           void *userdata);
+
+pa_operation *pulse_fake_context_get_server_info(pa_context *c,
+                                                 pa_server_info_cb_t cb,
+                                                 void *userdata);
+pa_operation *pulse_fake_context_get_card_info_by_index(pa_context *c,
+                                                        uint32_t idx,
+                                                        pa_card_info_cb_t cb,
+                                                        void *userdata);
+pa_operation *pulse_fake_context_get_card_info_by_name(pa_context *c,
+                                                       const char *name,
+                                                       pa_card_info_cb_t cb,
+                                                       void *userdata);
+pa_operation *pulse_fake_context_get_card_info_list(pa_context *c,
+                                                    pa_card_info_cb_t cb,
+                                                    void *userdata);
+pa_operation *pulse_fake_context_get_sink_info_by_index(pa_context *c,
+                                                        uint32_t idx,
+                                                        pa_sink_info_cb_t cb,
+                                                        void *userdata);
+pa_operation *pulse_fake_context_get_sink_info_by_name(pa_context *c,
+                                                       const char *name,
+                                                       pa_sink_info_cb_t cb,
+                                                       void *userdata);
+pa_operation *pulse_fake_context_get_sink_info_list(pa_context *c,
+                                                    pa_sink_info_cb_t cb,
+                                                    void *userdata);
+pa_operation *pulse_fake_context_get_source_info_by_index(
+    pa_context *c, uint32_t idx, pa_source_info_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_get_source_info_by_name(pa_context *c,
+                                                         const char *name,
+                                                         pa_source_info_cb_t cb,
+                                                         void *userdata);
+pa_operation *pulse_fake_context_get_source_info_list(pa_context *c,
+                                                      pa_source_info_cb_t cb,
+                                                      void *userdata);
+pa_operation *pulse_fake_context_get_sink_input_info(
+    pa_context *c, uint32_t idx, pa_sink_input_info_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_get_sink_input_info_list(
+    pa_context *c, pa_sink_input_info_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_get_source_output_info(
+    pa_context *c, uint32_t idx, pa_source_output_info_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_get_source_output_info_list(
+    pa_context *c, pa_source_output_info_cb_t cb, void *userdata);
+
+pa_operation *pulse_fake_context_set_default_sink(pa_context *c,
+                                                  const char *name,
+                                                  pa_context_success_cb_t cb,
+                                                  void *userdata);
+pa_operation *pulse_fake_context_set_default_source(pa_context *c,
+                                                    const char *name,
+                                                    pa_context_success_cb_t cb,
+                                                    void *userdata);
+pa_operation *pulse_fake_context_set_card_profile_by_name(
+    pa_context *c, const char *name, const char *profile,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_set_sink_mute_by_index(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_set_sink_volume_by_index(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_set_sink_port_by_index(
+    pa_context *c, uint32_t idx, const char *port, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_set_source_mute_by_index(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_set_source_volume_by_index(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_set_source_port_by_index(
+    pa_context *c, uint32_t idx, const char *port, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_set_sink_input_mute(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_set_sink_input_volume(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_set_source_output_mute(
+    pa_context *c, uint32_t idx, int mute, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_set_source_output_volume(
+    pa_context *c, uint32_t idx, const pa_cvolume *volume,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_suspend_sink_by_index(
+    pa_context *c, uint32_t idx, int suspend, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_suspend_source_by_index(
+    pa_context *c, uint32_t idx, int suspend, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_move_sink_input_by_index(
+    pa_context *c, uint32_t idx, uint32_t sink_idx, pa_context_success_cb_t cb,
+    void *userdata);
+pa_operation *pulse_fake_context_move_source_output_by_index(
+    pa_context *c, uint32_t idx, uint32_t source_idx,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_context_kill_sink_input(pa_context *c, uint32_t idx,
+                                                 pa_context_success_cb_t cb,
+                                                 void *userdata);
+pa_operation *pulse_fake_context_kill_source_output(pa_context *c,
+                                                    uint32_t idx,
+                                                    pa_context_success_cb_t cb,
+                                                    void *userdata);
+
+pa_operation *pulse_fake_ext_stream_restore_read(
+    pa_context *c, pa_ext_stream_restore_read_cb_t cb, void *userdata);
+pa_operation *pulse_fake_ext_stream_restore_write(
+    pa_context *c, pa_update_mode_t mode,
+    const pa_ext_stream_restore_info data[], unsigned n, int apply_immediately,
+    pa_context_success_cb_t cb, void *userdata);
+pa_operation *pulse_fake_ext_stream_restore_delete(pa_context *c,
+                                                   const char *const s[],
+                                                   pa_context_success_cb_t cb,
+                                                   void *userdata);
+pa_operation *pulse_fake_ext_stream_restore_subscribe(
+    pa_context *c, int enable, pa_context_success_cb_t cb, void *userdata);
+void pulse_fake_ext_stream_restore_set_subscribe_cb(
+    pa_context *c, pa_ext_stream_restore_subscribe_cb_t cb, void *userdata);
+
+void pulse_fake_operation_unref(pa_operation *o);
+void pulse_fake_operation_cancel(pa_operation *o);
+
+pa_stream *pulse_fake_stream_new_with_proplist(pa_context *c, const char *name,
+                                               const pa_sample_spec *ss,
+                                               const pa_channel_map *map,
+                                               pa_proplist *p);
+
+/* The simulated server is driven by the check program through the following
+ * functions, objects are identified by their indices */
+typedef enum {
+  PULSE_FAKE_CARD,
+  PULSE_FAKE_SINK,
+  PULSE_FAKE_SOURCE,
+  PULSE_FAKE_SINK_INPUT,
+  PULSE_FAKE_SOURCE_OUTPUT,
+  PULSE_FAKE_N_KINDS
+} PulseFakeKind;
+
+typedef enum {
+  PULSE_FAKE_REQUEST_SERVER_INFO,
+  PULSE_FAKE_REQUEST_CARD_INFO,
+  PULSE_FAKE_REQUEST_SINK_INFO,
+  PULSE_FAKE_REQUEST_SOURCE_INFO,
+  PULSE_FAKE_REQUEST_SINK_INPUT_INFO,
+  PULSE_FAKE_REQUEST_SOURCE_OUTPUT_INFO,
+  PULSE_FAKE_REQUEST_EXT_STREAM_READ,
+  PULSE_FAKE_REQUEST_MOVE,
+  PULSE_FAKE_REQUEST_KILL,
+  PULSE_FAKE_REQUEST_WRITE,
+  PULSE_FAKE_N_REQUESTS
+} PulseFakeRequest;
+
+void pulse_fake_reset(void);
+void pulse_fake_set_latency(guint latency);
+
+void pulse_fake_stop(void);
+void pulse_fake_start(void);
+void pulse_fake_restart(void);
+
+guint32 pulse_fake_add(PulseFakeKind kind, const gchar *name, guint32 parent);
+void pulse_fake_remove(PulseFakeKind kind, guint32 index);
+void pulse_fake_set_volume(PulseFakeKind kind, guint32 index,
+                           pa_volume_t volume);
+void pulse_fake_storm(PulseFakeKind kind, guint n_events);
+
+void pulse_fake_add_ext_stream(const gchar *name, const gchar *device);
+
+guint32 pulse_fake_find(PulseFakeKind kind, const gchar *name);
+guint pulse_fake_get_requests(PulseFakeRequest request);
+pa_subscription_mask_t pulse_fake_get_subscription_mask(void);
+gboolean pulse_fake_is_idle(void);
+
+G_END_DECLS
+
+#endif /* PULSE_FAKE_H */
@@ -0,0 +1,767 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef G_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include <libmatemixer/matemixer.h>
+
+#ifdef BENCH_MODULES_DIR
+#include <libmatemixer/matemixer-private.h>
+#endif
+
+/* How long to wait for a single notification in the latency test before the
+ * sample is counted as lost */
+#define LATENCY_TIMEOUT 1000
+
+typedef enum { FORMAT_TEXT, FORMAT_JSON, FORMAT_CSV } OutputFormat;
+
+typedef struct {
+  const gchar *section;
+  gchar *name;
+  gdouble value;
+  const gchar *unit;
+} Metric;
+
+typedef struct {
+  GType type;
+  guint count;
+} ObjectUsage;
+
+static MateMixerContext *context;
+static GArray *metrics;
+static GHashTable *events;
+static gboolean counting = FALSE;
+
+static GPollFunc default_poll;
+static guint wakeups = 0;
+
+static MateMixerStreamControl *latency_control;
+static gboolean latency_notified;
+static gint64 latency_time;
+
+/* Add a measured value to the report, the name is copied */
+static void add_metric(const gchar *section, const gchar *name, gdouble value,
+                       const gchar *unit) {
+  Metric metric;
+
+  metric.section = section;
+  metric.name = g_strdup(name);
+  metric.value = value;
+  metric.unit = unit;
+
+  g_array_append_val(metrics, metric);
+}
+
+static void clear_metric(Metric *metric) { g_free(metric->name); }
+
+static gdouble to_ms(gint64 usec) { return (gdouble)usec / 1000.0; }
+
+/* Resident set size of the process in bytes or -1 if not available */
+static gint64 get_resident_size(void) {
+#ifdef G_OS_UNIX
+  gchar *contents;
+  gchar **fields;
+  gint64 size = -1;
+
+  if (g_file_get_contents("/proc/self/statm", &contents, NULL, NULL) == FALSE)
+    return -1;
+
+  fields = g_strsplit(contents, " ", 3);
+  if (fields[0] != NULL && fields[1] != NULL)
+    size = g_ascii_strtoll(fields[1], NULL, 10) * sysconf(_SC_PAGESIZE);
+
+  g_strfreev(fields);
+  g_free(contents);
+  return size;
+#else
+  return -1;
+#endif
+}
+
+/* Count the times the main loop goes to sleep and wakes up again, polls which
+ * do not block are not wakeups */
+static gint count_poll(GPollFD *fds, guint nfds, gint timeout) {
+  if (counting == TRUE && timeout != 0) wakeups++;
+
+  return default_poll(fds, nfds, timeout);
+}
+
+/* Block in the main loop until the flag is set or the timeout expires */
+static gboolean on_wait_timeout(gpointer timed_out) {
+  *(gboolean *)timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean wait_for(gboolean *done, guint timeout) {
+  GSource *source;
+  gboolean timed_out = FALSE;
+
+  source = g_timeout_source_new(timeout);
+  g_source_set_callback(source, on_wait_timeout, &timed_out, NULL);
+  g_source_attach(source, NULL);
+
+  while (*done == FALSE && timed_out == FALSE)
+    g_main_context_iteration(NULL, TRUE);
+
+  g_source_destroy(source);
+  g_source_unref(source);
+  return *done;
+}
+
+static void count_event(const gchar *kind, const gchar *signal) {
+  gchar *key;
+  gpointer value;
+
+  if (counting == FALSE) return;
+
+  key = g_strdup_printf("%s:%s", kind, signal);
+
+  value = g_hash_table_lookup(events, key);
+  g_hash_table_insert(events, key,
+                      GUINT_TO_POINTER(GPOINTER_TO_UINT(value) + 1));
+}
+
+static void on_control_notify(MateMixerStreamControl *control,
+                              GParamSpec *pspec) {
+  gchar *signal;
+
+  signal = g_strdup_printf("notify::%s", pspec->name);
+  count_event("control", signal);
+  g_free(signal);
+
+  if (control == latency_control && strcmp(pspec->name, "volume") == 0 &&
+      latency_notified == FALSE) {
+    latency_time = g_get_monotonic_time() - latency_time;
+    latency_notified = TRUE;
+  }
+}
+
+static void on_switch_notify(MateMixerSwitch *swtch, GParamSpec *pspec) {
+  gchar *signal;
+
+  signal = g_strdup_printf("notify::%s", pspec->name);
+  count_event("switch", signal);
+  g_free(signal);
+}
+
+static void watch_control(MateMixerStreamControl *control) {
+  g_signal_connect(G_OBJECT(control), "notify", G_CALLBACK(on_control_notify),
+                   NULL);
+}
+
+static void on_stream_control_added(MateMixerStream *stream,
+                                    const gchar *name) {
+  MateMixerStreamControl *control;
+
+  count_event("stream", "control-added");
+
+  control = mate_mixer_stream_get_control(stream, name);
+  if (control != NULL) watch_control(control);
+}
+
+static void on_stream_control_removed(MateMixerStream *stream,
+                                      const gchar *name) {
+  count_event("stream", "control-removed");
+}
+
+static void watch_stream(MateMixerStream *stream) {
+  const GList *list;
+
+  g_signal_connect(G_OBJECT(stream), "control-added",
+                   G_CALLBACK(on_stream_control_added), NULL);
+  g_signal_connect(G_OBJECT(stream), "control-removed",
+                   G_CALLBACK(on_stream_control_removed), NULL);
+
+  list = mate_mixer_stream_list_controls(stream);
+  while (list != NULL) {
+    watch_control(MATE_MIXER_STREAM_CONTROL(list->data));
+    list = list->next;
+  }
+
+  list = mate_mixer_stream_list_switches(stream);
+  while (list != NULL) {
+    g_signal_connect(G_OBJECT(list->data), "notify",
+                     G_CALLBACK(on_switch_notify), NULL);
+    list = list->next;
+  }
+}
+
+static void on_context_device_added(MateMixerContext *context,
+                                    const gchar *name) {
+  count_event("context", "device-added");
+}
+
+static void on_context_device_removed(MateMixerContext *context,
+                                      const gchar *name) {
+  count_event("context", "device-removed");
+}
+
+static void on_context_stream_added(MateMixerContext *context,
+                                    const gchar *name) {
+  MateMixerStream *stream;
+
+  count_event("context", "stream-added");
+
+  stream = mate_mixer_context_get_stream(context, name);
+  if (stream != NULL) watch_stream(stream);
+}
+
+static void on_context_stream_removed(MateMixerContext *context,
+                                      const gchar *name) {
+  count_event("context", "stream-removed");
+}
+
+static void on_context_stored_control_added(MateMixerContext *context,
+                                            const gchar *name) {
+  MateMixerStoredControl *control;
+
+  count_event("context", "stored-control-added");
+
+  control = mate_mixer_context_get_stored_control(context, name);
+  if (control != NULL) watch_control(MATE_MIXER_STREAM_CONTROL(control));
+}
+
+static void on_context_stored_control_removed(MateMixerContext *context,
+                                              const gchar *name) {
+  count_event("context", "stored-control-removed");
+}
+
+static void on_context_notify(MateMixerContext *context, GParamSpec *pspec) {
+  gchar *signal;
+
+  signal = g_strdup_printf("notify::%s", pspec->name);
+  count_event("context", signal);
+  g_free(signal);
+}
+
+static void on_context_state_notify(MateMixerContext *context,
+                                    GParamSpec *pspec, gboolean *done) {
+  MateMixerState state;
+
+  state = mate_mixer_context_get_state(context);
+  if (state == MATE_MIXER_STATE_READY || state == MATE_MIXER_STATE_FAILED)
+    *done = TRUE;
+}
+
+static void watch_context(void) {
+  const GList *list;
+
+  g_signal_connect(G_OBJECT(context), "device-added",
+                   G_CALLBACK(on_context_device_added), NULL);
+  g_signal_connect(G_OBJECT(context), "device-removed",
+                   G_CALLBACK(on_context_device_removed), NULL);
+  g_signal_connect(G_OBJECT(context), "stream-added",
+                   G_CALLBACK(on_context_stream_added), NULL);
+  g_signal_connect(G_OBJECT(context), "stream-removed",
+                   G_CALLBACK(on_context_stream_removed), NULL);
+  g_signal_connect(G_OBJECT(context), "stored-control-added",
+                   G_CALLBACK(on_context_stored_control_added), NULL);
+  g_signal_connect(G_OBJECT(context), "stored-control-removed",
+                   G_CALLBACK(on_context_stored_control_removed), NULL);
+  g_signal_connect(G_OBJECT(context), "notify", G_CALLBACK(on_context_notify),
+                   NULL);
+
+  list = mate_mixer_context_list_streams(context);
+  while (list != NULL) {
+    watch_stream(MATE_MIXER_STREAM(list->data));
+    list = list->next;
+  }
+
+  list = mate_mixer_context_list_stored_controls(context);
+  while (list != NULL) {
+    watch_control(MATE_MIXER_STREAM_CONTROL(list->data));
+    list = list->next;
+  }
+}
+
+/* Walk through all the objects the way a mixer application would when it
+ * populates its user interface and count them by type */
+static void count_object(GHashTable *usage, gpointer object) {
+  ObjectUsage *item;
+  GType type;
+
+  type = G_OBJECT_TYPE(object);
+
+  item = g_hash_table_lookup(usage, GSIZE_TO_POINTER(type));
+  if (item == NULL) {
+    item = g_new0(ObjectUsage, 1);
+    item->type = type;
+    g_hash_table_insert(usage, GSIZE_TO_POINTER(type), item);
+  }
+  item->count++;
+}
+
+static void count_switches(GHashTable *usage, const GList *switches) {
+  while (switches != NULL) {
+    const GList *options;
+
+    count_object(usage, switches->data);
+
+    options = mate_mixer_switch_list_options(MATE_MIXER_SWITCH(switches->data));
+    while (options != NULL) {
+      count_object(usage, options->data);
+      options = options->next;
+    }
+    switches = switches->next;
+  }
+}
+
+static void enumerate_objects(GHashTable *usage) {
+  const GList *list;
+
+  list = mate_mixer_context_list_devices(context);
+  while (list != NULL) {
+    MateMixerDevice *device = MATE_MIXER_DEVICE(list->data);
+
+    count_object(usage, device);
+    count_switches(usage, mate_mixer_device_list_switches(device));
+    list = list->next;
+  }
+
+  list = mate_mixer_context_list_streams(context);
+  while (list != NULL) {
+    MateMixerStream *stream = MATE_MIXER_STREAM(list->data);
+    const GList *controls;
+
+    count_object(usage, stream);
+
+    controls = mate_mixer_stream_list_controls(stream);
+    while (controls != NULL) {
+      count_object(usage, controls->data);
+      controls = controls->next;
+    }
+    count_switches(usage, mate_mixer_stream_list_switches(stream));
+    list = list->next;
+  }
+
+  list = mate_mixer_context_list_stored_controls(context);
+  while (list != NULL) {
+    count_object(usage, list->data);
+    list = list->next;
+  }
+}
+
+static gint compare_usage(gconstpointer a, gconstpointer b) {
+  const ObjectUsage *ua = *(ObjectUsage *const *)a;
+  const ObjectUsage *ub = *(ObjectUsage *const *)b;
+
+  return strcmp(g_type_name(ua->type), g_type_name(ub->type));
+}
+
+static void measure_objects(void) {
+  GHashTable *usage;
+  GPtrArray *items;
+  GHashTableIter iter;
+  gpointer value;
+  gint64 start;
+  guint i;
+
+  usage = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+
+  start = g_get_monotonic_time();
+  enumerate_objects(usage);
+  add_metric("startup", "enumerate", to_ms(g_get_monotonic_time() - start),
+             "ms");
+
+  /* Only the instance structures are accounted for, memory allocated by the
+   * objects themselves is part of the resident size difference */
+  items = g_ptr_array_new();
+
+  g_hash_table_iter_init(&iter, usage);
+  while (g_hash_table_iter_next(&iter, NULL, &value) == TRUE)
+    g_ptr_array_add(items, value);
+
+  g_ptr_array_sort(items, compare_usage);
+
+  for (i = 0; i < items->len; i++) {
+    ObjectUsage *item = g_ptr_array_index(items, i);
+    GTypeQuery query;
+    gchar *name;
+
+    g_type_query(item->type, &query);
+
+    name = g_strdup_printf("%s.count", g_type_name(item->type));
+    add_metric("objects", name, item->count, "objects");
+    g_free(name);
+
+    name = g_strdup_printf("%s.size", g_type_name(item->type));
+    add_metric("objects", name, (gdouble)item->count * query.instance_size,
+               "bytes");
+    g_free(name);
+  }
+
+  g_ptr_array_free(items, TRUE);
+  g_hash_table_unref(usage);
+}
+
+static void measure_events(guint duration) {
+  GList *keys;
+  GList *list;
+  gboolean done = FALSE;
+  gint64 start;
+  gdouble seconds;
+
+  counting = TRUE;
+  wakeups = 0;
+
+  start = g_get_monotonic_time();
+  wait_for(&done, duration * 1000);
+  seconds = (gdouble)(g_get_monotonic_time() - start) / G_USEC_PER_SEC;
+
+  counting = FALSE;
+
+  add_metric("wakeups", "main-loop", wakeups / seconds, "wakeups/s");
+
+  keys = g_hash_table_get_keys(events);
+  keys = g_list_sort(keys, (GCompareFunc)strcmp);
+
+  for (list = keys; list != NULL; list = list->next) {
+    guint count;
+
+    count = GPOINTER_TO_UINT(g_hash_table_lookup(events, list->data));
+    add_metric("events", list->data, count / seconds, "events/s");
+  }
+  g_list_free(keys);
+}
+
+/* Find a control to measure the latency with, prefer the one most likely
+ * touched by users */
+static MateMixerStreamControl *find_latency_control(void) {
+  MateMixerStream *stream;
+  MateMixerStreamControl *control;
+  const GList *list;
+
+  stream = mate_mixer_context_get_default_output_stream(context);
+  if (stream != NULL) {
+    control = mate_mixer_stream_get_default_control(stream);
+    if (control != NULL &&
+        mate_mixer_stream_control_get_flags(control) &
+            MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE)
+      return control;
+  }
+
+  list = mate_mixer_context_list_streams(context);
+  while (list != NULL) {
+    const GList *controls;
+
+    controls = mate_mixer_stream_list_controls(MATE_MIXER_STREAM(list->data));
+    while (controls != NULL) {
+      control = MATE_MIXER_STREAM_CONTROL(controls->data);
+
+      if (mate_mixer_stream_control_get_flags(control) &
+          MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE)
+        return control;
+
+      controls = controls->next;
+    }
+    list = list->next;
+  }
+  return NULL;
+}
+
+static gint compare_double(gconstpointer a, gconstpointer b) {
+  gdouble da = *(const gdouble *)a;
+  gdouble db = *(const gdouble *)b;
+
+  return (da > db) - (da < db);
+}
+
+static void measure_latency(guint iterations) {
+  GArray *samples;
+  guint volume[2];
+  guint original;
+  guint lost = 0;
+  gdouble sum = 0;
+  guint i;
+
+  latency_control = find_latency_control();
+  if (latency_control == NULL) {
+    g_printerr("No writable volume control, skipping latency test.\n");
+    return;
+  }
+
+  /* Alternate between two distinct values so that each call is a change */
+  original = mate_mixer_stream_control_get_volume(latency_control);
+  volume[0] = mate_mixer_stream_control_get_min_volume(latency_control);
+  volume[1] = mate_mixer_stream_control_get_normal_volume(latency_control);
+  if (original == volume[0]) volume[0] = (volume[0] + volume[1]) / 2;
+
+  samples = g_array_sized_new(FALSE, FALSE, sizeof(gdouble), iterations);
+
+  for (i = 0; i < iterations; i++) {
+    gdouble sample;
+
+    latency_notified = FALSE;
+    latency_time = g_get_monotonic_time();
+
+    if (mate_mixer_stream_control_set_volume(latency_control,
+                                             volume[i % 2]) == FALSE) {
+      lost++;
+      continue;
+    }
+
+    /* Backends without a server notify before the setter returns */
+    if (wait_for(&latency_notified, LATENCY_TIMEOUT) == FALSE) {
+      lost++;
+      continue;
+    }
+
+    sample = to_ms(latency_time);
+    g_array_append_val(samples, sample);
+  }
+
+  mate_mixer_stream_control_set_volume(latency_control, original);
+
+  if (samples->len > 0) {
+    g_array_sort(samples, compare_double);
+
+    for (i = 0; i < samples->len; i++)
+      sum += g_array_index(samples, gdouble, i);
+
+    add_metric("latency", "min", g_array_index(samples, gdouble, 0), "ms");
+    add_metric("latency", "median",
+               g_array_index(samples, gdouble, samples->len / 2), "ms");
+    add_metric("latency", "p95",
+               g_array_index(samples, gdouble, samples->len * 95 / 100), "ms");
+    add_metric("latency", "max",
+               g_array_index(samples, gdouble, samples->len - 1), "ms");
+    add_metric("latency", "mean", sum / samples->len, "ms");
+  }
+  add_metric("latency", "lost", lost, "samples");
+
+  g_array_free(samples, TRUE);
+  latency_control = NULL;
+}
+
+static void print_report(OutputFormat format) {
+  guint i;
+
+  switch (format) {
+    case FORMAT_JSON:
+      g_print("{\n  \"backend\": \"%s\",\n  \"metrics\": [\n",
+              mate_mixer_context_get_backend_name(context));
+
+      for (i = 0; i < metrics->len; i++) {
+        Metric *metric = &g_array_index(metrics, Metric, i);
+        gchar *name = g_strescape(metric->name, NULL);
+        gchar value[G_ASCII_DTOSTR_BUF_SIZE];
+
+        g_ascii_formatd(value, sizeof(value), "%.3f", metric->value);
+        g_print(
+            "    {\"section\": \"%s\", \"name\": \"%s\", \"value\": %s, "
+            "\"unit\": \"%s\"}%s\n",
+            metric->section, name, value, metric->unit,
+            (i + 1 < metrics->len) ? "," : "");
+        g_free(name);
+      }
+      g_print("  ]\n}\n");
+      break;
+
+    case FORMAT_CSV:
+      g_print("section,name,value,unit\n");
+
+      for (i = 0; i < metrics->len; i++) {
+        Metric *metric = &g_array_index(metrics, Metric, i);
+        gchar value[G_ASCII_DTOSTR_BUF_SIZE];
+
+        g_ascii_formatd(value, sizeof(value), "%.3f", metric->value);
+        g_print("%s,%s,%s,%s\n", metric->section, metric->name, value,
+                metric->unit);
+      }
+      break;
+
+    default:
+      g_print("Backend: %s\n\n", mate_mixer_context_get_backend_name(context));
+
+      for (i = 0; i < metrics->len; i++) {
+        Metric *metric = &g_array_index(metrics, Metric, i);
+
+        g_print("%-8s %-48s %14.3f %s\n", metric->section, metric->name,
+                metric->value, metric->unit);
+      }
+      break;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  MateMixerState state;
+  GOptionContext *ctx;
+  gchar *backend = NULL;
+  gchar *server = NULL;
+  gchar *format = NULL;
+  gint duration = 5;
+  gint iterations = 100;
+  gboolean done = FALSE;
+  OutputFormat output = FORMAT_TEXT;
+  GError *error = NULL;
+  gint64 rss;
+  gint64 start, opened;
+  GOptionEntry entries[] = {
+      {"backend", 'b', 0, G_OPTION_ARG_STRING, &backend,
+       "Sound system to use (pulseaudio, alsa, oss, null)", NULL},
+      {"server", 's', 0, G_OPTION_ARG_STRING, &server, "Sound server address",
+       NULL},
+      {"duration", 't', 0, G_OPTION_ARG_INT, &duration,
+       "Seconds to count events for (default 5)", "SECONDS"},
+      {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+       "Number of volume changes in the latency test (default 100)", "N"},
+      {"format", 'f', 0, G_OPTION_ARG_STRING, &format,
+       "Output format (text, json, csv)", "FORMAT"},
+      {NULL}};
+
+  ctx = g_option_context_new("- libmatemixer benchmark");
+
+  g_option_context_add_main_entries(ctx, entries, NULL);
+
+  if (g_option_context_parse(ctx, &argc, &argv, &error) == FALSE) {
+    g_printerr("%s\n", error->message);
+    g_error_free(error);
+    g_option_context_free(ctx);
+    return 1;
+  }
+
+  g_option_context_free(ctx);
+
+  if (format != NULL) {
+    if (strcmp(format, "json") == 0)
+      output = FORMAT_JSON;
+    else if (strcmp(format, "csv") == 0)
+      output = FORMAT_CSV;
+    else if (strcmp(format, "text") != 0) {
+      g_printerr("Output format '%s' is unknown.\n", format);
+      g_free(format);
+      return 1;
+    }
+    g_free(format);
+  }
+
+  setlocale(LC_ALL, "");
+
+  metrics = g_array_new(FALSE, FALSE, sizeof(Metric));
+  g_array_set_clear_func(metrics, (GDestroyNotify)clear_metric);
+
+  events = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+  default_poll = g_main_context_get_poll_func(NULL);
+  g_main_context_set_poll_func(NULL, count_poll);
+
+  rss = get_resident_size();
+
+  /* Loading of the backend modules */
+  start = g_get_monotonic_time();
+
+#ifdef BENCH_MODULES_DIR
+  /* Copies built for the checks use the backend modules of the build tree */
+  _mate_mixer_set_modules_dir(BENCH_MODULES_DIR);
+#endif
+
+  if (mate_mixer_init() == FALSE) return 1;
+
+  add_metric("startup", "init", to_ms(g_get_monotonic_time() - start), "ms");
+
+  context = mate_mixer_context_new();
+
+  mate_mixer_context_set_app_name(context, "MateMixer Benchmark");
+  mate_mixer_context_set_app_id(context, "org.mate-desktop.libmatemixer-bench");
+  mate_mixer_context_set_app_version(context, "1.0");
+  mate_mixer_context_set_app_icon(context, "multimedia-volume-control");
+
+  if (backend != NULL) {
+    if (strcmp(backend, "pulseaudio") == 0)
+      mate_mixer_context_set_backend_type(context,
+                                          MATE_MIXER_BACKEND_PULSEAUDIO);
+    else if (strcmp(backend, "alsa") == 0)
+      mate_mixer_context_set_backend_type(context, MATE_MIXER_BACKEND_ALSA);
+    else if (strcmp(backend, "oss") == 0)
+      mate_mixer_context_set_backend_type(context, MATE_MIXER_BACKEND_OSS);
+    else if (strcmp(backend, "null") == 0)
+      mate_mixer_context_set_backend_type(context, MATE_MIXER_BACKEND_NULL);
+    else
+      g_printerr(
+          "Sound system backend '%s' is unknown, the backend will be "
+          "auto-detected.\n",
+          backend);
+
+    g_free(backend);
+  }
+
+  if (server != NULL) {
+    mate_mixer_context_set_server_address(context, server);
+    g_free(server);
+  }
+
+  g_signal_connect(G_OBJECT(context), "notify::state",
+                   G_CALLBACK(on_context_state_notify), &done);
+
+  /* Synchronous part of the startup, the backend is created and opened */
+  start = g_get_monotonic_time();
+
+  if (mate_mixer_context_open(context) == FALSE) {
+    g_printerr("Could not connect to a sound system, quitting.\n");
+    g_object_unref(context);
+    return 1;
+  }
+
+  opened = g_get_monotonic_time();
+  add_metric("startup", "open", to_ms(opened - start), "ms");
+
+  /* Asynchronous part of the startup, the backend reads the initial state
+   * of the sound system */
+  state = mate_mixer_context_get_state(context);
+  if (state == MATE_MIXER_STATE_CONNECTING) wait_for(&done, G_MAXUINT);
+
+  state = mate_mixer_context_get_state(context);
+  if (state != MATE_MIXER_STATE_READY) {
+    g_printerr("Connection failed.\n");
+    g_object_unref(context);
+    return 1;
+  }
+
+  add_metric("startup", "connect", to_ms(g_get_monotonic_time() - opened),
+             "ms");
+  add_metric("startup", "total", to_ms(g_get_monotonic_time() - start), "ms");
+
+  measure_objects();
+
+  if (rss != -1) {
+    gint64 ready = get_resident_size();
+
+    if (ready != -1) add_metric("memory", "resident", ready - rss, "bytes");
+  }
+
+  watch_context();
+
+  if (duration > 0) measure_events(duration);
+  if (iterations > 0) measure_latency(iterations);
+
+  print_report(output);
+
+  g_object_unref(context);
+
+  g_hash_table_unref(events);
+  g_array_free(metrics, TRUE);
+  return 0;
+}
@@ -24,7 +24,10 @@
 
 G_BEGIN_DECLS
 
+/* The records may be shared by reference once they are no longer modified,
+ * the strings are owned by the record and freed with it */
 struct _MateMixerAppInfo {
+  gint ref_count;
   gchar *name;
   gchar *id;
   gchar *version;
@@ -40,7 +43,9 @@ void _mate_mixer_app_info_set_version(MateMixerAppInfo *info,
 void _mate_mixer_app_info_set_icon(MateMixerAppInfo *info, const gchar *icon);
 
 MateMixerAppInfo *_mate_mixer_app_info_copy(MateMixerAppInfo *info);
-void _mate_mixer_app_info_free(MateMixerAppInfo *info);
+
+MateMixerAppInfo *_mate_mixer_app_info_ref(MateMixerAppInfo *info);
+void _mate_mixer_app_info_unref(MateMixerAppInfo *info);
 
 G_END_DECLS
 
@@ -38,7 +38,7 @@
  * be accessed using the provided API.
  */
 G_DEFINE_BOXED_TYPE(MateMixerAppInfo, mate_mixer_app_info,
-                    _mate_mixer_app_info_copy, _mate_mixer_app_info_free)
+                    _mate_mixer_app_info_ref, _mate_mixer_app_info_unref)
 
 /**
  * mate_mixer_app_info_get_name:
@@ -105,7 +105,12 @@ const gchar *mate_mixer_app_info_get_icon(MateMixerAppInfo *info) {
  * Returns: a new #MateMixerAppInfo.
  */
 MateMixerAppInfo *_mate_mixer_app_info_new(void) {
-  return g_slice_new0(MateMixerAppInfo);
+  MateMixerAppInfo *info;
+
+  info = g_slice_new0(MateMixerAppInfo);
+  info->ref_count = 1;
+
+  return info;
 }
 
 /**
@@ -119,7 +124,6 @@ void _mate_mixer_app_info_set_name(MateMixerAppInfo *info, const gchar *name) {
   g_return_if_fail(info != NULL);
 
   g_free(info->name);
-
   info->name = g_strdup(name);
 }
 
@@ -134,7 +138,6 @@ void _mate_mixer_app_info_set_id(MateMixerAppInfo *info, const gchar *id) {
   g_return_if_fail(info != NULL);
 
   g_free(info->id);
-
   info->id = g_strdup(id);
 }
 
@@ -150,12 +153,11 @@ void _mate_mixer_app_info_set_version(MateMixerAppInfo *info,
   g_return_if_fail(info != NULL);
 
   g_free(info->version);
-
   info->version = g_strdup(version);
 }
 
 /**
- * _mate_mixer_app_info_set_version:
+ * _mate_mixer_app_info_set_icon:
  * @info: a #MateMixerAppInfo
  * @icon: the application icon name to set
  *
@@ -165,7 +167,6 @@ void _mate_mixer_app_info_set_icon(MateMixerAppInfo *info, const gchar *icon) {
   g_return_if_fail(info != NULL);
 
   g_free(info->icon);
-
   info->icon = g_strdup(icon);
 }
 
@@ -173,7 +174,8 @@ void _mate_mixer_app_info_set_icon(MateMixerAppInfo *info, const gchar *icon) {
  * _mate_mixer_app_info_copy:
  * @info: a #MateMixerAppInfo
  *
- * Creates a copy of the #MateMixerAppInfo.
+ * Creates a copy of the #MateMixerAppInfo, which unlike @info may be
+ * modified.
  *
  * Returns: a copy of the given @info.
  */
@@ -192,14 +194,33 @@ MateMixerAppInfo *_mate_mixer_app_info_copy(MateMixerAppInfo *info) {
 }
 
 /**
- * _mate_mixer_app_info_free:
+ * _mate_mixer_app_info_ref:
  * @info: a #MateMixerAppInfo
  *
- * Frees the #MateMixerAppInfo.
+ * Increases the reference count of the #MateMixerAppInfo. A record must not
+ * be modified once it is shared.
+ *
+ * Returns: the given @info.
  */
-void _mate_mixer_app_info_free(MateMixerAppInfo *info) {
+MateMixerAppInfo *_mate_mixer_app_info_ref(MateMixerAppInfo *info) {
+  g_return_val_if_fail(info != NULL, NULL);
+
+  g_atomic_int_inc(&info->ref_count);
+  return info;
+}
+
+/**
+ * _mate_mixer_app_info_unref:
+ * @info: a #MateMixerAppInfo
+ *
+ * Decreases the reference count of the #MateMixerAppInfo and frees it when
+ * the count drops to zero.
+ */
+void _mate_mixer_app_info_unref(MateMixerAppInfo *info) {
   g_return_if_fail(info != NULL);
 
+  if (g_atomic_int_dec_and_test(&info->ref_count) == FALSE) return;
+
   g_free(info->name);
   g_free(info->id);
   g_free(info->version);
@@ -242,6 +242,41 @@ void mate_mixer_backend_set_server_address(MateMixerBackend *backend,
     klass->set_server_address(backend, address);
 }
 
+void mate_mixer_backend_set_loading_flags(MateMixerBackend *backend,
+                                          MateMixerLoadingFlags flags) {
+  MateMixerBackendClass *klass;
+
+  g_return_if_fail(MATE_MIXER_IS_BACKEND(backend));
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  if (klass->set_loading_flags != NULL)
+    klass->set_loading_flags(backend, flags);
+}
+
+void mate_mixer_backend_set_min_control_lifetime(MateMixerBackend *backend,
+                                                 guint lifetime) {
+  MateMixerBackendClass *klass;
+
+  g_return_if_fail(MATE_MIXER_IS_BACKEND(backend));
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  if (klass->set_min_control_lifetime != NULL)
+    klass->set_min_control_lifetime(backend, lifetime);
+}
+
+void mate_mixer_backend_set_interests(MateMixerBackend *backend,
+                                      MateMixerInterestFlags interests) {
+  MateMixerBackendClass *klass;
+
+  g_return_if_fail(MATE_MIXER_IS_BACKEND(backend));
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  if (klass->set_interests != NULL) klass->set_interests(backend, interests);
+}
+
 gboolean mate_mixer_backend_open(MateMixerBackend *backend) {
   g_return_val_if_fail(MATE_MIXER_IS_BACKEND(backend), FALSE);
 
@@ -359,6 +394,54 @@ const GList *mate_mixer_backend_list_stored_controls(
   return NULL;
 }
 
+GList *mate_mixer_backend_list_loaded_streams(MateMixerBackend *backend) {
+  MateMixerBackendClass *klass;
+
+  g_return_val_if_fail(MATE_MIXER_IS_BACKEND(backend), NULL);
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  /* Backends which load everything up front have nothing to skip */
+  if (klass->list_loaded_streams != NULL)
+    return klass->list_loaded_streams(backend);
+
+  return g_list_copy((GList *)mate_mixer_backend_list_streams(backend));
+}
+
+GList *mate_mixer_backend_list_loaded_stored_controls(
+    MateMixerBackend *backend) {
+  MateMixerBackendClass *klass;
+
+  g_return_val_if_fail(MATE_MIXER_IS_BACKEND(backend), NULL);
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  if (klass->list_loaded_stored_controls != NULL)
+    return klass->list_loaded_stored_controls(backend);
+
+  return g_list_copy((GList *)mate_mixer_backend_list_stored_controls(backend));
+}
+
+void mate_mixer_backend_begin_transaction(MateMixerBackend *backend) {
+  MateMixerBackendClass *klass;
+
+  g_return_if_fail(MATE_MIXER_IS_BACKEND(backend));
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  if (klass->begin_transaction != NULL) klass->begin_transaction(backend);
+}
+
+void mate_mixer_backend_commit_transaction(MateMixerBackend *backend) {
+  MateMixerBackendClass *klass;
+
+  g_return_if_fail(MATE_MIXER_IS_BACKEND(backend));
+
+  klass = MATE_MIXER_BACKEND_GET_CLASS(backend);
+
+  if (klass->commit_transaction != NULL) klass->commit_transaction(backend);
+}
+
 MateMixerStream *mate_mixer_backend_get_default_input_stream(
     MateMixerBackend *backend) {
   g_return_val_if_fail(MATE_MIXER_IS_BACKEND(backend), NULL);
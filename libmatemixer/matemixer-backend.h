@@ -56,6 +56,11 @@ struct _MateMixerBackendClass {
   /*< private >*/
   void (*set_app_info)(MateMixerBackend *backend, MateMixerAppInfo *info);
   void (*set_server_address)(MateMixerBackend *backend, const gchar *address);
+  void (*set_loading_flags)(MateMixerBackend *backend,
+                            MateMixerLoadingFlags flags);
+  void (*set_min_control_lifetime)(MateMixerBackend *backend, guint lifetime);
+  void (*set_interests)(MateMixerBackend *backend,
+                        MateMixerInterestFlags interests);
 
   gboolean (*open)(MateMixerBackend *backend);
   void (*close)(MateMixerBackend *backend);
@@ -76,6 +81,12 @@ struct _MateMixerBackendClass {
   void (*stream_removed)(MateMixerBackend *backend, const gchar *name);
   void (*stored_control_added)(MateMixerBackend *backend, const gchar *name);
   void (*stored_control_removed)(MateMixerBackend *backend, const gchar *name);
+
+  GList *(*list_loaded_streams)(MateMixerBackend *backend);
+  GList *(*list_loaded_stored_controls)(MateMixerBackend *backend);
+
+  void (*begin_transaction)(MateMixerBackend *backend);
+  void (*commit_transaction)(MateMixerBackend *backend);
 };
 
 GType mate_mixer_backend_get_type(void) G_GNUC_CONST;
@@ -84,6 +95,12 @@ void mate_mixer_backend_set_app_info(MateMixerBackend *backend,
                                      MateMixerAppInfo *info);
 void mate_mixer_backend_set_server_address(MateMixerBackend *backend,
                                            const gchar *address);
+void mate_mixer_backend_set_loading_flags(MateMixerBackend *backend,
+                                          MateMixerLoadingFlags flags);
+void mate_mixer_backend_set_min_control_lifetime(MateMixerBackend *backend,
+                                                 guint lifetime);
+void mate_mixer_backend_set_interests(MateMixerBackend *backend,
+                                      MateMixerInterestFlags interests);
 
 gboolean mate_mixer_backend_open(MateMixerBackend *backend);
 void mate_mixer_backend_close(MateMixerBackend *backend);
@@ -101,6 +118,13 @@ const GList *mate_mixer_backend_list_devices(MateMixerBackend *backend);
 const GList *mate_mixer_backend_list_streams(MateMixerBackend *backend);
 const GList *mate_mixer_backend_list_stored_controls(MateMixerBackend *backend);
 
+GList *mate_mixer_backend_list_loaded_streams(MateMixerBackend *backend);
+GList *mate_mixer_backend_list_loaded_stored_controls(
+    MateMixerBackend *backend);
+
+void mate_mixer_backend_begin_transaction(MateMixerBackend *backend);
+void mate_mixer_backend_commit_transaction(MateMixerBackend *backend);
+
 MateMixerStream *mate_mixer_backend_get_default_input_stream(
     MateMixerBackend *backend);
 gboolean mate_mixer_backend_set_default_input_stream(MateMixerBackend *backend,
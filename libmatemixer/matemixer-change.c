@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "matemixer-change.h"
+
+#include "matemixer-change-private.h"
+
+/**
+ * SECTION:matemixer-change
+ * @short_description: Change journal entry
+ * @include: libmatemixer/matemixer.h
+ * @see_also: #MateMixerContext
+ *
+ * The #MateMixerChange structure describes a single change recorded in the
+ * change journal of a #MateMixerContext.
+ *
+ * See mate_mixer_context_set_journal_size() and
+ * mate_mixer_context_list_changes() for more information.
+ */
+
+/**
+ * MateMixerChange:
+ *
+ * The #MateMixerChange structure contains only private data and should only
+ * be accessed using the provided API.
+ */
+G_DEFINE_BOXED_TYPE(MateMixerChange, mate_mixer_change, mate_mixer_change_ref,
+                    mate_mixer_change_unref)
+
+/**
+ * mate_mixer_change_ref:
+ * @change: a #MateMixerChange
+ *
+ * Increases the reference count of the #MateMixerChange.
+ *
+ * Returns: the @change.
+ */
+MateMixerChange *mate_mixer_change_ref(MateMixerChange *change) {
+  g_return_val_if_fail(change != NULL, NULL);
+
+  g_atomic_int_inc(&change->ref_count);
+  return change;
+}
+
+/**
+ * mate_mixer_change_unref:
+ * @change: a #MateMixerChange
+ *
+ * Decreases the reference count of the #MateMixerChange and frees it when the
+ * reference count drops to zero.
+ */
+void mate_mixer_change_unref(MateMixerChange *change) {
+  g_return_if_fail(change != NULL);
+
+  if (g_atomic_int_dec_and_test(&change->ref_count) == FALSE) return;
+
+  g_free(change->name);
+  g_free(change->parent_name);
+
+  g_slice_free(MateMixerChange, change);
+}
+
+/**
+ * mate_mixer_change_get_sequence:
+ * @change: a #MateMixerChange
+ *
+ * Gets the sequence number of the @change. Sequence numbers of changes
+ * recorded by a #MateMixerContext are consecutive and increase
+ * monotonically.
+ *
+ * Returns: the sequence number.
+ */
+guint64 mate_mixer_change_get_sequence(MateMixerChange *change) {
+  g_return_val_if_fail(change != NULL, 0);
+
+  return change->sequence;
+}
+
+/**
+ * mate_mixer_change_get_change_type:
+ * @change: a #MateMixerChange
+ *
+ * Gets the type of the @change.
+ *
+ * Returns: a #MateMixerChangeType.
+ */
+MateMixerChangeType mate_mixer_change_get_change_type(MateMixerChange *change) {
+  g_return_val_if_fail(change != NULL, MATE_MIXER_CHANGE_UNKNOWN);
+
+  return change->type;
+}
+
+/**
+ * mate_mixer_change_get_name:
+ * @change: a #MateMixerChange
+ *
+ * Gets the name of the object affected by the @change. For changes of the
+ * default streams, this is the name of the new default stream.
+ *
+ * Returns: name of the object or %NULL.
+ */
+const gchar *mate_mixer_change_get_name(MateMixerChange *change) {
+  g_return_val_if_fail(change != NULL, NULL);
+
+  return change->name;
+}
+
+/**
+ * mate_mixer_change_get_parent_name:
+ * @change: a #MateMixerChange
+ *
+ * Gets the name of the stream or device which owns the control or switch
+ * affected by the @change.
+ *
+ * Returns: name of the stream or device, or %NULL if the affected object is
+ * not owned by a stream or device.
+ */
+const gchar *mate_mixer_change_get_parent_name(MateMixerChange *change) {
+  g_return_val_if_fail(change != NULL, NULL);
+
+  return change->parent_name;
+}
+
+/**
+ * _mate_mixer_change_new:
+ * @sequence: the sequence number of the change
+ * @type: the type of the change
+ * @name: name of the affected object
+ * @parent_name: name of the stream or device owning the affected object
+ *
+ * Creates a new #MateMixerChange structure.
+ *
+ * Returns: a new #MateMixerChange.
+ */
+MateMixerChange *_mate_mixer_change_new(guint64 sequence,
+                                        MateMixerChangeType type,
+                                        const gchar *name,
+                                        const gchar *parent_name) {
+  MateMixerChange *change;
+
+  change = g_slice_new(MateMixerChange);
+  change->ref_count = 1;
+  change->sequence = sequence;
+  change->type = type;
+  change->name = g_strdup(name);
+  change->parent_name = g_strdup(parent_name);
+
+  return change;
+}
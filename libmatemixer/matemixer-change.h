@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATEMIXER_CHANGE_H
+#define MATEMIXER_CHANGE_H
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-enums.h"
+#include "matemixer-types.h"
+
+G_BEGIN_DECLS
+
+#define MATE_MIXER_TYPE_CHANGE (mate_mixer_change_get_type())
+
+GType mate_mixer_change_get_type(void) G_GNUC_CONST;
+
+MateMixerChange *mate_mixer_change_ref(MateMixerChange *change);
+void mate_mixer_change_unref(MateMixerChange *change);
+
+guint64 mate_mixer_change_get_sequence(MateMixerChange *change);
+MateMixerChangeType mate_mixer_change_get_change_type(MateMixerChange *change);
+const gchar *mate_mixer_change_get_name(MateMixerChange *change);
+const gchar *mate_mixer_change_get_parent_name(MateMixerChange *change);
+
+G_END_DECLS
+
+#endif /* MATEMIXER_CHANGE_H */
@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-backend.h"
+#include "matemixer-change-private.h"
+#include "matemixer-change.h"
+#include "matemixer-context-private.h"
+#include "matemixer-context.h"
+#include "matemixer-device-switch.h"
+#include "matemixer-device.h"
+#include "matemixer-private.h"
+#include "matemixer-stream-switch.h"
+#include "matemixer-stream.h"
+
+static void on_device_switch_added(MateMixerDevice *device, const gchar *name,
+                                   MateMixerContext *context);
+static void on_device_switch_removed(MateMixerDevice *device,
+                                     const gchar *name,
+                                     MateMixerContext *context);
+
+static void on_stream_control_added(MateMixerStream *stream,
+                                    const gchar *name,
+                                    MateMixerContext *context);
+static void on_stream_control_removed(MateMixerStream *stream,
+                                      const gchar *name,
+                                      MateMixerContext *context);
+static void on_stream_control_loaded(MateMixerStream *stream,
+                                     MateMixerStreamControl *control,
+                                     MateMixerContext *context);
+static void on_stream_switch_added(MateMixerStream *stream, const gchar *name,
+                                   MateMixerContext *context);
+static void on_stream_switch_removed(MateMixerStream *stream,
+                                     const gchar *name,
+                                     MateMixerContext *context);
+
+static void on_control_notify(MateMixerStreamControl *control,
+                              GParamSpec *pspec, MateMixerContext *context);
+static void on_switch_notify(MateMixerSwitch *swtch, GParamSpec *pspec,
+                             MateMixerContext *context);
+static void on_snapshot_notify(GObject *object, GParamSpec *pspec,
+                               MateMixerContext *context);
+
+static void watch_switch(MateMixerContext *context, MateMixerSwitch *swtch);
+
+/**
+ * mate_mixer_context_get_journal_sequence:
+ * @context: a #MateMixerContext
+ *
+ * Gets the sequence number of the last change recorded in the change journal.
+ *
+ * An application will usually read the state of the sound system together
+ * with this number and later pass the number to
+ * mate_mixer_context_list_changes().
+ *
+ * Returns: the sequence number of the last change.
+ */
+guint64 mate_mixer_context_get_journal_sequence(MateMixerContext *context) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), 0);
+
+  return context->priv->journal_sequence;
+}
+
+/**
+ * mate_mixer_context_list_changes:
+ * @context: a #MateMixerContext
+ * @sequence: sequence number of the last change known to the caller
+ * @changes: (out) (transfer full) (element-type MateMixerChange): return
+ * location for the list of changes
+ *
+ * Gets the changes recorded in the change journal after the change with the
+ * given @sequence number, ordered from the oldest to the newest one.
+ *
+ * The list should be freed with
+ * g_list_free_full(changes, (GDestroyNotify) mate_mixer_change_unref).
+ *
+ * The function fails if some of the requested changes are no longer available,
+ * either because they have been discarded to make room for newer changes or
+ * because the connection to the sound system has been closed in the meantime.
+ * In this case the application should read the whole state again and continue
+ * from the number returned by mate_mixer_context_get_journal_sequence().
+ *
+ * Returns: %TRUE on success or %FALSE if some of the changes have been
+ * discarded.
+ */
+gboolean mate_mixer_context_list_changes(MateMixerContext *context,
+                                         guint64 sequence, GList **changes) {
+  MateMixerContextPrivate *priv;
+  guint64 first;
+  guint64 i;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+  g_return_val_if_fail(changes != NULL, FALSE);
+
+  priv = context->priv;
+
+  *changes = NULL;
+
+  /* Sequence number of the oldest change still in the journal */
+  first = priv->journal_sequence - priv->journal_length + 1;
+  if (sequence + 1 < first) return FALSE;
+
+  /* Walk backwards to build the list in the right order */
+  for (i = priv->journal_sequence; i > sequence; i--) {
+    guint index = (priv->journal_head + (i - first)) % priv->journal_size;
+
+    *changes = g_list_prepend(*changes,
+                              mate_mixer_change_ref(priv->journal[index]));
+  }
+  return TRUE;
+}
+
+static void on_device_switch_added(MateMixerDevice *device, const gchar *name,
+                                   MateMixerContext *context) {
+  MateMixerDeviceSwitch *swtch = mate_mixer_device_get_switch(device, name);
+
+  if (swtch != NULL) watch_switch(context, MATE_MIXER_SWITCH(swtch));
+
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_SWITCH_ADDED,
+                                    name, mate_mixer_device_get_name(device));
+}
+
+static void on_device_switch_removed(MateMixerDevice *device,
+                                     const gchar *name,
+                                     MateMixerContext *context) {
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_SWITCH_REMOVED,
+                                    name, mate_mixer_device_get_name(device));
+}
+
+static void on_stream_control_added(MateMixerStream *stream,
+                                    const gchar *name,
+                                    MateMixerContext *context) {
+  MateMixerStreamControl *control;
+
+  /* A control which is only announced is watched once it gets created,
+   * see on_stream_control_loaded() */
+  control = _mate_mixer_stream_peek_control(stream, name);
+  if (control != NULL) _mate_mixer_context_watch_control(context, control);
+
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_CONTROL_ADDED,
+                                    name, mate_mixer_stream_get_name(stream));
+}
+
+static void on_stream_control_removed(MateMixerStream *stream,
+                                      const gchar *name,
+                                      MateMixerContext *context) {
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_CONTROL_REMOVED,
+                                    name, mate_mixer_stream_get_name(stream));
+}
+
+static void on_stream_control_loaded(MateMixerStream *stream,
+                                     MateMixerStreamControl *control,
+                                     MateMixerContext *context) {
+  _mate_mixer_context_watch_control(context, control);
+}
+
+static void on_stream_switch_added(MateMixerStream *stream, const gchar *name,
+                                   MateMixerContext *context) {
+  MateMixerStreamSwitch *swtch = mate_mixer_stream_get_switch(stream, name);
+
+  if (swtch != NULL) watch_switch(context, MATE_MIXER_SWITCH(swtch));
+
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_SWITCH_ADDED,
+                                    name, mate_mixer_stream_get_name(stream));
+}
+
+static void on_stream_switch_removed(MateMixerStream *stream,
+                                     const gchar *name,
+                                     MateMixerContext *context) {
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_SWITCH_REMOVED,
+                                    name, mate_mixer_stream_get_name(stream));
+}
+
+static void on_control_notify(MateMixerStreamControl *control,
+                              GParamSpec *pspec, MateMixerContext *context) {
+  MateMixerStream *stream;
+  MateMixerChangeType type;
+
+  if (g_strcmp0(pspec->name, "volume") == 0)
+    type = MATE_MIXER_CHANGE_VOLUME;
+  else
+    type = MATE_MIXER_CHANGE_MUTE;
+
+  /* Stored controls do not belong to a stream */
+  stream = mate_mixer_stream_control_get_stream(control);
+
+  _mate_mixer_context_record_change(
+      context, type, mate_mixer_stream_control_get_name(control),
+      (stream != NULL) ? mate_mixer_stream_get_name(stream) : NULL);
+}
+
+static void on_switch_notify(MateMixerSwitch *swtch, GParamSpec *pspec,
+                             MateMixerContext *context) {
+  const gchar *parent_name = NULL;
+
+  if (MATE_MIXER_IS_STREAM_SWITCH(swtch)) {
+    MateMixerStream *stream;
+
+    stream =
+        mate_mixer_stream_switch_get_stream(MATE_MIXER_STREAM_SWITCH(swtch));
+    if (stream != NULL) parent_name = mate_mixer_stream_get_name(stream);
+  } else if (MATE_MIXER_IS_DEVICE_SWITCH(swtch)) {
+    MateMixerDevice *device;
+
+    device =
+        mate_mixer_device_switch_get_device(MATE_MIXER_DEVICE_SWITCH(swtch));
+    if (device != NULL) parent_name = mate_mixer_device_get_name(device);
+  }
+
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_ACTIVE_OPTION,
+                                    mate_mixer_switch_get_name(swtch),
+                                    parent_name);
+}
+
+static void on_snapshot_notify(GObject *object, GParamSpec *pspec,
+                               MateMixerContext *context) {
+  /* Properties which are part of the snapshot, but not of the journal */
+  _mate_mixer_context_schedule_snapshot(context);
+}
+
+void _mate_mixer_context_watch_device(MateMixerContext *context,
+                                      MateMixerDevice *device) {
+  const GList *list;
+
+  if (context->priv->publish_snapshots)
+    g_signal_connect_object(G_OBJECT(device), "notify::label",
+                            G_CALLBACK(on_snapshot_notify), context, 0);
+
+  g_signal_connect_object(G_OBJECT(device), "switch-added",
+                          G_CALLBACK(on_device_switch_added), context, 0);
+  g_signal_connect_object(G_OBJECT(device), "switch-removed",
+                          G_CALLBACK(on_device_switch_removed), context, 0);
+
+  list = mate_mixer_device_list_switches(device);
+  while (list != NULL) {
+    watch_switch(context, MATE_MIXER_SWITCH(list->data));
+    list = list->next;
+  }
+}
+
+void _mate_mixer_context_watch_stream(MateMixerContext *context,
+                                      MateMixerStream *stream) {
+  const GList *list;
+  GList *loaded;
+
+  g_signal_connect_object(G_OBJECT(stream), "control-added",
+                          G_CALLBACK(on_stream_control_added), context, 0);
+  g_signal_connect_object(G_OBJECT(stream), "control-removed",
+                          G_CALLBACK(on_stream_control_removed), context, 0);
+  g_signal_connect_object(G_OBJECT(stream), "control-loaded",
+                          G_CALLBACK(on_stream_control_loaded), context, 0);
+  g_signal_connect_object(G_OBJECT(stream), "switch-added",
+                          G_CALLBACK(on_stream_switch_added), context, 0);
+  g_signal_connect_object(G_OBJECT(stream), "switch-removed",
+                          G_CALLBACK(on_stream_switch_removed), context, 0);
+
+  if (context->priv->publish_snapshots)
+    g_signal_connect_object(G_OBJECT(stream), "notify::label",
+                            G_CALLBACK(on_snapshot_notify), context, 0);
+
+  /* Listing the controls would create the ones which are only announced */
+  loaded = _mate_mixer_stream_list_loaded_controls(stream);
+  while (loaded != NULL) {
+    _mate_mixer_context_watch_control(context,
+                                      MATE_MIXER_STREAM_CONTROL(loaded->data));
+    loaded = g_list_delete_link(loaded, loaded);
+  }
+
+  list = mate_mixer_stream_list_switches(stream);
+  while (list != NULL) {
+    watch_switch(context, MATE_MIXER_SWITCH(list->data));
+    list = list->next;
+  }
+}
+
+void _mate_mixer_context_watch_control(MateMixerContext *context,
+                                       MateMixerStreamControl *control) {
+  g_signal_connect_object(G_OBJECT(control), "notify::volume",
+                          G_CALLBACK(on_control_notify), context, 0);
+  g_signal_connect_object(G_OBJECT(control), "notify::mute",
+                          G_CALLBACK(on_control_notify), context, 0);
+
+  if (context->priv->publish_snapshots) {
+    g_signal_connect_object(G_OBJECT(control), "notify::flags",
+                            G_CALLBACK(on_snapshot_notify), context, 0);
+    g_signal_connect_object(G_OBJECT(control), "notify::label",
+                            G_CALLBACK(on_snapshot_notify), context, 0);
+  }
+}
+
+static void watch_switch(MateMixerContext *context, MateMixerSwitch *swtch) {
+  g_signal_connect_object(G_OBJECT(swtch), "notify::active-option",
+                          G_CALLBACK(on_switch_notify), context, 0);
+}
+
+void _mate_mixer_context_watch_objects(MateMixerContext *context) {
+  MateMixerBackend *backend = context->priv->backend;
+  const GList *list;
+  GList *loaded;
+
+  list = mate_mixer_backend_list_devices(backend);
+  while (list != NULL) {
+    _mate_mixer_context_watch_device(context, MATE_MIXER_DEVICE(list->data));
+    list = list->next;
+  }
+
+  /* The objects loaded later are announced by the added signals and
+   * watched from their handlers */
+  loaded = mate_mixer_backend_list_loaded_streams(backend);
+  while (loaded != NULL) {
+    _mate_mixer_context_watch_stream(context, MATE_MIXER_STREAM(loaded->data));
+    loaded = g_list_delete_link(loaded, loaded);
+  }
+
+  loaded = mate_mixer_backend_list_loaded_stored_controls(backend);
+  while (loaded != NULL) {
+    _mate_mixer_context_watch_control(context,
+                                      MATE_MIXER_STREAM_CONTROL(loaded->data));
+    loaded = g_list_delete_link(loaded, loaded);
+  }
+}
+
+void _mate_mixer_context_unwatch_objects(MateMixerContext *context) {
+  GHashTable *objects;
+  GHashTableIter iter;
+  gpointer object;
+
+  objects = _mate_mixer_context_collect_objects(context->priv->backend);
+
+  g_hash_table_iter_init(&iter, objects);
+  while (g_hash_table_iter_next(&iter, &object, NULL) == TRUE)
+    g_signal_handlers_disconnect_by_data(G_OBJECT(object), context);
+
+  g_hash_table_unref(objects);
+}
+
+gboolean _mate_mixer_context_is_watching(MateMixerContext *context) {
+  return context->priv->journal_size > 0 || context->priv->publish_snapshots;
+}
+
+void _mate_mixer_context_record_change(MateMixerContext *context,
+                                       MateMixerChangeType type,
+                                       const gchar *name,
+                                       const gchar *parent_name) {
+  MateMixerContextPrivate *priv = context->priv;
+  guint index;
+
+  if (priv->publish_snapshots) _mate_mixer_context_schedule_snapshot(context);
+
+  if (priv->journal_size == 0) return;
+
+  /* Discard the oldest change when the journal is full */
+  if (priv->journal_length == priv->journal_size) {
+    mate_mixer_change_unref(priv->journal[priv->journal_head]);
+
+    priv->journal_head = (priv->journal_head + 1) % priv->journal_size;
+    priv->journal_length--;
+  }
+
+  index = (priv->journal_head + priv->journal_length) % priv->journal_size;
+
+  priv->journal[index] =
+      _mate_mixer_change_new(++priv->journal_sequence, type, name, parent_name);
+  priv->journal_length++;
+}
+
+void _mate_mixer_context_clear_journal(MateMixerContext *context) {
+  MateMixerContextPrivate *priv = context->priv;
+
+  while (priv->journal_length > 0) {
+    mate_mixer_change_unref(priv->journal[priv->journal_head]);
+
+    priv->journal_head = (priv->journal_head + 1) % priv->journal_size;
+    priv->journal_length--;
+  }
+
+  /* Skip a sequence number to make the changes made before closing the
+   * connection unavailable */
+  if (priv->journal_size > 0) priv->journal_sequence++;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-context-private.h"
+#include "matemixer-context.h"
+
+/**
+ * mate_mixer_context_query:
+ * @context: a #MateMixerContext
+ * @timeout: (out): return location for the maximum time to wait in
+ * milliseconds, or -1 to wait without a limit
+ * @fds: (array length=n_fds): location to store the file descriptors to wait
+ * for
+ * @n_fds: the number of elements in @fds
+ *
+ * Gets the file descriptors and the timeout the application should wait for
+ * before calling mate_mixer_context_dispatch(), see
+ * mate_mixer_context_set_pollable().
+ *
+ * The file descriptors are stored as #GPollFD structures, the application
+ * should wait for the events given in the events field and store the events
+ * which occurred in the revents field.
+ *
+ * If the returned number is greater than @n_fds, only @n_fds file
+ * descriptors have been stored and the function should be called again with
+ * a larger array.
+ *
+ * Returns: the number of file descriptors to wait for.
+ */
+gint mate_mixer_context_query(MateMixerContext *context, gint *timeout,
+                              GPollFD *fds, gint n_fds) {
+  MateMixerContextPrivate *priv;
+  gint result;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), 0);
+  g_return_val_if_fail(timeout != NULL, 0);
+  g_return_val_if_fail(fds != NULL || n_fds == 0, 0);
+
+  priv = context->priv;
+
+  *timeout = -1;
+
+  if (priv->poll_context == NULL) return 0;
+
+  if (g_main_context_acquire(priv->poll_context) == FALSE) {
+    g_warning("The context is being driven from another thread");
+    return 0;
+  }
+
+  g_main_context_prepare(priv->poll_context, &priv->poll_priority);
+
+  result = g_main_context_query(priv->poll_context, priv->poll_priority,
+                                timeout, fds, n_fds);
+
+  g_main_context_release(priv->poll_context);
+  return result;
+}
+
+/**
+ * mate_mixer_context_dispatch:
+ * @context: a #MateMixerContext
+ * @fds: (array length=n_fds): the file descriptors returned by
+ * mate_mixer_context_query() with the revents fields filled in
+ * @n_fds: the number of elements in @fds
+ *
+ * Processes the events which occurred on the file descriptors returned by
+ * mate_mixer_context_query() as well as the expired timeouts, see
+ * mate_mixer_context_set_pollable().
+ *
+ * Returns: %TRUE on success or %FALSE if the @context is not pollable.
+ */
+gboolean mate_mixer_context_dispatch(MateMixerContext *context, GPollFD *fds,
+                                     gint n_fds) {
+  MateMixerContextPrivate *priv;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+  g_return_val_if_fail(fds != NULL || n_fds == 0, FALSE);
+
+  priv = context->priv;
+
+  if (priv->poll_context == NULL) return FALSE;
+
+  if (g_main_context_acquire(priv->poll_context) == FALSE) {
+    g_warning("The context is being driven from another thread");
+    return FALSE;
+  }
+
+  /* Signal handlers may drop the last reference to the context */
+  g_object_ref(context);
+
+  /* Sources created while dispatching must be attached to the same
+   * main context */
+  g_main_context_push_thread_default(priv->poll_context);
+
+  if (g_main_context_check(priv->poll_context, priv->poll_priority, fds,
+                           n_fds) == TRUE)
+    g_main_context_dispatch(priv->poll_context);
+
+  g_main_context_pop_thread_default(priv->poll_context);
+  g_main_context_release(priv->poll_context);
+
+  g_object_unref(context);
+  return TRUE;
+}
+
+gboolean _mate_mixer_context_open_pollable(MateMixerContext *context) {
+  gboolean result;
+
+  /* Make the backend attach its sources to the context driven by
+   * mate_mixer_context_query() and mate_mixer_context_dispatch() */
+  if (context->priv->poll_context == NULL)
+    context->priv->poll_context = g_main_context_new();
+
+  g_main_context_push_thread_default(context->priv->poll_context);
+
+  result = _mate_mixer_context_open_backend(context);
+
+  g_main_context_pop_thread_default(context->priv->poll_context);
+  return result;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATEMIXER_CONTEXT_PRIVATE_H
+#define MATEMIXER_CONTEXT_PRIVATE_H
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-backend-module.h"
+#include "matemixer-backend.h"
+#include "matemixer-context.h"
+#include "matemixer-enums.h"
+#include "matemixer-types.h"
+
+G_BEGIN_DECLS
+
+typedef struct _SharedBackend SharedBackend;
+
+struct _MateMixerContextPrivate {
+  gboolean backend_chosen;
+  MateMixerLoadingFlags loading_flags;
+  guint min_control_lifetime;
+  MateMixerInterestFlags interests;
+  gchar *server_address;
+  MateMixerState state;
+  MateMixerBackend *backend;
+  SharedBackend *shared;
+  MateMixerAppInfo *app_info;
+  MateMixerBackendType backend_type;
+  MateMixerBackendModule *module;
+  guint transaction_depth;
+  GList *transaction_objects;
+  guint journal_size;
+  guint journal_head;
+  guint journal_length;
+  guint64 journal_sequence;
+  MateMixerChange **journal;
+  gboolean publish_snapshots;
+  guint64 snapshot_generation;
+  GSource *snapshot_source;
+  GVariant *snapshot;
+  GMutex snapshot_mutex;
+  gboolean dedicated_thread;
+  GThread *thread;
+  GMainLoop *thread_loop;
+  GMainContext *thread_context;
+  GMainContext *caller_context;
+  MateMixerContext *inner;
+  GMutex thread_mutex;
+  GQueue thread_events;
+  GSource *thread_source;
+  gboolean pollable;
+  gint poll_priority;
+  GMainContext *poll_context;
+};
+
+
+/* matemixer-context.c */
+gboolean _mate_mixer_context_open_backend(MateMixerContext *context);
+void _mate_mixer_context_change_state(MateMixerContext *context,
+                                      MateMixerState state);
+void _mate_mixer_context_close_connection(MateMixerContext *context);
+gboolean _mate_mixer_context_backend_ready(MateMixerContext *context);
+
+/* matemixer-context-shared.c */
+gboolean _mate_mixer_context_start_backend(MateMixerContext *context,
+                                           MateMixerBackendModule *module);
+void _mate_mixer_context_release_backend(MateMixerContext *context);
+
+/* matemixer-context-transaction.c */
+GHashTable *_mate_mixer_context_collect_objects(MateMixerBackend *backend);
+void _mate_mixer_context_end_transactions(MateMixerContext *context);
+
+/* matemixer-context-journal.c */
+gboolean _mate_mixer_context_is_watching(MateMixerContext *context);
+void _mate_mixer_context_watch_device(MateMixerContext *context,
+                                      MateMixerDevice *device);
+void _mate_mixer_context_watch_stream(MateMixerContext *context,
+                                      MateMixerStream *stream);
+void _mate_mixer_context_watch_control(MateMixerContext *context,
+                                       MateMixerStreamControl *control);
+void _mate_mixer_context_watch_objects(MateMixerContext *context);
+void _mate_mixer_context_unwatch_objects(MateMixerContext *context);
+void _mate_mixer_context_record_change(MateMixerContext *context,
+                                       MateMixerChangeType type,
+                                       const gchar *name,
+                                       const gchar *parent_name);
+void _mate_mixer_context_clear_journal(MateMixerContext *context);
+
+/* matemixer-context-snapshot.c */
+void _mate_mixer_context_update_snapshot(MateMixerContext *context);
+void _mate_mixer_context_schedule_snapshot(MateMixerContext *context);
+void _mate_mixer_context_clear_snapshot(MateMixerContext *context);
+
+/* matemixer-context-state.c */
+GVariant *_mate_mixer_context_save_switches_state(const GList *list);
+
+/* matemixer-context-thread.c */
+gboolean _mate_mixer_context_open_thread(MateMixerContext *context);
+void _mate_mixer_context_close_thread(MateMixerContext *context);
+GVariant *_mate_mixer_context_save_thread_state(MateMixerContext *context);
+void _mate_mixer_context_restore_thread_state(MateMixerContext *context,
+                                              GVariant *state);
+void _mate_mixer_context_set_thread_interests(MateMixerContext *context,
+                                              MateMixerInterestFlags interests);
+
+/* matemixer-context-poll.c */
+gboolean _mate_mixer_context_open_pollable(MateMixerContext *context);
+
+G_END_DECLS
+
+#endif /* MATEMIXER_CONTEXT_PRIVATE_H */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-backend-module.h"
+#include "matemixer-backend.h"
+#include "matemixer-context-private.h"
+#include "matemixer-private.h"
+
+/* Backends opened by contexts with identical settings are shared, the
+ * objects they provide are then the same for all these contexts */
+struct _SharedBackend {
+  gchar *key;
+  MateMixerBackend *backend;
+  guint users;
+};
+
+#define STR_OR_EMPTY(s) (((s) != NULL) ? (s) : "")
+
+static GHashTable *shared_backends = NULL;
+
+G_LOCK_DEFINE_STATIC(shared_backends);
+
+static gchar *create_backend_key(MateMixerContext *context,
+                                 const MateMixerBackendInfo *info);
+
+gboolean _mate_mixer_context_start_backend(MateMixerContext *context,
+                                           MateMixerBackendModule *module) {
+  const MateMixerBackendInfo *info;
+  MateMixerBackend *backend;
+  MateMixerState state;
+  SharedBackend *shared = NULL;
+  gchar *key;
+
+  info = mate_mixer_backend_module_get_info(module);
+
+  context->priv->module = g_object_ref(module);
+
+  key = create_backend_key(context, info);
+
+  G_LOCK(shared_backends);
+  if (shared_backends != NULL) {
+    shared = g_hash_table_lookup(shared_backends, key);
+
+    /* Only share a backend which is usable */
+    if (shared != NULL) {
+      state = mate_mixer_backend_get_state(shared->backend);
+      if (state == MATE_MIXER_STATE_READY ||
+          state == MATE_MIXER_STATE_CONNECTING)
+        shared->users++;
+      else
+        shared = NULL;
+    }
+  }
+  G_UNLOCK(shared_backends);
+
+  if (shared != NULL) {
+    g_debug("Sharing backend %s", info->name);
+
+    context->priv->shared = shared;
+    context->priv->backend = g_object_ref(shared->backend);
+
+    g_free(key);
+    return TRUE;
+  }
+
+  backend = g_object_new(info->g_type, NULL);
+
+  mate_mixer_backend_set_app_info(backend, context->priv->app_info);
+  mate_mixer_backend_set_server_address(backend,
+                                        context->priv->server_address);
+  mate_mixer_backend_set_loading_flags(backend, context->priv->loading_flags);
+  mate_mixer_backend_set_min_control_lifetime(
+      backend, context->priv->min_control_lifetime);
+  mate_mixer_backend_set_interests(backend, context->priv->interests);
+
+  context->priv->backend = backend;
+
+  g_debug("Trying to open backend %s", info->name);
+
+  if (mate_mixer_backend_open(backend) == FALSE) {
+    g_free(key);
+    return FALSE;
+  }
+
+  state = mate_mixer_backend_get_state(backend);
+  if (state != MATE_MIXER_STATE_READY && state != MATE_MIXER_STATE_CONNECTING) {
+    g_free(key);
+    return TRUE;
+  }
+
+  /* Let other contexts with the same settings use this backend */
+  shared = g_slice_new(SharedBackend);
+  shared->key = key;
+  shared->backend = g_object_ref(backend);
+  shared->users = 1;
+
+  G_LOCK(shared_backends);
+  if (shared_backends == NULL)
+    shared_backends = g_hash_table_new(g_str_hash, g_str_equal);
+
+  g_hash_table_replace(shared_backends, shared->key, shared);
+  G_UNLOCK(shared_backends);
+
+  context->priv->shared = shared;
+  return TRUE;
+}
+
+void _mate_mixer_context_release_backend(MateMixerContext *context) {
+  SharedBackend *shared = context->priv->shared;
+  gboolean last = TRUE;
+
+  if (shared != NULL) {
+    G_LOCK(shared_backends);
+    last = --shared->users == 0;
+
+    /* The entry may have been replaced by a newer backend */
+    if (last && g_hash_table_lookup(shared_backends, shared->key) == shared)
+      g_hash_table_remove(shared_backends, shared->key);
+    G_UNLOCK(shared_backends);
+
+    context->priv->shared = NULL;
+  }
+
+  /* The backend is only closed when the last context stops using it */
+  if (last) mate_mixer_backend_close(context->priv->backend);
+
+  if (shared != NULL && last) {
+    g_object_unref(shared->backend);
+    g_free(shared->key);
+
+    g_slice_free(SharedBackend, shared);
+  }
+  g_clear_object(&context->priv->backend);
+}
+
+static gchar *create_backend_key(MateMixerContext *context,
+                                 const MateMixerBackendInfo *info) {
+  MateMixerAppInfo *app_info = context->priv->app_info;
+
+  /* Backends are bound to the main context their sources are attached to,
+   * so they may only be shared within a single main context */
+  return g_strdup_printf(
+      "%p|%s|%s|%s|%s|%s|%s|%u|%u|%u", g_main_context_get_thread_default(),
+      info->name, STR_OR_EMPTY(context->priv->server_address),
+      STR_OR_EMPTY(app_info->name), STR_OR_EMPTY(app_info->id),
+      STR_OR_EMPTY(app_info->version), STR_OR_EMPTY(app_info->icon),
+      context->priv->loading_flags, context->priv->min_control_lifetime,
+      context->priv->interests);
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-backend.h"
+#include "matemixer-context-private.h"
+#include "matemixer-context.h"
+#include "matemixer-device.h"
+#include "matemixer-private.h"
+#include "matemixer-stream-control.h"
+#include "matemixer-stream.h"
+
+/* Format of the snapshots returned by mate_mixer_context_get_snapshot() */
+#define SNAPSHOT_FORMAT "(tssa(ssa(ss))a(ssusa(ssubau)a(ss))a(ssubau))"
+
+static GVariant *build_control_snapshot(MateMixerStreamControl *control);
+static GVariant *build_snapshot(MateMixerContext *context);
+
+static void publish_snapshot(MateMixerContext *context, GVariant *snapshot);
+
+static gboolean update_snapshot_cb(MateMixerContext *context);
+
+/**
+ * mate_mixer_context_get_snapshot:
+ * @context: a #MateMixerContext
+ *
+ * Gets the most recently published snapshot of the state of the sound system.
+ *
+ * Unlike the rest of the library, this function may be called from any
+ * thread. The snapshot is an immutable #GVariant, so it may be kept and read
+ * from any thread without synchronization, while the library continues to
+ * publish newer snapshots.
+ *
+ * The snapshot has the type
+ * <literal>(tssa(ssa(ss))a(ssusa(ssubau)a(ss))a(ssubau))</literal>. Its
+ * members are:
+ * <itemizedlist>
+ * <listitem><para>the generation number of the snapshot, which increases with
+ * each published snapshot;</para></listitem>
+ * <listitem><para>names of the default input and output streams, or empty
+ * strings;</para></listitem>
+ * <listitem><para>the devices, each with its name, label and the switches,
+ * such as the active profile;</para></listitem>
+ * <listitem><para>the streams, each with its name, label,
+ * #MateMixerDirection, name of the owning device or an empty string, the
+ * controls and the switches, such as the active port;</para></listitem>
+ * <listitem><para>the stored controls.</para></listitem>
+ * </itemizedlist>
+ *
+ * Each control is described by its name, label, #MateMixerStreamControlFlags,
+ * mute state and a list of channel volumes, which is empty if the volume is
+ * not readable. Each switch is described by its name and the name of the
+ * active option, or an empty string.
+ *
+ * Returns: (transfer full): a #GVariant which should be freed with
+ * g_variant_unref(), or %NULL if publishing of snapshots is not enabled or the
+ * @context is not connected to a sound system.
+ */
+GVariant *mate_mixer_context_get_snapshot(MateMixerContext *context) {
+  GVariant *snapshot = NULL;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+
+  /* The lock is only held to take a reference, the snapshot is never
+   * modified after it has been published */
+  g_mutex_lock(&context->priv->snapshot_mutex);
+
+  if (context->priv->inner != NULL)
+    snapshot = mate_mixer_context_get_snapshot(context->priv->inner);
+  else if (context->priv->snapshot != NULL)
+    snapshot = g_variant_ref(context->priv->snapshot);
+
+  g_mutex_unlock(&context->priv->snapshot_mutex);
+
+  return snapshot;
+}
+
+static GVariant *build_control_snapshot(MateMixerStreamControl *control) {
+  GVariantBuilder volumes;
+  MateMixerStreamControlFlags flags;
+  const gchar *label;
+
+  g_variant_builder_init(&volumes, G_VARIANT_TYPE("au"));
+
+  flags = mate_mixer_stream_control_get_flags(control);
+
+  if (flags & MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE) {
+    guint channels;
+    guint i;
+
+    channels = mate_mixer_stream_control_get_num_channels(control);
+    for (i = 0; i < channels; i++)
+      g_variant_builder_add(
+          &volumes, "u",
+          mate_mixer_stream_control_get_channel_volume(control, i));
+  }
+
+  label = mate_mixer_stream_control_get_label(control);
+
+  return g_variant_new("(ssub@au)", mate_mixer_stream_control_get_name(control),
+                       (label != NULL) ? label : "", flags,
+                       mate_mixer_stream_control_get_mute(control),
+                       g_variant_builder_end(&volumes));
+}
+
+static GVariant *build_snapshot(MateMixerContext *context) {
+  MateMixerBackend *backend = context->priv->backend;
+  GVariantBuilder devices;
+  GVariantBuilder streams;
+  GVariantBuilder stored;
+  MateMixerStream *input;
+  MateMixerStream *output;
+  const GList *list;
+
+  g_variant_builder_init(&devices, G_VARIANT_TYPE("a(ssa(ss))"));
+
+  list = mate_mixer_backend_list_devices(backend);
+  while (list != NULL) {
+    MateMixerDevice *device = MATE_MIXER_DEVICE(list->data);
+    const gchar *label = mate_mixer_device_get_label(device);
+
+    g_variant_builder_add(
+        &devices, "(ss@a(ss))", mate_mixer_device_get_name(device),
+        (label != NULL) ? label : "",
+        _mate_mixer_context_save_switches_state(
+            mate_mixer_device_list_switches(device)));
+
+    list = list->next;
+  }
+
+  g_variant_builder_init(&streams, G_VARIANT_TYPE("a(ssusa(ssubau)a(ss))"));
+
+  list = mate_mixer_backend_list_streams(backend);
+  while (list != NULL) {
+    MateMixerStream *stream = MATE_MIXER_STREAM(list->data);
+    MateMixerDevice *device = mate_mixer_stream_get_device(stream);
+    const gchar *label = mate_mixer_stream_get_label(stream);
+    GVariantBuilder controls;
+    const GList *item;
+
+    g_variant_builder_init(&controls, G_VARIANT_TYPE("a(ssubau)"));
+
+    item = mate_mixer_stream_list_controls(stream);
+    while (item != NULL) {
+      g_variant_builder_add_value(
+          &controls,
+          build_control_snapshot(MATE_MIXER_STREAM_CONTROL(item->data)));
+
+      item = item->next;
+    }
+
+    g_variant_builder_add(
+        &streams, "(ssus@a(ssubau)@a(ss))", mate_mixer_stream_get_name(stream),
+        (label != NULL) ? label : "", mate_mixer_stream_get_direction(stream),
+        (device != NULL) ? mate_mixer_device_get_name(device) : "",
+        g_variant_builder_end(&controls),
+        _mate_mixer_context_save_switches_state(
+            mate_mixer_stream_list_switches(stream)));
+
+    list = list->next;
+  }
+
+  g_variant_builder_init(&stored, G_VARIANT_TYPE("a(ssubau)"));
+
+  list = mate_mixer_backend_list_stored_controls(backend);
+  while (list != NULL) {
+    g_variant_builder_add_value(
+        &stored, build_control_snapshot(MATE_MIXER_STREAM_CONTROL(list->data)));
+
+    list = list->next;
+  }
+
+  input = mate_mixer_backend_get_default_input_stream(backend);
+  output = mate_mixer_backend_get_default_output_stream(backend);
+
+  return g_variant_ref_sink(g_variant_new(
+      SNAPSHOT_FORMAT, ++context->priv->snapshot_generation,
+      (input != NULL) ? mate_mixer_stream_get_name(input) : "",
+      (output != NULL) ? mate_mixer_stream_get_name(output) : "", &devices,
+      &streams, &stored));
+}
+
+static void publish_snapshot(MateMixerContext *context, GVariant *snapshot) {
+  GVariant *previous;
+
+  g_mutex_lock(&context->priv->snapshot_mutex);
+
+  previous = context->priv->snapshot;
+  context->priv->snapshot = snapshot;
+
+  g_mutex_unlock(&context->priv->snapshot_mutex);
+
+  /* Other threads may still be holding a reference to the previous
+   * snapshot, in which case it is only freed when they drop it */
+  if (previous != NULL) g_variant_unref(previous);
+}
+
+void _mate_mixer_context_update_snapshot(MateMixerContext *context) {
+  publish_snapshot(context, build_snapshot(context));
+}
+
+void _mate_mixer_context_schedule_snapshot(MateMixerContext *context) {
+  if (context->priv->snapshot_source != NULL) return;
+
+  /* Wait until all the pending changes have been processed */
+  context->priv->snapshot_source = g_idle_source_new();
+  g_source_set_callback(context->priv->snapshot_source,
+                        (GSourceFunc)update_snapshot_cb, context, NULL);
+  if (context->priv->pollable && context->priv->poll_context != NULL)
+    g_source_attach(context->priv->snapshot_source,
+                    context->priv->poll_context);
+  else
+    g_source_attach(context->priv->snapshot_source,
+                    g_main_context_get_thread_default());
+}
+
+void _mate_mixer_context_clear_snapshot(MateMixerContext *context) {
+  if (context->priv->snapshot_source != NULL) {
+    g_source_destroy(context->priv->snapshot_source);
+    g_source_unref(context->priv->snapshot_source);
+
+    context->priv->snapshot_source = NULL;
+  }
+  publish_snapshot(context, NULL);
+}
+
+static gboolean update_snapshot_cb(MateMixerContext *context) {
+  g_source_unref(context->priv->snapshot_source);
+
+  context->priv->snapshot_source = NULL;
+
+  _mate_mixer_context_update_snapshot(context);
+  return G_SOURCE_REMOVE;
+}
@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-backend.h"
+#include "matemixer-context-private.h"
+#include "matemixer-context.h"
+#include "matemixer-device-switch.h"
+#include "matemixer-device.h"
+#include "matemixer-private.h"
+#include "matemixer-stored-control.h"
+#include "matemixer-stream-control.h"
+#include "matemixer-stream-switch.h"
+#include "matemixer-stream.h"
+#include "matemixer-switch.h"
+
+/* Version and format of the state created by mate_mixer_context_save_state(),
+ * the version must be increased whenever the format changes */
+#define STATE_VERSION 1
+#define STATE_FORMAT "(ussa(sa(ss))a(sa(sbau)a(ss))a(sbau))"
+
+static GVariant *save_control_state(MateMixerStreamControl *control);
+
+static gboolean restore_control_state(MateMixerStreamControl *control,
+                                      gboolean mute, GVariant *volumes);
+static gboolean restore_switch_state(MateMixerSwitch *swtch,
+                                     const gchar *option_name);
+
+/**
+ * mate_mixer_context_save_state:
+ * @context: a #MateMixerContext
+ *
+ * Captures the current state of the sound system in a single #GVariant.
+ *
+ * The state includes the active options of device switches, the mute state
+ * and channel volumes of stream controls and stored controls, the active
+ * options of stream switches and the default input and output streams.
+ * All the objects are identified by their names.
+ *
+ * The format of the returned value is versioned, the first member is always
+ * the format version as an unsigned 32-bit integer. It may be stored or
+ * transferred elsewhere and later passed to mate_mixer_context_restore_state().
+ *
+ * If the backend runs in a dedicated thread, the state is saved in that
+ * thread and this function blocks until it is done.
+ *
+ * Returns: (transfer full): a #GVariant which should be freed with
+ * g_variant_unref(), or %NULL if the @context is not connected to a sound
+ * system.
+ */
+GVariant *mate_mixer_context_save_state(MateMixerContext *context) {
+  GVariantBuilder devices;
+  GVariantBuilder streams;
+  GVariantBuilder stored;
+  MateMixerStream *input;
+  MateMixerStream *output;
+  const GList *list;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+
+  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+
+  /* The objects are owned by the dedicated thread, which saves the state */
+  if (context->priv->thread != NULL)
+    return _mate_mixer_context_save_thread_state(context);
+
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
+
+  g_variant_builder_init(&devices, G_VARIANT_TYPE("a(sa(ss))"));
+
+  list = mate_mixer_context_list_devices(context);
+  while (list != NULL) {
+    MateMixerDevice *device = MATE_MIXER_DEVICE(list->data);
+
+    g_variant_builder_add(
+        &devices, "(s@a(ss))", mate_mixer_device_get_name(device),
+        _mate_mixer_context_save_switches_state(
+            mate_mixer_device_list_switches(device)));
+
+    list = list->next;
+  }
+
+  g_variant_builder_init(&streams, G_VARIANT_TYPE("a(sa(sbau)a(ss))"));
+
+  list = mate_mixer_context_list_streams(context);
+  while (list != NULL) {
+    MateMixerStream *stream = MATE_MIXER_STREAM(list->data);
+    GVariantBuilder controls;
+    const GList *item;
+
+    g_variant_builder_init(&controls, G_VARIANT_TYPE("a(sbau)"));
+
+    item = mate_mixer_stream_list_controls(stream);
+    while (item != NULL) {
+      g_variant_builder_add_value(
+          &controls, save_control_state(MATE_MIXER_STREAM_CONTROL(item->data)));
+
+      item = item->next;
+    }
+
+    g_variant_builder_add(
+        &streams, "(s@a(sbau)@a(ss))", mate_mixer_stream_get_name(stream),
+        g_variant_builder_end(&controls),
+        _mate_mixer_context_save_switches_state(
+            mate_mixer_stream_list_switches(stream)));
+
+    list = list->next;
+  }
+
+  g_variant_builder_init(&stored, G_VARIANT_TYPE("a(sbau)"));
+
+  list = mate_mixer_context_list_stored_controls(context);
+  while (list != NULL) {
+    g_variant_builder_add_value(
+        &stored, save_control_state(MATE_MIXER_STREAM_CONTROL(list->data)));
+
+    list = list->next;
+  }
+
+  input = mate_mixer_context_get_default_input_stream(context);
+  output = mate_mixer_context_get_default_output_stream(context);
+
+  return g_variant_ref_sink(g_variant_new(
+      STATE_FORMAT, STATE_VERSION,
+      (input != NULL) ? mate_mixer_stream_get_name(input) : "",
+      (output != NULL) ? mate_mixer_stream_get_name(output) : "", &devices,
+      &streams, &stored));
+}
+
+/**
+ * mate_mixer_context_restore_state:
+ * @context: a #MateMixerContext
+ * @state: a #GVariant created by mate_mixer_context_save_state()
+ *
+ * Restores the state previously captured by mate_mixer_context_save_state().
+ *
+ * The @state is compared to the current state of the sound system and only
+ * the values which differ are changed. Objects which no longer exist are
+ * skipped. All the changes are made in a single transaction, see
+ * mate_mixer_context_begin_transaction().
+ *
+ * The @state does not have to be complete. The names of the default streams
+ * may be empty strings and the lists may only include the objects and values
+ * to change, so a partial state may be built to change a few values at once.
+ *
+ * If the backend runs in a dedicated thread, the @state is restored
+ * asynchronously in that thread and this function only checks its validity.
+ *
+ * Returns: %TRUE on success or %FALSE if the @state is not valid or some of
+ * the values could not be changed.
+ */
+gboolean mate_mixer_context_restore_state(MateMixerContext *context,
+                                          GVariant *state) {
+  GVariantIter *devices;
+  GVariantIter *streams;
+  GVariantIter *stored;
+  GVariant *volumes;
+  GVariant *switches;
+  GVariant *controls;
+  const gchar *input;
+  const gchar *output;
+  const gchar *name;
+  gboolean mute;
+  guint32 version;
+  gboolean result = TRUE;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+  g_return_val_if_fail(state != NULL, FALSE);
+
+  if (context->priv->state != MATE_MIXER_STATE_READY) return FALSE;
+
+  if (g_variant_is_of_type(state, G_VARIANT_TYPE(STATE_FORMAT)) == FALSE) {
+    g_warning("Invalid mixer state of type %s",
+              g_variant_get_type_string(state));
+    return FALSE;
+  }
+
+  if (context->priv->thread != NULL) {
+    _mate_mixer_context_restore_thread_state(context, state);
+    return TRUE;
+  }
+
+  g_variant_get(state, STATE_FORMAT, &version, &input, &output, &devices,
+                &streams, &stored);
+
+  if (version != STATE_VERSION) {
+    g_warning("Unsupported mixer state version %u", version);
+    result = FALSE;
+    goto out;
+  }
+
+  mate_mixer_context_begin_transaction(context);
+
+  while (g_variant_iter_loop(devices, "(&s@a(ss))", &name, &switches)) {
+    MateMixerDevice *device;
+    GVariantIter iter;
+    const gchar *option;
+
+    device = mate_mixer_context_get_device(context, name);
+    if (device == NULL) continue;
+
+    g_variant_iter_init(&iter, switches);
+    while (g_variant_iter_next(&iter, "(&s&s)", &name, &option)) {
+      MateMixerDeviceSwitch *swtch = mate_mixer_device_get_switch(device, name);
+
+      if (restore_switch_state(MATE_MIXER_SWITCH(swtch), option) == FALSE)
+        result = FALSE;
+    }
+  }
+
+  while (g_variant_iter_loop(streams, "(&s@a(sbau)@a(ss))", &name, &controls,
+                             &switches)) {
+    MateMixerStream *stream;
+    GVariantIter iter;
+    const gchar *option;
+
+    stream = mate_mixer_context_get_stream(context, name);
+    if (stream == NULL) continue;
+
+    g_variant_iter_init(&iter, controls);
+    while (g_variant_iter_loop(&iter, "(&sb@au)", &name, &mute, &volumes)) {
+      MateMixerStreamControl *control;
+
+      control = mate_mixer_stream_get_control(stream, name);
+      if (control != NULL &&
+          restore_control_state(control, mute, volumes) == FALSE)
+        result = FALSE;
+    }
+
+    g_variant_iter_init(&iter, switches);
+    while (g_variant_iter_next(&iter, "(&s&s)", &name, &option)) {
+      MateMixerStreamSwitch *swtch = mate_mixer_stream_get_switch(stream, name);
+
+      if (restore_switch_state(MATE_MIXER_SWITCH(swtch), option) == FALSE)
+        result = FALSE;
+    }
+  }
+
+  while (g_variant_iter_loop(stored, "(&sb@au)", &name, &mute, &volumes)) {
+    MateMixerStoredControl *control;
+
+    control = mate_mixer_context_get_stored_control(context, name);
+    if (control != NULL &&
+        restore_control_state(MATE_MIXER_STREAM_CONTROL(control), mute,
+                              volumes) == FALSE)
+      result = FALSE;
+  }
+
+  if (*input != '\0') {
+    MateMixerStream *stream = mate_mixer_context_get_stream(context, input);
+
+    if (stream != NULL &&
+        stream != mate_mixer_context_get_default_input_stream(context) &&
+        mate_mixer_context_set_default_input_stream(context, stream) == FALSE)
+      result = FALSE;
+  }
+
+  if (*output != '\0') {
+    MateMixerStream *stream = mate_mixer_context_get_stream(context, output);
+
+    if (stream != NULL &&
+        stream != mate_mixer_context_get_default_output_stream(context) &&
+        mate_mixer_context_set_default_output_stream(context, stream) == FALSE)
+      result = FALSE;
+  }
+
+  mate_mixer_context_commit_transaction(context);
+
+out:
+  g_variant_iter_free(devices);
+  g_variant_iter_free(streams);
+  g_variant_iter_free(stored);
+
+  return result;
+}
+
+static GVariant *save_control_state(MateMixerStreamControl *control) {
+  GVariantBuilder volumes;
+
+  g_variant_builder_init(&volumes, G_VARIANT_TYPE("au"));
+
+  if (mate_mixer_stream_control_get_flags(control) &
+      MATE_MIXER_STREAM_CONTROL_VOLUME_READABLE) {
+    guint channels;
+    guint i;
+
+    channels = mate_mixer_stream_control_get_num_channels(control);
+    for (i = 0; i < channels; i++)
+      g_variant_builder_add(
+          &volumes, "u",
+          mate_mixer_stream_control_get_channel_volume(control, i));
+  }
+
+  return g_variant_new("(sb@au)", mate_mixer_stream_control_get_name(control),
+                       mate_mixer_stream_control_get_mute(control),
+                       g_variant_builder_end(&volumes));
+}
+
+GVariant *_mate_mixer_context_save_switches_state(const GList *list) {
+  GVariantBuilder builder;
+
+  g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ss)"));
+
+  while (list != NULL) {
+    MateMixerSwitch *swtch = MATE_MIXER_SWITCH(list->data);
+    MateMixerSwitchOption *option;
+
+    option = mate_mixer_switch_get_active_option(swtch);
+
+    g_variant_builder_add(
+        &builder, "(ss)", mate_mixer_switch_get_name(swtch),
+        (option != NULL) ? mate_mixer_switch_option_get_name(option) : "");
+
+    list = list->next;
+  }
+  return g_variant_builder_end(&builder);
+}
+
+static gboolean restore_control_state(MateMixerStreamControl *control,
+                                      gboolean mute, GVariant *volumes) {
+  const guint32 *v;
+  gsize channels;
+  gsize i;
+  gboolean result = TRUE;
+
+  if (mate_mixer_stream_control_get_mute(control) != mute &&
+      mate_mixer_stream_control_set_mute(control, mute) == FALSE)
+    result = FALSE;
+
+  v = g_variant_get_fixed_array(volumes, &channels, sizeof(guint32));
+
+  /* Volumes are only restored if the channel layout has not changed */
+  if (channels == 0 ||
+      channels != mate_mixer_stream_control_get_num_channels(control))
+    return result;
+
+  for (i = 0; i < channels; i++) {
+    if (mate_mixer_stream_control_get_channel_volume(control, i) != v[i])
+      break;
+  }
+  if (i == channels) return result;
+
+  /* The whole channel set is applied at once, backends which support it
+   * send a single request to the server */
+  if (_mate_mixer_stream_control_set_channel_volumes(control, v, channels) ==
+      FALSE)
+    result = FALSE;
+
+  return result;
+}
+
+static gboolean restore_switch_state(MateMixerSwitch *swtch,
+                                     const gchar *option_name) {
+  MateMixerSwitchOption *option;
+
+  if (swtch == NULL || *option_name == '\0') return TRUE;
+
+  option = mate_mixer_switch_get_option(swtch, option_name);
+  if (option == NULL) return TRUE;
+
+  if (option == mate_mixer_switch_get_active_option(swtch)) return TRUE;
+
+  return mate_mixer_switch_set_active_option(swtch, option);
+}
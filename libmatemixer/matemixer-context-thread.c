@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-app-info.h"
+#include "matemixer-backend-module.h"
+#include "matemixer-context-private.h"
+#include "matemixer-context.h"
+#include "matemixer-enums.h"
+
+/* Events passed from the dedicated mixer thread to the thread which opened
+ * the context */
+typedef enum {
+  THREAD_EVENT_STATE,
+  THREAD_EVENT_DEVICE_ADDED,
+  THREAD_EVENT_DEVICE_REMOVED,
+  THREAD_EVENT_STREAM_ADDED,
+  THREAD_EVENT_STREAM_REMOVED,
+  THREAD_EVENT_STORED_CONTROL_ADDED,
+  THREAD_EVENT_STORED_CONTROL_REMOVED,
+  THREAD_EVENT_DEFAULT_INPUT_STREAM,
+  THREAD_EVENT_DEFAULT_OUTPUT_STREAM
+} ThreadEventType;
+
+typedef struct {
+  ThreadEventType type;
+  MateMixerState state;
+  MateMixerBackendModule *module;
+  gchar *name;
+} ThreadEvent;
+
+typedef struct {
+  MateMixerContext *inner;
+  GVariant *state;
+} ThreadRestore;
+
+typedef struct {
+  MateMixerContext *inner;
+  MateMixerInterestFlags interests;
+} ThreadInterests;
+
+/* The state is saved synchronously, the caller waits for the reply */
+typedef struct {
+  MateMixerContext *inner;
+  GVariant *state;
+  gboolean done;
+  GMutex mutex;
+  GCond cond;
+} ThreadSave;
+
+static gpointer thread_main(MateMixerContext *context);
+
+static gboolean open_thread_cb(MateMixerContext *context);
+static gboolean close_thread_cb(MateMixerContext *context);
+static gboolean save_thread_state_cb(ThreadSave *save);
+static gboolean restore_thread_state_cb(ThreadRestore *restore);
+static gboolean set_thread_interests_cb(ThreadInterests *interests);
+
+static void on_thread_state_notify(MateMixerContext *inner, GParamSpec *pspec,
+                                   MateMixerContext *context);
+static void on_thread_device_added(MateMixerContext *inner, const gchar *name,
+                                   MateMixerContext *context);
+static void on_thread_device_removed(MateMixerContext *inner,
+                                     const gchar *name,
+                                     MateMixerContext *context);
+static void on_thread_stream_added(MateMixerContext *inner, const gchar *name,
+                                   MateMixerContext *context);
+static void on_thread_stream_removed(MateMixerContext *inner,
+                                     const gchar *name,
+                                     MateMixerContext *context);
+static void on_thread_stored_control_added(MateMixerContext *inner,
+                                           const gchar *name,
+                                           MateMixerContext *context);
+static void on_thread_stored_control_removed(MateMixerContext *inner,
+                                             const gchar *name,
+                                             MateMixerContext *context);
+static void on_thread_default_input_stream_notify(MateMixerContext *inner,
+                                                  GParamSpec *pspec,
+                                                  MateMixerContext *context);
+static void on_thread_default_output_stream_notify(MateMixerContext *inner,
+                                                   GParamSpec *pspec,
+                                                   MateMixerContext *context);
+
+static void push_thread_event(MateMixerContext *context, ThreadEvent *event);
+static gboolean dispatch_thread_events_cb(MateMixerContext *context);
+
+static ThreadEvent *thread_event_new(ThreadEventType type, const gchar *name);
+static void thread_event_free(ThreadEvent *event);
+
+static void thread_restore_free(ThreadRestore *restore);
+static void thread_interests_free(ThreadInterests *interests);
+
+gboolean _mate_mixer_context_open_thread(MateMixerContext *context) {
+  MateMixerContextPrivate *priv = context->priv;
+  MateMixerContext *inner;
+
+  /* The backend is run by another context living in the dedicated thread */
+  inner = mate_mixer_context_new();
+
+  mate_mixer_context_set_backend_type(inner, priv->backend_type);
+  mate_mixer_context_set_app_name(
+      inner, mate_mixer_app_info_get_name(priv->app_info));
+  mate_mixer_context_set_app_id(inner,
+                                mate_mixer_app_info_get_id(priv->app_info));
+  mate_mixer_context_set_app_version(
+      inner, mate_mixer_app_info_get_version(priv->app_info));
+  mate_mixer_context_set_app_icon(
+      inner, mate_mixer_app_info_get_icon(priv->app_info));
+  mate_mixer_context_set_server_address(inner, priv->server_address);
+  mate_mixer_context_set_loading_flags(inner, priv->loading_flags);
+  mate_mixer_context_set_min_control_lifetime(inner,
+                                              priv->min_control_lifetime);
+  mate_mixer_context_set_interests(inner, priv->interests);
+  /* Snapshots are the only way to read the state owned by the thread */
+  mate_mixer_context_set_publish_snapshots(inner, TRUE);
+
+  g_signal_connect(G_OBJECT(inner), "notify::state",
+                   G_CALLBACK(on_thread_state_notify), context);
+  g_signal_connect(G_OBJECT(inner), "device-added",
+                   G_CALLBACK(on_thread_device_added), context);
+  g_signal_connect(G_OBJECT(inner), "device-removed",
+                   G_CALLBACK(on_thread_device_removed), context);
+  g_signal_connect(G_OBJECT(inner), "stream-added",
+                   G_CALLBACK(on_thread_stream_added), context);
+  g_signal_connect(G_OBJECT(inner), "stream-removed",
+                   G_CALLBACK(on_thread_stream_removed), context);
+  g_signal_connect(G_OBJECT(inner), "stored-control-added",
+                   G_CALLBACK(on_thread_stored_control_added), context);
+  g_signal_connect(G_OBJECT(inner), "stored-control-removed",
+                   G_CALLBACK(on_thread_stored_control_removed), context);
+  g_signal_connect(G_OBJECT(inner), "notify::default-input-stream",
+                   G_CALLBACK(on_thread_default_input_stream_notify), context);
+  g_signal_connect(G_OBJECT(inner), "notify::default-output-stream",
+                   G_CALLBACK(on_thread_default_output_stream_notify),
+                   context);
+
+  g_mutex_lock(&priv->snapshot_mutex);
+  priv->inner = inner;
+  g_mutex_unlock(&priv->snapshot_mutex);
+
+  priv->caller_context = g_main_context_ref_thread_default();
+  priv->thread_context = g_main_context_new();
+  priv->thread_loop = g_main_loop_new(priv->thread_context, FALSE);
+
+  _mate_mixer_context_change_state(context, MATE_MIXER_STATE_CONNECTING);
+
+  priv->thread = g_thread_new("matemixer", (GThreadFunc)thread_main, context);
+
+  g_main_context_invoke(priv->thread_context, (GSourceFunc)open_thread_cb,
+                        context);
+  return TRUE;
+}
+
+void _mate_mixer_context_close_thread(MateMixerContext *context) {
+  MateMixerContextPrivate *priv = context->priv;
+  MateMixerContext *inner;
+
+  g_main_context_invoke(priv->thread_context, (GSourceFunc)close_thread_cb,
+                        context);
+
+  g_thread_join(priv->thread);
+  priv->thread = NULL;
+
+  g_mutex_lock(&priv->snapshot_mutex);
+  inner = priv->inner;
+  priv->inner = NULL;
+  g_mutex_unlock(&priv->snapshot_mutex);
+
+  g_object_unref(inner);
+
+  /* Drop the events which have not been dispatched yet */
+  g_mutex_lock(&priv->thread_mutex);
+  if (priv->thread_source != NULL) {
+    g_source_destroy(priv->thread_source);
+    g_source_unref(priv->thread_source);
+
+    priv->thread_source = NULL;
+  }
+  g_queue_foreach(&priv->thread_events, (GFunc)thread_event_free, NULL);
+  g_queue_clear(&priv->thread_events);
+  g_mutex_unlock(&priv->thread_mutex);
+
+  g_main_loop_unref(priv->thread_loop);
+  priv->thread_loop = NULL;
+
+  /* Pending requests for the thread are freed with its main context */
+  g_main_context_unref(priv->thread_context);
+  priv->thread_context = NULL;
+
+  g_main_context_unref(priv->caller_context);
+  priv->caller_context = NULL;
+}
+
+GVariant *_mate_mixer_context_save_thread_state(MateMixerContext *context) {
+  ThreadSave save = {
+      NULL,
+  };
+
+  /* The objects are owned by the dedicated thread, wait for it to save
+   * the state */
+  save.inner = context->priv->inner;
+  g_mutex_init(&save.mutex);
+  g_cond_init(&save.cond);
+
+  g_main_context_invoke(context->priv->thread_context,
+                        (GSourceFunc)save_thread_state_cb, &save);
+
+  g_mutex_lock(&save.mutex);
+  while (save.done == FALSE) g_cond_wait(&save.cond, &save.mutex);
+  g_mutex_unlock(&save.mutex);
+
+  g_mutex_clear(&save.mutex);
+  g_cond_clear(&save.cond);
+  return save.state;
+}
+
+void _mate_mixer_context_restore_thread_state(MateMixerContext *context,
+                                              GVariant *state) {
+  ThreadRestore *restore = g_slice_new(ThreadRestore);
+
+  restore->inner = g_object_ref(context->priv->inner);
+  restore->state = g_variant_ref(state);
+
+  g_main_context_invoke_full(context->priv->thread_context, G_PRIORITY_DEFAULT,
+                             (GSourceFunc)restore_thread_state_cb, restore,
+                             (GDestroyNotify)thread_restore_free);
+}
+
+void _mate_mixer_context_set_thread_interests(
+    MateMixerContext *context, MateMixerInterestFlags interests) {
+  ThreadInterests *data = g_slice_new(ThreadInterests);
+
+  data->inner = g_object_ref(context->priv->inner);
+  data->interests = interests;
+
+  g_main_context_invoke_full(context->priv->thread_context, G_PRIORITY_DEFAULT,
+                             (GSourceFunc)set_thread_interests_cb, data,
+                             (GDestroyNotify)thread_interests_free);
+}
+
+static gpointer thread_main(MateMixerContext *context) {
+  g_main_context_push_thread_default(context->priv->thread_context);
+
+  g_main_loop_run(context->priv->thread_loop);
+
+  g_main_context_pop_thread_default(context->priv->thread_context);
+  return NULL;
+}
+
+static gboolean open_thread_cb(MateMixerContext *context) {
+  /* Failures are reported through the state notifications */
+  mate_mixer_context_open(context->priv->inner);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean close_thread_cb(MateMixerContext *context) {
+  g_signal_handlers_disconnect_by_data(G_OBJECT(context->priv->inner),
+                                       context);
+
+  mate_mixer_context_close(context->priv->inner);
+
+  g_main_loop_quit(context->priv->thread_loop);
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean save_thread_state_cb(ThreadSave *save) {
+  GVariant *state;
+
+  state = mate_mixer_context_save_state(save->inner);
+
+  g_mutex_lock(&save->mutex);
+  save->state = state;
+  save->done = TRUE;
+  g_cond_signal(&save->cond);
+  g_mutex_unlock(&save->mutex);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean restore_thread_state_cb(ThreadRestore *restore) {
+  mate_mixer_context_restore_state(restore->inner, restore->state);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean set_thread_interests_cb(ThreadInterests *interests) {
+  mate_mixer_context_set_interests(interests->inner, interests->interests);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void on_thread_state_notify(MateMixerContext *inner, GParamSpec *pspec,
+                                   MateMixerContext *context) {
+  ThreadEvent *event;
+
+  event = thread_event_new(THREAD_EVENT_STATE, NULL);
+  event->state = mate_mixer_context_get_state(inner);
+
+  if (event->state == MATE_MIXER_STATE_READY)
+    event->module = g_object_ref(inner->priv->module);
+
+  push_thread_event(context, event);
+}
+
+static void on_thread_device_added(MateMixerContext *inner, const gchar *name,
+                                   MateMixerContext *context) {
+  push_thread_event(context,
+                    thread_event_new(THREAD_EVENT_DEVICE_ADDED, name));
+}
+
+static void on_thread_device_removed(MateMixerContext *inner,
+                                     const gchar *name,
+                                     MateMixerContext *context) {
+  push_thread_event(context,
+                    thread_event_new(THREAD_EVENT_DEVICE_REMOVED, name));
+}
+
+static void on_thread_stream_added(MateMixerContext *inner, const gchar *name,
+                                   MateMixerContext *context) {
+  push_thread_event(context,
+                    thread_event_new(THREAD_EVENT_STREAM_ADDED, name));
+}
+
+static void on_thread_stream_removed(MateMixerContext *inner,
+                                     const gchar *name,
+                                     MateMixerContext *context) {
+  push_thread_event(context,
+                    thread_event_new(THREAD_EVENT_STREAM_REMOVED, name));
+}
+
+static void on_thread_stored_control_added(MateMixerContext *inner,
+                                           const gchar *name,
+                                           MateMixerContext *context) {
+  push_thread_event(
+      context, thread_event_new(THREAD_EVENT_STORED_CONTROL_ADDED, name));
+}
+
+static void on_thread_stored_control_removed(MateMixerContext *inner,
+                                             const gchar *name,
+                                             MateMixerContext *context) {
+  push_thread_event(
+      context, thread_event_new(THREAD_EVENT_STORED_CONTROL_REMOVED, name));
+}
+
+static void on_thread_default_input_stream_notify(MateMixerContext *inner,
+                                                  GParamSpec *pspec,
+                                                  MateMixerContext *context) {
+  push_thread_event(
+      context, thread_event_new(THREAD_EVENT_DEFAULT_INPUT_STREAM, NULL));
+}
+
+static void on_thread_default_output_stream_notify(MateMixerContext *inner,
+                                                   GParamSpec *pspec,
+                                                   MateMixerContext *context) {
+  push_thread_event(
+      context, thread_event_new(THREAD_EVENT_DEFAULT_OUTPUT_STREAM, NULL));
+}
+
+static void push_thread_event(MateMixerContext *context, ThreadEvent *event) {
+  MateMixerContextPrivate *priv = context->priv;
+
+  g_mutex_lock(&priv->thread_mutex);
+
+  g_queue_push_tail(&priv->thread_events, event);
+
+  /* Events are dispatched in batches, a single source handles all the events
+   * queued until it runs */
+  if (priv->thread_source == NULL) {
+    priv->thread_source = g_idle_source_new();
+    g_source_set_priority(priv->thread_source, G_PRIORITY_DEFAULT);
+    g_source_set_callback(priv->thread_source,
+                          (GSourceFunc)dispatch_thread_events_cb, context,
+                          NULL);
+    g_source_attach(priv->thread_source, priv->caller_context);
+  }
+
+  g_mutex_unlock(&priv->thread_mutex);
+}
+
+static gboolean dispatch_thread_events_cb(MateMixerContext *context) {
+  MateMixerContextPrivate *priv = context->priv;
+  ThreadEvent *event;
+  GQueue events;
+
+  g_mutex_lock(&priv->thread_mutex);
+
+  events = priv->thread_events;
+  g_queue_init(&priv->thread_events);
+
+  g_source_unref(priv->thread_source);
+  priv->thread_source = NULL;
+
+  g_mutex_unlock(&priv->thread_mutex);
+
+  /* Signal handlers may close the context or drop the last reference */
+  g_object_ref(context);
+  g_object_freeze_notify(G_OBJECT(context));
+
+  while ((event = g_queue_pop_head(&events)) != NULL) {
+    if (priv->thread == NULL) {
+      thread_event_free(event);
+      continue;
+    }
+
+    switch (event->type) {
+      case THREAD_EVENT_STATE:
+        if (event->state == MATE_MIXER_STATE_READY) {
+          g_clear_object(&priv->module);
+
+          priv->module = g_object_ref(event->module);
+          priv->backend_chosen = TRUE;
+        } else if (event->state == MATE_MIXER_STATE_FAILED) {
+          _mate_mixer_context_close_connection(context);
+        }
+        _mate_mixer_context_change_state(context, event->state);
+        break;
+      case THREAD_EVENT_DEVICE_ADDED:
+        g_signal_emit_by_name(G_OBJECT(context), "device-added", event->name);
+        break;
+      case THREAD_EVENT_DEVICE_REMOVED:
+        g_signal_emit_by_name(G_OBJECT(context), "device-removed",
+                              event->name);
+        break;
+      case THREAD_EVENT_STREAM_ADDED:
+        g_signal_emit_by_name(G_OBJECT(context), "stream-added", event->name);
+        break;
+      case THREAD_EVENT_STREAM_REMOVED:
+        g_signal_emit_by_name(G_OBJECT(context), "stream-removed",
+                              event->name);
+        break;
+      case THREAD_EVENT_STORED_CONTROL_ADDED:
+        g_signal_emit_by_name(G_OBJECT(context), "stored-control-added",
+                              event->name);
+        break;
+      case THREAD_EVENT_STORED_CONTROL_REMOVED:
+        g_signal_emit_by_name(G_OBJECT(context), "stored-control-removed",
+                              event->name);
+        break;
+      case THREAD_EVENT_DEFAULT_INPUT_STREAM:
+        g_object_notify(G_OBJECT(context), "default-input-stream");
+        break;
+      case THREAD_EVENT_DEFAULT_OUTPUT_STREAM:
+        g_object_notify(G_OBJECT(context), "default-output-stream");
+        break;
+    }
+    thread_event_free(event);
+  }
+
+  g_object_thaw_notify(G_OBJECT(context));
+  g_object_unref(context);
+
+  return G_SOURCE_REMOVE;
+}
+
+static ThreadEvent *thread_event_new(ThreadEventType type, const gchar *name) {
+  ThreadEvent *event;
+
+  event = g_slice_new0(ThreadEvent);
+  event->type = type;
+  event->name = g_strdup(name);
+
+  return event;
+}
+
+static void thread_event_free(ThreadEvent *event) {
+  if (event->module != NULL) g_object_unref(event->module);
+
+  g_free(event->name);
+  g_slice_free(ThreadEvent, event);
+}
+
+static void thread_restore_free(ThreadRestore *restore) {
+  g_object_unref(restore->inner);
+  g_variant_unref(restore->state);
+
+  g_slice_free(ThreadRestore, restore);
+}
+
+static void thread_interests_free(ThreadInterests *interests) {
+  g_object_unref(interests->inner);
+
+  g_slice_free(ThreadInterests, interests);
+}
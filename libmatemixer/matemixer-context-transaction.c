@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2014 Michal Ratajsky <michal.ratajsky@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the licence, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib-object.h>
+#include <glib.h>
+
+#include "matemixer-backend.h"
+#include "matemixer-context-private.h"
+#include "matemixer-context.h"
+#include "matemixer-device.h"
+#include "matemixer-private.h"
+#include "matemixer-stream.h"
+
+static void add_objects(GHashTable *objects, const GList *list);
+
+static void freeze_objects(MateMixerContext *context);
+static void thaw_objects(MateMixerContext *context);
+
+/**
+ * mate_mixer_context_begin_transaction:
+ * @context: a #MateMixerContext
+ *
+ * Starts a transaction, which allows changing many controls, switches and
+ * default streams as a single unit.
+ *
+ * Changes are made with the usual functions, such as
+ * mate_mixer_stream_control_set_volume() or
+ * mate_mixer_switch_set_active_option(). Most sound systems receive them
+ * right away, so they are submitted together as long as the transaction is
+ * committed within a single main loop iteration. The ALSA backend instead
+ * holds back the volume and mute changes and writes each mixer element once
+ * when the transaction is committed. Property change notifications of the
+ * devices, streams, controls and switches which have already been loaded,
+ * as well as of the @context itself, are held back until the transaction is
+ * committed with mate_mixer_context_commit_transaction(). At that point each
+ * changed property is notified only once, no matter how many times it
+ * changed during the transaction.
+ *
+ * Transactions may be nested, the notifications are emitted when the
+ * outermost transaction is committed. Closing the connection to the sound
+ * system commits all pending transactions.
+ *
+ * Returns: %TRUE on success or %FALSE if the @context is not connected to a
+ * sound system.
+ */
+gboolean mate_mixer_context_begin_transaction(MateMixerContext *context) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+  g_return_val_if_fail(context->priv->thread == NULL, FALSE);
+
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return FALSE;
+
+  if (context->priv->transaction_depth++ == 0) {
+    freeze_objects(context);
+
+    mate_mixer_backend_begin_transaction(context->priv->backend);
+  }
+
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_commit_transaction:
+ * @context: a #MateMixerContext
+ *
+ * Finishes a transaction started with mate_mixer_context_begin_transaction().
+ *
+ * When the outermost transaction is committed, the property change
+ * notifications held back during the transaction are emitted.
+ *
+ * Returns: %TRUE on success or %FALSE if there is no transaction to commit.
+ */
+gboolean mate_mixer_context_commit_transaction(MateMixerContext *context) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->transaction_depth == 0) return FALSE;
+
+  if (--context->priv->transaction_depth == 0) {
+    /* Let the backend submit the changes it held back, their notifications
+     * are still frozen */
+    mate_mixer_backend_commit_transaction(context->priv->backend);
+
+    thaw_objects(context);
+  }
+
+  return TRUE;
+}
+
+void _mate_mixer_context_end_transactions(MateMixerContext *context) {
+  if (context->priv->transaction_depth == 0) return;
+
+  context->priv->transaction_depth = 0;
+
+  if (context->priv->backend != NULL)
+    mate_mixer_backend_commit_transaction(context->priv->backend);
+
+  thaw_objects(context);
+}
+
+static void add_objects(GHashTable *objects, const GList *list) {
+  while (list != NULL) {
+    g_hash_table_add(objects, list->data);
+    list = list->next;
+  }
+}
+
+GHashTable *_mate_mixer_context_collect_objects(MateMixerBackend *backend) {
+  GHashTable *objects;
+  const GList *list;
+  GList *loaded;
+  GList *item;
+
+  /* Streams may be reachable from devices as well as from the backend,
+   * collect the objects in a set to visit each of them only once.
+   *
+   * Objects which the backend has not created or loaded yet are skipped,
+   * they cannot have pending notifications or connected handlers and
+   * visiting them would force loading them */
+  objects = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+  list = mate_mixer_backend_list_devices(backend);
+  while (list != NULL) {
+    MateMixerDevice *device = MATE_MIXER_DEVICE(list->data);
+
+    g_hash_table_add(objects, device);
+    add_objects(objects, mate_mixer_device_list_switches(device));
+
+    list = list->next;
+  }
+
+  loaded = mate_mixer_backend_list_loaded_streams(backend);
+  for (item = loaded; item != NULL; item = item->next) {
+    MateMixerStream *stream = MATE_MIXER_STREAM(item->data);
+    GList *controls;
+
+    g_hash_table_add(objects, stream);
+
+    controls = _mate_mixer_stream_list_loaded_controls(stream);
+    add_objects(objects, controls);
+    g_list_free(controls);
+
+    add_objects(objects, mate_mixer_stream_list_switches(stream));
+  }
+  g_list_free(loaded);
+
+  loaded = mate_mixer_backend_list_loaded_stored_controls(backend);
+  add_objects(objects, loaded);
+  g_list_free(loaded);
+
+  return objects;
+}
+
+static void freeze_objects(MateMixerContext *context) {
+  GHashTable *objects;
+  GHashTableIter iter;
+  gpointer object;
+
+  objects = _mate_mixer_context_collect_objects(context->priv->backend);
+
+  /* Keep a reference, the objects may be removed during the transaction */
+  g_hash_table_iter_init(&iter, objects);
+  while (g_hash_table_iter_next(&iter, &object, NULL) == TRUE) {
+    g_object_freeze_notify(G_OBJECT(object));
+
+    context->priv->transaction_objects = g_list_prepend(
+        context->priv->transaction_objects, g_object_ref(object));
+  }
+  g_hash_table_unref(objects);
+
+  /* The context is not referenced to allow disposing it in the middle of
+   * a transaction */
+  g_object_freeze_notify(G_OBJECT(context));
+}
+
+static void thaw_objects(MateMixerContext *context) {
+  GList *list;
+
+  /* Steal the list first, notification handlers may start another
+   * transaction */
+  list = context->priv->transaction_objects;
+
+  context->priv->transaction_objects = NULL;
+
+  g_list_foreach(list, (GFunc)g_object_thaw_notify, NULL);
+  g_list_free_full(list, g_object_unref);
+
+  g_object_thaw_notify(G_OBJECT(context));
+}
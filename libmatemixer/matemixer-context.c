@@ -22,6 +22,7 @@
 
 #include "matemixer-backend-module.h"
 #include "matemixer-backend.h"
+#include "matemixer-context-private.h"
 #include "matemixer-enum-types.h"
 #include "matemixer-enums.h"
 #include "matemixer-private.h"
@@ -69,18 +70,25 @@
  * and disappear at any time, for example when external sound cards are plugged
  * and unplugged. The application should connect to the appropriate signals to
  * handle these events.
+ *
+ * Applications which only check the state of the sound system from time to
+ * time may instead enable the change journal with
+ * mate_mixer_context_set_journal_size() and fetch the changes made since the
+ * last check with mate_mixer_context_list_changes().
+ *
+ * Applications which need to read the state of the sound system from other
+ * threads may enable publishing of state snapshots with
+ * mate_mixer_context_set_publish_snapshots().
+ *
+ * To keep the processing of sound system events independent of a busy main
+ * loop, the whole backend may also be moved to a dedicated thread with
+ * mate_mixer_context_set_dedicated_thread(). The state is then only
+ * available through snapshots.
+ *
+ * Applications which do not use a GLib main loop may drive the @context from
+ * their own event loop, see mate_mixer_context_set_pollable().
  */
 
-struct _MateMixerContextPrivate {
-  gboolean backend_chosen;
-  gchar *server_address;
-  MateMixerState state;
-  MateMixerBackend *backend;
-  MateMixerAppInfo *app_info;
-  MateMixerBackendType backend_type;
-  MateMixerBackendModule *module;
-};
-
 enum {
   PROP_0,
   PROP_APP_NAME,
@@ -88,6 +96,14 @@ enum {
   PROP_APP_VERSION,
   PROP_APP_ICON,
   PROP_SERVER_ADDRESS,
+  PROP_LAZY_LOADING,
+  PROP_LOADING_FLAGS,
+  PROP_MIN_CONTROL_LIFETIME,
+  PROP_INTERESTS,
+  PROP_JOURNAL_SIZE,
+  PROP_PUBLISH_SNAPSHOTS,
+  PROP_DEDICATED_THREAD,
+  PROP_POLLABLE,
   PROP_STATE,
   PROP_DEFAULT_INPUT_STREAM,
   PROP_DEFAULT_OUTPUT_STREAM,
@@ -157,10 +173,6 @@ static void on_backend_default_output_stream_notify(MateMixerBackend *backend,
 
 static gboolean try_next_backend(MateMixerContext *context);
 
-static void change_state(MateMixerContext *context, MateMixerState state);
-
-static void close_context(MateMixerContext *context);
-
 static void mate_mixer_context_class_init(MateMixerContextClass *klass) {
   GObjectClass *object_class;
 
@@ -219,6 +231,100 @@ static void mate_mixer_context_class_init(MateMixerContextClass *klass) {
       "server-address", "Server address", "Sound server address", NULL,
       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * MateMixerContext:lazy-loading:
+   *
+   * Whether any part of the state may be loaded on demand. Setting this
+   * property enables or disables all the #MateMixerContext:loading-flags at
+   * once.
+   *
+   * This feature is currently only supported by the ALSA and PulseAudio
+   * backends.
+   */
+  properties[PROP_LAZY_LOADING] = g_param_spec_boolean(
+      "lazy-loading", "Lazy loading", "Load device controls on demand", FALSE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:loading-flags:
+   *
+   * Parts of the state the backend may load on demand rather than when the
+   * connection is established.
+   *
+   * This feature is currently only supported by the ALSA and PulseAudio
+   * backends.
+   */
+  properties[PROP_LOADING_FLAGS] = g_param_spec_flags(
+      "loading-flags", "Loading flags", "Parts of the state loaded on demand",
+      MATE_MIXER_TYPE_LOADING_FLAGS, MATE_MIXER_LOADING_NONE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:min-control-lifetime:
+   *
+   * Number of milliseconds an application stream control must exist before it
+   * is reported, zero to report application stream controls immediately.
+   *
+   * This feature is currently only supported by the PulseAudio backend.
+   */
+  properties[PROP_MIN_CONTROL_LIFETIME] = g_param_spec_uint(
+      "min-control-lifetime", "Minimum control lifetime",
+      "Minimum lifetime of reported application stream controls", 0,
+      G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:interests:
+   *
+   * Kinds of objects the application is interested in, the sound system
+   * backend may avoid tracking the remaining ones.
+   *
+   * This feature is currently only supported by the PulseAudio backend.
+   */
+  properties[PROP_INTERESTS] = g_param_spec_flags(
+      "interests", "Interests", "Kinds of objects of interest",
+      MATE_MIXER_TYPE_INTEREST_FLAGS, MATE_MIXER_INTEREST_ALL,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:journal-size:
+   *
+   * Maximum number of changes kept in the change journal, zero if the journal
+   * is disabled.
+   */
+  properties[PROP_JOURNAL_SIZE] = g_param_spec_uint(
+      "journal-size", "Journal size", "Maximum number of journal entries", 0,
+      G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:publish-snapshots:
+   *
+   * Whether the context publishes snapshots of its state, which can be read
+   * from any thread with mate_mixer_context_get_snapshot().
+   */
+  properties[PROP_PUBLISH_SNAPSHOTS] = g_param_spec_boolean(
+      "publish-snapshots", "Publish snapshots", "Publish state snapshots",
+      FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:dedicated-thread:
+   *
+   * Whether the sound system backend runs in a dedicated thread.
+   */
+  properties[PROP_DEDICATED_THREAD] = g_param_spec_boolean(
+      "dedicated-thread", "Dedicated thread",
+      "Run the backend in a dedicated thread", FALSE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * MateMixerContext:pollable:
+   *
+   * Whether the context is driven by the application using
+   * mate_mixer_context_query() and mate_mixer_context_dispatch().
+   */
+  properties[PROP_POLLABLE] = g_param_spec_boolean(
+      "pollable", "Pollable", "Driven by the application event loop", FALSE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   /**
    * MateMixerContext:state:
    *
@@ -390,16 +496,45 @@ static void mate_mixer_context_get_property(GObject *object, guint param_id,
     case PROP_SERVER_ADDRESS:
       g_value_set_string(value, context->priv->server_address);
       break;
+    case PROP_LAZY_LOADING:
+      g_value_set_boolean(
+          value, context->priv->loading_flags != MATE_MIXER_LOADING_NONE);
+      break;
+    case PROP_LOADING_FLAGS:
+      g_value_set_flags(value, context->priv->loading_flags);
+      break;
+    case PROP_MIN_CONTROL_LIFETIME:
+      g_value_set_uint(value, context->priv->min_control_lifetime);
+      break;
+    case PROP_INTERESTS:
+      g_value_set_flags(value, context->priv->interests);
+      break;
+    case PROP_JOURNAL_SIZE:
+      g_value_set_uint(value, context->priv->journal_size);
+      break;
+    case PROP_PUBLISH_SNAPSHOTS:
+      g_value_set_boolean(value, context->priv->publish_snapshots);
+      break;
+    case PROP_DEDICATED_THREAD:
+      g_value_set_boolean(value, context->priv->dedicated_thread);
+      break;
+    case PROP_POLLABLE:
+      g_value_set_boolean(value, context->priv->pollable);
+      break;
     case PROP_STATE:
       g_value_set_enum(value, context->priv->state);
       break;
+    /* The streams are not available in the dedicated thread mode, only
+     * their notifications are forwarded */
     case PROP_DEFAULT_INPUT_STREAM:
-      g_value_set_object(value,
-                         mate_mixer_context_get_default_input_stream(context));
+      if (context->priv->thread == NULL)
+        g_value_set_object(
+            value, mate_mixer_context_get_default_input_stream(context));
       break;
     case PROP_DEFAULT_OUTPUT_STREAM:
-      g_value_set_object(value,
-                         mate_mixer_context_get_default_output_stream(context));
+      if (context->priv->thread == NULL)
+        g_value_set_object(
+            value, mate_mixer_context_get_default_output_stream(context));
       break;
 
     default:
@@ -431,6 +566,33 @@ static void mate_mixer_context_set_property(GObject *object, guint param_id,
     case PROP_SERVER_ADDRESS:
       mate_mixer_context_set_server_address(context, g_value_get_string(value));
       break;
+    case PROP_LAZY_LOADING:
+      mate_mixer_context_set_lazy_loading(context, g_value_get_boolean(value));
+      break;
+    case PROP_LOADING_FLAGS:
+      mate_mixer_context_set_loading_flags(context, g_value_get_flags(value));
+      break;
+    case PROP_MIN_CONTROL_LIFETIME:
+      mate_mixer_context_set_min_control_lifetime(context,
+                                                  g_value_get_uint(value));
+      break;
+    case PROP_INTERESTS:
+      mate_mixer_context_set_interests(context, g_value_get_flags(value));
+      break;
+    case PROP_JOURNAL_SIZE:
+      mate_mixer_context_set_journal_size(context, g_value_get_uint(value));
+      break;
+    case PROP_PUBLISH_SNAPSHOTS:
+      mate_mixer_context_set_publish_snapshots(context,
+                                               g_value_get_boolean(value));
+      break;
+    case PROP_DEDICATED_THREAD:
+      mate_mixer_context_set_dedicated_thread(context,
+                                              g_value_get_boolean(value));
+      break;
+    case PROP_POLLABLE:
+      mate_mixer_context_set_pollable(context, g_value_get_boolean(value));
+      break;
     case PROP_DEFAULT_INPUT_STREAM:
       mate_mixer_context_set_default_input_stream(context,
                                                   g_value_get_object(value));
@@ -450,6 +612,12 @@ static void mate_mixer_context_init(MateMixerContext *context) {
   context->priv = mate_mixer_context_get_instance_private(context);
 
   context->priv->app_info = _mate_mixer_app_info_new();
+  context->priv->interests = MATE_MIXER_INTEREST_ALL;
+
+  g_mutex_init(&context->priv->snapshot_mutex);
+  g_mutex_init(&context->priv->thread_mutex);
+
+  g_queue_init(&context->priv->thread_events);
 }
 
 static void mate_mixer_context_dispose(GObject *object) {
@@ -457,7 +625,7 @@ static void mate_mixer_context_dispose(GObject *object) {
 
   context = MATE_MIXER_CONTEXT(object);
 
-  close_context(context);
+  _mate_mixer_context_close_connection(context);
 
   G_OBJECT_CLASS(mate_mixer_context_parent_class)->dispose(object);
 }
@@ -467,9 +635,16 @@ static void mate_mixer_context_finalize(GObject *object) {
 
   context = MATE_MIXER_CONTEXT(object);
 
-  _mate_mixer_app_info_free(context->priv->app_info);
+  _mate_mixer_app_info_unref(context->priv->app_info);
 
   g_free(context->priv->server_address);
+  g_free(context->priv->journal);
+
+  g_mutex_clear(&context->priv->snapshot_mutex);
+  g_mutex_clear(&context->priv->thread_mutex);
+
+  if (context->priv->poll_context != NULL)
+    g_main_context_unref(context->priv->poll_context);
 
   G_OBJECT_CLASS(mate_mixer_context_parent_class)->finalize(object);
 }
@@ -683,6 +858,354 @@ gboolean mate_mixer_context_set_server_address(MateMixerContext *context,
   return TRUE;
 }
 
+/**
+ * mate_mixer_context_set_lazy_loading:
+ * @context: a #MateMixerContext
+ * @lazy_loading: whether the state may be loaded on demand
+ *
+ * Enables all the behaviours described by #MateMixerLoadingFlags when
+ * @lazy_loading is %TRUE, or disables all of them otherwise. Use
+ * mate_mixer_context_set_loading_flags() to choose them individually.
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_lazy_loading(MateMixerContext *context,
+                                             gboolean lazy_loading) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  return mate_mixer_context_set_loading_flags(
+      context, (lazy_loading == TRUE) ? MATE_MIXER_LOADING_ALL
+                                      : MATE_MIXER_LOADING_NONE);
+}
+
+/**
+ * mate_mixer_context_set_loading_flags:
+ * @context: a #MateMixerContext
+ * @flags: the parts of the state which may be loaded on demand
+ *
+ * Chooses which parts of the state the backend may load on demand rather
+ * than when the connection is established. By default everything is loaded
+ * before the connection is reported as ready.
+ *
+ * With %MATE_MIXER_LOADING_DEFER_DEVICES the streams and controls of a
+ * device are loaded when they are first requested, either directly by the
+ * application or when the library needs to choose a default stream. Devices
+ * are still listed and reported as soon as the connection is established,
+ * but the #MateMixerDevice::stream-added signals of a device may only be
+ * emitted when its streams are first requested. The ALSA backend uses this
+ * to avoid loading the mixers of sound cards the application never looks at.
+ *
+ * With %MATE_MIXER_LOADING_PROGRESSIVE the PulseAudio backend reaches the
+ * %MATE_MIXER_STATE_READY state as soon as the sound server information is
+ * known, instead of waiting for the full lists of devices, streams and
+ * controls. These are then announced by the #MateMixerContext::device-added,
+ * #MateMixerContext::stream-added and #MateMixerStream::control-added
+ * signals as they arrive.
+ *
+ * With %MATE_MIXER_LOADING_LAZY_STORED_CONTROLS the PulseAudio backend only
+ * loads the stored controls the first time they are listed with
+ * mate_mixer_context_list_stored_controls(), they are then announced by the
+ * #MateMixerContext::stored-control-added signal.
+ *
+ * With %MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS the PulseAudio backend
+ * keeps the stream controls of applications in a compact form and only
+ * creates them the first time they are listed with
+ * mate_mixer_stream_list_controls() or looked up with
+ * mate_mixer_stream_get_control(). The #MateMixerStream::control-added and
+ * #MateMixerStream::control-removed signals are still emitted for them and
+ * #MateMixerStream::control-loaded is emitted once they are created. The
+ * change journal records the added controls by name without creating them.
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_loading_flags(MateMixerContext *context,
+                                              MateMixerLoadingFlags flags) {
+  gboolean lazy_loading;
+
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    return FALSE;
+
+  if (context->priv->loading_flags == flags) return TRUE;
+
+  lazy_loading = context->priv->loading_flags != MATE_MIXER_LOADING_NONE;
+
+  context->priv->loading_flags = flags;
+
+  g_object_freeze_notify(G_OBJECT(context));
+  g_object_notify_by_pspec(G_OBJECT(context), properties[PROP_LOADING_FLAGS]);
+
+  if (lazy_loading != (flags != MATE_MIXER_LOADING_NONE))
+    g_object_notify_by_pspec(G_OBJECT(context), properties[PROP_LAZY_LOADING]);
+
+  g_object_thaw_notify(G_OBJECT(context));
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_set_min_control_lifetime:
+ * @context: a #MateMixerContext
+ * @lifetime: minimum lifetime in milliseconds, or 0 to disable the filter
+ *
+ * Sets the number of milliseconds an application stream control, such as
+ * a playback stream of an event sound, must exist before it is reported by
+ * the #MateMixerStream::control-added signal. Controls which disappear
+ * before reaching this age are never created and neither the
+ * #MateMixerStream::control-added nor the #MateMixerStream::control-removed
+ * signal is emitted for them.
+ *
+ * Application stream controls which already exist when the connection is
+ * established are always reported immediately.
+ *
+ * This feature is currently only supported by the PulseAudio backend.
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_min_control_lifetime(MateMixerContext *context,
+                                                     guint lifetime) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    return FALSE;
+
+  if (context->priv->min_control_lifetime == lifetime) return TRUE;
+
+  context->priv->min_control_lifetime = lifetime;
+
+  g_object_notify_by_pspec(G_OBJECT(context),
+                           properties[PROP_MIN_CONTROL_LIFETIME]);
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_set_interests:
+ * @context: a #MateMixerContext
+ * @interests: the kinds of objects of interest
+ *
+ * Sets the kinds of objects the application is interested in. The sound
+ * system backend may then avoid loading and tracking the remaining ones,
+ * which are not reported. By default all objects are of interest.
+ *
+ * Default streams are only known while streams are of interest. The
+ * PulseAudio backend also always tracks devices together with streams and
+ * streams together with application stream controls, as these objects
+ * belong to each other.
+ *
+ * While a connection to a sound system is open, the interests may only be
+ * widened; the newly requested objects are loaded and reported as they
+ * arrive and flags missing from @interests are ignored.
+ *
+ * This feature is currently only supported by the PulseAudio backend.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_interests(MateMixerContext *context,
+                                          MateMixerInterestFlags interests) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    interests |= context->priv->interests;
+
+  if (context->priv->interests == interests) return TRUE;
+
+  context->priv->interests = interests;
+
+  if (context->priv->thread != NULL)
+    _mate_mixer_context_set_thread_interests(context, interests);
+  else if (context->priv->backend != NULL)
+    mate_mixer_backend_set_interests(context->priv->backend, interests);
+
+  g_object_notify_by_pspec(G_OBJECT(context), properties[PROP_INTERESTS]);
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_set_journal_size:
+ * @context: a #MateMixerContext
+ * @size: maximum number of changes to keep, or 0 to disable the journal
+ *
+ * Enables the change journal and sets the maximum number of changes it keeps.
+ *
+ * When the journal is enabled, the @context records each addition and removal
+ * of a device, stream, stored control, stream control or switch, as well as
+ * each change of a volume, mute state, active switch option and default
+ * stream. Each change is assigned a sequence number, which is one higher than
+ * the sequence number of the previous change.
+ *
+ * Applications which do not stay connected to the signals of all the objects
+ * may then use mate_mixer_context_list_changes() to find out what has changed
+ * since they last checked. When more than @size changes are made between two
+ * checks, the oldest changes are discarded and the application has to read
+ * the whole state again.
+ *
+ * Enabling the journal makes the library watch all the streams as soon as the
+ * connection is established, so the #MateMixerContext:loading-flags setting
+ * has no effect while the journal is enabled.
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_journal_size(MateMixerContext *context,
+                                             guint size) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    return FALSE;
+
+  if (context->priv->journal_size == size) return TRUE;
+
+  /* The journal is always empty while disconnected */
+  g_free(context->priv->journal);
+
+  context->priv->journal = (size > 0) ? g_new0(MateMixerChange *, size) : NULL;
+  context->priv->journal_size = size;
+  context->priv->journal_head = 0;
+
+  g_object_notify_by_pspec(G_OBJECT(context), properties[PROP_JOURNAL_SIZE]);
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_set_publish_snapshots:
+ * @context: a #MateMixerContext
+ * @publish_snapshots: whether to publish snapshots of the state
+ *
+ * Enables publishing of state snapshots, which can be read from any thread
+ * with mate_mixer_context_get_snapshot().
+ *
+ * A new snapshot is published when the connection is established and after
+ * each batch of changes made by the sound system, once the changes made
+ * within a single main loop iteration have been processed.
+ *
+ * Publishing snapshots makes the library watch all the streams as soon as the
+ * connection is established, so the #MateMixerContext:loading-flags setting
+ * has no effect while it is enabled.
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_publish_snapshots(MateMixerContext *context,
+                                                  gboolean publish_snapshots) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    return FALSE;
+
+  if (context->priv->publish_snapshots == publish_snapshots) return TRUE;
+
+  context->priv->publish_snapshots = publish_snapshots;
+
+  g_object_notify_by_pspec(G_OBJECT(context),
+                           properties[PROP_PUBLISH_SNAPSHOTS]);
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_set_dedicated_thread:
+ * @context: a #MateMixerContext
+ * @dedicated_thread: whether to run the backend in a dedicated thread
+ *
+ * Makes the @context run the sound system backend in a dedicated thread with
+ * its own #GMainContext, so that the processing of sound system events is not
+ * delayed by a busy main loop of the application.
+ *
+ * The state changes of the @context, its signals and the notifications of
+ * the default streams are forwarded in batches to the thread-default main
+ * context of the thread which calls mate_mixer_context_open().
+ *
+ * This is a snapshot-only mode. The devices, streams and controls are owned
+ * by the dedicated thread and cannot be accessed by the application, so the
+ * functions which return or take these objects must not be used and neither
+ * may transactions nor the change journal. The forwarded signals only carry
+ * the names of the objects.
+ *
+ * Snapshots are always published in this mode, so the state of the sound
+ * system is read using mate_mixer_context_get_snapshot(). Changes are
+ * passed to the dedicated thread using mate_mixer_context_restore_state(),
+ * which also accepts a partial state listing only the objects and values to
+ * change, for example a single control of a single stream. The complete
+ * state may also be saved using mate_mixer_context_save_state().
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_dedicated_thread(MateMixerContext *context,
+                                                 gboolean dedicated_thread) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    return FALSE;
+
+  if (context->priv->dedicated_thread == dedicated_thread) return TRUE;
+
+  context->priv->dedicated_thread = dedicated_thread;
+
+  g_object_notify_by_pspec(G_OBJECT(context),
+                           properties[PROP_DEDICATED_THREAD]);
+  return TRUE;
+}
+
+/**
+ * mate_mixer_context_set_pollable:
+ * @context: a #MateMixerContext
+ * @pollable: whether the context is driven by the application
+ *
+ * Makes the @context independent of the GLib main loop. Instead of attaching
+ * to the thread-default main context, the sound system backend uses a private
+ * #GMainContext, which the application drives from its own event loop.
+ *
+ * In each iteration of its event loop, the application calls
+ * mate_mixer_context_query() to get the file descriptors and the timeout to
+ * wait for, and after waiting it passes the file descriptors to
+ * mate_mixer_context_dispatch(). All the signals of the library are emitted
+ * from mate_mixer_context_dispatch().
+ *
+ * This setting has no effect if #MateMixerContext:dedicated-thread is
+ * enabled.
+ *
+ * This function must be used before opening a connection to a sound system with
+ * mate_mixer_context_open(), otherwise it will fail.
+ *
+ * Returns: %TRUE on success or %FALSE on failure.
+ */
+gboolean mate_mixer_context_set_pollable(MateMixerContext *context,
+                                         gboolean pollable) {
+  g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+
+  if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
+      context->priv->state == MATE_MIXER_STATE_READY)
+    return FALSE;
+
+  if (context->priv->pollable == pollable) return TRUE;
+
+  context->priv->pollable = pollable;
+
+  g_object_notify_by_pspec(G_OBJECT(context), properties[PROP_POLLABLE]);
+  return TRUE;
+}
+
 /**
  * mate_mixer_context_open:
  * @context: a #MateMixerContext
@@ -713,98 +1236,28 @@ gboolean mate_mixer_context_set_server_address(MateMixerContext *context,
  * system and the #MateMixerContext:state will be set to
  * %MATE_MIXER_STATE_FAILED.
  *
+ * Contexts with identical settings, which are opened in the same thread-default
+ * main context, share a single connection to the sound system. The devices,
+ * streams and controls are then the same objects in all these contexts and
+ * the connection is only closed when the last of them is closed.
+ *
  * Returns: %TRUE on success or if the result will be determined asynchronously,
  * or %FALSE on failure.
  */
 gboolean mate_mixer_context_open(MateMixerContext *context) {
-  MateMixerBackendModule *module = NULL;
-  MateMixerState state;
-  const GList *modules;
-  const MateMixerBackendInfo *info = NULL;
-
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
 
   if (context->priv->state == MATE_MIXER_STATE_CONNECTING ||
       context->priv->state == MATE_MIXER_STATE_READY)
     return FALSE;
 
-  /* We are going to choose the first backend to try. It will be either the one
-   * selected by the application or the one with the highest priority */
-  modules = _mate_mixer_list_modules();
-
-  if (context->priv->backend_type != MATE_MIXER_BACKEND_UNKNOWN) {
-    while (modules != NULL) {
-      const MateMixerBackendInfo *info;
-
-      module = MATE_MIXER_BACKEND_MODULE(modules->data);
-      info = mate_mixer_backend_module_get_info(module);
-
-      if (info->backend_type == context->priv->backend_type) break;
-
-      module = NULL;
-      modules = modules->next;
-    }
-    if (module == NULL) {
-      /* The selected backend is not available */
-      change_state(context, MATE_MIXER_STATE_FAILED);
-      return FALSE;
-    }
-  } else {
-    /* The highest priority module is on the top of the list */
-    module = MATE_MIXER_BACKEND_MODULE(modules->data);
-  }
-
-  if (info == NULL) info = mate_mixer_backend_module_get_info(module);
-
-  context->priv->module = g_object_ref(module);
-  context->priv->backend = g_object_new(info->g_type, NULL);
-
-  mate_mixer_backend_set_app_info(context->priv->backend,
-                                  context->priv->app_info);
-  mate_mixer_backend_set_server_address(context->priv->backend,
-                                        context->priv->server_address);
-
-  g_debug("Trying to open backend %s", info->name);
-
-  /* This transitional state is always present, it will change to
-   * MATE_MIXER_STATE_READY or MATE_MIXER_STATE_FAILED either instantly or
-   * asynchronously */
-  change_state(context, MATE_MIXER_STATE_CONNECTING);
-
-  /* The backend initialization might fail in case it is known right now that
-   * the backend is unusable */
-  if (mate_mixer_backend_open(context->priv->backend) == FALSE) {
-    if (context->priv->backend_type == MATE_MIXER_BACKEND_UNKNOWN) {
-      /* User didn't request a specific backend, so try another one */
-      return try_next_backend(context);
-    }
-
-    /* User requested a specific backend and it failed */
-    close_context(context);
-    change_state(context, MATE_MIXER_STATE_FAILED);
-    return FALSE;
-  }
-
-  state = mate_mixer_backend_get_state(context->priv->backend);
-
-  if (G_UNLIKELY(state != MATE_MIXER_STATE_READY &&
-                 state != MATE_MIXER_STATE_CONNECTING)) {
-    /* This would be a backend bug */
-    g_warn_if_reached();
+  if (context->priv->dedicated_thread == TRUE)
+    return _mate_mixer_context_open_thread(context);
 
-    if (context->priv->backend_type == MATE_MIXER_BACKEND_UNKNOWN)
-      return try_next_backend(context);
+  if (context->priv->pollable == TRUE)
+    return _mate_mixer_context_open_pollable(context);
 
-    close_context(context);
-    change_state(context, MATE_MIXER_STATE_FAILED);
-    return FALSE;
-  }
-
-  g_signal_connect(G_OBJECT(context->priv->backend), "notify::state",
-                   G_CALLBACK(on_backend_state_notify), context);
-
-  change_state(context, state);
-  return TRUE;
+  return _mate_mixer_context_open_backend(context);
 }
 
 /**
@@ -817,8 +1270,8 @@ gboolean mate_mixer_context_open(MateMixerContext *context) {
 void mate_mixer_context_close(MateMixerContext *context) {
   g_return_if_fail(MATE_MIXER_IS_CONTEXT(context));
 
-  close_context(context);
-  change_state(context, MATE_MIXER_STATE_IDLE);
+  _mate_mixer_context_close_connection(context);
+  _mate_mixer_context_change_state(context, MATE_MIXER_STATE_IDLE);
 }
 
 /**
@@ -848,9 +1301,10 @@ MateMixerState mate_mixer_context_get_state(MateMixerContext *context) {
 MateMixerDevice *mate_mixer_context_get_device(MateMixerContext *context,
                                                const gchar *name) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
   g_return_val_if_fail(name != NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_get_device(
       MATE_MIXER_BACKEND(context->priv->backend), name);
@@ -868,9 +1322,10 @@ MateMixerDevice *mate_mixer_context_get_device(MateMixerContext *context,
 MateMixerStream *mate_mixer_context_get_stream(MateMixerContext *context,
                                                const gchar *name) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
   g_return_val_if_fail(name != NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_get_stream(
       MATE_MIXER_BACKEND(context->priv->backend), name);
@@ -889,9 +1344,10 @@ MateMixerStream *mate_mixer_context_get_stream(MateMixerContext *context,
 MateMixerStoredControl *mate_mixer_context_get_stored_control(
     MateMixerContext *context, const gchar *name) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
   g_return_val_if_fail(name != NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_get_stored_control(
       MATE_MIXER_BACKEND(context->priv->backend), name);
@@ -912,8 +1368,9 @@ MateMixerStoredControl *mate_mixer_context_get_stored_control(
  */
 const GList *mate_mixer_context_list_devices(MateMixerContext *context) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_list_devices(
       MATE_MIXER_BACKEND(context->priv->backend));
@@ -938,8 +1395,9 @@ const GList *mate_mixer_context_list_devices(MateMixerContext *context) {
  */
 const GList *mate_mixer_context_list_streams(MateMixerContext *context) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_list_streams(
       MATE_MIXER_BACKEND(context->priv->backend));
@@ -961,8 +1419,9 @@ const GList *mate_mixer_context_list_streams(MateMixerContext *context) {
 const GList *mate_mixer_context_list_stored_controls(
     MateMixerContext *context) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_list_stored_controls(
       MATE_MIXER_BACKEND(context->priv->backend));
@@ -980,8 +1439,9 @@ const GList *mate_mixer_context_list_stored_controls(
 MateMixerStream *mate_mixer_context_get_default_input_stream(
     MateMixerContext *context) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_get_default_input_stream(context->priv->backend);
 }
@@ -1001,9 +1461,10 @@ MateMixerStream *mate_mixer_context_get_default_input_stream(
 gboolean mate_mixer_context_set_default_input_stream(MateMixerContext *context,
                                                      MateMixerStream *stream) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+  g_return_val_if_fail(context->priv->thread == NULL, FALSE);
   g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), FALSE);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return FALSE;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return FALSE;
 
   return mate_mixer_backend_set_default_input_stream(context->priv->backend,
                                                      stream);
@@ -1022,8 +1483,9 @@ gboolean mate_mixer_context_set_default_input_stream(MateMixerContext *context,
 MateMixerStream *mate_mixer_context_get_default_output_stream(
     MateMixerContext *context) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), NULL);
+  g_return_val_if_fail(context->priv->thread == NULL, NULL);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return NULL;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return NULL;
 
   return mate_mixer_backend_get_default_output_stream(context->priv->backend);
 }
@@ -1044,9 +1506,10 @@ MateMixerStream *mate_mixer_context_get_default_output_stream(
 gboolean mate_mixer_context_set_default_output_stream(MateMixerContext *context,
                                                       MateMixerStream *stream) {
   g_return_val_if_fail(MATE_MIXER_IS_CONTEXT(context), FALSE);
+  g_return_val_if_fail(context->priv->thread == NULL, FALSE);
   g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), FALSE);
 
-  if (context->priv->state != MATE_MIXER_STATE_READY) return FALSE;
+  if (_mate_mixer_context_backend_ready(context) == FALSE) return FALSE;
 
   return mate_mixer_backend_set_default_output_stream(context->priv->backend,
                                                       stream);
@@ -1126,14 +1589,14 @@ static void on_backend_state_notify(MateMixerBackend *backend,
       g_debug("Backend %s changed state to CONNECTING",
               mate_mixer_backend_module_get_info(context->priv->module)->name);
 
-      change_state(context, state);
+      _mate_mixer_context_change_state(context, state);
       break;
 
     case MATE_MIXER_STATE_READY:
       g_debug("Backend %s changed state to READY",
               mate_mixer_backend_module_get_info(context->priv->module)->name);
 
-      change_state(context, state);
+      _mate_mixer_context_change_state(context, state);
       break;
 
     case MATE_MIXER_STATE_FAILED:
@@ -1145,8 +1608,8 @@ static void on_backend_state_notify(MateMixerBackend *backend,
         try_next_backend(context);
       } else {
         /* User requested a specific backend and it failed */
-        close_context(context);
-        change_state(context, state);
+        _mate_mixer_context_close_connection(context);
+        _mate_mixer_context_change_state(context, state);
       }
       break;
 
@@ -1158,42 +1621,88 @@ static void on_backend_state_notify(MateMixerBackend *backend,
 static void on_backend_device_added(MateMixerBackend *backend,
                                     const gchar *name,
                                     MateMixerContext *context) {
+  if (_mate_mixer_context_is_watching(context)) {
+    MateMixerDevice *device = mate_mixer_backend_get_device(backend, name);
+
+    if (device != NULL) _mate_mixer_context_watch_device(context, device);
+
+    _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_DEVICE_ADDED,
+                                      name, NULL);
+  }
   g_signal_emit(G_OBJECT(context), signals[DEVICE_ADDED], 0, name);
 }
 
 static void on_backend_device_removed(MateMixerBackend *backend,
                                       const gchar *name,
                                       MateMixerContext *context) {
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_DEVICE_REMOVED,
+                                    name, NULL);
+
   g_signal_emit(G_OBJECT(context), signals[DEVICE_REMOVED], 0, name);
 }
 
 static void on_backend_stream_added(MateMixerBackend *backend,
                                     const gchar *name,
                                     MateMixerContext *context) {
+  if (_mate_mixer_context_is_watching(context)) {
+    MateMixerStream *stream = mate_mixer_backend_get_stream(backend, name);
+
+    if (stream != NULL) _mate_mixer_context_watch_stream(context, stream);
+
+    _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_STREAM_ADDED,
+                                      name, NULL);
+  }
   g_signal_emit(G_OBJECT(context), signals[STREAM_ADDED], 0, name);
 }
 
 static void on_backend_stream_removed(MateMixerBackend *backend,
                                       const gchar *name,
                                       MateMixerContext *context) {
+  _mate_mixer_context_record_change(context, MATE_MIXER_CHANGE_STREAM_REMOVED,
+                                    name, NULL);
+
   g_signal_emit(G_OBJECT(context), signals[STREAM_REMOVED], 0, name);
 }
 
 static void on_backend_stored_control_added(MateMixerBackend *backend,
                                             const gchar *name,
                                             MateMixerContext *context) {
+  if (_mate_mixer_context_is_watching(context)) {
+    MateMixerStoredControl *control;
+
+    control = mate_mixer_backend_get_stored_control(backend, name);
+    if (control != NULL)
+      _mate_mixer_context_watch_control(context,
+                                        MATE_MIXER_STREAM_CONTROL(control));
+
+    _mate_mixer_context_record_change(context,
+                                      MATE_MIXER_CHANGE_STORED_CONTROL_ADDED,
+                                      name, NULL);
+  }
   g_signal_emit(G_OBJECT(context), signals[STORED_CONTROL_ADDED], 0, name);
 }
 
 static void on_backend_stored_control_removed(MateMixerBackend *backend,
                                               const gchar *name,
                                               MateMixerContext *context) {
+  _mate_mixer_context_record_change(context,
+                                    MATE_MIXER_CHANGE_STORED_CONTROL_REMOVED,
+                                    name, NULL);
+
   g_signal_emit(G_OBJECT(context), signals[STORED_CONTROL_REMOVED], 0, name);
 }
 
 static void on_backend_default_input_stream_notify(MateMixerBackend *backend,
                                                    GParamSpec *pspec,
                                                    MateMixerContext *context) {
+  if (_mate_mixer_context_is_watching(context)) {
+    MateMixerStream *stream;
+
+    stream = mate_mixer_backend_get_default_input_stream(backend);
+    _mate_mixer_context_record_change(
+        context, MATE_MIXER_CHANGE_DEFAULT_INPUT_STREAM,
+        (stream != NULL) ? mate_mixer_stream_get_name(stream) : NULL, NULL);
+  }
   g_object_notify_by_pspec(G_OBJECT(context),
                            properties[PROP_DEFAULT_INPUT_STREAM]);
 }
@@ -1201,15 +1710,94 @@ static void on_backend_default_input_stream_notify(MateMixerBackend *backend,
 static void on_backend_default_output_stream_notify(MateMixerBackend *backend,
                                                     GParamSpec *pspec,
                                                     MateMixerContext *context) {
+  if (_mate_mixer_context_is_watching(context)) {
+    MateMixerStream *stream;
+
+    stream = mate_mixer_backend_get_default_output_stream(backend);
+    _mate_mixer_context_record_change(
+        context, MATE_MIXER_CHANGE_DEFAULT_OUTPUT_STREAM,
+        (stream != NULL) ? mate_mixer_stream_get_name(stream) : NULL, NULL);
+  }
   g_object_notify_by_pspec(G_OBJECT(context),
                            properties[PROP_DEFAULT_OUTPUT_STREAM]);
 }
 
+gboolean _mate_mixer_context_open_backend(MateMixerContext *context) {
+  MateMixerBackendModule *module = NULL;
+  MateMixerState state;
+  const GList *modules;
+
+  /* We are going to choose the first backend to try. It will be either the one
+   * selected by the application or the one with the highest priority */
+  modules = _mate_mixer_list_modules();
+
+  if (context->priv->backend_type != MATE_MIXER_BACKEND_UNKNOWN) {
+    while (modules != NULL) {
+      const MateMixerBackendInfo *info;
+
+      module = MATE_MIXER_BACKEND_MODULE(modules->data);
+      info = mate_mixer_backend_module_get_info(module);
+
+      if (info->backend_type == context->priv->backend_type) break;
+
+      module = NULL;
+      modules = modules->next;
+    }
+    if (module == NULL) {
+      /* The selected backend is not available */
+      _mate_mixer_context_change_state(context, MATE_MIXER_STATE_FAILED);
+      return FALSE;
+    }
+  } else {
+    /* The highest priority module is on the top of the list */
+    module = MATE_MIXER_BACKEND_MODULE(modules->data);
+  }
+
+  /* This transitional state is always present, it will change to
+   * MATE_MIXER_STATE_READY or MATE_MIXER_STATE_FAILED either instantly or
+   * asynchronously */
+  _mate_mixer_context_change_state(context, MATE_MIXER_STATE_CONNECTING);
+
+  /* The backend initialization might fail in case it is known right now that
+   * the backend is unusable */
+  if (_mate_mixer_context_start_backend(context, module) == FALSE) {
+    if (context->priv->backend_type == MATE_MIXER_BACKEND_UNKNOWN) {
+      /* User didn't request a specific backend, so try another one */
+      return try_next_backend(context);
+    }
+
+    /* User requested a specific backend and it failed */
+    _mate_mixer_context_close_connection(context);
+    _mate_mixer_context_change_state(context, MATE_MIXER_STATE_FAILED);
+    return FALSE;
+  }
+
+  state = mate_mixer_backend_get_state(context->priv->backend);
+
+  if (G_UNLIKELY(state != MATE_MIXER_STATE_READY &&
+                 state != MATE_MIXER_STATE_CONNECTING)) {
+    /* This would be a backend bug */
+    g_warn_if_reached();
+
+    if (context->priv->backend_type == MATE_MIXER_BACKEND_UNKNOWN)
+      return try_next_backend(context);
+
+    _mate_mixer_context_close_connection(context);
+    _mate_mixer_context_change_state(context, MATE_MIXER_STATE_FAILED);
+    return FALSE;
+  }
+
+  g_signal_connect(G_OBJECT(context->priv->backend), "notify::state",
+                   G_CALLBACK(on_backend_state_notify), context);
+
+  _mate_mixer_context_change_state(context, state);
+  return TRUE;
+}
+
 static gboolean try_next_backend(MateMixerContext *context) {
   MateMixerBackendModule *module = NULL;
   MateMixerState state;
   const GList *modules;
-  const MateMixerBackendInfo *info = NULL;
 
   modules = _mate_mixer_list_modules();
 
@@ -1223,29 +1811,17 @@ static gboolean try_next_backend(MateMixerContext *context) {
     }
     modules = modules->next;
   }
-  close_context(context);
+  _mate_mixer_context_close_connection(context);
 
   if (module == NULL) {
     /* We have tried all the modules and all of them failed */
-    change_state(context, MATE_MIXER_STATE_FAILED);
+    _mate_mixer_context_change_state(context, MATE_MIXER_STATE_FAILED);
     return FALSE;
   }
 
-  info = mate_mixer_backend_module_get_info(module);
-
-  context->priv->module = g_object_ref(module);
-  context->priv->backend = g_object_new(info->g_type, NULL);
-
-  mate_mixer_backend_set_app_info(context->priv->backend,
-                                  context->priv->app_info);
-  mate_mixer_backend_set_server_address(context->priv->backend,
-                                        context->priv->server_address);
-
-  g_debug("Trying to open backend %s", info->name);
-
   /* Try to open this backend and in case of failure keep trying until we find
    * one that works or reach the end of the list */
-  if (mate_mixer_backend_open(context->priv->backend) == FALSE)
+  if (_mate_mixer_context_start_backend(context, module) == FALSE)
     return try_next_backend(context);
 
   state = mate_mixer_backend_get_state(context->priv->backend);
@@ -1261,11 +1837,12 @@ static gboolean try_next_backend(MateMixerContext *context) {
   g_signal_connect(G_OBJECT(context->priv->backend), "notify::state",
                    G_CALLBACK(on_backend_state_notify), context);
 
-  change_state(context, state);
+  _mate_mixer_context_change_state(context, state);
   return TRUE;
 }
 
-static void change_state(MateMixerContext *context, MateMixerState state) {
+void _mate_mixer_context_change_state(MateMixerContext *context,
+                                      MateMixerState state) {
   if (context->priv->state == state) return;
 
   context->priv->state = state;
@@ -1296,22 +1873,46 @@ static void change_state(MateMixerContext *context, MateMixerState state) {
         G_OBJECT(context->priv->backend), "notify::default-output-stream",
         G_CALLBACK(on_backend_default_output_stream_notify), context);
 
+    if (_mate_mixer_context_is_watching(context))
+      _mate_mixer_context_watch_objects(context);
+
+    if (context->priv->publish_snapshots)
+      _mate_mixer_context_update_snapshot(context);
+
     context->priv->backend_chosen = TRUE;
   }
 
   g_object_notify_by_pspec(G_OBJECT(context), properties[PROP_STATE]);
 }
 
-static void close_context(MateMixerContext *context) {
+void _mate_mixer_context_close_connection(MateMixerContext *context) {
+  /* Emit the notifications held back by an unfinished transaction */
+  _mate_mixer_context_end_transactions(context);
+
+  if (context->priv->thread != NULL) _mate_mixer_context_close_thread(context);
+
   if (context->priv->backend != NULL) {
     g_signal_handlers_disconnect_by_data(G_OBJECT(context->priv->backend),
                                          context);
 
-    mate_mixer_backend_close(context->priv->backend);
-    g_clear_object(&context->priv->backend);
+    if (_mate_mixer_context_is_watching(context) &&
+        context->priv->backend_chosen)
+      _mate_mixer_context_unwatch_objects(context);
+
+    _mate_mixer_context_release_backend(context);
   }
 
   g_clear_object(&context->priv->module);
 
   context->priv->backend_chosen = FALSE;
+
+  _mate_mixer_context_clear_journal(context);
+  _mate_mixer_context_clear_snapshot(context);
 }
+
+gboolean _mate_mixer_context_backend_ready(MateMixerContext *context) {
+  /* The backend is not available when it runs in a dedicated thread */
+  return context->priv->state == MATE_MIXER_STATE_READY &&
+         context->priv->backend != NULL;
+}
+
@@ -88,8 +88,29 @@ gboolean mate_mixer_context_set_app_icon(MateMixerContext *context,
                                          const gchar *app_icon);
 gboolean mate_mixer_context_set_server_address(MateMixerContext *context,
                                                const gchar *address);
+gboolean mate_mixer_context_set_lazy_loading(MateMixerContext *context,
+                                             gboolean lazy_loading);
+gboolean mate_mixer_context_set_loading_flags(MateMixerContext *context,
+                                              MateMixerLoadingFlags flags);
+gboolean mate_mixer_context_set_min_control_lifetime(MateMixerContext *context,
+                                                     guint lifetime);
+gboolean mate_mixer_context_set_interests(MateMixerContext *context,
+                                          MateMixerInterestFlags interests);
+gboolean mate_mixer_context_set_journal_size(MateMixerContext *context,
+                                             guint size);
+gboolean mate_mixer_context_set_publish_snapshots(MateMixerContext *context,
+                                                  gboolean publish_snapshots);
+gboolean mate_mixer_context_set_dedicated_thread(MateMixerContext *context,
+                                                 gboolean dedicated_thread);
+gboolean mate_mixer_context_set_pollable(MateMixerContext *context,
+                                         gboolean pollable);
 
 gboolean mate_mixer_context_open(MateMixerContext *context);
+
+gint mate_mixer_context_query(MateMixerContext *context, gint *timeout,
+                              GPollFD *fds, gint n_fds);
+gboolean mate_mixer_context_dispatch(MateMixerContext *context, GPollFD *fds,
+                                     gint n_fds);
 void mate_mixer_context_close(MateMixerContext *context);
 
 MateMixerState mate_mixer_context_get_state(MateMixerContext *context);
@@ -115,6 +136,19 @@ MateMixerStream *mate_mixer_context_get_default_output_stream(
 gboolean mate_mixer_context_set_default_output_stream(MateMixerContext *context,
                                                       MateMixerStream *stream);
 
+gboolean mate_mixer_context_begin_transaction(MateMixerContext *context);
+gboolean mate_mixer_context_commit_transaction(MateMixerContext *context);
+
+guint64 mate_mixer_context_get_journal_sequence(MateMixerContext *context);
+gboolean mate_mixer_context_list_changes(MateMixerContext *context,
+                                         guint64 sequence, GList **changes);
+
+GVariant *mate_mixer_context_get_snapshot(MateMixerContext *context);
+
+GVariant *mate_mixer_context_save_state(MateMixerContext *context);
+gboolean mate_mixer_context_restore_state(MateMixerContext *context,
+                                          GVariant *state);
+
 const gchar *mate_mixer_context_get_backend_name(MateMixerContext *context);
 MateMixerBackendType mate_mixer_context_get_backend_type(
     MateMixerContext *context);
@@ -84,6 +84,51 @@ GType mate_mixer_backend_flags_get_type(void) {
   return etype;
 }
 
+GType mate_mixer_interest_flags_get_type(void) {
+  static GType etype = 0;
+
+  if (etype == 0) {
+    static const GFlagsValue values[] = {
+        {MATE_MIXER_INTEREST_NONE, "MATE_MIXER_INTEREST_NONE", "none"},
+        {MATE_MIXER_INTEREST_DEVICES, "MATE_MIXER_INTEREST_DEVICES",
+         "devices"},
+        {MATE_MIXER_INTEREST_STREAMS, "MATE_MIXER_INTEREST_STREAMS",
+         "streams"},
+        {MATE_MIXER_INTEREST_APPLICATION_CONTROLS,
+         "MATE_MIXER_INTEREST_APPLICATION_CONTROLS", "application-controls"},
+        {MATE_MIXER_INTEREST_STORED_CONTROLS,
+         "MATE_MIXER_INTEREST_STORED_CONTROLS", "stored-controls"},
+        {MATE_MIXER_INTEREST_ALL, "MATE_MIXER_INTEREST_ALL", "all"},
+        {0, NULL, NULL}};
+    etype = g_flags_register_static(
+        g_intern_static_string("MateMixerInterestFlags"), values);
+  }
+  return etype;
+}
+
+GType mate_mixer_loading_flags_get_type(void) {
+  static GType etype = 0;
+
+  if (etype == 0) {
+    static const GFlagsValue values[] = {
+        {MATE_MIXER_LOADING_NONE, "MATE_MIXER_LOADING_NONE", "none"},
+        {MATE_MIXER_LOADING_DEFER_DEVICES, "MATE_MIXER_LOADING_DEFER_DEVICES",
+         "defer-devices"},
+        {MATE_MIXER_LOADING_PROGRESSIVE, "MATE_MIXER_LOADING_PROGRESSIVE",
+         "progressive"},
+        {MATE_MIXER_LOADING_LAZY_STORED_CONTROLS,
+         "MATE_MIXER_LOADING_LAZY_STORED_CONTROLS", "lazy-stored-controls"},
+        {MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS,
+         "MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS",
+         "lazy-application-controls"},
+        {MATE_MIXER_LOADING_ALL, "MATE_MIXER_LOADING_ALL", "all"},
+        {0, NULL, NULL}};
+    etype = g_flags_register_static(
+        g_intern_static_string("MateMixerLoadingFlags"), values);
+  }
+  return etype;
+}
+
 GType mate_mixer_direction_get_type(void) {
   static GType etype = 0;
 
@@ -307,3 +352,44 @@ GType mate_mixer_channel_position_get_type(void) {
   }
   return etype;
 }
+
+GType mate_mixer_change_type_get_type(void) {
+  static GType etype = 0;
+
+  if (etype == 0) {
+    static const GEnumValue values[] = {
+        {MATE_MIXER_CHANGE_UNKNOWN, "MATE_MIXER_CHANGE_UNKNOWN", "unknown"},
+        {MATE_MIXER_CHANGE_DEVICE_ADDED, "MATE_MIXER_CHANGE_DEVICE_ADDED",
+         "device-added"},
+        {MATE_MIXER_CHANGE_DEVICE_REMOVED, "MATE_MIXER_CHANGE_DEVICE_REMOVED",
+         "device-removed"},
+        {MATE_MIXER_CHANGE_STREAM_ADDED, "MATE_MIXER_CHANGE_STREAM_ADDED",
+         "stream-added"},
+        {MATE_MIXER_CHANGE_STREAM_REMOVED, "MATE_MIXER_CHANGE_STREAM_REMOVED",
+         "stream-removed"},
+        {MATE_MIXER_CHANGE_STORED_CONTROL_ADDED,
+         "MATE_MIXER_CHANGE_STORED_CONTROL_ADDED", "stored-control-added"},
+        {MATE_MIXER_CHANGE_STORED_CONTROL_REMOVED,
+         "MATE_MIXER_CHANGE_STORED_CONTROL_REMOVED", "stored-control-removed"},
+        {MATE_MIXER_CHANGE_CONTROL_ADDED, "MATE_MIXER_CHANGE_CONTROL_ADDED",
+         "control-added"},
+        {MATE_MIXER_CHANGE_CONTROL_REMOVED, "MATE_MIXER_CHANGE_CONTROL_REMOVED",
+         "control-removed"},
+        {MATE_MIXER_CHANGE_SWITCH_ADDED, "MATE_MIXER_CHANGE_SWITCH_ADDED",
+         "switch-added"},
+        {MATE_MIXER_CHANGE_SWITCH_REMOVED, "MATE_MIXER_CHANGE_SWITCH_REMOVED",
+         "switch-removed"},
+        {MATE_MIXER_CHANGE_VOLUME, "MATE_MIXER_CHANGE_VOLUME", "volume"},
+        {MATE_MIXER_CHANGE_MUTE, "MATE_MIXER_CHANGE_MUTE", "mute"},
+        {MATE_MIXER_CHANGE_ACTIVE_OPTION, "MATE_MIXER_CHANGE_ACTIVE_OPTION",
+         "active-option"},
+        {MATE_MIXER_CHANGE_DEFAULT_INPUT_STREAM,
+         "MATE_MIXER_CHANGE_DEFAULT_INPUT_STREAM", "default-input-stream"},
+        {MATE_MIXER_CHANGE_DEFAULT_OUTPUT_STREAM,
+         "MATE_MIXER_CHANGE_DEFAULT_OUTPUT_STREAM", "default-output-stream"},
+        {0, NULL, NULL}};
+    etype = g_enum_register_static(
+        g_intern_static_string("MateMixerChangeType"), values);
+  }
+  return etype;
+}
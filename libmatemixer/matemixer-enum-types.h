@@ -37,6 +37,12 @@ GType mate_mixer_backend_type_get_type(void) G_GNUC_CONST;
 #define MATE_MIXER_TYPE_BACKEND_FLAGS (mate_mixer_backend_flags_get_type())
 GType mate_mixer_backend_flags_get_type(void) G_GNUC_CONST;
 
+#define MATE_MIXER_TYPE_INTEREST_FLAGS (mate_mixer_interest_flags_get_type())
+GType mate_mixer_interest_flags_get_type(void) G_GNUC_CONST;
+
+#define MATE_MIXER_TYPE_LOADING_FLAGS (mate_mixer_loading_flags_get_type())
+GType mate_mixer_loading_flags_get_type(void) G_GNUC_CONST;
+
 #define MATE_MIXER_TYPE_DIRECTION (mate_mixer_direction_get_type())
 GType mate_mixer_direction_get_type(void) G_GNUC_CONST;
 
@@ -68,6 +74,9 @@ GType mate_mixer_stream_switch_role_get_type(void) G_GNUC_CONST;
   (mate_mixer_channel_position_get_type())
 GType mate_mixer_channel_position_get_type(void) G_GNUC_CONST;
 
+#define MATE_MIXER_TYPE_CHANGE_TYPE (mate_mixer_change_type_get_type())
+GType mate_mixer_change_type_get_type(void) G_GNUC_CONST;
+
 G_END_DECLS
 
 #endif /* MATEMIXER_ENUM_TYPES_H */
@@ -103,6 +103,64 @@ typedef enum { /*< flags >*/
                MATE_MIXER_BACKEND_CAN_SET_DEFAULT_OUTPUT_STREAM = 1 << 3
 } MateMixerBackendFlags;
 
+/**
+ * MateMixerInterestFlags:
+ * @MATE_MIXER_INTEREST_NONE:
+ *     No objects besides the server information are of interest.
+ * @MATE_MIXER_INTEREST_DEVICES:
+ *     Devices are of interest.
+ * @MATE_MIXER_INTEREST_STREAMS:
+ *     Streams and their controls are of interest.
+ * @MATE_MIXER_INTEREST_APPLICATION_CONTROLS:
+ *     Stream controls of applications are of interest.
+ * @MATE_MIXER_INTEREST_STORED_CONTROLS:
+ *     Stored controls are of interest.
+ * @MATE_MIXER_INTEREST_ALL:
+ *     All objects are of interest.
+ *
+ * Flags describing which objects an application is interested in, the sound
+ * system backend may avoid tracking the remaining ones.
+ */
+typedef enum { /*< flags >*/
+               MATE_MIXER_INTEREST_NONE = 0,
+               MATE_MIXER_INTEREST_DEVICES = 1 << 0,
+               MATE_MIXER_INTEREST_STREAMS = 1 << 1,
+               MATE_MIXER_INTEREST_APPLICATION_CONTROLS = 1 << 2,
+               MATE_MIXER_INTEREST_STORED_CONTROLS = 1 << 3,
+               MATE_MIXER_INTEREST_ALL = 0xf
+} MateMixerInterestFlags;
+
+/**
+ * MateMixerLoadingFlags:
+ * @MATE_MIXER_LOADING_NONE:
+ *     Everything is loaded before the connection is reported as ready.
+ * @MATE_MIXER_LOADING_DEFER_DEVICES:
+ *     The streams and controls of a device are only loaded when they are
+ *     first requested.
+ * @MATE_MIXER_LOADING_PROGRESSIVE:
+ *     The connection is reported as ready as soon as the sound server
+ *     information is known and the remaining objects are announced as they
+ *     arrive.
+ * @MATE_MIXER_LOADING_LAZY_STORED_CONTROLS:
+ *     Stored controls are only loaded when they are first listed.
+ * @MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS:
+ *     Stream controls of applications are only created when they are first
+ *     listed or looked up.
+ * @MATE_MIXER_LOADING_ALL:
+ *     All the loading behaviours are enabled.
+ *
+ * Flags describing which parts of the state the sound system backend may
+ * load on demand rather than when the connection is established.
+ */
+typedef enum { /*< flags >*/
+               MATE_MIXER_LOADING_NONE = 0,
+               MATE_MIXER_LOADING_DEFER_DEVICES = 1 << 0,
+               MATE_MIXER_LOADING_PROGRESSIVE = 1 << 1,
+               MATE_MIXER_LOADING_LAZY_STORED_CONTROLS = 1 << 2,
+               MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS = 1 << 3,
+               MATE_MIXER_LOADING_ALL = 0xf
+} MateMixerLoadingFlags;
+
 /**
  * MateMixerDirection:
  * @MATE_MIXER_DIRECTION_UNKNOWN:
@@ -369,4 +427,60 @@ typedef enum {
   MATE_MIXER_CHANNEL_MAX
 } MateMixerChannelPosition;
 
+/**
+ * MateMixerChangeType:
+ * @MATE_MIXER_CHANGE_UNKNOWN:
+ *     Unknown change type. This type is used as an error indicator.
+ * @MATE_MIXER_CHANGE_DEVICE_ADDED:
+ *     A device has been added.
+ * @MATE_MIXER_CHANGE_DEVICE_REMOVED:
+ *     A device has been removed.
+ * @MATE_MIXER_CHANGE_STREAM_ADDED:
+ *     A stream has been added.
+ * @MATE_MIXER_CHANGE_STREAM_REMOVED:
+ *     A stream has been removed.
+ * @MATE_MIXER_CHANGE_STORED_CONTROL_ADDED:
+ *     A stored control has been added.
+ * @MATE_MIXER_CHANGE_STORED_CONTROL_REMOVED:
+ *     A stored control has been removed.
+ * @MATE_MIXER_CHANGE_CONTROL_ADDED:
+ *     A stream control has been added to a stream.
+ * @MATE_MIXER_CHANGE_CONTROL_REMOVED:
+ *     A stream control has been removed from a stream.
+ * @MATE_MIXER_CHANGE_SWITCH_ADDED:
+ *     A switch has been added to a stream or device.
+ * @MATE_MIXER_CHANGE_SWITCH_REMOVED:
+ *     A switch has been removed from a stream or device.
+ * @MATE_MIXER_CHANGE_VOLUME:
+ *     The volume of a stream control or stored control has changed.
+ * @MATE_MIXER_CHANGE_MUTE:
+ *     The mute state of a stream control or stored control has changed.
+ * @MATE_MIXER_CHANGE_ACTIVE_OPTION:
+ *     The active option of a switch has changed.
+ * @MATE_MIXER_CHANGE_DEFAULT_INPUT_STREAM:
+ *     The default input stream has changed.
+ * @MATE_MIXER_CHANGE_DEFAULT_OUTPUT_STREAM:
+ *     The default output stream has changed.
+ *
+ * Type of a change recorded in the change journal of a #MateMixerContext.
+ */
+typedef enum {
+  MATE_MIXER_CHANGE_UNKNOWN,
+  MATE_MIXER_CHANGE_DEVICE_ADDED,
+  MATE_MIXER_CHANGE_DEVICE_REMOVED,
+  MATE_MIXER_CHANGE_STREAM_ADDED,
+  MATE_MIXER_CHANGE_STREAM_REMOVED,
+  MATE_MIXER_CHANGE_STORED_CONTROL_ADDED,
+  MATE_MIXER_CHANGE_STORED_CONTROL_REMOVED,
+  MATE_MIXER_CHANGE_CONTROL_ADDED,
+  MATE_MIXER_CHANGE_CONTROL_REMOVED,
+  MATE_MIXER_CHANGE_SWITCH_ADDED,
+  MATE_MIXER_CHANGE_SWITCH_REMOVED,
+  MATE_MIXER_CHANGE_VOLUME,
+  MATE_MIXER_CHANGE_MUTE,
+  MATE_MIXER_CHANGE_ACTIVE_OPTION,
+  MATE_MIXER_CHANGE_DEFAULT_INPUT_STREAM,
+  MATE_MIXER_CHANGE_DEFAULT_OUTPUT_STREAM
+} MateMixerChangeType;
+
 #endif /* MATEMIXER_ENUMS_H */
@@ -107,6 +107,8 @@ G_BEGIN_DECLS
 
 const GList *_mate_mixer_list_modules(void);
 
+void _mate_mixer_set_modules_dir(const gchar *path);
+
 guint32 _mate_mixer_create_channel_mask(MateMixerChannelPosition *positions,
                                         guint n) G_GNUC_PURE;
 
@@ -40,6 +40,12 @@ void _mate_mixer_stream_control_set_balance(MateMixerStreamControl *control,
 void _mate_mixer_stream_control_set_fade(MateMixerStreamControl *control,
                                          gfloat fade);
 
+void _mate_mixer_stream_control_invalidate_balance_fade(
+    MateMixerStreamControl *control);
+
+gboolean _mate_mixer_stream_control_set_channel_volumes(
+    MateMixerStreamControl *control, const guint *volumes, guint channels);
+
 G_END_DECLS
 
 #endif /* MATEMIXER_STREAM_CONTROL_PRIVATE_H */
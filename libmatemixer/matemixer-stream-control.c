@@ -36,6 +36,8 @@ struct _MateMixerStreamControlPrivate {
   gboolean mute;
   gfloat balance;
   gfloat fade;
+  gboolean balance_dirty;
+  gboolean fade_dirty;
   MateMixerStream *stream;
   MateMixerStreamControlFlags flags;
   MateMixerStreamControlRole role;
@@ -67,6 +69,8 @@ static guint signals[N_SIGNALS] = {
     0,
 };
 
+static guint notify_signal_id = 0;
+
 static void mate_mixer_stream_control_get_property(GObject *object,
                                                    guint param_id,
                                                    GValue *value,
@@ -78,6 +82,12 @@ static void mate_mixer_stream_control_set_property(GObject *object,
 
 static void mate_mixer_stream_control_finalize(GObject *object);
 
+static void refresh_balance(MateMixerStreamControl *control);
+static void refresh_fade(MateMixerStreamControl *control);
+
+static gboolean has_notify_handler(MateMixerStreamControl *control,
+                                   guint param_id);
+
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE(MateMixerStreamControl,
                                     mate_mixer_stream_control, G_TYPE_OBJECT)
 
@@ -142,6 +152,8 @@ static void mate_mixer_stream_control_class_init(
       "monitor-value", G_TYPE_FROM_CLASS(klass), G_SIGNAL_RUN_FIRST,
       G_STRUCT_OFFSET(MateMixerStreamControlClass, monitor_value), NULL, NULL,
       g_cclosure_marshal_VOID__DOUBLE, G_TYPE_NONE, 1, G_TYPE_DOUBLE);
+
+  notify_signal_id = g_signal_lookup("notify", G_TYPE_OBJECT);
 }
 
 static void mate_mixer_stream_control_get_property(GObject *object,
@@ -601,9 +613,10 @@ gboolean mate_mixer_stream_control_set_channel_decibel(
 gfloat mate_mixer_stream_control_get_balance(MateMixerStreamControl *control) {
   g_return_val_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control), 0.0f);
 
-  if (control->priv->flags & MATE_MIXER_STREAM_CONTROL_CAN_BALANCE)
+  if (control->priv->flags & MATE_MIXER_STREAM_CONTROL_CAN_BALANCE) {
+    refresh_balance(control);
     return control->priv->balance;
-  else
+  } else
     return 0.0f;
 }
 
@@ -620,6 +633,8 @@ gboolean mate_mixer_stream_control_set_balance(MateMixerStreamControl *control,
   if ((control->priv->flags & MATE_MIXER_STREAM_CONTROL_CAN_BALANCE) == 0)
     return FALSE;
 
+  refresh_balance(control);
+
   if (control->priv->balance != balance) {
     MateMixerStreamControlClass *klass =
         MATE_MIXER_STREAM_CONTROL_GET_CLASS(control);
@@ -639,9 +654,10 @@ gboolean mate_mixer_stream_control_set_balance(MateMixerStreamControl *control,
 gfloat mate_mixer_stream_control_get_fade(MateMixerStreamControl *control) {
   g_return_val_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control), 0.0f);
 
-  if (control->priv->flags & MATE_MIXER_STREAM_CONTROL_CAN_FADE)
+  if (control->priv->flags & MATE_MIXER_STREAM_CONTROL_CAN_FADE) {
+    refresh_fade(control);
     return control->priv->fade;
-  else
+  } else
     return 0.0f;
 }
 
@@ -658,6 +674,8 @@ gboolean mate_mixer_stream_control_set_fade(MateMixerStreamControl *control,
   if ((control->priv->flags & MATE_MIXER_STREAM_CONTROL_CAN_FADE) == 0)
     return FALSE;
 
+  refresh_fade(control);
+
   if (control->priv->fade != fade) {
     MateMixerStreamControlClass *klass =
         MATE_MIXER_STREAM_CONTROL_GET_CLASS(control);
@@ -802,6 +820,8 @@ void _mate_mixer_stream_control_set_balance(MateMixerStreamControl *control,
                                             gfloat balance) {
   g_return_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control));
 
+  control->priv->balance_dirty = FALSE;
+
   if (control->priv->balance == balance) return;
 
   control->priv->balance = balance;
@@ -813,9 +833,102 @@ void _mate_mixer_stream_control_set_fade(MateMixerStreamControl *control,
                                          gfloat fade) {
   g_return_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control));
 
+  control->priv->fade_dirty = FALSE;
+
   if (control->priv->fade == fade) return;
 
   control->priv->fade = fade;
 
   g_object_notify_by_pspec(G_OBJECT(control), properties[PROP_FADE]);
 }
+
+void _mate_mixer_stream_control_invalidate_balance_fade(
+    MateMixerStreamControl *control) {
+  gfloat value;
+
+  g_return_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control));
+
+  /* Computing the values requires going through the channel map, which is
+   * postponed until the values are read, unless somebody is waiting for
+   * the notifications */
+  control->priv->balance_dirty = TRUE;
+  control->priv->fade_dirty = TRUE;
+
+  if (has_notify_handler(control, PROP_BALANCE) == TRUE) {
+    value = control->priv->balance;
+
+    refresh_balance(control);
+    if (control->priv->balance != value)
+      g_object_notify_by_pspec(G_OBJECT(control), properties[PROP_BALANCE]);
+  }
+
+  if (has_notify_handler(control, PROP_FADE) == TRUE) {
+    value = control->priv->fade;
+
+    refresh_fade(control);
+    if (control->priv->fade != value)
+      g_object_notify_by_pspec(G_OBJECT(control), properties[PROP_FADE]);
+  }
+}
+
+gboolean _mate_mixer_stream_control_set_channel_volumes(
+    MateMixerStreamControl *control, const guint *volumes, guint channels) {
+  MateMixerStreamControlClass *klass;
+  guint i;
+  gboolean result = TRUE;
+
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control), FALSE);
+  g_return_val_if_fail(volumes != NULL, FALSE);
+
+  if ((control->priv->flags & MATE_MIXER_STREAM_CONTROL_VOLUME_WRITABLE) == 0)
+    return FALSE;
+
+  if (channels != mate_mixer_stream_control_get_num_channels(control))
+    return FALSE;
+
+  klass = MATE_MIXER_STREAM_CONTROL_GET_CLASS(control);
+
+  /* Backends which can change all the channels in a single request provide
+   * the function, otherwise only the differing channels are set one by one */
+  if (klass->set_channel_volumes != NULL)
+    return klass->set_channel_volumes(control, volumes, channels);
+
+  for (i = 0; i < channels; i++) {
+    if (klass->get_channel_volume(control, i) == volumes[i]) continue;
+
+    if (klass->set_channel_volume(control, i, volumes[i]) == FALSE)
+      result = FALSE;
+  }
+  return result;
+}
+
+static void refresh_balance(MateMixerStreamControl *control) {
+  MateMixerStreamControlClass *klass;
+
+  if (control->priv->balance_dirty == FALSE) return;
+
+  klass = MATE_MIXER_STREAM_CONTROL_GET_CLASS(control);
+  if (klass->get_balance != NULL)
+    control->priv->balance = klass->get_balance(control);
+
+  control->priv->balance_dirty = FALSE;
+}
+
+static void refresh_fade(MateMixerStreamControl *control) {
+  MateMixerStreamControlClass *klass;
+
+  if (control->priv->fade_dirty == FALSE) return;
+
+  klass = MATE_MIXER_STREAM_CONTROL_GET_CLASS(control);
+  if (klass->get_fade != NULL) control->priv->fade = klass->get_fade(control);
+
+  control->priv->fade_dirty = FALSE;
+}
+
+static gboolean has_notify_handler(MateMixerStreamControl *control,
+                                   guint param_id) {
+  /* Also true for handlers connected to notify without a detail */
+  return g_signal_has_handler_pending(
+      control, notify_signal_id,
+      g_param_spec_get_name_quark(properties[param_id]), FALSE);
+}
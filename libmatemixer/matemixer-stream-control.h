@@ -117,6 +117,13 @@ struct _MateMixerStreamControlClass {
 
   /* Signals */
   void (*monitor_value)(MateMixerStreamControl *control, gdouble value);
+
+  /* Appended to keep the offsets of the older members */
+  gfloat (*get_balance)(MateMixerStreamControl *control);
+  gfloat (*get_fade)(MateMixerStreamControl *control);
+
+  gboolean (*set_channel_volumes)(MateMixerStreamControl *control,
+                                  const guint *volumes, guint channels);
 };
 
 GType mate_mixer_stream_control_get_type(void) G_GNUC_CONST;
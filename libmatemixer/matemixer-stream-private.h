@@ -27,6 +27,17 @@ G_BEGIN_DECLS
 void _mate_mixer_stream_set_default_control(MateMixerStream *stream,
                                             MateMixerStreamControl *control);
 
+void _mate_mixer_stream_finish_batch(MateMixerStream *stream, guint batch,
+                                     gboolean success);
+
+/* Variants which do not create controls the backend has only announced */
+MateMixerStreamControl *_mate_mixer_stream_peek_control(
+    MateMixerStream *stream, const gchar *name);
+GList *_mate_mixer_stream_list_loaded_controls(MateMixerStream *stream);
+
+void _mate_mixer_stream_control_loaded(MateMixerStream *stream,
+                                       MateMixerStreamControl *control);
+
 G_END_DECLS
 
 #endif /* MATEMIXER_STREAM_PRIVATE_H */
@@ -40,8 +40,16 @@ struct _MateMixerStreamPrivate {
   MateMixerDirection direction;
   MateMixerDevice *device;
   MateMixerStreamControl *control;
+  GMainContext *main_context;
+  guint batch_serial;
 };
 
+/* A batch which is finished without involving the sound system */
+typedef struct {
+  MateMixerStream *stream;
+  guint batch;
+} StreamBatch;
+
 enum {
   PROP_0,
   PROP_NAME,
@@ -61,6 +69,8 @@ enum {
   CONTROL_REMOVED,
   SWITCH_ADDED,
   SWITCH_REMOVED,
+  BATCH_FINISHED,
+  CONTROL_LOADED,
   N_SIGNALS
 };
 
@@ -85,6 +95,11 @@ static MateMixerStreamControl *mate_mixer_stream_real_get_control(
 static MateMixerStreamSwitch *mate_mixer_stream_real_get_switch(
     MateMixerStream *stream, const gchar *name);
 
+static guint next_batch(MateMixerStream *stream);
+
+static gboolean finish_batch_cb(StreamBatch *data);
+static void stream_batch_free(StreamBatch *data);
+
 static void mate_mixer_stream_class_init(MateMixerStreamClass *klass) {
   GObjectClass *object_class;
 
@@ -141,6 +156,40 @@ static void mate_mixer_stream_class_init(MateMixerStreamClass *klass) {
       "switch-removed", G_TYPE_FROM_CLASS(object_class), G_SIGNAL_RUN_FIRST,
       G_STRUCT_OFFSET(MateMixerStreamClass, switch_removed), NULL, NULL,
       g_cclosure_marshal_VOID__STRING, G_TYPE_NONE, 1, G_TYPE_STRING);
+
+  /**
+   * MateMixerStream::batch-finished:
+   * @stream: a #MateMixerStream
+   * @batch: identifier of the batch
+   * @success: whether all the operations of the batch succeeded
+   *
+   * The signal is emitted once the sound system has processed all the
+   * operations requested by mate_mixer_stream_move_controls() or
+   * mate_mixer_stream_kill_controls().
+   *
+   * The @batch is the identifier returned by the function which started
+   * the batch. The signal is never emitted before that function returns.
+   */
+  signals[BATCH_FINISHED] = g_signal_new(
+      "batch-finished", G_TYPE_FROM_CLASS(object_class), G_SIGNAL_RUN_FIRST,
+      G_STRUCT_OFFSET(MateMixerStreamClass, batch_finished), NULL, NULL, NULL,
+      G_TYPE_NONE, 2, G_TYPE_UINT, G_TYPE_BOOLEAN);
+
+  /**
+   * MateMixerStream::control-loaded:
+   * @stream: a #MateMixerStream
+   * @control: the #MateMixerStreamControl which has been created
+   *
+   * The signal is emitted when the backend creates a control which has
+   * only been announced by #MateMixerStream::control-added so far. This
+   * happens with %MATE_MIXER_LOADING_LAZY_APPLICATION_CONTROLS enabled
+   * once the control is listed or looked up.
+   */
+  signals[CONTROL_LOADED] = g_signal_new(
+      "control-loaded", G_TYPE_FROM_CLASS(object_class), G_SIGNAL_RUN_FIRST,
+      G_STRUCT_OFFSET(MateMixerStreamClass, control_loaded), NULL, NULL,
+      g_cclosure_marshal_VOID__OBJECT, G_TYPE_NONE, 1,
+      MATE_MIXER_TYPE_STREAM_CONTROL);
 }
 
 static void mate_mixer_stream_get_property(GObject *object, guint param_id,
@@ -212,6 +261,10 @@ static void mate_mixer_stream_set_property(GObject *object, guint param_id,
 
 static void mate_mixer_stream_init(MateMixerStream *stream) {
   stream->priv = mate_mixer_stream_get_instance_private(stream);
+
+  /* Streams are created by backends within the main context they run in,
+   * which may be private to the library */
+  stream->priv->main_context = g_main_context_ref_thread_default();
 }
 
 static void mate_mixer_stream_dispose(GObject *object) {
@@ -232,6 +285,8 @@ static void mate_mixer_stream_finalize(GObject *object) {
   g_free(stream->priv->name);
   g_free(stream->priv->label);
 
+  g_main_context_unref(stream->priv->main_context);
+
   G_OBJECT_CLASS(mate_mixer_stream_parent_class)->finalize(object);
 }
 
@@ -359,6 +414,129 @@ const GList *mate_mixer_stream_list_switches(MateMixerStream *stream) {
   return NULL;
 }
 
+/**
+ * mate_mixer_stream_list_controls_by_role:
+ * @stream: a #MateMixerStream
+ * @role: the role to match or %MATE_MIXER_STREAM_CONTROL_ROLE_UNKNOWN to
+ * match any role
+ * @media_role: the media role to match or
+ * %MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_UNKNOWN to match any media role
+ *
+ * Gets the controls of the stream which match the given roles, for example to
+ * move or kill them using mate_mixer_stream_move_controls() or
+ * mate_mixer_stream_kill_controls().
+ *
+ * Returns: (transfer container) (element-type MateMixerStreamControl): a new
+ * list of the matching controls. Free it with g_list_free().
+ */
+GList *mate_mixer_stream_list_controls_by_role(
+    MateMixerStream *stream, MateMixerStreamControlRole role,
+    MateMixerStreamControlMediaRole media_role) {
+  const GList *list;
+  GList *controls = NULL;
+
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), NULL);
+
+  list = mate_mixer_stream_list_controls(stream);
+  while (list != NULL) {
+    MateMixerStreamControl *control = MATE_MIXER_STREAM_CONTROL(list->data);
+
+    if ((role == MATE_MIXER_STREAM_CONTROL_ROLE_UNKNOWN ||
+         role == mate_mixer_stream_control_get_role(control)) &&
+        (media_role == MATE_MIXER_STREAM_CONTROL_MEDIA_ROLE_UNKNOWN ||
+         media_role == mate_mixer_stream_control_get_media_role(control)))
+      controls = g_list_prepend(controls, control);
+
+    list = list->next;
+  }
+  return g_list_reverse(controls);
+}
+
+/**
+ * mate_mixer_stream_move_controls:
+ * @stream: a #MateMixerStream
+ * @controls: (element-type MateMixerStreamControl) (allow-none): a list of
+ * controls of @stream, or %NULL to include all the controls of applications
+ * @target: the #MateMixerStream to move the controls to
+ *
+ * Moves the given application controls to a different stream of the same
+ * direction in a single batch. The sound system processes the whole batch
+ * at once and the #MateMixerStream::batch-finished signal is emitted when it
+ * is done; the controls then appear in @target as they are reported by the
+ * sound system.
+ *
+ * Returns: identifier of the batch, which is passed to the
+ * #MateMixerStream::batch-finished signal, or 0 on failure.
+ */
+guint mate_mixer_stream_move_controls(MateMixerStream *stream,
+                                      const GList *controls,
+                                      MateMixerStream *target) {
+  MateMixerStreamClass *klass;
+  guint batch;
+
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), 0);
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM(target), 0);
+
+  if (stream->priv->direction != target->priv->direction) return 0;
+
+  batch = next_batch(stream);
+
+  /* Nothing to move, the batch is still reported as finished */
+  if (target == stream) {
+    StreamBatch *data = g_slice_new(StreamBatch);
+    GSource *source;
+
+    data->stream = g_object_ref(stream);
+    data->batch = batch;
+
+    /* The pending source keeps a reference to the stream */
+    source = g_idle_source_new();
+    g_source_set_callback(source, (GSourceFunc)finish_batch_cb, data,
+                          (GDestroyNotify)stream_batch_free);
+    g_source_attach(source, stream->priv->main_context);
+    g_source_unref(source);
+    return batch;
+  }
+
+  klass = MATE_MIXER_STREAM_GET_CLASS(stream);
+
+  if (klass->move_controls != NULL &&
+      klass->move_controls(stream, controls, target, batch) == TRUE)
+    return batch;
+
+  return 0;
+}
+
+/**
+ * mate_mixer_stream_kill_controls:
+ * @stream: a #MateMixerStream
+ * @controls: (element-type MateMixerStreamControl) (allow-none): a list of
+ * controls of @stream, or %NULL to include all the controls of applications
+ *
+ * Terminates the streams of the applications behind the given controls in a
+ * single batch. The #MateMixerStream::batch-finished signal is emitted once
+ * the sound system has processed the whole batch.
+ *
+ * Returns: identifier of the batch, which is passed to the
+ * #MateMixerStream::batch-finished signal, or 0 on failure.
+ */
+guint mate_mixer_stream_kill_controls(MateMixerStream *stream,
+                                      const GList *controls) {
+  MateMixerStreamClass *klass;
+  guint batch;
+
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), 0);
+
+  klass = MATE_MIXER_STREAM_GET_CLASS(stream);
+  if (klass->kill_controls == NULL) return 0;
+
+  batch = next_batch(stream);
+
+  if (klass->kill_controls(stream, controls, batch) == TRUE) return batch;
+
+  return 0;
+}
+
 static MateMixerStreamControl *mate_mixer_stream_real_get_control(
     MateMixerStream *stream, const gchar *name) {
   const GList *list;
@@ -422,3 +600,64 @@ void _mate_mixer_stream_set_default_control(MateMixerStream *stream,
 
   g_object_notify_by_pspec(G_OBJECT(stream), properties[PROP_DEFAULT_CONTROL]);
 }
+
+void _mate_mixer_stream_finish_batch(MateMixerStream *stream, guint batch,
+                                     gboolean success) {
+  g_return_if_fail(MATE_MIXER_IS_STREAM(stream));
+  g_return_if_fail(batch > 0);
+
+  g_signal_emit(G_OBJECT(stream), signals[BATCH_FINISHED], 0, batch, success);
+}
+
+MateMixerStreamControl *_mate_mixer_stream_peek_control(
+    MateMixerStream *stream, const gchar *name) {
+  MateMixerStreamClass *klass;
+
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), NULL);
+  g_return_val_if_fail(name != NULL, NULL);
+
+  /* Streams without on-demand controls have nothing to avoid creating */
+  klass = MATE_MIXER_STREAM_GET_CLASS(stream);
+  if (klass->peek_control != NULL) return klass->peek_control(stream, name);
+
+  return klass->get_control(stream, name);
+}
+
+GList *_mate_mixer_stream_list_loaded_controls(MateMixerStream *stream) {
+  MateMixerStreamClass *klass;
+
+  g_return_val_if_fail(MATE_MIXER_IS_STREAM(stream), NULL);
+
+  klass = MATE_MIXER_STREAM_GET_CLASS(stream);
+  if (klass->list_loaded_controls != NULL)
+    return klass->list_loaded_controls(stream);
+
+  return g_list_copy((GList *)mate_mixer_stream_list_controls(stream));
+}
+
+void _mate_mixer_stream_control_loaded(MateMixerStream *stream,
+                                       MateMixerStreamControl *control) {
+  g_return_if_fail(MATE_MIXER_IS_STREAM(stream));
+  g_return_if_fail(MATE_MIXER_IS_STREAM_CONTROL(control));
+
+  g_signal_emit(G_OBJECT(stream), signals[CONTROL_LOADED], 0, control);
+}
+
+static guint next_batch(MateMixerStream *stream) {
+  /* Zero is reserved for failures */
+  if (++stream->priv->batch_serial == 0) stream->priv->batch_serial = 1;
+
+  return stream->priv->batch_serial;
+}
+
+static gboolean finish_batch_cb(StreamBatch *data) {
+  _mate_mixer_stream_finish_batch(data->stream, data->batch, TRUE);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void stream_batch_free(StreamBatch *data) {
+  g_object_unref(data->stream);
+
+  g_slice_free(StreamBatch, data);
+}
@@ -77,6 +77,22 @@ struct _MateMixerStreamClass {
 
   void (*switch_added)(MateMixerStream *stream, const gchar *name);
   void (*switch_removed)(MateMixerStream *stream, const gchar *name);
+
+  void (*batch_finished)(MateMixerStream *stream, guint batch,
+                         gboolean success);
+
+  /* Appended to keep the offsets of the older members */
+  gboolean (*move_controls)(MateMixerStream *stream, const GList *controls,
+                            MateMixerStream *target, guint batch);
+  gboolean (*kill_controls)(MateMixerStream *stream, const GList *controls,
+                            guint batch);
+
+  MateMixerStreamControl *(*peek_control)(MateMixerStream *stream,
+                                          const gchar *name);
+  GList *(*list_loaded_controls)(MateMixerStream *stream);
+
+  void (*control_loaded)(MateMixerStream *stream,
+                         MateMixerStreamControl *control);
 };
 
 GType mate_mixer_stream_get_type(void) G_GNUC_CONST;
@@ -98,6 +114,16 @@ MateMixerStreamControl *mate_mixer_stream_get_default_control(
 const GList *mate_mixer_stream_list_controls(MateMixerStream *stream);
 const GList *mate_mixer_stream_list_switches(MateMixerStream *stream);
 
+GList *mate_mixer_stream_list_controls_by_role(
+    MateMixerStream *stream, MateMixerStreamControlRole role,
+    MateMixerStreamControlMediaRole media_role);
+
+guint mate_mixer_stream_move_controls(MateMixerStream *stream,
+                                      const GList *controls,
+                                      MateMixerStream *target);
+guint mate_mixer_stream_kill_controls(MateMixerStream *stream,
+                                      const GList *controls);
+
 G_END_DECLS
 
 #endif /* MATEMIXER_STREAM_H */
@@ -21,6 +21,7 @@
 G_BEGIN_DECLS
 
 typedef struct _MateMixerAppInfo MateMixerAppInfo;
+typedef struct _MateMixerChange MateMixerChange;
 typedef struct _MateMixerContext MateMixerContext;
 typedef struct _MateMixerDevice MateMixerDevice;
 typedef struct _MateMixerDeviceSwitch MateMixerDeviceSwitch;
@@ -48,6 +48,7 @@ static void load_modules(void);
 static gint compare_modules(gconstpointer a, gconstpointer b);
 
 static GList *modules = NULL;
+static gchar *modules_dir = NULL;
 static gboolean initialized = FALSE;
 
 /**
@@ -109,6 +110,23 @@ gboolean mate_mixer_is_initialized(void) { return initialized; }
  */
 const GList *_mate_mixer_list_modules(void) { return (const GList *)modules; }
 
+/**
+ * _mate_mixer_set_modules_dir:
+ * @path: a directory containing backend module libraries
+ *
+ * Makes the library load the backend modules from @path instead of the
+ * installation directory. This is only meant for programs running in the
+ * build tree, such as the checks, and must be called before
+ * mate_mixer_init().
+ */
+void _mate_mixer_set_modules_dir(const gchar *path) {
+  g_return_if_fail(path != NULL);
+  g_return_if_fail(initialized == FALSE);
+
+  g_free(modules_dir);
+  modules_dir = g_strdup(path);
+}
+
 /**
  * _mate_mixer_create_channel_mask:
  * @positions: an array of channel positions
@@ -138,11 +156,14 @@ static void load_modules(void) {
 
   if (G_LIKELY(g_module_supported() == TRUE)) {
     GDir *dir;
+    const gchar *path;
     GError *error = NULL;
 
+    path = (modules_dir != NULL) ? modules_dir : LIBMATEMIXER_BACKEND_DIR;
+
     /* Read the directory which contains module libraries and create a list
      * of those that are likely to be usable backend modules */
-    dir = g_dir_open(LIBMATEMIXER_BACKEND_DIR, 0, &error);
+    dir = g_dir_open(path, 0, &error);
     if (dir != NULL) {
       const gchar *name;
 
@@ -151,7 +172,7 @@ static void load_modules(void) {
 
         if (g_str_has_suffix(name, "." G_MODULE_SUFFIX) == FALSE) continue;
 
-        file = g_build_filename(LIBMATEMIXER_BACKEND_DIR, name, NULL);
+        file = g_build_filename(path, name, NULL);
         modules = g_list_prepend(modules, mate_mixer_backend_module_new(file));
         g_free(file);
       }
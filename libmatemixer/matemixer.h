@@ -21,6 +21,7 @@
 #include <glib-object.h>
 #include <glib.h>
 #include <libmatemixer/matemixer-app-info.h>
+#include <libmatemixer/matemixer-change.h>
 #include <libmatemixer/matemixer-context.h>
 #include <libmatemixer/matemixer-device-switch.h>
 #include <libmatemixer/matemixer-device.h>